@@ -6,6 +6,8 @@
 #include "Core/Components/AC_Inventory.h"
 #include "Core/Data/FL_InventoryFramework.h"
 #include "Core/Interfaces/I_Inventory.h"
+#include "Core/Subsystems/RPCBudgetSubsystem.h"
+#include "Core/Subsystems/RPCProfilerSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Net/UnrealNetwork.h"
@@ -36,6 +38,12 @@ void UAC_Crafting::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLife
 	DOREPLIFETIME_CONDITION(UAC_Crafting, Recipes, COND_OwnerOnly)
 }
 
+bool UAC_Crafting::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+	URPCProfilerSubsystem::RecordRPC(this, Function, Parameters);
+	return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
+}
+
 void UAC_Crafting::OnRep_Recipes_Internal(const TArray<TSoftObjectPtr<UDA_CoreCraftingRecipe>>& OldRecipes)
 {
 	//Call blueprint event for blueprint programmers
@@ -211,6 +219,12 @@ void UAC_Crafting::C_CraftCancelled_Implementation(UDA_CoreCraftingRecipe* Recip
 
 void UAC_Crafting::S_CancelCraft_Implementation(int32 Handle)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_CancelCraft_Implementation(Handle); }))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	for(int32 CurrentCraft = 0; CurrentCraft < CraftHandles.Num(); CurrentCraft++)
 	{
 		if(CraftHandles[CurrentCraft].TimerHandle == Handle)
@@ -224,6 +238,22 @@ void UAC_Crafting::S_CancelCraft_Implementation(int32 Handle)
 
 void UAC_Crafting::S_CraftRecipe_Implementation(UDA_CoreCraftingRecipe* Recipe, int32 Handle)
 {
+	//Let the client know the craft won't happen if the budget turns it away.
+	auto RejectCraft = [WeakThis = TWeakObjectPtr<UAC_Crafting>(this), WeakRecipe = TWeakObjectPtr<UDA_CoreCraftingRecipe>(Recipe), Handle]()
+	{
+		if(UAC_Crafting* Requester = WeakThis.Get())
+		{
+			Requester->C_CraftCancelled(WeakRecipe.Get(), Handle, true);
+		}
+	};
+
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_CraftRecipe_Implementation(Recipe, Handle); },
+		{Recipe}, RejectCraft))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	//Start of validation
 	if(!UKismetSystemLibrary::DoesImplementInterface(GetOwner(), UI_Inventory::StaticClass()))
 	{
@@ -389,6 +419,13 @@ void UAC_Crafting::C_CallPostRecipeCrafted_Implementation(UDA_CoreCraftingRecipe
 
 void UAC_Crafting::S_AddRecipe_Implementation(UDA_CoreCraftingRecipe* Recipe)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AddRecipe_Implementation(Recipe); },
+		{Recipe}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(Recipes.Contains(Recipe))
 	{
 		//Recipe was already owned
@@ -419,6 +456,13 @@ void UAC_Crafting::C_CallRecipeAdded_Implementation(UDA_CoreCraftingRecipe* Reci
 
 void UAC_Crafting::S_RemoveRecipe_Implementation(UDA_CoreCraftingRecipe* Recipe)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveRecipe_Implementation(Recipe); },
+		{Recipe}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!Recipes.RemoveSingle(Recipe))
 	{
 		//Recipe was not found for removal.
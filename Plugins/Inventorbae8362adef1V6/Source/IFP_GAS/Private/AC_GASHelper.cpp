@@ -70,24 +70,21 @@ void UAC_GASHelper::ProcessItem(UDA_CoreItem* Item, FGameplayTagContainer Events
 		return;
 	}
 	
-	UIO_GameplayAbilityReferences* Abilities = Cast<UIO_GameplayAbilityReferences>(
-			UFL_InventoryFramework::GetTraitByClassForItem(Item, UIO_GameplayAbilityReferences::StaticClass()));
+	UIO_GameplayAbilityReferences* Abilities = UFL_InventoryFramework::GetTraitForItem<UIO_GameplayAbilityReferences>(Item);
 	if(Abilities)
 	{
 		GrantItemAbilitiesInternal(Abilities, Events);
 		RemoveItemAbilitiesInternal(Abilities, Events);
 	}
 
-	UIO_AttributeSetReferences* Attributes = Cast<UIO_AttributeSetReferences>(
-		UFL_InventoryFramework::GetTraitByClassForItem(Item, UIO_AttributeSetReferences::StaticClass()));
+	UIO_AttributeSetReferences* Attributes = UFL_InventoryFramework::GetTraitForItem<UIO_AttributeSetReferences>(Item);
 	if(Attributes)
 	{
 		GrantItemAttributesInternal(Attributes, Events);
 		RemoveItemAttributesInternal(Attributes, Events);
 	}
 		
-	UIO_GameplayEffectReferences* Effects = Cast<UIO_GameplayEffectReferences>(
-				UFL_InventoryFramework::GetTraitByClassForItem(Item, UIO_GameplayEffectReferences::StaticClass()));
+	UIO_GameplayEffectReferences* Effects = UFL_InventoryFramework::GetTraitForItem<UIO_GameplayEffectReferences>(Item);
 	if(Effects)
 	{
 		ApplyItemEffectsInternal(Item, Effects, Events);
@@ -97,7 +94,7 @@ void UAC_GASHelper::ProcessItem(UDA_CoreItem* Item, FGameplayTagContainer Events
 
 void UAC_GASHelper::GrantItemAbilities(UDA_CoreItem* Item, FGameplayTagContainer GrantEventsFilter)
 {
-	UIO_GameplayAbilityReferences* Abilities = Cast<UIO_GameplayAbilityReferences>(UFL_InventoryFramework::GetTraitByClassForItem(Item, UIO_GameplayAbilityReferences::StaticClass()));
+	UIO_GameplayAbilityReferences* Abilities = UFL_InventoryFramework::GetTraitForItem<UIO_GameplayAbilityReferences>(Item);
 	if(!Abilities)
 	{
 		return;
@@ -167,7 +164,7 @@ void UAC_GASHelper::GrantItemAbilitiesInternal(UIO_GameplayAbilityReferences* Ab
 
 void UAC_GASHelper::RemoveItemAbilities(UDA_CoreItem* Item, FGameplayTagContainer RemoveEventsFilter)
 {
-	UIO_GameplayAbilityReferences* Abilities = Cast<UIO_GameplayAbilityReferences>(UFL_InventoryFramework::GetTraitByClassForItem(Item, UIO_GameplayAbilityReferences::StaticClass()));
+	UIO_GameplayAbilityReferences* Abilities = UFL_InventoryFramework::GetTraitForItem<UIO_GameplayAbilityReferences>(Item);
 	if(!Abilities)
 	{
 		return;
@@ -221,7 +218,7 @@ void UAC_GASHelper::RemoveItemAbilitiesInternal(UIO_GameplayAbilityReferences* A
 
 void UAC_GASHelper::GrantItemAttributes(UDA_CoreItem* Item, FGameplayTagContainer GrantEventsFilter)
 {
-	UIO_AttributeSetReferences* Attributes = Cast<UIO_AttributeSetReferences>(UFL_InventoryFramework::GetTraitByClassForItem(Item, UIO_AttributeSetReferences::StaticClass()));
+	UIO_AttributeSetReferences* Attributes = UFL_InventoryFramework::GetTraitForItem<UIO_AttributeSetReferences>(Item);
 	if(!Attributes)
 	{
 		return;
@@ -288,7 +285,7 @@ void UAC_GASHelper::GrantItemAttributesInternal(UIO_AttributeSetReferences* Attr
 
 void UAC_GASHelper::RemoveItemAttributes(UDA_CoreItem* Item, FGameplayTagContainer RemoveEventsFilter)
 {
-	UIO_AttributeSetReferences* Attributes = Cast<UIO_AttributeSetReferences>(UFL_InventoryFramework::GetTraitByClassForItem(Item, UIO_AttributeSetReferences::StaticClass()));
+	UIO_AttributeSetReferences* Attributes = UFL_InventoryFramework::GetTraitForItem<UIO_AttributeSetReferences>(Item);
 	if(!Attributes)
 	{
 		return;
@@ -341,7 +338,7 @@ void UAC_GASHelper::RemoveItemAttributesInternal(UIO_AttributeSetReferences* Att
 
 void UAC_GASHelper::GrantItemEffects(UDA_CoreItem* Item, FGameplayTagContainer GrantEventsFilter)
 {
-	UIO_GameplayEffectReferences* Effects = Cast<UIO_GameplayEffectReferences>(UFL_InventoryFramework::GetTraitByClassForItem(Item, UIO_GameplayEffectReferences::StaticClass()));
+	UIO_GameplayEffectReferences* Effects = UFL_InventoryFramework::GetTraitForItem<UIO_GameplayEffectReferences>(Item);
 	if(!Effects)
 	{
 		return;
@@ -405,7 +402,7 @@ void UAC_GASHelper::ApplyItemEffectsInternal(UDA_CoreItem* Item, UIO_GameplayEff
 
 void UAC_GASHelper::RemoveItemEffects(UDA_CoreItem* Item, FGameplayTagContainer RemoveEventsFilter)
 {
-	UIO_GameplayEffectReferences* Effects = Cast<UIO_GameplayEffectReferences>(UFL_InventoryFramework::GetTraitByClassForItem(Item, UIO_GameplayEffectReferences::StaticClass()));
+	UIO_GameplayEffectReferences* Effects = UFL_InventoryFramework::GetTraitForItem<UIO_GameplayEffectReferences>(Item);
 	if(!Effects)
 	{
 		return;
@@ -481,7 +478,7 @@ TArray<UDA_CoreItem*> UAC_GASHelper::GetItemsForEvent_Implementation(FGameplayTa
 				continue;
 			}
 			
-			UIO_GameplayAbilityReferences* Abilities = Cast<UIO_GameplayAbilityReferences>(UFL_InventoryFramework::GetTraitByClassForItem(CurrentItem.ItemAsset, UIO_GameplayAbilityReferences::StaticClass()));
+			UIO_GameplayAbilityReferences* Abilities = UFL_InventoryFramework::GetTraitForItem<UIO_GameplayAbilityReferences>(CurrentItem.ItemAsset);
 			if(Abilities)
 			{
 				if(Abilities->HasAnyTagEvents(FGameplayTagContainer(Event)))
@@ -491,7 +488,7 @@ TArray<UDA_CoreItem*> UAC_GASHelper::GetItemsForEvent_Implementation(FGameplayTa
 				}
 			}
 
-			UIO_AttributeSetReferences* Attributes = Cast<UIO_AttributeSetReferences>(UFL_InventoryFramework::GetTraitByClassForItem(CurrentItem.ItemAsset, UIO_AttributeSetReferences::StaticClass()));
+			UIO_AttributeSetReferences* Attributes = UFL_InventoryFramework::GetTraitForItem<UIO_AttributeSetReferences>(CurrentItem.ItemAsset);
 			if(Attributes)
 			{
 				if(Attributes->HasAnyTagEvents(FGameplayTagContainer(Event)))
@@ -501,7 +498,7 @@ TArray<UDA_CoreItem*> UAC_GASHelper::GetItemsForEvent_Implementation(FGameplayTa
 				}
 			}
 
-			UIO_GameplayEffectReferences* Effects = Cast<UIO_GameplayEffectReferences>(UFL_InventoryFramework::GetTraitByClassForItem(CurrentItem.ItemAsset, UIO_GameplayEffectReferences::StaticClass()));
+			UIO_GameplayEffectReferences* Effects = UFL_InventoryFramework::GetTraitForItem<UIO_GameplayEffectReferences>(CurrentItem.ItemAsset);
 			if(Effects)
 			{
 				if(Effects->HasAnyTagEvents(FGameplayTagContainer(Event)))
@@ -30,6 +30,7 @@ public class InventoryFrameworkPlugin : ModuleRules
 				"UMG", 
 				"GameFeatures", 
 				"EnhancedInput",
+				"NetCore",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -6,6 +6,8 @@
 #include "Core/Components/AC_Inventory.h"
 #include "Core/Data/FL_InventoryFramework.h"
 #include "Core/Fragments/FL_IFP_FragmentHelpers.h"
+#include "Core/Subsystems/RPCBudgetSubsystem.h"
+#include "Core/Subsystems/RPCProfilerSubsystem.h"
 
 #if WITH_EDITOR
 #include "Framework/Notifications/NotificationManager.h"
@@ -30,6 +32,12 @@ UAC_Inventory* UAC_FragmentManager::GetInventory()
 	return Inventory;
 }
 
+bool UAC_FragmentManager::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+	URPCProfilerSubsystem::RecordRPC(this, Function, Parameters);
+	return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
+}
+
 void UAC_FragmentManager::InitializeFragments_Implementation()
 {
 	TArray<FS_ContainerSettings>& Containers = GetInventory()->ContainerSettings;
@@ -180,6 +188,13 @@ void UAC_FragmentManager::AddFragmentToItem(FS_InventoryItem Item, TInstancedStr
 void UAC_FragmentManager::S_AddFragmentToItem_Implementation(FS_UniqueID ItemID,
                                                              TInstancedStruct<FCoreFragment> Fragment, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AddFragmentToItem_Implementation(ItemID, Fragment, CallerLocalRole); },
+		{ItemID.ParentComponent}, GetInventory() ? GetInventory()->MakeRejectedRequest({ItemID}) : nullptr))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!ItemID.ParentComponent)
 	{
 		return;
@@ -293,6 +308,7 @@ void UAC_FragmentManager::Internal_AddFragmentToItem(FS_UniqueID ItemID, TInstan
 		//Item couldn't be found, might have been destroyed since RPC call
 		return;
 	}
+	ItemID.ParentComponent->MarkContainerDirty(ItemID.ParentComponent->ContainerSettings[Item.ContainerIndex].UniqueID.IdentityNumber);
 
 	//Check if the item already has the fragment
 	for(TInstancedStruct<FCoreFragment>& InstancedStruct : Item.ItemFragments)
@@ -349,6 +365,13 @@ void UAC_FragmentManager::RemoveFragmentFromItem(FS_InventoryItem Item, UScriptS
 void UAC_FragmentManager::S_RemoveFragmentFromItem_Implementation(FS_UniqueID ItemID,
                                                                   UScriptStruct* FragmentType, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveFragmentFromItem_Implementation(ItemID, FragmentType, CallerLocalRole); },
+		{ItemID.ParentComponent, FragmentType}, GetInventory() ? GetInventory()->MakeRejectedRequest({ItemID}) : nullptr))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!ItemID.ParentComponent)
 	{
 		return;
@@ -461,6 +484,7 @@ void UAC_FragmentManager::Internal_RemoveFragmentFromItem(FS_UniqueID ItemID, US
 		//Item couldn't be found, might have been destroyed since RPC call
 		return;
 	}
+	ItemID.ParentComponent->MarkContainerDirty(ItemID.ParentComponent->ContainerSettings[Item.ContainerIndex].UniqueID.IdentityNumber);
 
 	//Check if the item already has the fragment
 	for(TInstancedStruct<FCoreFragment>& InstancedStruct : Item.ItemFragments)
@@ -521,6 +545,13 @@ void UAC_FragmentManager::OverrideFragmentOnItem(FS_InventoryItem Item, TInstanc
 void UAC_FragmentManager::S_OverrideFragmentOnItem_Implementation(FS_UniqueID ItemID, TInstancedStruct<FCoreFragment> Fragment,
 	ENetRole CallerLocalRole, bool AddIfMissing)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_OverrideFragmentOnItem_Implementation(ItemID, Fragment, CallerLocalRole, AddIfMissing); },
+		{ItemID.ParentComponent}, GetInventory() ? GetInventory()->MakeRejectedRequest({ItemID}) : nullptr))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!ItemID.ParentComponent)
 	{
 		return;
@@ -634,6 +665,7 @@ void UAC_FragmentManager::Internal_OverrideFragmentOnItem(FS_UniqueID ItemID, TI
 		//Item couldn't be found, might have been destroyed since RPC call
 		return;
 	}
+	ItemID.ParentComponent->MarkContainerDirty(ItemID.ParentComponent->ContainerSettings[Item.ContainerIndex].UniqueID.IdentityNumber);
 	
 	for(TInstancedStruct<FCoreFragment>& InstancedStruct : ItemID.ParentComponent->ContainerSettings[Item.ContainerIndex].Items[Item.ItemIndex].ItemFragments)
 	{
@@ -691,6 +723,13 @@ void UAC_FragmentManager::AddFragmentToContainer(FS_ContainerSettings Container,
 void UAC_FragmentManager::S_AddFragmentToContainer_Implementation(FS_UniqueID ContainerID,
                                                              TInstancedStruct<FCoreFragment> Fragment, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AddFragmentToContainer_Implementation(ContainerID, Fragment, CallerLocalRole); },
+		{ContainerID.ParentComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!ContainerID.ParentComponent)
 	{
 		return;
@@ -803,6 +842,7 @@ void UAC_FragmentManager::Internal_AddFragmentToContainer(FS_UniqueID ContainerI
 		//Container couldn't be found, might have been destroyed since RPC call
 		return;
 	}
+	ContainerID.ParentComponent->MarkContainerDirty(ContainerID.IdentityNumber);
 
 	//Check if the container already has the fragment
 	for(TInstancedStruct<FCoreFragment>& InstancedStruct : Container.ContainerFragments)
@@ -855,6 +895,13 @@ void UAC_FragmentManager::RemoveFragmentFromContainer(FS_ContainerSettings Conta
 void UAC_FragmentManager::S_RemoveFragmentFromContainer_Implementation(FS_UniqueID ContainerID,
                                                                   UScriptStruct* FragmentType, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveFragmentFromContainer_Implementation(ContainerID, FragmentType, CallerLocalRole); },
+		{ContainerID.ParentComponent, FragmentType}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!ContainerID.ParentComponent)
 	{
 		return;
@@ -968,6 +1015,7 @@ void UAC_FragmentManager::Internal_RemoveFragmentFromContainer(FS_UniqueID Conta
 		//Container couldn't be found, might have been destroyed since RPC call
 		return;
 	}
+	ContainerID.ParentComponent->MarkContainerDirty(ContainerID.IdentityNumber);
 
 	//Check if the container already has the fragment
 	for(TInstancedStruct<FCoreFragment>& InstancedStruct : Container.ContainerFragments)
@@ -1024,6 +1072,13 @@ void UAC_FragmentManager::OverrideFragmentOnContainer(FS_ContainerSettings Conta
 void UAC_FragmentManager::S_OverrideFragmentOnContainer_Implementation(FS_UniqueID ContainerID, TInstancedStruct<FCoreFragment> Fragment,
 	ENetRole CallerLocalRole, bool AddIfMissing)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_OverrideFragmentOnContainer_Implementation(ContainerID, Fragment, CallerLocalRole, AddIfMissing); },
+		{ContainerID.ParentComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!ContainerID.ParentComponent)
 	{
 		return;
@@ -1137,6 +1192,7 @@ void UAC_FragmentManager::Internal_OverrideFragmentOnContainer(FS_UniqueID Conta
 		//Container couldn't be found, might have been destroyed since RPC call
 		return;
 	}
+	ContainerID.ParentComponent->MarkContainerDirty(ContainerID.IdentityNumber);
 	
 	for(TInstancedStruct<FCoreFragment>& InstancedStruct : ContainerID.ParentComponent->ContainerSettings[Container.ContainerIndex].ContainerFragments)
 	{
@@ -9,6 +9,7 @@
 #include "Core/Data/DS_InventoryFrameworkSettingsRuntime.h"
 #include "Engine/GameInstance.h"
 #include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Data/InventoryJournal.h"
 #include "Core/Fragments/CF_CompatibilitySettings.h"
 #include "Core/Fragments/CF_TileTags.h"
 #include "Core/Fragments/FL_IFP_FragmentHelpers.h"
@@ -19,6 +20,9 @@
 #include "Core/Fragments/IF_RandomItemCount.h"
 #include "Core/Interfaces/I_Inventory.h"
 #include "Core/Interfaces/I_InventoryExtension.h"
+#include "Core/Subsystems/InventoryStartupSubsystem.h"
+#include "Core/Subsystems/RPCBudgetSubsystem.h"
+#include "Core/Subsystems/RPCProfilerSubsystem.h"
 #include "Core/Traits/IT_ItemComponentTrait.h"
 #include "Core/Widgets/W_Container.h"
 #include "Kismet/GameplayStatics.h"
@@ -30,9 +34,14 @@
 #include "Core/Widgets/W_AttachmentParent.h"
 #include "Engine/ActorChannel.h"
 #include "Engine/AssetManager.h"
+#include "Async/ParallelFor.h"
 #include "LootTableSystem/Components/AC_LootTable.h"
 #include "LootTableSystem/Data/FL_LootTableHelpers.h"
+#include "LootTableSystem/Objects/O_LootPool.h"
+#include "LootTableSystem/Subsystems/LootGenerationSubsystem.h"
+#include "Misc/Paths.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 struct FTagFragment;
 UE_DEFINE_GAMEPLAY_TAG(IFP_SkipValidation, "IFP.Initialization.SkipValidation");
@@ -60,8 +69,18 @@ void UAC_Inventory::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLif
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UAC_Inventory, TagsContainer)
-	DOREPLIFETIME(UAC_Inventory, TagValuesContainer);
+	/**Component tags rarely change, so rather than comparing them every
+	 * net update, they are only replicated when they've been marked dirty.*/
+	FDoRepLifetimeParams PushModelParams;
+	PushModelParams.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAC_Inventory, TagsContainer, PushModelParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAC_Inventory, ComponentTagValues, PushModelParams);
+}
+
+bool UAC_Inventory::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+	URPCProfilerSubsystem::RecordRPC(this, Function, Parameters);
+	return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
 }
 
 UAC_FragmentManager* UAC_Inventory::GetFragmentManager()
@@ -94,11 +113,67 @@ UAC_FragmentManager* UAC_Inventory::GetFragmentManager()
 }
 
 void UAC_Inventory::StartComponent(bool RemoveSkipValidationTags)
+{
+	if(!IsComponentStarting() && !BeginStartComponent(RemoveSkipValidationTags, false))
+	{
+		return;
+	}
+
+	//Finish everything right away, even if a time sliced start was already in progress.
+	StartState.TimeSliced = false;
+	while(RunStartComponentStep())
+	{
+	}
+}
+
+void UAC_Inventory::StartComponentTimeSliced(bool RemoveSkipValidationTags)
+{
+	UInventoryStartupSubsystem* StartupSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UInventoryStartupSubsystem>() : nullptr;
+	if(!StartupSubsystem || UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->StartComponentFrameBudgetMs <= 0 ||
+		!IsValid(GetOwner()) || !GetOwner()->HasAuthority())
+	{
+		//Clients only request the containers from the server, there's nothing to spread out.
+		StartComponent(RemoveSkipValidationTags);
+		return;
+	}
+
+	if(IsComponentStarting())
+	{
+		return;
+	}
+
+	if(BeginStartComponent(RemoveSkipValidationTags, true))
+	{
+		StartupSubsystem->QueueComponent(this);
+	}
+}
+
+bool UAC_Inventory::IsComponentStarting() const
+{
+	return StartState.Stage != EComponentStartStage::None;
+}
+
+bool UAC_Inventory::IsComponentReady() const
+{
+	return Initialized && !IsComponentStarting();
+}
+
+bool UAC_Inventory::IsStartWaitingForAssets() const
+{
+	return StartState.Stage == EComponentStartStage::LoadAssets && StartState.AssetsHandle.IsValid() && !StartState.AssetsHandle->HasLoadCompleted();
+}
+
+bool UAC_Inventory::IsStartWaitingForLoot() const
+{
+	return StartState.Stage == EComponentStartStage::RollLoot && StartState.LootQueued;
+}
+
+bool UAC_Inventory::BeginStartComponent(bool RemoveSkipValidationTags, bool TimeSliced)
 {
 	if(!IsValid(GetOwner()))
 	{
 		UFL_InventoryFramework::LogIFPMessage(this, "Inventory component has no owner. Something has gone horribly wrong");
-		return;
+		return false;
 	}
 
 	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &UAC_Inventory::CleanupNullReferences);
@@ -108,28 +183,221 @@ void UAC_Inventory::StartComponent(bool RemoveSkipValidationTags)
 		if(!Initialized)
 		{
 			C_RequestServerContainerData(true);
-			return;
+			return false;
 		}
 	}
 	if(Initialized)
 	{
-		return;
+		return false;
 	}
-	
+
+	StartState = FComponentStartState();
+	StartState.Stage = EComponentStartStage::Prepare;
+	StartState.RemoveSkipValidationTags = RemoveSkipValidationTags;
+	StartState.TimeSliced = TimeSliced;
+	return true;
+}
+
+static bool CanBatchRollLootPool(const UO_LootPool* Pool)
+{
+	return IsValid(Pool) && Pool->IsBatchRolled();
+}
+
+static bool HasUnrolledLootPools(const TArray<TObjectPtr<UAC_LootTable>>& LootTables, int32 FirstTable)
+{
+	for(int32 TableIndex = FirstTable; TableIndex < LootTables.Num(); TableIndex++)
+	{
+		if(!IsValid(LootTables[TableIndex]))
+		{
+			continue;
+		}
+
+		for(auto& CurrentPool : LootTables[TableIndex]->LootPools)
+		{
+			if(CanBatchRollLootPool(CurrentPool))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool UAC_Inventory::RunStartComponentStep()
+{
+	switch(StartState.Stage)
+	{
+	case EComponentStartStage::None:
+		{
+			return false;
+		}
+	case EComponentStartStage::Prepare:
+		{
+			PrepareStartComponent();
+			StartState.Stage = EComponentStartStage::LoadAssets;
+			break;
+		}
+	case EComponentStartStage::LoadAssets:
+		{
+			if(StartState.AssetsHandle.IsValid())
+			{
+				if(StartState.TimeSliced && !StartState.AssetsHandle->HasLoadCompleted())
+				{
+					return true;
+				}
+
+				StartState.AssetsHandle->WaitUntilComplete();
+				StartState.AssetsHandle.Reset();
+			}
+			StartState.Stage = EComponentStartStage::InitializeIDs;
+			StartState.Cursor = 0;
+			break;
+		}
+	case EComponentStartStage::InitializeIDs:
+		{
+			//Containers are added while going through the items, so this is checked every step.
+			if(StartState.Cursor < ContainerSettings.Num())
+			{
+				InitializeContainerIDs(StartState.Cursor++);
+				break;
+			}
+			StartState.Stage = EComponentStartStage::RollLoot;
+			break;
+		}
+	case EComponentStartStage::RollLoot:
+		{
+			//Applying the rolls can add more loot tables, so this is checked every step.
+			if(HasUnrolledLootPools(StartState.LootTables, StartState.RolledLootTables))
+			{
+				ULootGenerationSubsystem* LootSubsystem = GetWorld() ? GetWorld()->GetSubsystem<ULootGenerationSubsystem>() : nullptr;
+				if(StartState.LootQueued)
+				{
+					if(StartState.TimeSliced)
+					{
+						return true;
+					}
+
+					/**A blocking StartComponent took over a time sliced start.
+					 * Don't wait for the subsystem, roll the loot right here.*/
+					StartState.LootQueued = false;
+					if(LootSubsystem)
+					{
+						LootSubsystem->RemoveInventory(this);
+					}
+				}
+				else if(StartState.TimeSliced && LootSubsystem)
+				{
+					//Rolled together with every other inventory that is starting.
+					LootSubsystem->QueueInventory(this);
+					StartState.LootQueued = true;
+					return true;
+				}
+
+				ULootGenerationSubsystem::GenerateLoot({this});
+				break;
+			}
+			StartState.RolledLootTables = StartState.LootTables.Num();
+			StartState.Stage = EComponentStartStage::LootTables;
+			StartState.Cursor = 0;
+			break;
+		}
+	case EComponentStartStage::LootTables:
+		{
+			if(StartState.Cursor < StartState.LootTables.Num())
+			{
+				InitializeLootTable(StartState.Cursor++);
+				break;
+			}
+			StartState.Stage = EComponentStartStage::EvaluateItems;
+			break;
+		}
+	case EComponentStartStage::EvaluateItems:
+		{
+			EvaluateItems();
+			StartState.Stage = EComponentStartStage::InitializeItems;
+			StartState.Cursor = 0;
+			break;
+		}
+	case EComponentStartStage::InitializeItems:
+		{
+			if(StartState.Cursor < ContainerSettings.Num())
+			{
+				InitializeContainerItems(StartState.Cursor++);
+				break;
+			}
+			StartState.Stage = EComponentStartStage::Finalize;
+			break;
+		}
+	case EComponentStartStage::Finalize:
+		{
+			FinalizeStartComponent();
+			StartState.Stage = EComponentStartStage::ItemInstances;
+			StartState.Cursor = 0;
+			break;
+		}
+	case EComponentStartStage::ItemInstances:
+		{
+			if(StartState.Cursor < ContainerSettings.Num() && GetOwner()->Implements<UI_Inventory>() && !II_Inventory::Execute_IsPreviewActor(GetOwner()))
+			{
+				CreateItemInstancesForContainer(ContainerSettings[StartState.Cursor++]);
+				break;
+			}
+
+			/**Alert any systems that want to work with the initialized inventory
+			 * data that everything is ready. Since we are about to initialize
+			 * equipment, which can be heavy, this is the ideal place to run
+			 * parallel work. Main example is the ItemQuery system*/
+			StartMultithreadWork.Broadcast();
+			StartState.Stage = EComponentStartStage::Equip;
+			StartState.Cursor = 0;
+			break;
+		}
+	case EComponentStartStage::Equip:
+		{
+			if(StartState.Cursor < StartState.EquippedItems.Num())
+			{
+				UFL_ExternalObjects::BroadcastItemEquipStatusUpdate(StartState.EquippedItems[StartState.Cursor++], true, TArray<FName>());
+				break;
+			}
+			StartState.Stage = EComponentStartStage::Finish;
+			break;
+		}
+	case EComponentStartStage::Finish:
+		{
+			//Reset before broadcasting, so anything listening sees the component as ready.
+			const FComponentStartState FinishedState = MoveTemp(StartState);
+			StartState = FComponentStartState();
+			FinishStartComponent(FinishedState);
+			break;
+		}
+	}
+
+	return IsComponentStarting();
+}
+
+void UAC_Inventory::CancelStartComponent()
+{
+	if(StartState.AssetsHandle.IsValid())
+	{
+		StartState.AssetsHandle->CancelHandle();
+	}
+	StartState = FComponentStartState();
+}
+
+void UAC_Inventory::PrepareStartComponent()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::PrepareStartComponent)
+
 	/**Notify all extension components the inventory is about to be initialized*/
-	TArray<UActorComponent*> InventoryExtensions = UFL_InventoryFramework::GetComponentsWithInterface(GetOwner(), UI_InventoryExtension::StaticClass());
+	StartState.InventoryExtensions.Append(UFL_InventoryFramework::GetComponentsWithInterface(GetOwner(), UI_InventoryExtension::StaticClass()));
 	
-	for(auto& CurrentExtension : InventoryExtensions)
+	for(auto& CurrentExtension : StartState.InventoryExtensions)
 	{
 		II_InventoryExtension::Execute_PreInventoryComponentInitialized(CurrentExtension, this);
 	}
 
-	TArray<FS_ContainerSettings> ContainersToRemove;
-	//We need to call ItemEquipStatusUpdated AFTER everything has been processed,
-	//so keep a record of all items that were equipped.
-	TArray<FS_InventoryItem> EquippedItems;
-
-	if(RemoveSkipValidationTags)
+	if(StartState.RemoveSkipValidationTags)
 	{
 		for(auto& CurrentContainer : ContainerSettings)
 		{
@@ -177,457 +445,711 @@ void UAC_Inventory::StartComponent(bool RemoveSkipValidationTags)
 		InitializeTileMap(CurrentContainer);
 	}
 
-	TArray<UAC_LootTable*> LootTables = UFL_LootTableHelpers::GetLootTableComponents(GetOwner());
+	StartState.LootTables.Append(UFL_LootTableHelpers::GetLootTableComponents(GetOwner()));
+
+	//Every start consumes an operation seed, so the rolls can be reproduced.
+	StartState.ItemSeed = NextOperationSeed().GetInitialSeed();
+
+	if(StartState.TimeSliced)
+	{
+		/**Generating ID's loads every item asset synchronously.
+		 * Load them in the background first so that stage doesn't hitch.*/
+		TSet<FSoftObjectPath> AssetsToLoad;
+		for(auto& CurrentContainer : ContainerSettings)
+		{
+			for(auto& CurrentItem : CurrentContainer.Items)
+			{
+				if(!CurrentItem.ItemAssetSoftReference.IsNull() && !CurrentItem.ItemAssetSoftReference.IsValid())
+				{
+					AssetsToLoad.Add(CurrentItem.ItemAssetSoftReference.ToSoftObjectPath());
+				}
+			}
+		}
+
+		if(!AssetsToLoad.IsEmpty())
+		{
+			StartState.AssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad.Array(), FStreamableDelegate());
+		}
+	}
+}
 
+void UAC_Inventory::InitializeContainerIDs(int32 ContainerIndex)
+{
 	/**Before we start processing items, we generate ID's
 	 * and update any BelongsToItem directions so when
 	 * we start processing items, loot tables and so forth,
 	 * everything is prepped for them.*/
-	for(int32 ContainerIndex = 0; ContainerIndex < ContainerSettings.Num(); ContainerIndex++)
+	TRACE_CPUPROFILER_EVENT_SCOPE("Initialize ID's")
+	
+	if(ContainerSettings[ContainerIndex].UniqueID.IdentityNumber > 0)
+	{
+		ContainerSettings[ContainerIndex].UniqueID.ParentComponent = this;
+	}
+	else
+	{
+		ContainerSettings[ContainerIndex].UniqueID = GenerateUniqueID();
+	}
+
+	for(int32 ItemIndex = 0; ItemIndex < ContainerSettings[ContainerIndex].Items.Num(); ItemIndex++)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE("Initialize ID's")
+		FS_InventoryItem& CurrentItem = ContainerSettings[ContainerIndex].Items[ItemIndex];
+		//Item is invalid. Just continue and allow the next Items loop
+		//to handle the removal.
+		if(CurrentItem.ItemAssetSoftReference.IsNull())
+		{
+			continue;
+		}
+
+		CurrentItem.ItemAsset = CurrentItem.ItemAssetSoftReference.LoadSynchronous();
 		
-		if(ContainerSettings[ContainerIndex].UniqueID.IdentityNumber > 0)
+		if(CurrentItem.UniqueID.IdentityNumber > 0)
 		{
-			ContainerSettings[ContainerIndex].UniqueID.ParentComponent = this;
+			CurrentItem.UniqueID.ParentComponent = this;
 		}
 		else
 		{
-			ContainerSettings[ContainerIndex].UniqueID = GenerateUniqueID();
+			CurrentItem.UniqueID = GenerateUniqueID();
 		}
-
-		for(int32 ItemIndex = 0; ItemIndex < ContainerSettings[ContainerIndex].Items.Num(); ItemIndex++)
+		
+		/**Find out if the item can have containers. If so, process them*/
+		TArray<FS_ContainerSettings> ItemDefaultContainers = CurrentItem.ItemAsset->GetDefaultContainers();
+		if(UIF_ItemContainers::GetItemContainersFragmentFromItem(CurrentItem).Containers.IsValidIndex(0))
 		{
-			FS_InventoryItem& CurrentItem = ContainerSettings[ContainerIndex].Items[ItemIndex];
-			//Item is invalid. Just continue and allow the next Items loop
-			//to handle the removal.
-			if(CurrentItem.ItemAssetSoftReference.IsNull())
+			ItemDefaultContainers = UIF_ItemContainers::GetItemContainersFragmentFromItem(CurrentItem).Containers;
+		}
+		if(ItemDefaultContainers.IsValidIndex(0))
+		{
+			TArray<FS_ContainerSettings> ItemsContainers;
+			//Find the items containers.
+			for(auto& CurrentContainer2 : ContainerSettings)
 			{
-				continue;
+				if((CurrentContainer2.BelongsToItem.X == ContainerSettings[ContainerIndex].ContainerIndex && CurrentContainer2.BelongsToItem.Y == CurrentItem.ItemIndex) ||
+					(CurrentContainer2.BelongsToItem.X == ContainerSettings[ContainerIndex].UniqueID.IdentityNumber && CurrentContainer2.BelongsToItem.Y == CurrentItem.UniqueID.IdentityNumber))
+				{
+					ItemsContainers.Add(CurrentContainer2);
+					CurrentContainer2.BelongsToItem.X = ContainerSettings[ContainerIndex].UniqueID.IdentityNumber;
+					CurrentContainer2.BelongsToItem.Y = CurrentItem.UniqueID.IdentityNumber;
+				}
 			}
 
-			CurrentItem.ItemAsset = CurrentItem.ItemAssetSoftReference.LoadSynchronous();
-			
-			if(CurrentItem.UniqueID.IdentityNumber > 0)
-			{
-				CurrentItem.UniqueID.ParentComponent = this;
-			}
-			else
-			{
-				CurrentItem.UniqueID = GenerateUniqueID();
-			}
-			
-			/**Find out if the item can have containers. If so, process them*/
-			TArray<FS_ContainerSettings> ItemDefaultContainers = CurrentItem.ItemAsset->GetDefaultContainers();
-			if(UIF_ItemContainers::GetItemContainersFragmentFromItem(CurrentItem).Containers.IsValidIndex(0))
+			/**In some cases, a designer might have added only some containers
+			 * to the component, or a designer has added more containers to an
+			 * item in an update. Find out if we missed any and add those.*/
+			FDefaultItemsFragment* DefaultItemsFragment = FindFragment<FDefaultItemsFragment>(CurrentItem.ItemFragments);
+			for(auto& CurrentDefaultContainer : ItemDefaultContainers)
 			{
-				ItemDefaultContainers = UIF_ItemContainers::GetItemContainersFragmentFromItem(CurrentItem).Containers;
-			}
-			if(ItemDefaultContainers.IsValidIndex(0))
-			{
-				TArray<FS_ContainerSettings> ItemsContainers;
-				//Find the items containers.
-				for(auto& CurrentContainer2 : ContainerSettings)
+				bool AlreadyAdded = false;
+				for(auto& CurrentContainer3 : ItemsContainers)
 				{
-					if((CurrentContainer2.BelongsToItem.X == ContainerSettings[ContainerIndex].ContainerIndex && CurrentContainer2.BelongsToItem.Y == CurrentItem.ItemIndex) ||
-						(CurrentContainer2.BelongsToItem.X == ContainerSettings[ContainerIndex].UniqueID.IdentityNumber && CurrentContainer2.BelongsToItem.Y == CurrentItem.UniqueID.IdentityNumber))
+					if(CurrentContainer3.ContainerIdentifier == CurrentDefaultContainer.ContainerIdentifier)
 					{
-						ItemsContainers.Add(CurrentContainer2);
-						CurrentContainer2.BelongsToItem.X = ContainerSettings[ContainerIndex].UniqueID.IdentityNumber;
-						CurrentContainer2.BelongsToItem.Y = CurrentItem.UniqueID.IdentityNumber;
+						AlreadyAdded = true;
+						break;
 					}
 				}
-
-				/**In some cases, a designer might have added only some containers
-				 * to the component, or a designer has added more containers to an
-				 * item in an update. Find out if we missed any and add those.*/
-				FDefaultItemsFragment* DefaultItemsFragment = FindFragment<FDefaultItemsFragment>(CurrentItem.ItemFragments);
-				for(auto& CurrentDefaultContainer : ItemDefaultContainers)
+				if(AlreadyAdded)
 				{
-					bool AlreadyAdded = false;
-					for(auto& CurrentContainer3 : ItemsContainers)
-					{
-						if(CurrentContainer3.ContainerIdentifier == CurrentDefaultContainer.ContainerIdentifier)
-						{
-							AlreadyAdded = true;
-							break;
-						}
-					}
-					if(AlreadyAdded)
-					{
-						continue;
-					}
-						
-					InitializeTileMap(CurrentDefaultContainer);
-					CurrentDefaultContainer.BelongsToItem.X = ContainerSettings[ContainerIndex].UniqueID.IdentityNumber;
-					CurrentDefaultContainer.BelongsToItem.Y = CurrentItem.UniqueID.IdentityNumber;
-					CurrentDefaultContainer.ContainerIndex = ContainerSettings.Num();
-					if(DefaultItemsFragment)
-					{
-						if(FItemStructArrayWrapper* ItemsArray = DefaultItemsFragment->DefaultItems.Find(CurrentDefaultContainer.ContainerIdentifier))
-						{
-							CurrentDefaultContainer.Items.Append(ItemsArray->Items);
-						}
-					}
+					continue;
+				}
 					
-					ContainerSettings.Add(CurrentDefaultContainer);
-					for(auto& DefaultContainerItem : ContainerSettings.Last().Items)
+				InitializeTileMap(CurrentDefaultContainer);
+				CurrentDefaultContainer.BelongsToItem.X = ContainerSettings[ContainerIndex].UniqueID.IdentityNumber;
+				CurrentDefaultContainer.BelongsToItem.Y = CurrentItem.UniqueID.IdentityNumber;
+				CurrentDefaultContainer.ContainerIndex = ContainerSettings.Num();
+				if(DefaultItemsFragment)
+				{
+					if(FItemStructArrayWrapper* ItemsArray = DefaultItemsFragment->DefaultItems.Find(CurrentDefaultContainer.ContainerIdentifier))
 					{
-						GetFragmentManager()->InitializeItemsFragments(DefaultContainerItem, CurrentDefaultContainer);
+						CurrentDefaultContainer.Items.Append(ItemsArray->Items);
 					}
 				}
+				
+				ContainerSettings.Add(CurrentDefaultContainer);
+				for(auto& DefaultContainerItem : ContainerSettings.Last().Items)
+				{
+					GetFragmentManager()->InitializeItemsFragments(DefaultContainerItem, CurrentDefaultContainer);
+				}
 			}
+		}
 
-			if(FTagFragment* TagFragment = FindFragment<FTagFragment>(CurrentItem.ItemFragments, false))
+		if(FTagFragment* TagFragment = FindFragment<FTagFragment>(CurrentItem.ItemFragments, false))
+		{
+			if(TagFragment->Tags.HasTag(IFP_IncludeLootTables))
 			{
-				if(TagFragment->Tags.HasTag(IFP_IncludeLootTables))
+				for(auto& CurrentLootTable : CurrentItem.ItemAsset->GetLootTables())
 				{
-					for(auto& CurrentLootTable : CurrentItem.ItemAsset->GetLootTables())
-					{
-						TRACE_CPUPROFILER_EVENT_SCOPE("Spawn Loot table component")
-						/**Since the item assets loot tables are instanced objects, we can't use that
-						 * raw object, we have to create a new component using it as a template.*/
-						LootTables.Add(NewObject<UAC_LootTable>(GetOwner(), CurrentLootTable->GetClass(),
-							NAME_None, RF_NoFlags, CurrentLootTable));
-						LootTables.Last()->ItemID = CurrentItem.UniqueID;
-					}
-
-					TagFragment->Tags.RemoveTag(IFP_IncludeLootTables);
+					TRACE_CPUPROFILER_EVENT_SCOPE("Spawn Loot table component")
+					/**Since the item assets loot tables are instanced objects, we can't use that
+					 * raw object, we have to create a new component using it as a template.*/
+					StartState.LootTables.Add(NewObject<UAC_LootTable>(GetOwner(), CurrentLootTable->GetClass(),
+						NAME_None, RF_NoFlags, CurrentLootTable));
+					StartState.LootTables.Last()->ItemID = CurrentItem.UniqueID;
 				}
+
+				TagFragment->Tags.RemoveTag(IFP_IncludeLootTables);
 			}
 		}
 	}
-	
-	for(int32 CurrentTable = 0; CurrentTable < LootTables.Num(); CurrentTable++)
+}
+
+void UAC_Inventory::InitializeLootTable(int32 CurrentTable)
+{
+	//Loot tables added by an item during this stage haven't been rolled yet.
+	if(CurrentTable >= StartState.RolledLootTables && HasUnrolledLootPools(StartState.LootTables, CurrentTable))
 	{
-		LootTables[CurrentTable]->PreInventoryInitialized(this);
+		ULootGenerationSubsystem::GenerateLoot({this});
+	}
+	
+	StartState.LootTables[CurrentTable]->PreInventoryInitialized(this);
+
+	ProcessQueuedLootTableItems();
+}
 
-		for(int32 CurrentIndex = 0; CurrentIndex < QueuedLootTableItems.Num(); CurrentIndex++)
+void UAC_Inventory::ProcessQueuedLootTableItems()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::ProcessQueuedLootTableItems)
+	
+	for(int32 CurrentIndex = 0; CurrentIndex < QueuedLootTableItems.Num(); CurrentIndex++)
+	{
+		FS_InventoryItem& Item = ContainerSettings[QueuedLootTableItems[CurrentIndex].ContainerIndex].Items[QueuedLootTableItems[CurrentIndex].ItemIndex];
+		
+		Item.UniqueID = GenerateUniqueID();
+		
+		/**Find out if the item can have containers. If so, process them*/
+		TArray<FS_ContainerSettings> ItemDefaultContainers = Item.ItemAsset->GetDefaultContainers();
+		if(ItemDefaultContainers.IsValidIndex(0))
 		{
-			FS_InventoryItem& Item = ContainerSettings[QueuedLootTableItems[CurrentIndex].ContainerIndex].Items[QueuedLootTableItems[CurrentIndex].ItemIndex];
-			
-			Item.UniqueID = GenerateUniqueID();
-			
-			/**Find out if the item can have containers. If so, process them*/
-			TArray<FS_ContainerSettings> ItemDefaultContainers = Item.ItemAsset->GetDefaultContainers();
-			if(ItemDefaultContainers.IsValidIndex(0))
+			/**In some cases, a designer might have added only some containers
+			 * to the component, or a designer has added more containers to an
+			 * item in an update. Find out if we missed any and add those.*/
+			for(auto& CurrentDefaultContainer : ItemDefaultContainers)
 			{
-				/**In some cases, a designer might have added only some containers
-				 * to the component, or a designer has added more containers to an
-				 * item in an update. Find out if we missed any and add those.*/
-				for(auto& CurrentDefaultContainer : ItemDefaultContainers)
-				{
-					InitializeTileMap(CurrentDefaultContainer);
-					CurrentDefaultContainer.BelongsToItem.X = ContainerSettings[Item.ContainerIndex].UniqueID.IdentityNumber;
-					CurrentDefaultContainer.BelongsToItem.Y = Item.UniqueID.IdentityNumber;
-					CurrentDefaultContainer.ContainerIndex = ContainerSettings.Num();
-					CurrentDefaultContainer.UniqueID = GenerateUniqueID();
-					ContainerSettings.Add(CurrentDefaultContainer);
-				}
+				InitializeTileMap(CurrentDefaultContainer);
+				CurrentDefaultContainer.BelongsToItem.X = ContainerSettings[Item.ContainerIndex].UniqueID.IdentityNumber;
+				CurrentDefaultContainer.BelongsToItem.Y = Item.UniqueID.IdentityNumber;
+				CurrentDefaultContainer.ContainerIndex = ContainerSettings.Num();
+				CurrentDefaultContainer.UniqueID = GenerateUniqueID();
+				ContainerSettings.Add(CurrentDefaultContainer);
 			}
+		}
 
-			if(FTagFragment* TagFragment = FindFragment<FTagFragment>(Item.ItemFragments, false))
+		if(FTagFragment* TagFragment = FindFragment<FTagFragment>(Item.ItemFragments, false))
+		{
+			if(TagFragment->Tags.HasTag(IFP_IncludeLootTables))
 			{
-				if(TagFragment->Tags.HasTag(IFP_IncludeLootTables))
+				for(auto& CurrentLootTable : Item.ItemAsset->GetLootTables())
 				{
-					for(auto& CurrentLootTable : Item.ItemAsset->GetLootTables())
-					{
-						TRACE_CPUPROFILER_EVENT_SCOPE("Spawn Loot table component")
-						/**Since the item assets loot tables are instanced objects, we can't use that
-						 * raw object, we have to create a new component using it as a template.*/
-						LootTables.Add(NewObject<UAC_LootTable>(GetOwner(), CurrentLootTable->GetClass(),
-							NAME_None, RF_NoFlags, CurrentLootTable));
-						LootTables.Last()->ItemID = Item.UniqueID;
-
-						TagFragment->Tags.RemoveTag(IFP_IncludeLootTables);
-					}
+					TRACE_CPUPROFILER_EVENT_SCOPE("Spawn Loot table component")
+					/**Since the item assets loot tables are instanced objects, we can't use that
+					 * raw object, we have to create a new component using it as a template.*/
+					StartState.LootTables.Add(NewObject<UAC_LootTable>(GetOwner(), CurrentLootTable->GetClass(),
+						NAME_None, RF_NoFlags, CurrentLootTable));
+					StartState.LootTables.Last()->ItemID = Item.UniqueID;
+
+					TagFragment->Tags.RemoveTag(IFP_IncludeLootTables);
 				}
 			}
 		}
-		
-		QueuedLootTableItems.Empty();
 	}
+	
+	QueuedLootTableItems.Empty();
+}
 
-	//Start initializing all items inside every container.
-	for(int32 ContainerIndex = 0; ContainerIndex < ContainerSettings.Num(); ContainerIndex++)
+void UAC_Inventory::GatherLootRolls(TArray<FLootRollJob>& OutJobs)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::GatherLootRolls)
+
+	for(int32 TableIndex = StartState.RolledLootTables; TableIndex < StartState.LootTables.Num(); TableIndex++)
 	{
-		/**V: I don't know why, I couldn't figure out why, but if I create a ref
-		 * to the container we are working with like this:
-		 * FS_ContainerSettings& Container = ContainerSettings[ContainerIndex];
-		 * The container index would very randomly be a random integer
-		 * and you could not remove items from the items array and when this happend,
-		 * it would ALWAYS fail on the fourth item. Not the third, not the fifth,
-		 * ALWAYS the fourth item in the array.
-		 * It was eating up enough time to resolve that I decided to just ignore it
-		 * and make this code a little bit uglier than it needs to be.*/
-		
-		/**In case a loot table added a container*/
-		if(!ContainerSettings[ContainerIndex].UniqueID.IsValid())
+		UAC_LootTable* LootTable = StartState.LootTables[TableIndex];
+		if(!IsValid(LootTable))
 		{
-			ContainerSettings[ContainerIndex].UniqueID = GenerateUniqueID();
+			continue;
 		}
 
-		TArray<FS_InventoryItem> ItemsToRemove;
-
-		for(int32 ItemIndex = 0; ItemIndex < ContainerSettings[ContainerIndex].Items.Num(); ItemIndex++)
+		for(int32 PoolIndex = 0; PoolIndex < LootTable->LootPools.Num(); PoolIndex++)
 		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(Initialize item)
-			FS_InventoryItem& CurrentItem = ContainerSettings[ContainerIndex].Items[ItemIndex];
-			
-			if(!IsValid(CurrentItem.ItemAsset))
+			UO_LootPool* Pool = LootTable->LootPools[PoolIndex];
+			if(!CanBatchRollLootPool(Pool))
 			{
-				//Invalid data asset
-				ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but found no item asset"),
-					ContainerIndex, ItemIndex));
-				ItemsToRemove.Add(CurrentItem);
 				continue;
 			}
 
-			/**In case a loot table added a item*/
-			if(!CurrentItem.UniqueID.IsValid())
+			//Loot tables created by an item only add to that items containers.
+			int32 TargetContainerIndex = INDEX_NONE;
+			for(int32 ContainerIndex = 0; ContainerIndex < ContainerSettings.Num(); ContainerIndex++)
 			{
-				CurrentItem.UniqueID = GenerateUniqueID();
+				const FS_ContainerSettings& CurrentContainer = ContainerSettings[ContainerIndex];
+				if(CurrentContainer.ContainerIdentifier.MatchesTagExact(Pool->TargetContainer) &&
+					(!LootTable->ItemID.IsValid() || CurrentContainer.BelongsToItem.Y == LootTable->ItemID.IdentityNumber))
+				{
+					TargetContainerIndex = ContainerIndex;
+					break;
+				}
 			}
 
-			if(FTagFragment* TagFragment = FindFragment<FTagFragment>(CurrentItem.ItemFragments, false))
+			if(TargetContainerIndex == INDEX_NONE)
 			{
-				if(TagFragment->Tags.HasTagExact(IFP_SkipValidation))
-				{
-					/**Item wishes to skip validation. If anything goes wrong
-					 * after this, a designer or a bug has incorrectly applied
-					 * this tag.*/
-					TagFragment->Tags.RemoveTag(IFP_SkipValidation);
-					if(ContainerSettings[ContainerIndex].ContainerType == Equipment)
-					{
-						EquippedItems.Add(CurrentItem);
-					}
+				UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Could not find container %s for loot pool %s - UAC_Inventory::GatherLootRolls"),
+					*Pool->TargetContainer.ToString(), *Pool->GetName()));
+				continue;
+			}
 
-					/* Container might not have the skip validation, so this item needs
-					 * to register its collision.*/
-					if(!UFL_InventoryFramework::GetContainersTags(ContainerSettings[ContainerIndex]).HasTagExact(IFP_SkipValidation) && ContainerSettings[ContainerIndex].SupportsTileMap())
-					{
-						AddItemToTileMap(CurrentItem);
-					}
-				
-					continue;
-				}
+			//Workers only read the weights, they have to be built here.
+			if(!Pool->AreWeightsBuilt())
+			{
+				Pool->BuildWeights();
+			}
+
+			FLootRollJob& Job = OutJobs.AddDefaulted_GetRef();
+			Job.Pool = Pool;
+			Job.ContainerIndex = TargetContainerIndex;
+			//Only depends on the start seed and where the pool is, not on anything else being rolled.
+			Job.Seed = GetOperationSeed(StartState.ItemSeed, static_cast<int32>(HashCombineFast(GetTypeHash(TableIndex), GetTypeHash(PoolIndex)))).GetInitialSeed();
+		}
+	}
+
+	StartState.RolledLootTables = StartState.LootTables.Num();
+}
+
+void UAC_Inventory::ApplyLootRolls(TArrayView<FLootRollJob> Jobs)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::ApplyLootRolls)
+
+	StartState.LootQueued = false;
+
+	/**Items that can't stack are added once for every count,
+	 * items that can are split into as many full stacks as needed.*/
+	auto GetStackSize = [](const FRolledLootItem& RolledItem)
+	{
+		return RolledItem.Item->CanItemStack() ? FMath::Max(RolledItem.Item->MaxStack, 1) : 1;
+	};
+	auto GetItemsToAdd = [&GetStackSize](const FRolledLootItem& RolledItem)
+	{
+		return FMath::DivideAndRoundUp(FMath::Max(RolledItem.Count, 1), GetStackSize(RolledItem));
+	};
+
+	//Reserve every container once, instead of growing it for every item.
+	TMap<int32, int32> ItemsPerContainer;
+	int32 TotalItems = 0;
+	for(const FLootRollJob& CurrentJob : Jobs)
+	{
+		for(const FRolledLootItem& CurrentItem : CurrentJob.RolledItems)
+		{
+			if(IsValid(CurrentItem.Item))
+			{
+				ItemsPerContainer.FindOrAdd(CurrentJob.ContainerIndex) += GetItemsToAdd(CurrentItem);
+				TotalItems += GetItemsToAdd(CurrentItem);
 			}
+		}
+	}
+
+	if(TotalItems == 0)
+	{
+		return;
+	}
 
-			//Generate data beforehand, so if the item failed to spawn, the delegate broadcast will get the info it needs.
-			CurrentItem.ContainerIndex = ContainerSettings[ContainerIndex].ContainerIndex;
-			CurrentItem.ItemIndex = ItemIndex;
+	for(auto& CurrentContainer : ItemsPerContainer)
+	{
+		TArray<FS_InventoryItem>& ContainerItems = ContainerSettings[CurrentContainer.Key].Items;
+		ContainerItems.Reserve(ContainerItems.Num() + CurrentContainer.Value);
+	}
+	QueuedLootTableItems.Reserve(QueuedLootTableItems.Num() + TotalItems);
 
-			//Determine spawn chance
-			if(!UKismetMathLibrary::RandomBoolWithWeight(UFL_InventoryFramework::GetItemsSpawnChance(CurrentItem)))
+	for(FLootRollJob& CurrentJob : Jobs)
+	{
+		FS_ContainerSettings& Container = ContainerSettings[CurrentJob.ContainerIndex];
+		for(const FRolledLootItem& CurrentItem : CurrentJob.RolledItems)
+		{
+			if(!IsValid(CurrentItem.Item))
 			{
-				ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but it failed its spawn change"),
-					ContainerIndex, ItemIndex));
-				//Find the items containers. Since the items containers don't have the Unique ID's assigned yet, we have to manually find them.
-				for(auto& CurrentContainer : ContainerSettings)
-				{
-					if(CurrentContainer.BelongsToItem.X == ContainerIndex && CurrentContainer.BelongsToItem.Y == CurrentItem.ItemIndex)
-					{
-						ContainersToRemove.Add(CurrentContainer);
-					}
-				}
-				ItemsToRemove.Add(CurrentItem);
 				continue;
 			}
-			else
+
+			const int32 ItemsToAdd = GetItemsToAdd(CurrentItem);
+			const int32 StackSize = GetStackSize(CurrentItem);
+			int32 RemainingCount = FMath::Max(CurrentItem.Count, 1);
+			for(int32 CurrentCopy = 0; CurrentCopy < ItemsToAdd; CurrentCopy++)
 			{
-				//Item succeeded spawn chance. Check if a game session is valid
-				//and remove the SpawnChance value. This is so we don't re-roll the chance
-				//when we pick up the item or restart the component.
-				if(IsValid(UGameplayStatics::GetGameInstance(this)))
+				FS_InventoryItem NewItem;
+				NewItem.ItemAssetSoftReference = CurrentItem.Item;
+				NewItem.ItemAsset = CurrentItem.Item;
+				NewItem.Count = FMath::Min(RemainingCount, StackSize);
+				RemainingCount -= NewItem.Count;
+				if(GetFragmentManager())
+				{
+					GetFragmentManager()->InitializeItemsFragments(NewItem, Container);
+				}
+				if(FTagFragment* TagFragment = FindFragment<FTagFragment>(NewItem.ItemFragments, true))
 				{
-					Internal_RemoveTagValueFromItem(CurrentItem, IFP_SpawnChanceValue);
+					TagFragment->Tags.AddTag(IFP_IncludeLootTables);
 				}
+
+				NewItem.ContainerIndex = CurrentJob.ContainerIndex;
+				NewItem.ItemIndex = Container.Items.Num();
+				QueuedLootTableItems.Add(Container.Items.Add_GetRef(MoveTemp(NewItem)));
+			}
+
+			CurrentJob.Pool->ItemsSpawned += ItemsToAdd;
+		}
+	}
+
+	//ID's are generated here, the ID map is only rebuilt once by FinalizeStartComponent.
+	ProcessQueuedLootTableItems();
+}
+
+static FItemStartEvaluation EvaluateItemForStart(FS_InventoryItem& Item, EInventoryType InventoryType, int32 ItemSeed)
+{
+	FItemStartEvaluation Evaluation;
+	const FRandomStream Seed = UAC_Inventory::GetOperationSeed(ItemSeed, Item.UniqueID.IdentityNumber);
+
+	Evaluation.PassedSpawnChance = UKismetMathLibrary::RandomBoolWithWeightFromStream(Seed, UFL_InventoryFramework::GetItemsSpawnChance(Item));
+	if(!Evaluation.PassedSpawnChance)
+	{
+		return Evaluation;
+	}
+
+	if(InventoryType == Vendor && !Item.ItemAsset->GetClass()->IsChildOf(UIDA_Currency::StaticClass()))
+	{
+		Evaluation.HasAcceptedCurrencies = UFL_InventoryFramework::GetAcceptedCurrencies(Item).IsValidIndex(0);
+		if(!Evaluation.HasAcceptedCurrencies)
+		{
+			return Evaluation;
+		}
+	}
+
+	if(Item.ItemAsset->CanItemStack() && Item.Count <= 0)
+	{
+		bool FragmentsFromStruct = false;
+		if(FRandomItemCountFragment* RandomCountFragment = FindFragmentFromItem<FRandomItemCountFragment>(Item, FragmentsFromStruct))
+		{
+			Evaluation.Count = UKismetMathLibrary::RandomIntegerInRangeFromStream(Seed, RandomCountFragment->MinMaxCount.X, RandomCountFragment->MinMaxCount.Y);
+			Evaluation.RemoveRandomCountFragment = FragmentsFromStruct;
+		}
+		else
+		{
+			Evaluation.Count = Item.ItemAsset->DefaultStack;
+		}
+	}
+	else if(!Item.ItemAsset->CanItemStack())
+	{
+		Evaluation.Count = 1;
+	}
+
+	return Evaluation;
+}
+
+void UAC_Inventory::EvaluateItems()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::EvaluateItems)
+
+	//Gather every item that is going to be validated.
+	TArray<FS_InventoryItem*> ItemsToEvaluate;
+	for(auto& CurrentContainer : ContainerSettings)
+	{
+		for(auto& CurrentItem : CurrentContainer.Items)
+		{
+			if(!IsValid(CurrentItem.ItemAsset) || !CurrentItem.UniqueID.IsValid())
+			{
+				continue;
 			}
 
-			//If we are a vendor, ensure the item has acceptable currencies. Also ensure that the item is not a currency 
-			if(InventoryType == Vendor && !CurrentItem.ItemAsset->GetClass()->IsChildOf(UIDA_Currency::StaticClass()))
+			if(FTagFragment* TagFragment = FindFragment<FTagFragment>(CurrentItem.ItemFragments, false))
 			{
-				TArray<UIDA_Currency*> AcceptedCurrencies = UFL_InventoryFramework::GetAcceptedCurrencies(CurrentItem);
-				if(!AcceptedCurrencies.IsValidIndex(0))
+				if(TagFragment->Tags.HasTagExact(IFP_SkipValidation))
 				{
-					//Find the items containers. Since the items containers don't have the Unique ID's assigned yet, we have to manually find them.
-					for(auto& CurrentContainer : ContainerSettings)
-					{
-						if(CurrentContainer.BelongsToItem.X == ContainerIndex && CurrentContainer.BelongsToItem.Y == CurrentItem.ItemIndex)
-						{
-							ContainersToRemove.Add(CurrentContainer);
-						}
-						
-					}
-					
-					ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but item had no acceptable currencies to exchange for"),
-						ContainerIndex, ItemIndex));
-					ItemsToRemove.Add(CurrentItem);
 					continue;
 				}
 			}
 
-			/**Handle item count. If the count is 0 or less, that means this item has never
-			 * been initialized before. So it's safe to say we want to evaluate the stack count.
-			 * But if it has been initialized before, we don't want to run this, because it would
-			 * mean that the count would be randomized every single time a save is loaded or
-			 * the item is dropped.*/
-			if(CurrentItem.ItemAsset->CanItemStack() && CurrentItem.Count <= 0)
+			ItemsToEvaluate.Add(&CurrentItem);
+		}
+	}
+
+	TArray<FItemStartEvaluation> Evaluations;
+	Evaluations.SetNum(ItemsToEvaluate.Num());
+	const EInventoryType Type = InventoryType;
+	const int32 ItemSeed = StartState.ItemSeed;
+	ParallelFor(ItemsToEvaluate.Num(), [&](int32 Index)
+	{
+		Evaluations[Index] = EvaluateItemForStart(*ItemsToEvaluate[Index], Type, ItemSeed);
+	}, ItemsToEvaluate.Num() < 64 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	StartState.ItemEvaluations.Reserve(ItemsToEvaluate.Num());
+	for(int32 Index = 0; Index < ItemsToEvaluate.Num(); Index++)
+	{
+		StartState.ItemEvaluations.Add(ItemsToEvaluate[Index]->UniqueID.IdentityNumber, Evaluations[Index]);
+	}
+}
+
+void UAC_Inventory::InitializeContainerItems(int32 ContainerIndex)
+{
+	/**V: I don't know why, I couldn't figure out why, but if I create a ref
+	 * to the container we are working with like this:
+	 * FS_ContainerSettings& Container = ContainerSettings[ContainerIndex];
+	 * The container index would very randomly be a random integer
+	 * and you could not remove items from the items array and when this happend,
+	 * it would ALWAYS fail on the fourth item. Not the third, not the fifth,
+	 * ALWAYS the fourth item in the array.
+	 * It was eating up enough time to resolve that I decided to just ignore it
+	 * and make this code a little bit uglier than it needs to be.*/
+	
+	/**In case a loot table added a container*/
+	if(!ContainerSettings[ContainerIndex].UniqueID.IsValid())
+	{
+		ContainerSettings[ContainerIndex].UniqueID = GenerateUniqueID();
+	}
+
+	TArray<FS_InventoryItem> ItemsToRemove;
+
+	for(int32 ItemIndex = 0; ItemIndex < ContainerSettings[ContainerIndex].Items.Num(); ItemIndex++)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(Initialize item)
+		FS_InventoryItem& CurrentItem = ContainerSettings[ContainerIndex].Items[ItemIndex];
+		
+		if(!IsValid(CurrentItem.ItemAsset))
+		{
+			//Invalid data asset
+			ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but found no item asset"),
+				ContainerIndex, ItemIndex));
+			ItemsToRemove.Add(CurrentItem);
+			continue;
+		}
+
+		/**In case a loot table added a item*/
+		if(!CurrentItem.UniqueID.IsValid())
+		{
+			CurrentItem.UniqueID = GenerateUniqueID();
+		}
+
+		if(FTagFragment* TagFragment = FindFragment<FTagFragment>(CurrentItem.ItemFragments, false))
+		{
+			if(TagFragment->Tags.HasTagExact(IFP_SkipValidation))
 			{
-				bool FragmentsFromStruct = false;
-				if(FRandomItemCountFragment* RandomCountFragment = FindFragmentFromItem<FRandomItemCountFragment>(CurrentItem, FragmentsFromStruct))
+				/**Item wishes to skip validation. If anything goes wrong
+				 * after this, a designer or a bug has incorrectly applied
+				 * this tag.*/
+				TagFragment->Tags.RemoveTag(IFP_SkipValidation);
+				if(ContainerSettings[ContainerIndex].ContainerType == Equipment)
 				{
-					CurrentItem.Count = UKismetMathLibrary::RandomIntegerInRange(RandomCountFragment->MinMaxCount.X, RandomCountFragment->MinMaxCount.Y);
-					//Only remove the fragment if it's part of the item struct.
-					if(FragmentsFromStruct)
-					{
-						RemoveFragmentFromArray(CurrentItem.ItemFragments, RandomCountFragment);
-					}
+					StartState.EquippedItems.Add(CurrentItem);
 				}
-				else
+
+				/* Container might not have the skip validation, so this item needs
+				 * to register its collision.*/
+				if(!UFL_InventoryFramework::GetContainersTags(ContainerSettings[ContainerIndex]).HasTagExact(IFP_SkipValidation) && ContainerSettings[ContainerIndex].SupportsTileMap())
 				{
-					CurrentItem.Count = CurrentItem.ItemAsset->DefaultStack;
+					AddItemToTileMap(CurrentItem);
 				}
+			
+				continue;
 			}
-			else if (!CurrentItem.ItemAsset->CanItemStack())
-			{
-				//Item can't stack, set its count to 1
-				CurrentItem.Count = 1;
-			}
+		}
+
+		//Generate data beforehand, so if the item failed to spawn, the delegate broadcast will get the info it needs.
+		CurrentItem.ContainerIndex = ContainerSettings[ContainerIndex].ContainerIndex;
+		CurrentItem.ItemIndex = ItemIndex;
+
+		//Items added after EvaluateItems ran, for example by a loot table, are evaluated here.
+		const FItemStartEvaluation* FoundEvaluation = StartState.ItemEvaluations.Find(CurrentItem.UniqueID.IdentityNumber);
+		const FItemStartEvaluation Evaluation = FoundEvaluation ? *FoundEvaluation : EvaluateItemForStart(CurrentItem, InventoryType, StartState.ItemSeed);
 
-			//Random count went to 0 or less, remove the item.
-			if(CurrentItem.Count <= 0)
+		//Determine spawn chance
+		if(!Evaluation.PassedSpawnChance)
+		{
+			ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but it failed its spawn change"),
+				ContainerIndex, ItemIndex));
+			//Find the items containers. Since the items containers don't have the Unique ID's assigned yet, we have to manually find them.
+			for(auto& CurrentContainer : ContainerSettings)
 			{
-				ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but item count was less than 1"),
-					ContainerIndex, ItemIndex));
-				ItemsToRemove.Add(CurrentItem);
-				continue;
+				if(CurrentContainer.BelongsToItem.X == ContainerIndex && CurrentContainer.BelongsToItem.Y == CurrentItem.ItemIndex)
+				{
+					StartState.ContainersToRemove.Add(CurrentContainer);
+				}
 			}
-
-			if(!CheckCompatibility(CurrentItem, ContainerSettings[ContainerIndex]))
+			ItemsToRemove.Add(CurrentItem);
+			continue;
+		}
+		else
+		{
+			//Item succeeded spawn chance. Check if a game session is valid
+			//and remove the SpawnChance value. This is so we don't re-roll the chance
+			//when we pick up the item or restart the component.
+			if(IsValid(UGameplayStatics::GetGameInstance(this)))
 			{
-				ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but item was incompatible with its container"),
-					ContainerIndex, ItemIndex));
-				ItemsToRemove.Add(CurrentItem);
-				continue;
+				Internal_RemoveTagValueFromItem(CurrentItem, IFP_SpawnChanceValue);
 			}
+		}
 
-			//Equipment and ThisActor types are much simpler, lots of logic can be skipped
-			if(ContainerSettings[ContainerIndex].ContainerType == Equipment || ContainerSettings[ContainerIndex].ContainerType == ThisActor)
+		//If we are a vendor, ensure the item has acceptable currencies. Also ensure that the item is not a currency 
+		if(!Evaluation.HasAcceptedCurrencies)
+		{
+			//Find the items containers. Since the items containers don't have the Unique ID's assigned yet, we have to manually find them.
+			for(auto& CurrentContainer : ContainerSettings)
 			{
-				//Container is an equipment container, so we skip all tile checks and forcefully add this item.
-				if(ContainerSettings[ContainerIndex].TileMap[0] == -1)
+				if(CurrentContainer.BelongsToItem.X == ContainerIndex && CurrentContainer.BelongsToItem.Y == CurrentItem.ItemIndex)
 				{
-					ContainerSettings[ContainerIndex].TileMap[0] = CurrentItem.UniqueID.IdentityNumber;
-					CurrentItem.ItemIndex = 0;
-					CurrentItem.TileIndex = 0;
-										
-					if(ContainerSettings[ContainerIndex].ContainerType == Equipment)
-					{
-						EquippedItems.Add(CurrentItem);
-					}
+					StartState.ContainersToRemove.Add(CurrentContainer);
 				}
 				
-				//Since only one item can be in this equipment or CurrentItem container, immediately break out of the loop.
-				break;
 			}
 			
-			if(!ContainerSettings[ContainerIndex].SupportsTileMap())
+			ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but item had no acceptable currencies to exchange for"),
+				ContainerIndex, ItemIndex));
+			ItemsToRemove.Add(CurrentItem);
+			continue;
+		}
+
+		/**Handle item count. If the count is 0 or less, that means this item has never
+		 * been initialized before. So it's safe to say we want to evaluate the stack count.
+		 * But if it has been initialized before, we don't want to run this, because it would
+		 * mean that the count would be randomized every single time a save is loaded or
+		 * the item is dropped.*/
+		if(Evaluation.Count != -1)
+		{
+			CurrentItem.Count = Evaluation.Count;
+			//Only remove the fragment if it's part of the item struct.
+			if(Evaluation.RemoveRandomCountFragment)
 			{
-				//Container does not support positioning, skip all positioning logic.
-				continue;
+				RemoveFragmentFromArray(CurrentItem.ItemFragments, FindFragment<FRandomItemCountFragment>(CurrentItem.ItemFragments, false));
 			}
-			
-			/**Item is in a container that can have multiple items, start finding a spot*/
-			//Start finding a spot
-			int32 StartAtIndex = CurrentItem.TileIndex == -1 ? 0 : CurrentItem.TileIndex;
-			bool SpotFound = false;
-			TArray<int32> TilesToIgnore = GetGenericIndexesToIgnore(ContainerSettings[ContainerIndex]);
-			
-			//find out if we check a specific tile.
-			if(UKismetMathLibrary::SelectInt(-1, CurrentItem.TileIndex, CurrentItem.TileIndex == -1) > 0)
+		}
+
+		//Random count went to 0 or less, remove the item.
+		if(CurrentItem.Count <= 0)
+		{
+			ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but item count was less than 1"),
+				ContainerIndex, ItemIndex));
+			ItemsToRemove.Add(CurrentItem);
+			continue;
+		}
+
+		if(!CheckCompatibility(CurrentItem, ContainerSettings[ContainerIndex]))
+		{
+			ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but item was incompatible with its container"),
+				ContainerIndex, ItemIndex));
+			ItemsToRemove.Add(CurrentItem);
+			continue;
+		}
+
+		//Equipment and ThisActor types are much simpler, lots of logic can be skipped
+		if(ContainerSettings[ContainerIndex].ContainerType == Equipment || ContainerSettings[ContainerIndex].ContainerType == ThisActor)
+		{
+			//Container is an equipment container, so we skip all tile checks and forcefully add this item.
+			if(ContainerSettings[ContainerIndex].TileMap[0] == -1)
 			{
-				TArray<FS_InventoryItem> ItemsInTheWay;
-				TArray<FS_InventoryItem> ItemsToIgnore;
-				CheckAllRotationsForSpace(CurrentItem, ContainerSettings[ContainerIndex], StartAtIndex, ItemsToIgnore, TilesToIgnore, SpotFound, CurrentItem.Rotation, CurrentItem.TileIndex, ItemsInTheWay);
+				ContainerSettings[ContainerIndex].TileMap[0] = CurrentItem.UniqueID.IdentityNumber;
+				CurrentItem.ItemIndex = 0;
+				CurrentItem.TileIndex = 0;
+									
+				if(ContainerSettings[ContainerIndex].ContainerType == Equipment)
+				{
+					StartState.EquippedItems.Add(CurrentItem);
+				}
 			}
-			else
+			
+			//Since only one item can be in this equipment or CurrentItem container, immediately break out of the loop.
+			break;
+		}
+		
+		if(!ContainerSettings[ContainerIndex].SupportsTileMap())
+		{
+			//Container does not support positioning, skip all positioning logic.
+			continue;
+		}
+		
+		/**Item is in a container that can have multiple items, start finding a spot*/
+		//Start finding a spot
+		int32 StartAtIndex = CurrentItem.TileIndex == -1 ? 0 : CurrentItem.TileIndex;
+		bool SpotFound = false;
+		TArray<int32> TilesToIgnore = GetGenericIndexesToIgnore(ContainerSettings[ContainerIndex]);
+		
+		//find out if we check a specific tile.
+		if(UKismetMathLibrary::SelectInt(-1, CurrentItem.TileIndex, CurrentItem.TileIndex == -1) > 0)
+		{
+			TArray<FS_InventoryItem> ItemsInTheWay;
+			TArray<FS_InventoryItem> ItemsToIgnore;
+			CheckAllRotationsForSpace(CurrentItem, ContainerSettings[ContainerIndex], StartAtIndex, ItemsToIgnore, TilesToIgnore, SpotFound, CurrentItem.Rotation, CurrentItem.TileIndex, ItemsInTheWay);
+		}
+		else
+		{
+			//Determine if we find a random tile or first available tile. -2 is random, -1 is first available.
+			if(CurrentItem.TileIndex == -2)
 			{
-				//Determine if we find a random tile or first available tile. -2 is random, -1 is first available.
-				if(CurrentItem.TileIndex == -2)
+				TArray<FS_InventoryItem> ItemsInTheWay;
+				//Attempt to find a free random spot, but limit it to 10 attempts.
+				FIntPoint ContainerSize;
+				UFL_InventoryFramework::GetContainerDimensions(ContainerSettings[ContainerIndex], ContainerSize.X, ContainerSize.Y);
+				int32 ContainerLength = (ContainerSize.X * ContainerSize.Y) - 1;
+				for(int32 LoopAttempt = 0; LoopAttempt < 10; LoopAttempt++)
 				{
-					TArray<FS_InventoryItem> ItemsInTheWay;
-					//Attempt to find a free random spot, but limit it to 10 attempts.
-					FIntPoint ContainerSize;
-					UFL_InventoryFramework::GetContainerDimensions(ContainerSettings[ContainerIndex], ContainerSize.X, ContainerSize.Y);
-					int32 ContainerLength = (ContainerSize.X * ContainerSize.Y) - 1;
-					for(int32 LoopAttempt = 0; LoopAttempt < 10; LoopAttempt++)
+					UKismetMathLibrary::RandomIntegerInRange(0, ContainerLength);
+					TArray<FS_InventoryItem> ItemsToIgnore;
+					CheckAllRotationsForSpace(CurrentItem, ContainerSettings[ContainerIndex], UKismetMathLibrary::RandomIntegerInRange(0, ContainerLength),
+						ItemsToIgnore, TilesToIgnore, SpotFound, CurrentItem.Rotation, CurrentItem.TileIndex, ItemsInTheWay);
+					if(SpotFound)
 					{
-						UKismetMathLibrary::RandomIntegerInRange(0, ContainerLength);
-						TArray<FS_InventoryItem> ItemsToIgnore;
-						CheckAllRotationsForSpace(CurrentItem, ContainerSettings[ContainerIndex], UKismetMathLibrary::RandomIntegerInRange(0, ContainerLength),
-							ItemsToIgnore, TilesToIgnore, SpotFound, CurrentItem.Rotation, CurrentItem.TileIndex, ItemsInTheWay);
-						if(SpotFound)
-						{
-							break;
-						}
+						break;
 					}
 				}
-				else
-				{
-					GetFirstAvailableTile(CurrentItem, ContainerSettings[ContainerIndex], TilesToIgnore, SpotFound, CurrentItem.TileIndex, CurrentItem.Rotation);
-				}
-			}
-
-			if(SpotFound)
-			{
-				//A free spot was found. Add it to the tile map.
-				AddItemToTileMap(CurrentItem);
 			}
-			//No free spot was found.
 			else
 			{
-				//Find the items containers. Since the items containers don't have the Unique ID's assigned yet, we have to manually find them.
-				for(auto& CurrentContainer : ContainerSettings)
-				{
-					if((CurrentContainer.BelongsToItem.X == ContainerIndex && CurrentContainer.BelongsToItem.Y == CurrentItem.ItemIndex))
-					{
-						ContainersToRemove.Add(CurrentContainer);
-					}
-				}
-				
-				ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but no free spot was found"),
-					ContainerIndex, ItemIndex));
-				ItemsToRemove.Add(CurrentItem);
+				GetFirstAvailableTile(CurrentItem, ContainerSettings[ContainerIndex], TilesToIgnore, SpotFound, CurrentItem.TileIndex, CurrentItem.Rotation);
 			}
 		}
 
-		FTagFragment* TagFragment = FindFragment<FTagFragment>(ContainerSettings[ContainerIndex].ContainerFragments);
-		if(TagFragment)
+		if(SpotFound)
 		{
-			TagFragment->Tags.RemoveTag(IFP_SkipValidation);
+			//A free spot was found. Add it to the tile map.
+			AddItemToTileMap(CurrentItem);
 		}
-
-		for(auto& CurrentRemovingItem : ItemsToRemove)
+		//No free spot was found.
+		else
 		{
-			TArray<FS_ContainerSettings> ItemsContainers;
-			GetAllContainersAssociatedWithItem(CurrentRemovingItem, ItemsContainers);
-			for(auto& CurrentContainer : ItemsContainers)
+			//Find the items containers. Since the items containers don't have the Unique ID's assigned yet, we have to manually find them.
+			for(auto& CurrentContainer : ContainerSettings)
 			{
-				ContainerSettings.RemoveSingle(CurrentContainer);
+				if((CurrentContainer.BelongsToItem.X == ContainerIndex && CurrentContainer.BelongsToItem.Y == CurrentItem.ItemIndex))
+				{
+					StartState.ContainersToRemove.Add(CurrentContainer);
+				}
 			}
 			
-			ContainerSettings[ContainerIndex].Items.RemoveSingle(CurrentRemovingItem);
+			ItemFailedSpawn.Broadcast(CurrentItem, FString::Printf(TEXT("Tried to initialize item (Container index: %d - Item Index: %d) but no free spot was found"),
+				ContainerIndex, ItemIndex));
+			ItemsToRemove.Add(CurrentItem);
 		}
-		ItemsToRemove.Empty();
+	}
+
+	FTagFragment* TagFragment = FindFragment<FTagFragment>(ContainerSettings[ContainerIndex].ContainerFragments);
+	if(TagFragment)
+	{
+		TagFragment->Tags.RemoveTag(IFP_SkipValidation);
+	}
 
-		UFL_InventoryFramework::SortItemsByIndex(ContainerSettings[ContainerIndex].Items, ContainerSettings[ContainerIndex].Items);
+	for(auto& CurrentRemovingItem : ItemsToRemove)
+	{
+		TArray<FS_ContainerSettings> ItemsContainers;
+		GetAllContainersAssociatedWithItem(CurrentRemovingItem, ItemsContainers);
+		for(auto& CurrentContainer : ItemsContainers)
+		{
+			ContainerSettings.RemoveSingle(CurrentContainer);
+		}
+		
+		ContainerSettings[ContainerIndex].Items.RemoveSingle(CurrentRemovingItem);
 	}
+	ItemsToRemove.Empty();
 
-	if(ContainersToRemove.IsValidIndex(0))
+	UFL_InventoryFramework::SortItemsByIndex(ContainerSettings[ContainerIndex].Items, ContainerSettings[ContainerIndex].Items);
+}
+
+void UAC_Inventory::FinalizeStartComponent()
+{
+	if(StartState.ContainersToRemove.IsValidIndex(0))
 	{
 		int32 ContainersRemoved = 0;
-		for(auto& RemovingContainer : ContainersToRemove)
+		for(auto& RemovingContainer : StartState.ContainersToRemove)
 		{
 			ContainerSettings.RemoveAt(RemovingContainer.ContainerIndex - ContainersRemoved);
 			ContainersRemoved++;
@@ -635,61 +1157,48 @@ void UAC_Inventory::StartComponent(bool RemoveSkipValidationTags)
 	}
 
 	RefreshIndexes();
+	RebuildContainerStateHashes();
 	Initialized = true;
+}
 
-	if(GetOwner()->Implements<UI_Inventory>())
+void UAC_Inventory::CreateItemInstancesForContainer(FS_ContainerSettings& CurrentContainer)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(CreateItemItemInstance - Loop)
+	for(auto& CurrentItem : CurrentContainer.Items)
 	{
-		if(!II_Inventory::Execute_IsPreviewActor(GetOwner()))
+		UItemInstance* Template = CurrentItem.ItemInstance;
+		if(!Template)
 		{
-			for(auto& CurrentContainer : ContainerSettings)
+			//No template can be found, check the asset
+			if(CurrentItem.ItemAsset->ItemInstance.IsNull())
 			{
-				TRACE_CPUPROFILER_EVENT_SCOPE(CreateItemItemInstance - Loop)
-				for(auto& CurrentItem : CurrentContainer.Items)
-				{
-					UItemInstance* Template = CurrentItem.ItemInstance;
-					if(!Template)
-					{
-						//No template can be found, check the asset
-						if(CurrentItem.ItemAsset->ItemInstance.IsNull())
-						{
-							continue;
-						}
+				continue;
+			}
 
-						//Try to load and get the default object.
-						Template = Cast<UItemInstance>(CurrentItem.ItemAsset->ItemInstance.LoadSynchronous()->GetDefaultObject());
-						if(!Template)
-						{
-							//Neither item struct nor item asset has a template
-							continue;
-						}
-					}
-			
-					if(Template->ConstructOnRequest)
-					{
-						Template->ItemID = CurrentItem.UniqueID;
-						//Object wants to be constructed during GetItemsInstance,
-						//not during StartComponent
-						continue;
-					}
-			
-					CreateItemInstanceForItem(CurrentItem);
-				}
+			//Try to load and get the default object.
+			Template = Cast<UItemInstance>(CurrentItem.ItemAsset->ItemInstance.LoadSynchronous()->GetDefaultObject());
+			if(!Template)
+			{
+				//Neither item struct nor item asset has a template
+				continue;
 			}
 		}
-	}
 
-	/**Alert any systems that want to work with the initialized inventory
-	 * data that everything is ready. Since we are about to initialize
-	 * equipment, which can be heavy, this is the ideal place to run
-	 * parallel work. Main example is the ItemQuery system*/
-	StartMultithreadWork.Broadcast();
+		if(Template->ConstructOnRequest)
+		{
+			Template->SetItemID(CurrentItem.UniqueID);
+			//Object wants to be constructed during GetItemsInstance,
+			//not during StartComponent
+			continue;
+		}
 
-	for(auto& CurrentEquippedItem : EquippedItems)
-	{
-		UFL_ExternalObjects::BroadcastItemEquipStatusUpdate(CurrentEquippedItem, true, TArray<FName>());
+		CreateItemInstanceForItem(CurrentItem);
 	}
-	
-	for(auto& CurrentTable : LootTables)
+}
+
+void UAC_Inventory::FinishStartComponent(const FComponentStartState& FinishedState)
+{
+	for(auto& CurrentTable : FinishedState.LootTables)
 	{
 		CurrentTable->PostInventoryInitialized(this);
 	}
@@ -702,7 +1211,7 @@ void UAC_Inventory::StartComponent(bool RemoveSkipValidationTags)
 	}
 
 	/**Notify all extension components the inventory has been initialized*/
-	for(auto& CurrentExtension : InventoryExtensions)
+	for(auto& CurrentExtension : FinishedState.InventoryExtensions)
 	{
 		if(CurrentExtension && CurrentExtension->Implements<UI_InventoryExtension>())
 		{
@@ -877,16 +1386,91 @@ void UAC_Inventory::C_RequestServerContainerData_Implementation(bool CallServerD
 
 void UAC_Inventory::S_SendContainerDataToClient_Implementation(bool CallServerDataReceived)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_SendContainerDataToClient_Implementation(CallServerDataReceived); }))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!Initialized)
 	{
 		StartComponent();
 	}
 
+	//The owner might not have had a client yet when BeginPlay ran.
+	RefreshContainerHashTimer();
+
 	/**Send a sanitized ContainerSettings to the client.
 	 * This removes any data we don't want clients to have or is
 	 * cheap to generate for clients but expensive to replicate,
 	 * like the TileMap.*/
-	C_ReceiveServerContainerData(UFL_InventoryFramework::SanitizeContainersForClientRPC(ContainerSettings), CallServerDataReceived);
+	TArray<FS_ContainerSettings> SanitizedContainers = UFL_InventoryFramework::SanitizeContainersForClientRPC(ContainerSettings);
+
+	if(UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->CompressContainerSnapshots)
+	{
+		/**Object references that can't be resolved by path are stripped.
+		 * The client reassigns the parent component and receives
+		 * the item instances separately.*/
+		TArray<UItemInstance*> ItemInstances;
+		for(auto& CurrentContainer : SanitizedContainers)
+		{
+			CurrentContainer.UniqueID.ParentComponent = nullptr;
+			CurrentContainer.Widget = nullptr;
+			CurrentContainer.ExternalObjects.Empty();
+			for(auto& CurrentItem : CurrentContainer.Items)
+			{
+				CurrentItem.UniqueID.ParentComponent = nullptr;
+				CurrentItem.ItemComponents.Empty();
+				CurrentItem.ExternalObjects.Empty();
+				CurrentItem.Widget = nullptr;
+				ItemInstances.Add(CurrentItem.ItemInstance);
+				CurrentItem.ItemInstance = nullptr;
+			}
+		}
+
+		TArray<uint8> CompressedContainers;
+		if(UFL_InventoryFramework::CompressContainers(SanitizedContainers, CompressedContainers))
+		{
+			C_ReceiveCompressedServerContainerData(CompressedContainers, ItemInstances, CallServerDataReceived);
+			return;
+		}
+
+		UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Failed to compress containers for %s, sending them uncompressed - AC_Inventory.cpp -> S_SendContainerDataToClient"),
+			*GetNameSafe(GetOwner())), true, false);
+		SanitizedContainers = UFL_InventoryFramework::SanitizeContainersForClientRPC(ContainerSettings);
+	}
+
+	C_ReceiveServerContainerData(SanitizedContainers, CallServerDataReceived);
+}
+
+void UAC_Inventory::C_ReceiveCompressedServerContainerData_Implementation(const TArray<uint8>& CompressedContainers,
+	const TArray<UItemInstance*>& ItemInstances, bool CallServerDataReceived)
+{
+	TArray<FS_ContainerSettings> ServerContainerSettings;
+	if(!UFL_InventoryFramework::DecompressContainers(CompressedContainers, ServerContainerSettings))
+	{
+		UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Failed to decompress container data for %s - AC_Inventory.cpp -> C_ReceiveCompressedServerContainerData"),
+			*GetNameSafe(GetOwner())));
+		return;
+	}
+
+	//Restore the references the server had to strip.
+	int32 ItemInstanceIndex = 0;
+	for(auto& CurrentContainer : ServerContainerSettings)
+	{
+		CurrentContainer.UniqueID.ParentComponent = this;
+		for(auto& CurrentItem : CurrentContainer.Items)
+		{
+			CurrentItem.UniqueID.ParentComponent = this;
+			if(ItemInstances.IsValidIndex(ItemInstanceIndex))
+			{
+				CurrentItem.ItemInstance = ItemInstances[ItemInstanceIndex];
+			}
+			ItemInstanceIndex++;
+		}
+	}
+
+	C_ReceiveServerContainerData_Implementation(ServerContainerSettings, CallServerDataReceived);
 }
 
 void UAC_Inventory::C_ReceiveServerContainerData_Implementation(const TArray<FS_ContainerSettings> &ServerContainerSettings, bool CallServerDataReceived)
@@ -900,6 +1484,7 @@ void UAC_Inventory::C_ReceiveServerContainerData_Implementation(const TArray<FS_
 	}
 
 	RefreshIDMap();
+	RebuildContainerStateHashes();
 	
 	Initialized = true;
 
@@ -945,12 +1530,17 @@ void UAC_Inventory::C_ReceiveServerContainerData_Implementation(const TArray<FS_
 
 void UAC_Inventory::StopComponent_Implementation()
 {
+	//A time sliced start that hasn't finished yet is simply dropped.
+	CancelStartComponent();
+	
 	if(!Initialized)
 	{
 		return;
 	}
 	
 	ComponentPreStop.Broadcast();
+
+	StopJournal();
 	
 	//This function can be overriden in Blueprints in case there are any blueprint level widgets that need to be wiped.
 	
@@ -972,24 +1562,16 @@ void UAC_Inventory::StopComponent_Implementation()
 				continue;
 			}
 			
-			for(auto& CurrentObject : CurrentItem.ItemAsset->TraitsAndComponents)
+			for(UIT_ItemComponentTrait* ItemComponentTrait : CurrentItem.ItemAsset->FindTraits<UIT_ItemComponentTrait>(true))
 			{
-				if(!IsValid(CurrentObject))
-				{
-					continue;
-				}
-
-				if(UIT_ItemComponentTrait* ItemComponentTrait = Cast<UIT_ItemComponentTrait>(CurrentObject))
+				UItemComponent* ItemComponent = GetItemComponent(CurrentItem, ItemComponentTrait, false, GetOwner());
+				if(ItemComponent)
 				{
-					UItemComponent* ItemComponent = GetItemComponent(CurrentItem, ItemComponentTrait, false, GetOwner());
-					if(ItemComponent)
+					const FGameplayTag StopResponse;
+					ItemComponent->StopComponent(StopResponse);
+					if(ItemComponent) //Component might have been destroyed instantly.
 					{
-						const FGameplayTag StopResponse;
-						ItemComponent->StopComponent(StopResponse);
-						if(ItemComponent) //Component might have been destroyed instantly.
-						{
-							ItemComponent->DestroyComponent();
-						}
+						ItemComponent->DestroyComponent();
 					}
 				}
 			}
@@ -1073,6 +1655,170 @@ TArray<FS_ContainerSettings> UAC_Inventory::GetContainersForSaveState()
 	return CleanedUpContainers;
 }
 
+bool UAC_Inventory::GetCompressedContainersForSaveState(TArray<uint8>& CompressedContainers)
+{
+	return UFL_InventoryFramework::CompressContainers(GetContainersForSaveState(), CompressedContainers);
+}
+
+bool UAC_Inventory::LoadContainersFromCompressedState(const TArray<uint8>& CompressedContainers)
+{
+	TArray<FS_ContainerSettings> LoadedContainers;
+	if(!UFL_InventoryFramework::DecompressContainers(CompressedContainers, LoadedContainers))
+	{
+		UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Failed to decompress saved containers for %s - AC_Inventory.cpp -> LoadContainersFromCompressedState"),
+			*GetNameSafe(GetOwner())));
+		return false;
+	}
+
+	if(Initialized)
+	{
+		UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Loading compressed containers for %s after the component has started - AC_Inventory.cpp -> LoadContainersFromCompressedState"),
+			*GetNameSafe(GetOwner())), true, false);
+	}
+
+	ContainerSettings = LoadedContainers;
+	return true;
+}
+
+void UAC_Inventory::MarkContainerDirty(int32 ContainerID)
+{
+	if(ContainerID > 0)
+	{
+		DirtyContainers.Add(ContainerID);
+
+		if(Journal.IsValid())
+		{
+			Journal->ContainerChanged(ContainerID);
+			ScheduleJournalFlush();
+		}
+	}
+}
+
+void UAC_Inventory::MarkItemInstanceDirty(UItemInstance* ItemInstance)
+{
+	if(!IsValid(ItemInstance) || ItemInstance->ItemID.ParentComponent != this)
+	{
+		return;
+	}
+
+	const FS_InventoryItem Item = GetItemByUniqueID(ItemInstance->ItemID);
+	if(Item.IsValid() && ContainerSettings.IsValidIndex(Item.ContainerIndex))
+	{
+		MarkContainerDirty(ContainerSettings[Item.ContainerIndex].UniqueID.IdentityNumber);
+	}
+}
+
+void UAC_Inventory::MarkAllContainersDirty()
+{
+	for(const FS_ContainerSettings& CurrentContainer : ContainerSettings)
+	{
+		MarkContainerDirty(CurrentContainer.UniqueID.IdentityNumber);
+	}
+}
+
+void UAC_Inventory::ClearDirtyContainers()
+{
+	DirtyContainers.Empty();
+}
+
+bool UAC_Inventory::StartJournal(const FString& JournalName, bool DiscardUnloadedRecords)
+{
+	if(!Initialized || !GetOwner()->HasAuthority())
+	{
+		UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Can only journal %s after the component has started and with authority - AC_Inventory.cpp -> StartJournal"),
+			*GetNameSafe(GetOwner())), true, false);
+		return false;
+	}
+
+	StopJournal();
+
+	const FString JournalPath = FInventoryJournal::GetJournalPath(JournalName.IsEmpty() ? GetOwner()->GetName() : JournalName);
+	const int64 LoadedSequence = FPaths::IsSamePath(LoadedJournalPath, JournalPath) ? LoadedJournalSequence : 0;
+	TSharedPtr<FInventoryJournal> NewJournal = MakeShared<FInventoryJournal>();
+	if(!NewJournal->Start(this, JournalPath, LoadedSequence, DiscardUnloadedRecords))
+	{
+		UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Could not start the journal at %s"), *JournalPath), true, false);
+		return false;
+	}
+
+	Journal = NewJournal;
+	return true;
+}
+
+void UAC_Inventory::StopJournal()
+{
+	if(!Journal.IsValid())
+	{
+		return;
+	}
+
+	FlushJournal();
+	//Everything the journal has came from this component, so it can be started again.
+	SetLoadedJournal(Journal->GetFilePath(), Journal->GetSequence());
+	Journal->Stop();
+	Journal.Reset();
+}
+
+void UAC_Inventory::SetLoadedJournal(const FString& JournalPath, int64 Sequence)
+{
+	LoadedJournalPath = JournalPath;
+	LoadedJournalSequence = Sequence;
+}
+
+void UAC_Inventory::FlushJournal()
+{
+	if(UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(JournalFlushTimer);
+	}
+
+	if(Journal.IsValid())
+	{
+		Journal->Flush(this);
+	}
+}
+
+bool UAC_Inventory::IsJournaling() const
+{
+	return Journal.IsValid() && Journal->IsRunning();
+}
+
+bool UAC_Inventory::LoadContainersFromJournal(const FString& JournalName)
+{
+	const FString JournalPath = FInventoryJournal::GetJournalPath(JournalName.IsEmpty() ? GetOwner()->GetName() : JournalName);
+	TArray<FS_ContainerSettings> Containers;
+	TArray<FLoadedItemInstance> ItemInstances;
+	int64 LastSequence = 0;
+	if(!FInventoryJournal::Replay(JournalPath, -1, Containers, ItemInstances, &LastSequence))
+	{
+		UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Could not load containers from the journal at %s"), *JournalPath), true, false);
+		return false;
+	}
+
+	USG_InventorySerialization::ApplyLoadedContainers(this, MoveTemp(Containers), ItemInstances);
+	ClearDirtyContainers();
+	SetLoadedJournal(JournalPath, LastSequence);
+	return true;
+}
+
+void UAC_Inventory::JournalItemChanged(int32 ItemID)
+{
+	if(Journal.IsValid())
+	{
+		Journal->ItemChanged(ItemID);
+		ScheduleJournalFlush();
+	}
+}
+
+void UAC_Inventory::ScheduleJournalFlush()
+{
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if(!TimerManager.TimerExists(JournalFlushTimer))
+	{
+		JournalFlushTimer = TimerManager.SetTimerForNextTick(this, &UAC_Inventory::FlushJournal);
+	}
+}
+
 void UAC_Inventory::ResetAllUniqueIDs()
 {
 	//Update BelongsToItem directions before we wipe out the UniqueID's
@@ -1233,6 +1979,11 @@ void UAC_Inventory::ConvertToRawState()
 	RemoveAllContainerWidgets();
 	Listeners.Empty();
 	NetworkQueue.Empty();
+	if(GetWorld())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(NetworkQueueEvictionTimer);
+	}
+	PendingPredictions.Empty();
 	WidgetRef = nullptr;
 	Initialized = false;
 }
@@ -1528,15 +2279,46 @@ void UAC_Inventory::MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory* FromCom
 				return;
 			}
 		}
+
+		/**Only predict moves we can fully resolve locally. Infinite containers
+		 * rely on the server to find or make a spot for the item.*/
+		FS_InventoryItem LocalItem = FromComponent->GetItemByUniqueID(ItemToMove.UniqueID);
+		if(PredictItemOperations && LocalItem.IsValid() && ToIndex >= 0 && ToComponent->ContainerSettings.IsValidIndex(ToContainer) &&
+			!ToComponent->ContainerSettings[ToContainer].IsInfinite())
+		{
+			/**Same seed the server and C_MoveItem derive, as long as the server runs
+			 * this at the sequence we expect. If it doesn't, the confirmation resyncs us.*/
+			const int32 MoveCount = Count <= 0 ? LocalItem.Count : Count;
+			const int32 Sequence = ++OperationSequence;
+			const FRandomStream Seed = MakeOperationSeed(TEXT("MoveItem"), Sequence, {LocalItem.UniqueID.IdentityNumber, ToContainer, MoveCount});
+
+			TArray<FS_ContainerSettings> ItemContainers;
+			if(FromComponent == ToComponent)
+			{
+				ItemContainers = FromComponent->GetItemsChildrenContainers(LocalItem);
+			}
+			else
+			{
+				FromComponent->GetAllContainersAssociatedWithItem(LocalItem, ItemContainers);
+			}
+
+			const int32 PredictionID = BeginPrediction({FromComponent, ToComponent});
+			ToComponent->Internal_MoveItem(LocalItem, FromComponent, ToComponent, ToContainer, ToIndex, MoveCount,
+				CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ItemContainers, Seed);
+			S_MoveItem(ItemToMove.UniqueID, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation,
+				GetOwner()->GetLocalRole(), PredictionID);
+			return;
+		}
 		
 		FromComponent->C_AddItemToNetworkQueue(ItemToMove.UniqueID);
 	}
-	S_MoveItem(ItemToMove.UniqueID, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, GetOwner()->GetLocalRole());
+	S_MoveItem(ItemToMove.UniqueID, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation,
+		GetOwner()->GetLocalRole(), 0);
 }
 
 bool UAC_Inventory::S_MoveItem_Validate(FS_UniqueID ItemToMove, UAC_Inventory* FromComponent,
 	UAC_Inventory* ToComponent, int32 ToContainer, int32 ToIndex, int32 Count, bool CallItemMoved, bool CallItemAdded, bool SkipCollisionCheck,
-	ERotation NewRotation, ENetRole CallerLocalRole)
+	ERotation NewRotation, ENetRole CallerLocalRole, int32 PredictionID)
 {
 	FS_InventoryItem Item = ItemToMove.ParentComponent->GetItemByUniqueID(ItemToMove);
 	if(!Item.IsValid())
@@ -1573,30 +2355,50 @@ bool UAC_Inventory::S_MoveItem_Validate(FS_UniqueID ItemToMove, UAC_Inventory* F
 }
 
 void UAC_Inventory::S_MoveItem_Implementation(FS_UniqueID ItemToMove, UAC_Inventory* FromComponent,
-	UAC_Inventory* ToComponent, int32 ToContainer, int32 ToIndex, int32 Count, bool CallItemMoved, bool CallItemAdded, bool SkipCollisionCheck, ERotation NewRotation, ENetRole CallerLocalRole)
+	UAC_Inventory* ToComponent, int32 ToContainer, int32 ToIndex, int32 Count, bool CallItemMoved, bool CallItemAdded, bool SkipCollisionCheck, ERotation NewRotation, ENetRole CallerLocalRole, int32 PredictionID)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_MoveItem_Implementation(ItemToMove, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, CallerLocalRole, PredictionID); },
+		{ItemToMove.ParentComponent, FromComponent, ToComponent}, MakeRejectedRequest({ItemToMove}, PredictionID)))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	TRACE_CPUPROFILER_EVENT_SCOPE("Move Item - Server")
+
+	/**If the client predicted this move, every early exit has to
+	 * tell the client to roll it back.*/
+	auto RejectMove = [this, ItemToMove, PredictionID]()
+	{
+		C_RemoveItemFromNetworkQueue(ItemToMove);
+		if(PredictionID > 0)
+		{
+			C_RejectPrediction(PredictionID);
+		}
+	};
+	
 	FS_InventoryItem Item = ItemToMove.ParentComponent->GetItemByUniqueID(ItemToMove);
 	if(!Item.IsValid())
 	{
+		RejectMove();
 		return;
 	}
 	
 	if(!IsValid(FromComponent) || !IsValid(ToComponent))
 	{
-		C_RemoveItemFromNetworkQueue(ItemToMove);
+		RejectMove();
 		return;
 	}
 
 	if(!FromComponent->ContainerSettings.IsValidIndex(Item.ContainerIndex))
 	{
-		C_RemoveItemFromNetworkQueue(ItemToMove);
+		RejectMove();
 		return;
 	}
 
 	if(!FromComponent->ContainerSettings[Item.ContainerIndex].Items.IsValidIndex(Item.ItemIndex))
 	{
-		C_RemoveItemFromNetworkQueue(ItemToMove);
+		RejectMove();
 		return;
 	}
 
@@ -1620,7 +2422,7 @@ void UAC_Inventory::S_MoveItem_Implementation(FS_UniqueID ItemToMove, UAC_Invent
 		FromComponent->GetItemByUniqueID(ItemToMove);
 		if(!ItemToMove.IsValid())
 		{
-			C_RemoveItemFromNetworkQueue(ItemToMove);
+			RejectMove();
 			return;
 		}
 	}
@@ -1628,7 +2430,7 @@ void UAC_Inventory::S_MoveItem_Implementation(FS_UniqueID ItemToMove, UAC_Invent
 	if(Item.TileIndex == ToIndex && Item.ContainerIndex == ToContainer && Item.UniqueID.ParentComponent == ToComponent && Item.Rotation == NewRotation)
 	{
 		//Item is in the exact same location and rotation.
-		C_RemoveItemFromNetworkQueue(ItemToMove);
+		RejectMove();
 		return;
 	}
 
@@ -1659,8 +2461,10 @@ void UAC_Inventory::S_MoveItem_Implementation(FS_UniqueID ItemToMove, UAC_Invent
 	NewlyCreatedItem.TileIndex = ToIndex;
 	NewlyCreatedItem.ContainerIndex = ToContainer;
 
-	FRandomStream Seed;
-	Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+	/**Derived from what C_MoveItem receives, so clients can make the same seed.
+	 * A predicting client derives it the same way, ConfirmPrediction catches any difference.*/
+	const int32 Sequence = AdvanceOperationSequence();
+	const FRandomStream Seed = MakeOperationSeed(TEXT("MoveItem"), Sequence, {Item.UniqueID.IdentityNumber, ToContainer, Count});
 
 	//If the container is infinite, first find a space. If none is available, expand it.
 	TEnumAsByte<EContainerInfinityDirection> InfinityDirection;
@@ -1668,6 +2472,7 @@ void UAC_Inventory::S_MoveItem_Implementation(FS_UniqueID ItemToMove, UAC_Invent
 	{
 		if(FromComponent == ToComponent && Item.ContainerIndex == ToContainer)
 		{
+			RejectMove();
 			return;
 		}
 		int32 AvailableTile;
@@ -1731,7 +2536,7 @@ void UAC_Inventory::S_MoveItem_Implementation(FS_UniqueID ItemToMove, UAC_Invent
 			if(!SpotAvailable)
 			{
 				//The spot was not available, immediately return.
-				C_RemoveItemFromNetworkQueue(ItemToMove);
+				RejectMove();
 				return;
 			}
 		}
@@ -1790,7 +2595,7 @@ void UAC_Inventory::S_MoveItem_Implementation(FS_UniqueID ItemToMove, UAC_Invent
 			//Update all clients that are currently listening to this component's replication calls.
 			if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
 			{
-				CurrentListener->C_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ContainerIDs, Seed);
+				CurrentListener->C_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ContainerIDs, Sequence);
 			}
 		}
 	}
@@ -1807,33 +2612,43 @@ void UAC_Inventory::S_MoveItem_Implementation(FS_UniqueID ItemToMove, UAC_Invent
 			}
 			else
 			{
-				C_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ContainerIDs, Seed);
+				C_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ContainerIDs, Sequence);
 				ToComponent->Internal_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ItemContainers, Seed);
 			}
 		}
 		else
 		{
-			C_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ContainerIDs, Seed);
+			C_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ContainerIDs, Sequence);
 			ToComponent->Internal_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ItemContainers, Seed);
 		}
 	}
 	else
 	{
-		C_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ContainerIDs, Seed);
 		ToComponent->Internal_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ItemContainers, Seed);
+		if(PredictionID > 0)
+		{
+			//Client has already moved the item, all it needs is to know it was accepted.
+			ConfirmPrediction(PredictionID, {FromComponent, ToComponent});
+		}
+		else
+		{
+			C_MoveItem(Item, FromComponent, ToComponent, ToContainer, ToIndex, Count, CallItemMoved, CallItemAdded, SkipCollisionCheck, NewRotation, ContainerIDs, Sequence);
+		}
 	}
 }
 
 
 void UAC_Inventory::C_MoveItem_Implementation(FS_InventoryItem ItemToMove, UAC_Inventory* FromComponent,
 	UAC_Inventory* ToComponent, int32 ToContainer, int32 ToIndex, int32 Count, bool CallItemMoved, bool CallItemAdded, bool SkipCollisionCheck, ERotation NewRotation,
-	const TArray<FS_UniqueID> &ItemContainers, FRandomStream Seed)
+	const TArray<FS_UniqueID> &ItemContainers, int32 Sequence)
 {
 	if(UKismetSystemLibrary::IsServer(this))
 	{
 		return;
 	}
 
+	const FRandomStream Seed = MakeOperationSeed(TEXT("MoveItem"), Sequence, {ItemToMove.UniqueID.IdentityNumber, ToContainer, Count});
+
 	/**To minimize the client RPC, we only send the UniqueID of the items containers.
 	 * Resolve the UniqueID to the container settings here to operate on them. */
 	TArray<FS_ContainerSettings> NewContainers;
@@ -1861,6 +2676,9 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 		return;
 	}
 
+	FromComponent->WakeNetDormancy();
+	ToComponent->WakeNetDormancy();
+
 	if(Count < 0)
 	{
 		Count = ItemToMove.Count;
@@ -1996,6 +2814,8 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 	TArray<FS_ItemAndContainers> ProcessList; //A list of all items and their owning containers.
 	bool bNewComponent = FromComponent != ToComponent;
 	TArray<FS_ContainerSettings> ContainerWidgetsToUpdate;
+	//Item instances that have to be re-registered with the ToComponent once the hierarchy has been moved.
+	TArray<TPair<TObjectPtr<UItemInstance>, FS_UniqueID>> TransferredInstances;
 	if(bNewComponent)
 	{
 		//It's easier to resolve the hierarchy if we start with items.
@@ -2103,6 +2923,7 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 					//We are trying to move an item, but not the entire stack. Split the item here.
 					const int32 NewCount = FMath::Clamp(ItemToMove.Count - Count, 0, UFL_InventoryFramework::GetItemMaxStack(ItemToMove));
 					FromComponent->ContainerSettings[ItemToMove.ContainerIndex].Items[ItemToMove.ItemIndex].Count = NewCount;
+					FromComponent->UpdateItemStateHash(ItemToMove);
 
 					if(!bNewComponent)
 					{
@@ -2169,14 +2990,8 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 
 				if(UItemInstance* ItemInstance = ItemToMove.ItemInstance)
 				{
-					ItemInstance->ItemID = NewlyCreatedItem.UniqueID;
-					if(UKismetSystemLibrary::IsServer(this))
-					{
-						ItemInstance->GetOwningActor()->RemoveReplicatedSubObject(ItemInstance);
-						ItemInstance->SetOwner(ToComponent->GetOwner());
-						AddReplicatedSubObject(ItemInstance, ItemInstance->ReplicationCondition);
-						ItemInstance->OnRep_ItemID(ItemToMove.UniqueID);
-					}
+					ItemInstance->SetItemID(NewlyCreatedItem.UniqueID);
+					TransferredInstances.Add({ItemInstance, ItemToMove.UniqueID});
 				}
 			}
 			
@@ -2241,7 +3056,8 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 										Seed.Initialize(Seed.GetCurrentSeed() + 1);
 										if(UItemInstance* ItemInstance = NewParentItem.ItemInstance)
 										{
-											ItemInstance->ItemID = NewParentItem.UniqueID;
+											ItemInstance->SetItemID(NewParentItem.UniqueID);
+											TransferredInstances.Add({ItemInstance, CurrentProcess.Item.UniqueID});
 										}
 									}
 																			
@@ -2282,7 +3098,8 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 							Seed.Initialize(Seed.GetCurrentSeed() + 1);
 							if(UItemInstance* ItemInstance = NewChildItem.ItemInstance)
 							{
-								ItemInstance->ItemID = NewChildItem.UniqueID;
+								ItemInstance->SetItemID(NewChildItem.UniqueID);
+								TransferredInstances.Add({ItemInstance, CurrentProcess.Item.UniqueID});
 							}
 							break;
 						}
@@ -2331,6 +3148,11 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 				CurrentWidget.Widget->ConstructContainers(CurrentWidget, ToComponent, true);
 			}
 		}
+
+		if(UKismetSystemLibrary::IsServer(this))
+		{
+			TransferItemInstances(FromComponent, ToComponent, TransferredInstances);
+		}
 	}
 
 	//Call equip dispatcher if @ToContainer was an equipment container.
@@ -2370,6 +3192,40 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 	}
 }
 
+void UAC_Inventory::TransferItemInstances(UAC_Inventory* FromComponent, UAC_Inventory* ToComponent,
+	const TArray<TPair<TObjectPtr<UItemInstance>, FS_UniqueID>>& ItemInstances)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::TransferItemInstances)
+
+	if(!IsValid(FromComponent) || !IsValid(ToComponent) || !ItemInstances.IsValidIndex(0))
+	{
+		return;
+	}
+
+	AActor* NewOwner = ToComponent->GetOwner();
+	for(auto& CurrentInstance : ItemInstances)
+	{
+		UItemInstance* ItemInstance = CurrentInstance.Key;
+		if(!IsValid(ItemInstance))
+		{
+			continue;
+		}
+
+		FromComponent->RemoveReplicatedSubObject(ItemInstance);
+		ItemInstance->SetOwner(NewOwner);
+		ToComponent->AddReplicatedSubObject(ItemInstance, ItemInstance->ReplicationCondition);
+	}
+
+	//Entire hierarchy has been moved, now let the instances know.
+	for(auto& CurrentInstance : ItemInstances)
+	{
+		if(IsValid(CurrentInstance.Key))
+		{
+			CurrentInstance.Key->OnRep_ItemID(CurrentInstance.Value);
+		}
+	}
+}
+
 void UAC_Inventory::SwapItemLocations(FS_InventoryItem Item1, FS_InventoryItem Item2, bool CallItemMoved)
 {
 	if(!UFL_InventoryFramework::IsItemValid(Item1) || !UFL_InventoryFramework::IsItemValid(Item2))
@@ -2393,6 +3249,13 @@ void UAC_Inventory::SwapItemLocations(FS_InventoryItem Item1, FS_InventoryItem I
 void UAC_Inventory::S_SwapItemLocations_Implementation(FS_InventoryItem Item1, FS_InventoryItem Item2,
                                                        bool CallItemMoved, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_SwapItemLocations_Implementation(Item1, Item2, CallItemMoved, CallerLocalRole); },
+		{Item1.UniqueID.ParentComponent, Item1.ItemAsset, Item2.UniqueID.ParentComponent, Item2.ItemAsset}, MakeRejectedRequest({Item1.UniqueID, Item2.UniqueID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	//Validate data before continuing
 	if(!UFL_InventoryFramework::IsItemValid(Item1) || !UFL_InventoryFramework::IsItemValid(Item2))
 	{
@@ -2474,10 +3337,11 @@ void UAC_Inventory::S_SwapItemLocations_Implementation(FS_InventoryItem Item1, F
 		}
 	}
 
-	FRandomStream Item1Seed;
-	Item1Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
-	FRandomStream Item2Seed;
-	Item2Seed.Initialize(Item1Seed.GetCurrentSeed() + 1); //Ensures Seed1 and Seed2 are never the same
+	//Both moves are sent as C_MoveItem, so use the same seeds it will derive.
+	const int32 Item1Sequence = AdvanceOperationSequence();
+	const int32 Item2Sequence = AdvanceOperationSequence();
+	const FRandomStream Item1Seed = MakeOperationSeed(TEXT("MoveItem"), Item1Sequence, {Item1.UniqueID.IdentityNumber, Item2.ContainerIndex, Item1.Count});
+	const FRandomStream Item2Seed = MakeOperationSeed(TEXT("MoveItem"), Item2Sequence, {Item2.UniqueID.IdentityNumber, Item1.ContainerIndex, Item2.Count});
 
 	if(CallerLocalRole == ROLE_Authority)
 	{
@@ -2494,24 +3358,24 @@ void UAC_Inventory::S_SwapItemLocations_Implementation(FS_InventoryItem Item1, F
 			{
 				Item2.UniqueID.ParentComponent->Internal_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1Containers, Item1Seed);
 				Item1.UniqueID.ParentComponent->Internal_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2Containers, Item2Seed);
-				C_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1ContainerIDs, Item1Seed);
-				C_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2ContainerIDs, Item2Seed);
+				C_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1ContainerIDs, Item1Sequence);
+				C_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2ContainerIDs, Item2Sequence);
 			}
 		}
 		else
 		{
 			Item2.UniqueID.ParentComponent->Internal_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1Containers, Item1Seed);
 			Item1.UniqueID.ParentComponent->Internal_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2Containers, Item2Seed);
-			C_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1ContainerIDs, Item1Seed);
-			C_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2ContainerIDs, Item2Seed);
+			C_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1ContainerIDs, Item1Sequence);
+			C_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2ContainerIDs, Item2Sequence);
 		}
 	}
 	else
 	{
 		Item2.UniqueID.ParentComponent->Internal_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1Containers, Item1Seed);
 		Item1.UniqueID.ParentComponent->Internal_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2Containers, Item2Seed);
-		C_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1ContainerIDs, Item1Seed);
-		C_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2ContainerIDs, Item2Seed);
+		C_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1ContainerIDs, Item1Sequence);
+		C_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2ContainerIDs, Item2Sequence);
 	}
 
 	TArray<UAC_Inventory*> CombinedListeners;
@@ -2537,8 +3401,8 @@ void UAC_Inventory::S_SwapItemLocations_Implementation(FS_InventoryItem Item1, F
 		//Update all clients that are currently listening to this component's replication calls.
 		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
 		{
-			CurrentListener->C_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1ContainerIDs, Item1Seed);
-			CurrentListener->C_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2ContainerIDs, Item2Seed);
+			CurrentListener->C_MoveItem(Item1, Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent, Item2.ContainerIndex, Item2.TileIndex, Item1.Count,  CallItemMoved, CallItemMoved, true, Item1NeededRotation, Item1ContainerIDs, Item1Sequence);
+			CurrentListener->C_MoveItem(Item2, Item2.UniqueID.ParentComponent, Item1.UniqueID.ParentComponent, Item1.ContainerIndex, Item1.TileIndex, Item2.Count,  CallItemMoved, CallItemMoved, true, Item2NeededRotation, Item2ContainerIDs, Item2Sequence);
 		}
 	}
 }
@@ -2556,6 +3420,8 @@ void UAC_Inventory::AddItemToTileMap(const FS_InventoryItem Item)
 	{
 		return;
 	}
+
+	UpdateItemStateHash(Item);
 	
 	if(!ContainerSettings[Item.ContainerIndex].SupportsTileMap())
 	{
@@ -2637,6 +3503,8 @@ void UAC_Inventory::AddItemToUninitializedTileMap(FS_InventoryItem Item, UPARAM(
 
 void UAC_Inventory::RemoveItemFromTileMap(FS_InventoryItem Item)
 {
+	RemoveItemStateHash(Item.UniqueID);
+
 	if (Item.TileIndex == -1 && Item.ContainerIndex == -1)
 	{
 		return;
@@ -2722,8 +3590,7 @@ void UAC_Inventory::RemoveItemFromInventory(FS_InventoryItem Item, bool CallItem
 {
 	if(UKismetSystemLibrary::IsStandalone(this))
 	{
-		FRandomStream Seed;
-		Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+		FRandomStream Seed = NextOperationSeed();
 		Internal_RemoveItemFromInventory(Item, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Seed, Success);
 		return;
 	}
@@ -2734,11 +3601,18 @@ void UAC_Inventory::RemoveItemFromInventory(FS_InventoryItem Item, bool CallItem
 void UAC_Inventory::S_RemoveItemFromInventory_Implementation(FS_UniqueID ItemID, bool CallItemRemoved, bool CallItemUnequipped,
 	bool RemoveItemComponents, bool RemoveItemsContainers, bool RemoveItemInstance, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveItemFromInventory_Implementation(ItemID, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, CallerLocalRole); },
+		{ItemID.ParentComponent}, MakeRejectedRequest({ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_InventoryItem Item = ItemID.ParentComponent->GetItemByUniqueID(ItemID);
 	bool RemovalSuccess;
 	
-	FRandomStream Seed;
-	Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+	const int32 Sequence = AdvanceOperationSequence();
+	const FRandomStream Seed = MakeOperationSeed(TEXT("RemoveItemFromInventory"), Sequence, {ItemID.IdentityNumber});
 
 	if(CallerLocalRole == ROLE_Authority)
 	{
@@ -2753,19 +3627,19 @@ void UAC_Inventory::S_RemoveItemFromInventory_Implementation(FS_UniqueID ItemID,
 			else
 			{
 				Internal_RemoveItemFromInventory(Item, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Seed, RemovalSuccess);
-				C_RemoveItemFromInventory(ItemID, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Seed);
+				C_RemoveItemFromInventory(ItemID, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Sequence);
 			}
 		}
 		else
 		{
 			Internal_RemoveItemFromInventory(Item, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Seed, RemovalSuccess);
-			C_RemoveItemFromInventory(ItemID, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Seed);
+			C_RemoveItemFromInventory(ItemID, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Sequence);
 		}
 	}
 	else
 	{
 		Internal_RemoveItemFromInventory(Item, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Seed, RemovalSuccess);
-		C_RemoveItemFromInventory(ItemID, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Seed);
+		C_RemoveItemFromInventory(ItemID, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Sequence);
 	}
 	
 	for(const auto& CurrentListener : ItemID.ParentComponent->Listeners)
@@ -2773,7 +3647,7 @@ void UAC_Inventory::S_RemoveItemFromInventory_Implementation(FS_UniqueID ItemID,
 		//Update all clients that are currently listening to this component's replication calls.
 		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
 		{
-			CurrentListener->C_RemoveItemFromInventory(ItemID, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Seed);
+			CurrentListener->C_RemoveItemFromInventory(ItemID, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Sequence);
 		}
 	}
 }
@@ -2790,7 +3664,7 @@ bool UAC_Inventory::S_RemoveItemFromInventory_Validate(FS_UniqueID ItemID, bool
 }
 
 void UAC_Inventory::C_RemoveItemFromInventory_Implementation(FS_UniqueID ItemID, bool CallItemRemoved, bool CallItemUnequipped,
-	bool RemoveItemComponents, bool RemoveItemsContainers, bool RemoveItemInstance, FRandomStream Seed)
+	bool RemoveItemComponents, bool RemoveItemsContainers, bool RemoveItemInstance, int32 Sequence)
 {
 	if(UKismetSystemLibrary::IsServer(this))
 	{
@@ -2801,6 +3675,7 @@ void UAC_Inventory::C_RemoveItemFromInventory_Implementation(FS_UniqueID ItemID,
 	bool RemovalSuccess;
 	if(Item.IsValid())
 	{
+		const FRandomStream Seed = MakeOperationSeed(TEXT("RemoveItemFromInventory"), Sequence, {ItemID.IdentityNumber});
 		Internal_RemoveItemFromInventory(Item, CallItemRemoved, CallItemUnequipped, RemoveItemComponents, RemoveItemsContainers, RemoveItemInstance, Seed, RemovalSuccess);
 	}
 	else
@@ -2819,6 +3694,8 @@ void UAC_Inventory::Internal_RemoveItemFromInventory_Implementation(FS_Inventory
 		return;
 	}
 
+	ParentComponent->WakeNetDormancy();
+
 	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
 
 	if(!Item.IsValid())
@@ -2833,19 +3710,16 @@ void UAC_Inventory::Internal_RemoveItemFromInventory_Implementation(FS_Inventory
 
 	if(RemoveItemComponents)
 	{
-		for(auto& CurrentObject : Item.ItemAsset->TraitsAndComponents)
+		for(UIT_ItemComponentTrait* ComponentTrait : Item.ItemAsset->FindTraits<UIT_ItemComponentTrait>(true))
 		{
-			if(UIT_ItemComponentTrait* ComponentTrait = Cast<UIT_ItemComponentTrait>(CurrentObject))
+			UItemComponent* ItemComponent = ParentComponent->GetItemComponent(Item, ComponentTrait, false, GetOwner());
+			if(IsValid(ItemComponent))
 			{
-				UItemComponent* ItemComponent = ParentComponent->GetItemComponent(Item, ComponentTrait, false, GetOwner());
-				if(IsValid(ItemComponent))
+				if(!ItemComponent->bIsBusy)
 				{
-					if(!ItemComponent->bIsBusy)
-					{
-						ItemComponent->DestroyComponent();
-					}
+					ItemComponent->DestroyComponent();
 				}
-			}		
+			}
 		}
 	}
 
@@ -2907,6 +3781,13 @@ void UAC_Inventory::LoadAndDropItem(FS_InventoryItem Item)
 
 void UAC_Inventory::S_DropItem_Implementation(FS_UniqueID ItemID)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_DropItem_Implementation(ItemID); },
+		{ItemID.ParentComponent}, MakeRejectedRequest({ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_InventoryItem Item = GetItemByUniqueID(ItemID);
 	if(Item.IsValid())
 	{
@@ -3069,8 +3950,10 @@ void UAC_Inventory::TryAddNewItem(FS_InventoryItem Item, TArray<FS_ContainerSett
 	UFL_InventoryFramework::AddDefaultTagsToItem(Item, false);
 	UFL_InventoryFramework::AddDefaultTagValuesToItem(Item, false, false);
 
-	FRandomStream Seed;
-	Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+	//Sent along with C_TryAddNewItem, so clients can make the same seed.
+	const int32 Sequence = AdvanceOperationSequence();
+	const FRandomStream Seed = MakeOperationSeed(TEXT("TryAddNewItem"), Sequence, {static_cast<int32>(FCrc::StrCrc32(*GetNameSafe(Item.ItemAsset))),
+		Item.UniqueID.IdentityNumber, Item.Count, Item.ContainerIndex, Item.TileIndex});
 	
 	if(UKismetSystemLibrary::IsStandalone(this))
 	{
@@ -3079,19 +3962,19 @@ void UAC_Inventory::TryAddNewItem(FS_InventoryItem Item, TArray<FS_ContainerSett
 	}
 	
 	Internal_TryAddNewItem(Item, ItemsContainers, DestinationComponent, CallItemAdded, SkipStacking, Seed, Result, NewItem, StackDelta);
-	DestinationComponent->C_TryAddNewItem(Item, ItemsContainers, DestinationComponent, CallItemAdded, SkipStacking, Seed);
+	DestinationComponent->C_TryAddNewItem(Item, ItemsContainers, DestinationComponent, CallItemAdded, SkipStacking, Sequence);
 	
 	for(auto& CurrentListener : DestinationComponent->Listeners)
 	{
 		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy)
 		{
-			CurrentListener->C_TryAddNewItem(Item, ItemsContainers, DestinationComponent, CallItemAdded, SkipStacking, Seed);
+			CurrentListener->C_TryAddNewItem(Item, ItemsContainers, DestinationComponent, CallItemAdded, SkipStacking, Sequence);
 		}
 	}
 }
 
 void UAC_Inventory::C_TryAddNewItem_Implementation(FS_InventoryItem Item, const TArray<FS_ContainerSettings> &ItemsContainers, UAC_Inventory* DestinationComponent,
-	bool CallItemAdded, bool SkipStacking, FRandomStream Seed)
+	bool CallItemAdded, bool SkipStacking, int32 Sequence)
 {
 	if(UKismetSystemLibrary::IsServer(this))
 	{
@@ -3103,6 +3986,8 @@ void UAC_Inventory::C_TryAddNewItem_Implementation(FS_InventoryItem Item, const
 		return;
 	}
 	
+	const FRandomStream Seed = MakeOperationSeed(TEXT("TryAddNewItem"), Sequence, {static_cast<int32>(FCrc::StrCrc32(*GetNameSafe(Item.ItemAsset))),
+		Item.UniqueID.IdentityNumber, Item.Count, Item.ContainerIndex, Item.TileIndex});
 	bool Result;
 	FS_InventoryItem NewItem;
 	int32 StackDelta;
@@ -3119,6 +4004,8 @@ void UAC_Inventory::Internal_TryAddNewItem(FS_InventoryItem Item, TArray<FS_Cont
 		Result = false;
 		return;
 	}
+
+	DestinationComponent->WakeNetDormancy();
 	
 	FS_InventoryItem UnmodifiedItem = Item;
 	TArray<FS_ContainerSettings> ContainersToWorkWith;
@@ -3479,16 +4366,39 @@ void UAC_Inventory::StackTwoItems(FS_InventoryItem Item1, FS_InventoryItem Item2
 		Internal_StackTwoItems(Item1, Item2, Item1RemainingCount, Item2NewStackCount);
 		return;
 	}
+
+	if(PredictItemOperations && !UKismetSystemLibrary::IsServer(this))
+	{
+		const int32 PredictionID = BeginPrediction({Item1.UniqueID.ParentComponent, Item2.UniqueID.ParentComponent});
+		Internal_StackTwoItems(Item1, Item2, Item1RemainingCount, Item2NewStackCount);
+		S_StackTwoItems(Item1.UniqueID, Item2.UniqueID, GetOwner()->GetLocalRole(), PredictionID);
+		return;
+	}
+	
 	C_AddItemToNetworkQueue(Item1.UniqueID);
 	C_AddItemToNetworkQueue(Item2.UniqueID);
-	S_StackTwoItems(Item1.UniqueID, Item2.UniqueID, GetOwner()->GetLocalRole());
+	S_StackTwoItems(Item1.UniqueID, Item2.UniqueID, GetOwner()->GetLocalRole(), 0);
 	Item1RemainingCount = UKismetMathLibrary::Clamp((Item2.Count + Item1.Count) - UFL_InventoryFramework::GetItemMaxStack(Item2), 0, UFL_InventoryFramework::GetItemMaxStack(Item1));
 	Item2NewStackCount = UKismetMathLibrary::Clamp(Item2.Count + Item1.Count, 1, UFL_InventoryFramework::GetItemMaxStack(Item2));
 }
 
-void UAC_Inventory::S_StackTwoItems_Implementation(FS_UniqueID Item1ID, FS_UniqueID Item2ID, ENetRole CallerLocalRole)
+void UAC_Inventory::S_StackTwoItems_Implementation(FS_UniqueID Item1ID, FS_UniqueID Item2ID, ENetRole CallerLocalRole, int32 PredictionID)
 {
-	if(!IsValid(Item1ID.ParentComponent) || !IsValid(Item2ID.ParentComponent)) { return; }
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_StackTwoItems_Implementation(Item1ID, Item2ID, CallerLocalRole, PredictionID); },
+		{Item1ID.ParentComponent, Item2ID.ParentComponent}, MakeRejectedRequest({Item1ID, Item2ID}, PredictionID)))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
+	if(!IsValid(Item1ID.ParentComponent) || !IsValid(Item2ID.ParentComponent))
+	{
+		if(PredictionID > 0)
+		{
+			C_RejectPrediction(PredictionID);
+		}
+		return;
+	}
 	
 	FS_InventoryItem Item1 = Item1ID.ParentComponent->GetItemByUniqueID(Item1ID);
 	
@@ -3498,6 +4408,10 @@ void UAC_Inventory::S_StackTwoItems_Implementation(FS_UniqueID Item1ID, FS_Uniqu
 	{
 		C_RemoveItemFromNetworkQueue(Item1.UniqueID);
 		C_RemoveItemFromNetworkQueue(Item2.UniqueID);
+		if(PredictionID > 0)
+		{
+			C_RejectPrediction(PredictionID);
+		}
 		return;
 	}
 
@@ -3528,12 +4442,19 @@ void UAC_Inventory::S_StackTwoItems_Implementation(FS_UniqueID Item1ID, FS_Uniqu
 	}
 	else
 	{
-		C_StackTwoItems(Item1ID, Item2ID);
 		Internal_StackTwoItems(Item1, Item2, Item1RemainingCount, Item2NewStackCount);
-	}
-
-	TArray<UAC_Inventory*> CombinedListeners;
-	for(auto& AppendingListener : Item1ID.ParentComponent->Listeners)
+		if(PredictionID > 0)
+		{
+			ConfirmPrediction(PredictionID, {Item1ID.ParentComponent, Item2ID.ParentComponent});
+		}
+		else
+		{
+			C_StackTwoItems(Item1ID, Item2ID);
+		}
+	}
+
+	TArray<UAC_Inventory*> CombinedListeners;
+	for(auto& AppendingListener : Item1ID.ParentComponent->Listeners)
 	{
 		CombinedListeners.AddUnique(AppendingListener);
 	}
@@ -3561,7 +4482,7 @@ void UAC_Inventory::S_StackTwoItems_Implementation(FS_UniqueID Item1ID, FS_Uniqu
 	}
 }
 
-bool UAC_Inventory::S_StackTwoItems_Validate(FS_UniqueID Item1ID, FS_UniqueID Item2ID, ENetRole CallerLocalRole)
+bool UAC_Inventory::S_StackTwoItems_Validate(FS_UniqueID Item1ID, FS_UniqueID Item2ID, ENetRole CallerLocalRole, int32 PredictionID)
 {
 	return true;
 }
@@ -3605,6 +4526,9 @@ void UAC_Inventory::Internal_StackTwoItems(FS_InventoryItem Item1, FS_InventoryI
 		UFL_InventoryFramework::LogIFPMessage(this, TEXT("Either Item1 or Item2 was not found for stacking"), true, false);
 		return;
 	}
+
+	Item1.UniqueID.ParentComponent->WakeNetDormancy();
+	Item2.UniqueID.ParentComponent->WakeNetDormancy();
 	
 	if(!UFL_InventoryFramework::CanStackItems(Item1, Item2))
 	{
@@ -3630,6 +4554,8 @@ void UAC_Inventory::Internal_StackTwoItems(FS_InventoryItem Item1, FS_InventoryI
 
 	Item1Ref.Count = Item1RemainingCount;
 	Item2Ref.Count = Item2NewStackCount;
+	Item1.ParentComponent()->UpdateItemStateHash(Item1Ref);
+	Item2.ParentComponent()->UpdateItemStateHash(Item2Ref);
 
 	//Notify everyone of the new item count
 	UFL_ExternalObjects::BroadcastItemCountUpdated(Item1, Item1Count, Item1RemainingCount);
@@ -3676,25 +4602,48 @@ void UAC_Inventory::SplitItem(FS_InventoryItem Item, int32 SplitAmount, UAC_Inve
 	if(UKismetSystemLibrary::IsStandalone(this))
 	{
 		FS_UniqueID NewStackUniqueID = DestinationComponent->GenerateUniqueID();
-		FRandomStream Seed;
-		Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+		FRandomStream Seed = NextOperationSeed();
+		Internal_SplitItem(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Item1RemainingCount, Item2NewStackCount, Seed);
+		return;
+	}
+
+	if(PredictItemOperations && !UKismetSystemLibrary::IsServer(this))
+	{
+		//Same seeds the server derives if it runs this at the sequence we expect.
+		const int32 Sequence = ++OperationSequence;
+		const FRandomStream Seed = MakeOperationSeed(TEXT("SplitItem"), Sequence, {Item.UniqueID.IdentityNumber, SplitAmount, NewStackContainerIndex, NewStackTileIndex});
+		const FS_UniqueID NewStackUniqueID = DestinationComponent->GenerateUniqueIDWithSeed(
+			MakeOperationSeed(TEXT("SplitItemStack"), Sequence, {Item.UniqueID.IdentityNumber, SplitAmount, NewStackContainerIndex, NewStackTileIndex}));
+		
+		const int32 PredictionID = BeginPrediction({Item.UniqueID.ParentComponent, DestinationComponent});
 		Internal_SplitItem(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Item1RemainingCount, Item2NewStackCount, Seed);
+		S_SplitItem(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, GetOwner()->GetLocalRole(), PredictionID);
 		return;
 	}
 
 	C_AddItemToNetworkQueue(Item.UniqueID);
-	S_SplitItem(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, GetOwner()->GetLocalRole());
+	S_SplitItem(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, GetOwner()->GetLocalRole(), 0);
 }
 
-void UAC_Inventory::S_SplitItem_Implementation(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, int32 NewStackContainerIndex, int32 NewStackTileIndex, ENetRole CallerLocalRole)
+void UAC_Inventory::S_SplitItem_Implementation(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, int32 NewStackContainerIndex, int32 NewStackTileIndex, ENetRole CallerLocalRole,
+	int32 PredictionID)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_SplitItem_Implementation(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, CallerLocalRole, PredictionID); },
+		{Item.UniqueID.ParentComponent, Item.ItemAsset, DestinationComponent}, MakeRejectedRequest({Item.UniqueID}, PredictionID)))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	int32 Item1RemainingCount;
 	int32 Item2NewStackCount;
 
-	FRandomStream Seed;
-	Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
-
-	FS_UniqueID NewStackUniqueID = DestinationComponent->GenerateUniqueID();
+	/**Derived the same way a predicting client does, so the new stack normally
+	 * ends up with the same UniqueID on both ends. ConfirmPrediction catches any difference.*/
+	const int32 Sequence = AdvanceOperationSequence();
+	const FRandomStream Seed = MakeOperationSeed(TEXT("SplitItem"), Sequence, {Item.UniqueID.IdentityNumber, SplitAmount, NewStackContainerIndex, NewStackTileIndex});
+	const FS_UniqueID NewStackUniqueID = DestinationComponent->GenerateUniqueIDWithSeed(
+		MakeOperationSeed(TEXT("SplitItemStack"), Sequence, {Item.UniqueID.IdentityNumber, SplitAmount, NewStackContainerIndex, NewStackTileIndex}));
 
 	if(CallerLocalRole == ROLE_Authority)
 	{
@@ -3709,19 +4658,26 @@ void UAC_Inventory::S_SplitItem_Implementation(FS_InventoryItem Item, int32 Spli
 			else
 			{
 				Internal_SplitItem(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Item1RemainingCount, Item2NewStackCount, Seed);
-				C_SplitItem(Item, SplitAmount, DestinationComponent, Item.ItemAsset, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Seed);
+				C_SplitItem(Item, SplitAmount, DestinationComponent, Item.ItemAsset, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Sequence);
 			}
 		}
 		else
 		{
 			Internal_SplitItem(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Item1RemainingCount, Item2NewStackCount, Seed);
-			C_SplitItem(Item, SplitAmount, DestinationComponent, Item.ItemAsset, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Seed);
+			C_SplitItem(Item, SplitAmount, DestinationComponent, Item.ItemAsset, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Sequence);
 		}
 	}
 	else
 	{
 		Internal_SplitItem(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Item1RemainingCount, Item2NewStackCount, Seed);
-		C_SplitItem(Item, SplitAmount, DestinationComponent, Item.ItemAsset, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Seed);
+		if(PredictionID > 0)
+		{
+			ConfirmPrediction(PredictionID, {Item.UniqueID.ParentComponent, DestinationComponent});
+		}
+		else
+		{
+			C_SplitItem(Item, SplitAmount, DestinationComponent, Item.ItemAsset, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Sequence);
+		}
 	}
 
 	TArray<UAC_Inventory*> CombinedListeners;
@@ -3739,12 +4695,13 @@ void UAC_Inventory::S_SplitItem_Implementation(FS_InventoryItem Item, int32 Spli
 		//Update all clients that are currently listening to this component's replication calls.
 		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
 		{
-			CurrentListener->C_SplitItem(Item, SplitAmount, DestinationComponent, Item.ItemAsset, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Seed);
+			CurrentListener->C_SplitItem(Item, SplitAmount, DestinationComponent, Item.ItemAsset, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Sequence);
 		}
 	}
 }
 
-bool UAC_Inventory::S_SplitItem_Validate(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, int32 NewStackContainerIndex, int32 NewStackTileIndex, ENetRole CallerLocalRole)
+bool UAC_Inventory::S_SplitItem_Validate(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, int32 NewStackContainerIndex, int32 NewStackTileIndex, ENetRole CallerLocalRole,
+	int32 PredictionID)
 {
 	if(!IsValid(Item.UniqueID.ParentComponent) || !IsValid(DestinationComponent)) { return false; }
 	if(!DestinationComponent->ContainerSettings.IsValidIndex(NewStackContainerIndex)) { return false; }
@@ -3761,8 +4718,9 @@ bool UAC_Inventory::S_SplitItem_Validate(FS_InventoryItem Item, int32 SplitAmoun
 }
 
 void UAC_Inventory::C_SplitItem_Implementation(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, UDA_CoreItem* ItemDataAsset,
-	int32 NewStackContainerIndex, int32 NewStackTileIndex, FS_UniqueID NewStackUniqueID, FRandomStream Seed)
+	int32 NewStackContainerIndex, int32 NewStackTileIndex, FS_UniqueID NewStackUniqueID, int32 Sequence)
 {
+	const FRandomStream Seed = MakeOperationSeed(TEXT("SplitItem"), Sequence, {Item.UniqueID.IdentityNumber, SplitAmount, NewStackContainerIndex, NewStackTileIndex});
 	int32 Item1RemainingCount;
 	int32 Item2NewStackCount;
 	Internal_SplitItem(Item, SplitAmount, DestinationComponent, NewStackContainerIndex, NewStackTileIndex, NewStackUniqueID, Item1RemainingCount, Item2NewStackCount, Seed);
@@ -3772,6 +4730,9 @@ void UAC_Inventory::C_SplitItem_Implementation(FS_InventoryItem Item, int32 Spli
 void UAC_Inventory::Internal_SplitItem(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, int32 NewStackContainerIndex, int32 NewStackTileIndex,
 	FS_UniqueID NewStackUniqueID, int32& Item1RemainingCount, int32& Item2NewStackCount, FRandomStream Seed)
 {
+	WakeNetDormancy();
+	DestinationComponent->WakeNetDormancy();
+
 	//First check if there's a colliding item. If we can stack with it, attempt to stack.
 	bool SpotAvailable;
 	int32 AvailableTile;
@@ -3903,6 +4864,13 @@ void UAC_Inventory::IncreaseItemCount(FS_InventoryItem Item, int32 Count, int32&
 
 void UAC_Inventory::S_IncreaseItemCount_Implementation(FS_UniqueID ItemID, int32 Count, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_IncreaseItemCount_Implementation(ItemID, Count, CallerLocalRole); },
+		{ItemID.ParentComponent}, MakeRejectedRequest({ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	int32 NewStackCount;
 
 	if(!IsValid(ItemID.ParentComponent))
@@ -3992,6 +4960,8 @@ void UAC_Inventory::Internal_IncreaseItemCount(FS_UniqueID ItemID, int32 Count,
 	{
 		return;
 	}
+
+	ParentComponent->WakeNetDormancy();
 	
 	if(IsValid(Item.ItemAsset))
 	{
@@ -4000,6 +4970,7 @@ void UAC_Inventory::Internal_IncreaseItemCount(FS_UniqueID ItemID, int32 Count,
 			int32 OldCount = Item.Count;
 			NewCount = FMath::Clamp(Item.Count + Count, 1, UFL_InventoryFramework::GetItemMaxStack(Item));
 			ParentComponent->ContainerSettings[Item.ContainerIndex].Items[Item.ItemIndex].Count = NewCount;
+			ParentComponent->UpdateItemStateHash(Item);
 
 			UFL_ExternalObjects::BroadcastItemCountUpdated(Item, OldCount, NewCount);
 		}
@@ -4017,8 +4988,7 @@ void UAC_Inventory::ReduceItemCount(FS_InventoryItem Item, int32 Count, bool Rem
 	
 	if(UKismetSystemLibrary::IsStandalone(this))
 	{
-		FRandomStream Seed;
-		Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+		FRandomStream Seed = NextOperationSeed();
 		Internal_ReduceItemCount(Item, Count, RemoveItemIf0, Seed);
 		return;
 	}
@@ -4028,13 +4998,20 @@ void UAC_Inventory::ReduceItemCount(FS_InventoryItem Item, int32 Count, bool Rem
 
 void UAC_Inventory::S_ReduceItemCount_Implementation(FS_UniqueID ItemID, int32 Count, bool RemoveItemIf0, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_ReduceItemCount_Implementation(ItemID, Count, RemoveItemIf0, CallerLocalRole); },
+		{ItemID.ParentComponent}, MakeRejectedRequest({ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!IsValid(ItemID.ParentComponent))
 	{
 		return;
 	}
 	
-	FRandomStream Seed;
-	Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+	const int32 Sequence = AdvanceOperationSequence();
+	const FRandomStream Seed = MakeOperationSeed(TEXT("ReduceItemCount"), Sequence, {ItemID.IdentityNumber, Count});
 
 	FS_InventoryItem Item = ItemID.ParentComponent->GetItemByUniqueID(ItemID);
 	if(!Item.IsValid())
@@ -4055,19 +5032,19 @@ void UAC_Inventory::S_ReduceItemCount_Implementation(FS_UniqueID ItemID, int32 C
 			else
 			{
 				Internal_ReduceItemCount(Item, Count, RemoveItemIf0, Seed);
-				C_ReduceItemCount(ItemID, Count, RemoveItemIf0, Seed);
+				C_ReduceItemCount(ItemID, Count, RemoveItemIf0, Sequence);
 			}
 		}
 		else
 		{
 			Internal_ReduceItemCount(Item, Count, RemoveItemIf0, Seed);
-			C_ReduceItemCount(ItemID, Count, RemoveItemIf0, Seed);
+			C_ReduceItemCount(ItemID, Count, RemoveItemIf0, Sequence);
 		}
 	}
 	else
 	{
 		Internal_ReduceItemCount(Item, Count, RemoveItemIf0, Seed);
-		C_ReduceItemCount(ItemID, Count, RemoveItemIf0, Seed);
+		C_ReduceItemCount(ItemID, Count, RemoveItemIf0, Sequence);
 	}
 	
 	for(const auto& CurrentListener : ItemID.ParentComponent->Listeners)
@@ -4075,7 +5052,7 @@ void UAC_Inventory::S_ReduceItemCount_Implementation(FS_UniqueID ItemID, int32 C
 		//Update all clients that are currently listening to this component's replication calls.
 		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
 		{
-			CurrentListener->C_ReduceItemCount(ItemID, Count, RemoveItemIf0, Seed);
+			CurrentListener->C_ReduceItemCount(ItemID, Count, RemoveItemIf0, Sequence);
 		}
 	}
 }
@@ -4085,7 +5062,7 @@ bool UAC_Inventory::S_ReduceItemCount_Validate(FS_UniqueID ItemID, int32 Count,
 	return true;
 }
 
-void UAC_Inventory::C_ReduceItemCount_Implementation(FS_UniqueID ItemID, int32 Count, bool RemoveItemIf0, FRandomStream Seed)
+void UAC_Inventory::C_ReduceItemCount_Implementation(FS_UniqueID ItemID, int32 Count, bool RemoveItemIf0, int32 Sequence)
 {
 	if(UKismetSystemLibrary::IsServer(this))
 	{
@@ -4100,7 +5077,7 @@ void UAC_Inventory::C_ReduceItemCount_Implementation(FS_UniqueID ItemID, int32 C
 	FS_InventoryItem Item = ItemID.ParentComponent->GetItemByUniqueID(ItemID);
 	if(Item.IsValid())
 	{
-		Internal_ReduceItemCount(Item, Count, RemoveItemIf0, Seed);
+		Internal_ReduceItemCount(Item, Count, RemoveItemIf0, MakeOperationSeed(TEXT("ReduceItemCount"), Sequence, {ItemID.IdentityNumber, Count}));
 		C_RemoveItemFromNetworkQueue(Item.UniqueID);
 	}
 }
@@ -4114,6 +5091,7 @@ void UAC_Inventory::Internal_ReduceItemCount(FS_InventoryItem Item, int32 Count,
 
 	UFL_InventoryFramework::UpdateItemStruct(Item);
 	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
+	ParentComponent->WakeNetDormancy();
 	if(!UFL_InventoryFramework::AreItemDirectionsValid(Item.UniqueID, Item.ContainerIndex, Item.ItemIndex))
 	{
 		return;
@@ -4124,6 +5102,7 @@ void UAC_Inventory::Internal_ReduceItemCount(FS_InventoryItem Item, int32 Count,
 	int32 OldCount = Item.Count;
 	const int32 NewCount = FMath::Clamp(Item.Count - Count, 0, UFL_InventoryFramework::GetItemMaxStack(Item));
 	ParentComponent->ContainerSettings[Item.ContainerIndex].Items[Item.ItemIndex].Count = NewCount;
+	ParentComponent->UpdateItemStateHash(Item);
 
 	UFL_ExternalObjects::BroadcastItemCountUpdated(Item, OldCount, NewCount);
 	
@@ -4165,8 +5144,7 @@ void UAC_Inventory::MassReduceCount(UDA_CoreItem* Item, int32 Count, UAC_Invento
 	
 	if(UKismetSystemLibrary::IsStandalone(this))
 	{
-		FRandomStream Seed;
-		Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+		FRandomStream Seed = NextOperationSeed();
 		Internal_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Seed, RemoveItemsIf0);
 		return;
 	}
@@ -4176,8 +5154,33 @@ void UAC_Inventory::MassReduceCount(UDA_CoreItem* Item, int32 Count, UAC_Invento
 
 void UAC_Inventory::S_MassReduceCount_Implementation(UDA_CoreItem* Item, int32 Count, UAC_Inventory* TargetComponent, int32 ContainerIndex, bool RemoveItemsIf0, ENetRole CallerLocalRole)
 {
-	FRandomStream Seed;
-	Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+	//The client queued every item it expected this to touch.
+	auto RejectMassReduce = [WeakThis = TWeakObjectPtr<UAC_Inventory>(this), WeakItem = TWeakObjectPtr<UDA_CoreItem>(Item),
+		WeakTarget = TWeakObjectPtr<UAC_Inventory>(TargetComponent), Count, ContainerIndex]()
+	{
+		UAC_Inventory* Requester = WeakThis.Get();
+		UAC_Inventory* Target = WeakTarget.Get();
+		if(!Requester || !Target || !WeakItem.IsValid())
+		{
+			return;
+		}
+	
+		int32 FoundTotalCount;
+		for(const FS_ItemCount& CurrentItem : Target->GetListOfItemsByCount(WeakItem.Get(), Count, ContainerIndex, FoundTotalCount))
+		{
+			Requester->C_RemoveItemFromNetworkQueue(CurrentItem.Item.UniqueID);
+		}
+	};
+
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_MassReduceCount_Implementation(Item, Count, TargetComponent, ContainerIndex, RemoveItemsIf0, CallerLocalRole); },
+		{Item, TargetComponent}, RejectMassReduce))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
+	const int32 Sequence = AdvanceOperationSequence();
+	const FRandomStream Seed = MakeOperationSeed(TEXT("MassReduceCount"), Sequence, {static_cast<int32>(FCrc::StrCrc32(*GetNameSafe(Item))), Count, ContainerIndex});
 
 	if(CallerLocalRole == ROLE_Authority)
 	{
@@ -4192,19 +5195,19 @@ void UAC_Inventory::S_MassReduceCount_Implementation(UDA_CoreItem* Item, int32 C
 			else
 			{
 				Internal_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Seed, RemoveItemsIf0);
-				C_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Seed, RemoveItemsIf0);
+				C_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Sequence, RemoveItemsIf0);
 			}
 		}
 		else
 		{
 			Internal_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Seed, RemoveItemsIf0);
-			C_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Seed, RemoveItemsIf0);
+			C_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Sequence, RemoveItemsIf0);
 		}
 	}
 	else
 	{
 		Internal_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Seed, RemoveItemsIf0);
-		C_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Seed, RemoveItemsIf0);
+		C_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Sequence, RemoveItemsIf0);
 	}
 	
 	for(const auto& CurrentListener : TargetComponent->Listeners)
@@ -4212,13 +5215,13 @@ void UAC_Inventory::S_MassReduceCount_Implementation(UDA_CoreItem* Item, int32 C
 		//Update all clients that are currently listening to this component's replication calls.
 		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
 		{
-			CurrentListener->C_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Seed, RemoveItemsIf0);
+			CurrentListener->C_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Sequence, RemoveItemsIf0);
 		}
 	}
 }
 
 void UAC_Inventory::C_MassReduceCount_Implementation(UDA_CoreItem* Item, int32 Count, UAC_Inventory* TargetComponent, int32 ContainerIndex,
-	FRandomStream Seed, bool RemoveItemsIf0)
+	int32 Sequence, bool RemoveItemsIf0)
 {
 	if(UKismetSystemLibrary::IsServer(this))
 	{
@@ -4227,6 +5230,7 @@ void UAC_Inventory::C_MassReduceCount_Implementation(UDA_CoreItem* Item, int32 C
 	
 	int32 FoundTotalCount;
 	TArray<FS_ItemCount> MatchingItems = TargetComponent->GetListOfItemsByCount(Item, Count, ContainerIndex, FoundTotalCount);
+	const FRandomStream Seed = MakeOperationSeed(TEXT("MassReduceCount"), Sequence, {static_cast<int32>(FCrc::StrCrc32(*GetNameSafe(Item))), Count, ContainerIndex});
 	Internal_MassReduceCount(Item, Count, TargetComponent, ContainerIndex, Seed, RemoveItemsIf0);
 	
 	if(!MatchingItems.IsValidIndex(0))
@@ -4300,6 +5304,13 @@ void UAC_Inventory::UpdateItemsOverrideSettings(FS_InventoryItem Item, FItemOver
 
 void UAC_Inventory::S_UpdateItemsOverrideSettings_Implementation(FS_UniqueID ItemID, FItemOverrideSettings NewSettings, ENetRole CallerLocalRole, AActor* ActorRequestingChange)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_UpdateItemsOverrideSettings_Implementation(ItemID, NewSettings, CallerLocalRole, ActorRequestingChange); },
+		{ItemID.ParentComponent, ActorRequestingChange}, MakeRejectedRequest({ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_InventoryItem Item = ItemID.ParentComponent->GetItemByUniqueID(ItemID);
 
 	if(!Item.IsValid())
@@ -4381,9 +5392,12 @@ void UAC_Inventory::Internal_UpdateItemsOverrideSettings(FS_InventoryItem Item,
 		return;
 	}
 
+	Item.UniqueID.ParentComponent->WakeNetDormancy();
+
 	FItemOverrideSettings* OverrideFragment = FindFragment<FItemOverrideSettings>(Item.UniqueID.ParentComponent->ContainerSettings[Item.ContainerIndex].Items[Item.ItemIndex].ItemFragments, true);
 	FItemOverrideSettings OldOverride = *OverrideFragment;
 	*OverrideFragment = NewSettings;
+	Item.UniqueID.ParentComponent->MarkContainerDirty(Item.UniqueID.ParentComponent->ContainerSettings[Item.ContainerIndex].UniqueID.IdentityNumber);
 	
 	UW_InventoryItem* ItemWidget = UFL_InventoryFramework::GetWidgetForItem(Item);
 	
@@ -4435,6 +5449,13 @@ bool UAC_Inventory::AddTagToItem(FS_InventoryItem Item, FGameplayTag Tag, bool I
 
 void UAC_Inventory::S_AddTagToItem_Implementation(FS_UniqueID ItemID, FGameplayTag Tag, ENetRole CallerLocalRole, bool IgnoreNetworkQueue)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AddTagToItem_Implementation(ItemID, Tag, CallerLocalRole, IgnoreNetworkQueue); },
+		{ItemID.ParentComponent}, MakeRejectedRequest(IgnoreNetworkQueue ? TArray<FS_UniqueID>() : TArray<FS_UniqueID>{ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_InventoryItem OriginalItem = ItemID.ParentComponent->GetItemByUniqueID(ItemID);
 
 	if(!OriginalItem.IsValid())
@@ -4531,6 +5552,7 @@ void UAC_Inventory::Internal_AddTagToItem(FS_InventoryItem Item, FGameplayTag Ta
 	}
 
 	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
+	ParentComponent->WakeNetDormancy();
 	FTagFragment* TagFragment = FindFragment<FTagFragment>(ParentComponent->ContainerSettings[Item.ContainerIndex].Items[Item.ItemIndex].ItemFragments, true);
 	if(TagFragment->Tags.HasTagExact(Tag))
 	{
@@ -4540,6 +5562,7 @@ void UAC_Inventory::Internal_AddTagToItem(FS_InventoryItem Item, FGameplayTag Ta
 	if(TagFragment)
 	{
 		TagFragment->Tags.AddTag(Tag);
+		ParentComponent->UpdateItemStateHash(Item);
 		UFL_ExternalObjects::BroadcastTagsUpdated(Tag, true, Item, FS_ContainerSettings());
 	}
 }
@@ -4579,6 +5602,13 @@ bool UAC_Inventory::RemoveTagFromItem(FS_InventoryItem Item, FGameplayTag Tag, b
 
 void UAC_Inventory::S_RemoveTagFromItem_Implementation(FS_UniqueID ItemID, FGameplayTag Tag, ENetRole CallerLocalRole, bool IgnoreNetworkQueue)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveTagFromItem_Implementation(ItemID, Tag, CallerLocalRole, IgnoreNetworkQueue); },
+		{ItemID.ParentComponent}, MakeRejectedRequest(IgnoreNetworkQueue ? TArray<FS_UniqueID>() : TArray<FS_UniqueID>{ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_InventoryItem OriginalItem = ItemID.ParentComponent->GetItemByUniqueID(ItemID);
 
 	if(!OriginalItem.IsValid())
@@ -4675,6 +5705,7 @@ void UAC_Inventory::Internal_RemoveTagFromItem(FS_InventoryItem Item, FGameplayT
 	}
 	
 	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
+	ParentComponent->WakeNetDormancy();
 	FTagFragment* TagFragment = FindFragment<FTagFragment>(ParentComponent->ContainerSettings[Item.ContainerIndex].Items[Item.ItemIndex].ItemFragments, true);
 
 	if(!TagFragment->Tags.HasTagExact(Tag))
@@ -4685,6 +5716,7 @@ void UAC_Inventory::Internal_RemoveTagFromItem(FS_InventoryItem Item, FGameplayT
 	if(TagFragment)
 	{
 		TagFragment->Tags.RemoveTag(Tag);
+		ParentComponent->UpdateItemStateHash(Item);
 		UFL_ExternalObjects::BroadcastTagsUpdated(Tag, false, Item, FS_ContainerSettings());
 	}
 }
@@ -4721,7 +5753,11 @@ float UAC_Inventory::GetTotalValueOfTag(FGameplayTag Tag, TArray<TEnumAsByte<ECo
 
 	if(Component)
 	{
-		AccumulatedValue += UFL_InventoryFramework::GetValueForTag(TagValuesContainer, Tag).Value;
+		const int32 TagValueIndex = ComponentTagValues.FindTagValueIndex(Tag);
+		if(ComponentTagValues.Items.IsValidIndex(TagValueIndex))
+		{
+			AccumulatedValue += ComponentTagValues.Items[TagValueIndex].TagValue.Value;
+		}
 	}
 
 	return AccumulatedValue;
@@ -4737,6 +5773,13 @@ void UAC_Inventory::RemoveSelfAsListener(UAC_Inventory* OtherComponent)
 
 void UAC_Inventory::S_RemoveSelfAsListener_Implementation(UAC_Inventory* OtherComponent)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveSelfAsListener_Implementation(OtherComponent); },
+		{OtherComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!OtherComponent)
 	{
 		return;
@@ -4746,6 +5789,8 @@ void UAC_Inventory::S_RemoveSelfAsListener_Implementation(UAC_Inventory* OtherCo
 	{
 		OtherComponent->Listeners.RemoveSingle(this);
 		C_SetClientReceivedContainerData(OtherComponent, false);
+		//Start the countdown to the other component going back to sleep.
+		OtherComponent->WakeNetDormancy();
 	}
 }
 
@@ -4796,6 +5841,13 @@ bool UAC_Inventory::SetTagValueForItem(FS_InventoryItem Item, FGameplayTag Tag,
 
 void UAC_Inventory::S_SetTagValueForItem_Implementation(FS_UniqueID ItemID, FGameplayTag Tag, float Value, ENetRole CallerLocalRole, bool AddIfNotFound, TSubclassOf<UO_TagValueCalculation> CalculationClass, bool IgnoreNetworkQueue)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_SetTagValueForItem_Implementation(ItemID, Tag, Value, CallerLocalRole, AddIfNotFound, CalculationClass, IgnoreNetworkQueue); },
+		{ItemID.ParentComponent, CalculationClass.Get()}, MakeRejectedRequest(IgnoreNetworkQueue ? TArray<FS_UniqueID>() : TArray<FS_UniqueID>{ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_TagValue TagValue;
 	TagValue.Tag = Tag;
 	TagValue.Value = Value;
@@ -4936,6 +5988,8 @@ void UAC_Inventory::Internal_SetTagValueForItem(FS_InventoryItem Item, FGameplay
 		return;
 	}
 
+	ParentComponent->WakeNetDormancy();
+
 	FS_TagValue NewTagValue;
 	NewTagValue.Tag = Tag;
 	NewTagValue.Value = Value;
@@ -4968,6 +6022,7 @@ void UAC_Inventory::Internal_SetTagValueForItem(FS_InventoryItem Item, FGameplay
 	if(UFL_InventoryFramework::DoesTagValuesHaveTag(TagFragment->TagValues, Tag, FoundTagValue, TagIndex))
 	{
 		TagFragment->TagValues[TagIndex].Value = Value;
+		ParentComponent->UpdateItemStateHash(Item);
 		ParentComponent->ItemTagValueUpdated.Broadcast(Item, NewTagValue, NewTagValue.Value - FoundTagValue.Value);
 		Success = true;
 	}
@@ -4976,6 +6031,7 @@ void UAC_Inventory::Internal_SetTagValueForItem(FS_InventoryItem Item, FGameplay
 		if(AddIfNotFound)
 		{
 			TagFragment->TagValues.AddUnique(NewTagValue);
+			ParentComponent->UpdateItemStateHash(Item);
 			ParentComponent->ItemTagValueUpdated.Broadcast(Item, NewTagValue, NewTagValue.Value);
 			Success = true;
 		}
@@ -5042,6 +6098,13 @@ bool UAC_Inventory::RemoveTagValueFromItem(FS_InventoryItem Item, FGameplayTag T
 
 void UAC_Inventory::S_RemoveTagValueFromItem_Implementation(FS_UniqueID ItemID, FGameplayTag Tag, ENetRole CallerLocalRole, bool IgnoreNetworkQueue)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveTagValueFromItem_Implementation(ItemID, Tag, CallerLocalRole, IgnoreNetworkQueue); },
+		{ItemID.ParentComponent}, MakeRejectedRequest(IgnoreNetworkQueue ? TArray<FS_UniqueID>() : TArray<FS_UniqueID>{ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_InventoryItem OriginalItem = ItemID.ParentComponent->GetItemByUniqueID(ItemID);
 
 	if(!OriginalItem.IsValid())
@@ -5124,6 +6187,8 @@ void UAC_Inventory::Internal_RemoveTagValueFromItem(FS_InventoryItem Item, FGame
 		return;
 	}
 
+	ParentComponent->WakeNetDormancy();
+
 	if(FTagFragment* TagFragment = FindFragment<FTagFragment>(ParentComponent->ContainerSettings[Item.ContainerIndex].Items[Item.ItemIndex].ItemFragments))
 	{
 		FS_TagValue FoundTagValue;
@@ -5131,6 +6196,7 @@ void UAC_Inventory::Internal_RemoveTagValueFromItem(FS_InventoryItem Item, FGame
 		if(UFL_InventoryFramework::DoesTagValuesHaveTag(TagFragment->TagValues, Tag, FoundTagValue, TagIndex))
 		{
 			TagFragment->TagValues.RemoveAt(TagIndex);
+			ParentComponent->UpdateItemStateHash(Item);
 			ParentComponent->ItemTagValueUpdated.Broadcast(Item, FoundTagValue, FoundTagValue.Value * -1);
 		
 			UFL_ExternalObjects::BroadcastTagValueUpdated(FoundTagValue, true, FoundTagValue.Value * -1, Item, FS_ContainerSettings());
@@ -5308,8 +6374,7 @@ void UAC_Inventory::SortAndMoveItems(TEnumAsByte<ESortingType> SortType, FS_Cont
 
 	if(UKismetSystemLibrary::IsStandalone(this))
 	{
-		FRandomStream Seed;
-		Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+		FRandomStream Seed = NextOperationSeed();
 		Internal_SortAndMoveItems(SortType, Container, StaggerTimer, Seed);
 		return;
 	}
@@ -5320,6 +6385,21 @@ void UAC_Inventory::SortAndMoveItems(TEnumAsByte<ESortingType> SortType, FS_Cont
 
 void UAC_Inventory::S_SortAndMoveItems_Implementation(ESortingType SortType, FS_UniqueID ContainerID, float StaggerTimer, ENetRole CallerLocalRole)
 {
+	auto RejectSort = [WeakParentComponent = TWeakObjectPtr<UAC_Inventory>(ContainerID.ParentComponent), ContainerIdentity = ContainerID.IdentityNumber]()
+	{
+		if(UAC_Inventory* ParentComponent = WeakParentComponent.Get())
+		{
+			ParentComponent->C_RemoveAllContainerItemsFromNetworkQueue(FS_UniqueID(ContainerIdentity, ParentComponent));
+		}
+	};
+
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_SortAndMoveItems_Implementation(SortType, ContainerID, StaggerTimer, CallerLocalRole); },
+		{ContainerID.ParentComponent}, RejectSort))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	UAC_Inventory* ParentComponent = ContainerID.ParentComponent;
 
 	if(!IsValid(ParentComponent))
@@ -5333,8 +6413,8 @@ void UAC_Inventory::S_SortAndMoveItems_Implementation(ESortingType SortType, FS_
 		return;
 	}
 
-	FRandomStream Seed;
-	Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+	const int32 Sequence = AdvanceOperationSequence();
+	const FRandomStream Seed = MakeOperationSeed(TEXT("SortAndMoveItems"), Sequence, {static_cast<int32>(SortType), ContainerID.IdentityNumber});
 
 	if(CallerLocalRole == ROLE_Authority)
 	{
@@ -5348,19 +6428,19 @@ void UAC_Inventory::S_SortAndMoveItems_Implementation(ESortingType SortType, FS_
 			}
 			else
 			{
-				C_SortAndMoveItems(SortType, ContainerID, StaggerTimer, Seed);
+				C_SortAndMoveItems(SortType, ContainerID, StaggerTimer, Sequence);
 				Internal_SortAndMoveItems(SortType, Container, StaggerTimer, Seed);
 			}
 		}
 		else
 		{
-			C_SortAndMoveItems(SortType, ContainerID, StaggerTimer, Seed);
+			C_SortAndMoveItems(SortType, ContainerID, StaggerTimer, Sequence);
 			Internal_SortAndMoveItems(SortType, Container, StaggerTimer, Seed);
 		}
 	}
 	else
 	{
-		C_SortAndMoveItems(SortType, ContainerID, StaggerTimer, Seed);
+		C_SortAndMoveItems(SortType, ContainerID, StaggerTimer, Sequence);
 		Internal_SortAndMoveItems(SortType, Container, StaggerTimer, Seed);
 	}
 	
@@ -5369,12 +6449,12 @@ void UAC_Inventory::S_SortAndMoveItems_Implementation(ESortingType SortType, FS_
 		//Update all clients that are currently listening to this component's replication calls.
 		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
 		{
-			CurrentListener->C_SortAndMoveItems(SortType, ContainerID, StaggerTimer, Seed);
+			CurrentListener->C_SortAndMoveItems(SortType, ContainerID, StaggerTimer, Sequence);
 		}
 	}
 }
 
-void UAC_Inventory::C_SortAndMoveItems_Implementation(ESortingType SortType, FS_UniqueID ContainerID, float StaggerTimer, FRandomStream Seed)
+void UAC_Inventory::C_SortAndMoveItems_Implementation(ESortingType SortType, FS_UniqueID ContainerID, float StaggerTimer, int32 Sequence)
 {
 	if(UKismetSystemLibrary::IsServer(this))
 	{
@@ -5394,7 +6474,7 @@ void UAC_Inventory::C_SortAndMoveItems_Implementation(ESortingType SortType, FS_
 		return;
 	}
 	
-	Internal_SortAndMoveItems(SortType, Container, StaggerTimer, Seed);
+	Internal_SortAndMoveItems(SortType, Container, StaggerTimer, MakeOperationSeed(TEXT("SortAndMoveItems"), Sequence, {static_cast<int32>(SortType), ContainerID.IdentityNumber}));
 	Container.UniqueID.ParentComponent->C_RemoveAllContainerItemsFromNetworkQueue(ContainerID);
 }
 
@@ -5406,6 +6486,8 @@ void UAC_Inventory::Internal_SortAndMoveItems(TEnumAsByte<ESortingType> SortType
 	{
 		return;
 	}
+
+	ParentComponent->WakeNetDormancy();
 	
 	FS_ContainerSettings FoundContainer = ParentComponent->GetContainerByUniqueID(Container.UniqueID);
 	if(!FoundContainer.IsValid() || FoundContainer.Items.IsEmpty())
@@ -5444,6 +6526,8 @@ void UAC_Inventory::Internal_SortAndMoveItems(TEnumAsByte<ESortingType> SortType
 		 * already.*/
 		ContainerRef.Items = SortedItems;
 		ParentComponent->RefreshItemsIndexes(ContainerRef);
+		//Also marks the container as dirty.
+		ParentComponent->RebuildContainerStateHash(ContainerRef);
 		SortingFinished.Broadcast();
 		return;
 	}
@@ -5545,6 +6629,13 @@ void UAC_Inventory::T_SortAndMoveItems(UAC_Inventory* ParentComponent, const FS_
 void UAC_Inventory::S_NotifyItemSold_Implementation(FS_InventoryItem Item, UIDA_Currency* Currency, int32 Amount, UAC_Inventory* Buyer,
                                                     UAC_Inventory* Seller)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_NotifyItemSold_Implementation(Item, Currency, Amount, Buyer, Seller); },
+		{Item.UniqueID.ParentComponent, Item.ItemAsset, Currency, Buyer, Seller}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	Seller->SoldItem.Broadcast(Item, Buyer, Currency, Amount);
 	Buyer->BoughtItem.Broadcast(Item, Seller, Currency, Amount);
 }
@@ -5809,7 +6900,7 @@ UItemInstance* UAC_Inventory::CreateItemInstanceForItem(FS_InventoryItem& Item)
 		//Create a new object and use the instanced copy as a template, so all the edited variables are inherited by the new object.
 		UItemInstance* ItemInstance = NewObject<UItemInstance>(GetOwner(), Template->GetClass(),
 			NAME_None, RF_NoFlags, Template);
-		ItemInstance->ItemID = Item.UniqueID;
+		ItemInstance->SetItemID(Item.UniqueID);
 		ItemInstance->ItemAsset = Item.ItemAsset;
 		ItemInstance->SetOwner(GetOwner());
 		
@@ -5873,6 +6964,13 @@ void UAC_Inventory::UpdateItemsEquipStatus(FS_InventoryItem Item, bool IsEquippe
 void UAC_Inventory::S_UpdateItemsEquipStatus_Implementation(FS_UniqueID ItemID, bool IsEquipped,
                                                             const TArray<FName>& CustomTriggerFilters, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_UpdateItemsEquipStatus_Implementation(ItemID, IsEquipped, CustomTriggerFilters, CallerLocalRole); },
+		{ItemID.ParentComponent}, MakeRejectedRequest({ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!ItemID.IsValid())
 	{
 		return;
@@ -5958,8 +7056,7 @@ void UAC_Inventory::MassSplitStack(FS_InventoryItem Item, int32 StackSize, int32
 	
 	if(UKismetSystemLibrary::IsStandalone(this))
 	{
-		FRandomStream Seed;
-		Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+		FRandomStream Seed = NextOperationSeed();
 		Internal_MassSplitStack(Item, StackSize, SplitAmount, DestinationContainer, Seed, 0);
 		return;
 	}
@@ -5971,6 +7068,13 @@ void UAC_Inventory::MassSplitStack(FS_InventoryItem Item, int32 StackSize, int32
 void UAC_Inventory::S_MassSplitStack_Implementation(FS_UniqueID ItemID, int32 StackSize, int32 SplitAmount,
                                                     FS_UniqueID ContainerID, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_MassSplitStack_Implementation(ItemID, StackSize, SplitAmount, ContainerID, CallerLocalRole); },
+		{ItemID.ParentComponent, ContainerID.ParentComponent}, MakeRejectedRequest({ItemID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!ItemID.IsValid() || !ContainerID.IsValid())
 	{
 		return;
@@ -5988,8 +7092,8 @@ void UAC_Inventory::S_MassSplitStack_Implementation(FS_UniqueID ItemID, int32 St
 		return;
 	}
 
-	FRandomStream Seed;
-	Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+	const int32 Sequence = AdvanceOperationSequence();
+	const FRandomStream Seed = MakeOperationSeed(TEXT("MassSplitStack"), Sequence, {ItemID.IdentityNumber, StackSize, SplitAmount, ContainerID.IdentityNumber});
 
 	int32 AmountReduced = Internal_MassSplitStack(Item, StackSize, SplitAmount, Container, Seed, 0);
 
@@ -6001,17 +7105,17 @@ void UAC_Inventory::S_MassSplitStack_Implementation(FS_UniqueID ItemID, int32 St
 		{
 			if(!GetOwner()->GetInstigatorController()->IsLocalPlayerController())
 			{
-				C_MassSplitStack(ItemID, StackSize, SplitAmount, ContainerID, Seed, AmountReduced);
+				C_MassSplitStack(ItemID, StackSize, SplitAmount, ContainerID, Sequence, AmountReduced);
 			}
 		}
 		else
 		{
-			C_MassSplitStack(ItemID, StackSize, SplitAmount, ContainerID, Seed, AmountReduced);
+			C_MassSplitStack(ItemID, StackSize, SplitAmount, ContainerID, Sequence, AmountReduced);
 		}
 	}
 	else
 	{
-		C_MassSplitStack(ItemID, StackSize, SplitAmount, ContainerID, Seed, AmountReduced);
+		C_MassSplitStack(ItemID, StackSize, SplitAmount, ContainerID, Sequence, AmountReduced);
 	}
 	
 	for(const auto& CurrentListener : ItemID.ParentComponent->Listeners)
@@ -6019,13 +7123,13 @@ void UAC_Inventory::S_MassSplitStack_Implementation(FS_UniqueID ItemID, int32 St
 		//Update all clients that are currently listening to this component's replication calls.
 		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
 		{
-			CurrentListener->C_MassSplitStack(ItemID, StackSize, SplitAmount, ContainerID, Seed, AmountReduced);;
+			CurrentListener->C_MassSplitStack(ItemID, StackSize, SplitAmount, ContainerID, Sequence, AmountReduced);
 		}
 	}
 }
 
-void UAC_Inventory::C_MassSplitStack_Implementation(FS_UniqueID ItemID, int32 StackSize, int32 SplitAmount, FS_UniqueID ContainerID, FRandomStream Seed, int32
-                                                    ItemCountReduction)
+void UAC_Inventory::C_MassSplitStack_Implementation(FS_UniqueID ItemID, int32 StackSize, int32 SplitAmount, FS_UniqueID ContainerID,
+	int32 Sequence, int32 ItemCountReduction)
 {
 	if(UKismetSystemLibrary::IsServer(this))
 	{
@@ -6045,6 +7149,7 @@ void UAC_Inventory::C_MassSplitStack_Implementation(FS_UniqueID ItemID, int32 St
 
 	FS_ContainerSettings Container = GetContainerByUniqueID(ContainerID);
 	
+	const FRandomStream Seed = MakeOperationSeed(TEXT("MassSplitStack"), Sequence, {ItemID.IdentityNumber, StackSize, SplitAmount, ContainerID.IdentityNumber});
 	Internal_MassSplitStack(Item, SplitAmount, SplitAmount, Container, Seed, ItemCountReduction);
 	C_RemoveItemFromNetworkQueue(Item.UniqueID);
 }
@@ -6193,6 +7298,13 @@ TArray<TSoftClassPtr<UItemInstance>> UAC_Inventory::GetUnloadedItemInstances()
 
 void UAC_Inventory::S_ConstructServerItemComponent_Implementation(UDA_CoreItem* CoreItem, FS_UniqueID UniqueID, UIT_ItemComponentTrait* Trait, AActor* Instigator, TSubclassOf<UItemComponent> ItemComponent, FGameplayTag Event, FItemComponentPayload Payload)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_ConstructServerItemComponent_Implementation(CoreItem, UniqueID, Trait, Instigator, ItemComponent, Event, Payload); },
+		{CoreItem, UniqueID.ParentComponent, Trait, Instigator, ItemComponent.Get(), Payload.OptionalObject}, MakeRejectedRequest({UniqueID})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	TRACE_CPUPROFILER_EVENT_SCOPE("Construct item Component")
 	
 	if(Trait->NetworkingMethod == Client)
@@ -6298,14 +7410,11 @@ void UAC_Inventory::UpdateItemComponentsUniqueID(FS_UniqueID OldUniqueID, FS_Uni
 	FS_InventoryItem ItemData = GetItemByUniqueID(OldUniqueID);
 	if(ItemData.IsValid())
 	{
-		for(auto& CurrentObject : ItemData.ItemAsset->TraitsAndComponents)
+		for(UIT_ItemComponentTrait* ComponentTrait : ItemData.ItemAsset->FindTraits<UIT_ItemComponentTrait>(true))
 		{
-			if(UIT_ItemComponentTrait* ComponentTrait = Cast<UIT_ItemComponentTrait>(CurrentObject))
+			if(UItemComponent* ItemComponent = GetItemComponent(ItemData, ComponentTrait, false, GetOwner()))
 			{
-				if(UItemComponent* ItemComponent = GetItemComponent(ItemData, ComponentTrait, false, GetOwner()))
-				{
-					ItemComponent->UniqueID = NewUniqueID;
-				}
+				ItemComponent->UniqueID = NewUniqueID;
 			}
 		}
 	}
@@ -7131,7 +8240,7 @@ TArray<FS_ContainerSettings> UAC_Inventory::GetItemsChildrenContainers(FS_Invent
 	
 	if(Item.ItemAsset)
 	{
-		if(Item.ItemAsset->GetDefaultContainers().IsEmpty())
+		if(!Item.ItemAsset->HasDefaultContainers())
 		{
 			return Containers;
 		}
@@ -7698,6 +8807,13 @@ void UAC_Inventory::AddTagsToTile(FS_ContainerSettings Container, int32 TileInde
 void UAC_Inventory::S_AddTagsToTile_Implementation(FS_UniqueID ContainerID, int32 TileIndex, FGameplayTagContainer Tags,
                                                    ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AddTagsToTile_Implementation(ContainerID, TileIndex, Tags, CallerLocalRole); },
+		{ContainerID.ParentComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_ContainerSettings OriginalContainer = ContainerID.ParentComponent->GetContainerByUniqueID(ContainerID);
 	
 	if(CallerLocalRole == ROLE_Authority)
@@ -7791,6 +8907,7 @@ void UAC_Inventory::Internal_AddTagsToTile(FS_ContainerSettings Container, int32
 		TileTagsFragment->TileTags[TileTagIndex].Tags.AppendTags(Tags);
 	}
 
+	ParentComponent->MarkContainerDirty(Container.UniqueID.IdentityNumber);
 	ParentComponent->TileTagsAdded.Broadcast(ParentComponent->ContainerSettings[Container.ContainerIndex], TileIndex, Tags);
 }
 
@@ -7817,6 +8934,13 @@ void UAC_Inventory::RemoveTagsFromTile(FS_ContainerSettings Container, int32 Til
 void UAC_Inventory::S_RemoveTagsFromTile_Implementation(FS_UniqueID ContainerID, int32 TileIndex,
 														FGameplayTagContainer Tags, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveTagsFromTile_Implementation(ContainerID, TileIndex, Tags, CallerLocalRole); },
+		{ContainerID.ParentComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_ContainerSettings OriginalContainer = ContainerID.ParentComponent->GetContainerByUniqueID(ContainerID);
 	
 	if(CallerLocalRole == ROLE_Authority)
@@ -7922,6 +9046,7 @@ void UAC_Inventory::Internal_RemoveTagsFromTile(FS_ContainerSettings Container,
 		}
 	}
 
+	ParentComponent->MarkContainerDirty(Container.UniqueID.IdentityNumber);
 	ParentComponent->TileTagsRemoved.Broadcast(ParentComponent->ContainerSettings[Container.ContainerIndex], TileIndex, Tags);
 }
 
@@ -8027,8 +9152,7 @@ void UAC_Inventory::AdjustContainerSize(FS_ContainerSettings Container, FMargin
 	
 	if(UKismetSystemLibrary::IsStandalone(this))
 	{
-		FRandomStream Seed;
-		Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+		FRandomStream Seed = NextOperationSeed();
 		TargetComponent->Internal_AdjustContainerSize(Container, Adjustments, ClampToItems, Seed);
 		return;
 	}
@@ -8038,6 +9162,13 @@ void UAC_Inventory::AdjustContainerSize(FS_ContainerSettings Container, FMargin
 
 void UAC_Inventory::S_AdjustContainerSize_Implementation(FS_ContainerSettings Container, FMargin Adjustments, bool ClampToItems, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AdjustContainerSize_Implementation(Container, Adjustments, ClampToItems, CallerLocalRole); },
+		{Container.UniqueID.ParentComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	UAC_Inventory* TargetComponent = Container.UniqueID.ParentComponent;
 	if(!IsValid(TargetComponent))
 	{
@@ -8074,8 +9205,9 @@ void UAC_Inventory::S_AdjustContainerSize_Implementation(FS_ContainerSettings Co
 		}
 	}
 	
-	FRandomStream Seed;
-	Seed.Initialize(UKismetMathLibrary::RandomIntegerInRange(1, 214748364));
+	const int32 Sequence = AdvanceOperationSequence();
+	const FRandomStream Seed = MakeOperationSeed(TEXT("AdjustContainerSize"), Sequence, {Container.UniqueID.IdentityNumber,
+		FMath::RoundToInt(Adjustments.Left), FMath::RoundToInt(Adjustments.Top), FMath::RoundToInt(Adjustments.Right), FMath::RoundToInt(Adjustments.Bottom)});
 
 	TArray<UAC_Inventory*> CombinedListeners;
 	for(auto& AppendingListener : Container.UniqueID.ParentComponent->Listeners)
@@ -8092,7 +9224,7 @@ void UAC_Inventory::S_AdjustContainerSize_Implementation(FS_ContainerSettings Co
 		//Update all clients that are currently listening to this component's replication calls.
 		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
 		{
-			CurrentListener->C_AdjustContainerSize(Container.UniqueID, Adjustments, ClampToItems, Seed);
+			CurrentListener->C_AdjustContainerSize(Container.UniqueID, Adjustments, ClampToItems, Sequence);
 		}
 	}
 
@@ -8109,23 +9241,23 @@ void UAC_Inventory::S_AdjustContainerSize_Implementation(FS_ContainerSettings Co
 			else
 			{
 				TargetComponent->Internal_AdjustContainerSize(Container, Adjustments, ClampToItems, Seed);
-				C_AdjustContainerSize(Container.UniqueID, Adjustments, ClampToItems, Seed);
+				C_AdjustContainerSize(Container.UniqueID, Adjustments, ClampToItems, Sequence);
 			}
 		}
 		else
 		{
 			TargetComponent->Internal_AdjustContainerSize(Container, Adjustments, ClampToItems, Seed);
-			C_AdjustContainerSize(Container.UniqueID, Adjustments, ClampToItems, Seed);
+			C_AdjustContainerSize(Container.UniqueID, Adjustments, ClampToItems, Sequence);
 		}
 	}
 	else
 	{
 		TargetComponent->Internal_AdjustContainerSize(Container, Adjustments, ClampToItems, Seed);
-		C_AdjustContainerSize(Container.UniqueID, Adjustments, ClampToItems, Seed);
+		C_AdjustContainerSize(Container.UniqueID, Adjustments, ClampToItems, Sequence);
 	}
 }
 
-void UAC_Inventory::C_AdjustContainerSize_Implementation(FS_UniqueID ContainerID, FMargin Adjustments, bool ClampToItems, FRandomStream Seed)
+void UAC_Inventory::C_AdjustContainerSize_Implementation(FS_UniqueID ContainerID, FMargin Adjustments, bool ClampToItems, int32 Sequence)
 {
 	if(UKismetSystemLibrary::IsServer(this))
 	{
@@ -8142,6 +9274,8 @@ void UAC_Inventory::C_AdjustContainerSize_Implementation(FS_UniqueID ContainerID
 	FS_ContainerSettings FoundContainer = TargetComponent->GetContainerByUniqueID(ContainerID);
 	if(FoundContainer.IsValid())
 	{
+		const FRandomStream Seed = MakeOperationSeed(TEXT("AdjustContainerSize"), Sequence, {ContainerID.IdentityNumber,
+			FMath::RoundToInt(Adjustments.Left), FMath::RoundToInt(Adjustments.Top), FMath::RoundToInt(Adjustments.Right), FMath::RoundToInt(Adjustments.Bottom)});
 		TargetComponent->Internal_AdjustContainerSize(FoundContainer, Adjustments, ClampToItems, Seed);
 	}
 	
@@ -8156,6 +9290,7 @@ bool UAC_Inventory::Internal_AdjustContainerSize(FS_ContainerSettings Container,
 
 	FS_ContainerSettings& ContainerRef = Container.UniqueID.ParentComponent->ContainerSettings[Container.ContainerIndex];
 	UAC_Inventory* ParentComponent = ContainerRef.UniqueID.ParentComponent;
+	ParentComponent->MarkContainerDirty(Container.UniqueID.IdentityNumber);
 
 	UW_Container* ContainerWidget = UFL_InventoryFramework::GetWidgetForContainer(Container);
 
@@ -9010,6 +10145,13 @@ bool UAC_Inventory::VerifyContainerToAdd(FS_ContainerSettings Container, FS_Inve
 void UAC_Inventory::S_AddContainer_Implementation(UAC_Inventory* TargetComponent, FS_ContainerSettings NewContainer, FS_UniqueID OwningItem,
                                                   ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AddContainer_Implementation(TargetComponent, NewContainer, OwningItem, CallerLocalRole); },
+		{TargetComponent, NewContainer.UniqueID.ParentComponent, OwningItem.ParentComponent}, MakeRejectedRequest({OwningItem})))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	if(!NewContainer.UniqueID.IsValid())
 	{
 		NewContainer.UniqueID = TargetComponent->GenerateUniqueID();
@@ -9124,6 +10266,7 @@ void UAC_Inventory::Internal_AddContainer(UAC_Inventory* TargetComponent, FS_Con
 	/**V: technically, we could manually refresh the indexes, but starting
 	 * the loop at where this container is being added. Tiny optimization. */
 	RefreshIndexes();
+	TargetComponent->RebuildContainerStateHash(TargetComponent->ContainerSettings[NewContainer.ContainerIndex]);
 
 	TargetComponent->ContainerAdded.Broadcast(TargetComponent->ContainerSettings[NewContainer.ContainerIndex]);
 }
@@ -9153,6 +10296,13 @@ void UAC_Inventory::RemoveContainer(FS_ContainerSettings Container)
 
 void UAC_Inventory::S_RemoveContainer_Implementation(FS_UniqueID ContainerID, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveContainer_Implementation(ContainerID, CallerLocalRole); },
+		{ContainerID.ParentComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_ContainerSettings Container = GetContainerByUniqueID(ContainerID);
 	if(!Container.IsValid())
 	{
@@ -9240,6 +10390,7 @@ void UAC_Inventory::Internal_RemoveContainer(FS_ContainerSettings Container)
 	/**V: technically, we could manually refresh the indexes, but starting
 	 * the loop at where this container is being removed. Tiny optimization. */
 	RefreshIndexes();
+	TargetComponent->RebuildContainerStateHashes();
 
 	TargetComponent->ContainerRemoved.Broadcast(Container);
 }
@@ -9270,6 +10421,13 @@ bool UAC_Inventory::AddTagToContainer(FS_ContainerSettings Container, FGameplayT
 
 void UAC_Inventory::S_AddTagToContainer_Implementation(FS_UniqueID ContainerID, FGameplayTag Tag, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AddTagToContainer_Implementation(ContainerID, Tag, CallerLocalRole); },
+		{ContainerID.ParentComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_ContainerSettings OriginalContainer = ContainerID.ParentComponent->GetContainerByUniqueID(ContainerID);
 	if(!OriginalContainer.IsValid())
 	{
@@ -9349,6 +10507,7 @@ void UAC_Inventory::Internal_AddTagToContainer(FS_ContainerSettings Container, F
 	if(FTagFragment* TagFragment = FindFragment<FTagFragment>(Container.UniqueID.ParentComponent->ContainerSettings[Container.ContainerIndex].ContainerFragments, true))
 	{
 		TagFragment->Tags.AddTag(Tag);
+		Container.UniqueID.ParentComponent->MarkContainerDirty(Container.UniqueID.IdentityNumber);
 		UFL_ExternalObjects::BroadcastTagsUpdated(Tag, true, FS_InventoryItem(), Container);
 	}
 }
@@ -9385,6 +10544,13 @@ bool UAC_Inventory::RemoveTagFromContainer(FS_ContainerSettings Container, FGame
 
 void UAC_Inventory::S_RemoveTagFromContainer_Implementation(FS_UniqueID ContainerID, FGameplayTag Tag, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveTagFromContainer_Implementation(ContainerID, Tag, CallerLocalRole); },
+		{ContainerID.ParentComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_ContainerSettings OriginalContainer = ContainerID.ParentComponent->GetContainerByUniqueID(ContainerID);
 
 	if(!OriginalContainer.IsValid())
@@ -9464,6 +10630,7 @@ void UAC_Inventory::Internal_RemoveTagFromContainer(FS_ContainerSettings Contain
 	if(FTagFragment* TagFragment = FindFragment<FTagFragment>(Container.UniqueID.ParentComponent->ContainerSettings[Container.ContainerIndex].ContainerFragments, false))
 	{
 		TagFragment->Tags.RemoveTag(Tag);
+		Container.UniqueID.ParentComponent->MarkContainerDirty(Container.UniqueID.IdentityNumber);
 		UFL_ExternalObjects::BroadcastTagsUpdated(Tag, false, FS_InventoryItem(), Container);
 	}
 }
@@ -9521,6 +10688,13 @@ bool UAC_Inventory::SetTagValueForContainer(FS_ContainerSettings Container, FGam
 
 void UAC_Inventory::S_SetTagValueForContainer_Implementation(FS_UniqueID ContainerID, FGameplayTag Tag, float Value, ENetRole CallerLocalRole, TSubclassOf<UO_TagValueCalculation> CalculationClass, bool AddIfNotFound)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_SetTagValueForContainer_Implementation(ContainerID, Tag, Value, CallerLocalRole, CalculationClass, AddIfNotFound); },
+		{ContainerID.ParentComponent, CalculationClass.Get()}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_ContainerSettings OriginalContainer = ContainerID.ParentComponent->GetContainerByUniqueID(ContainerID);
 	if(!OriginalContainer.IsValid())
 	{
@@ -9682,6 +10856,7 @@ void UAC_Inventory::Internal_SetTagValueForContainer(FS_ContainerSettings Contai
 			}
 		}
 
+		ParentComponent->MarkContainerDirty(Container.UniqueID.IdentityNumber);
 		UFL_ExternalObjects::BroadcastTagValueUpdated(NewTagValue, true, NewTagValue.Value - FoundTagValue.Value, FS_InventoryItem(), Container);
 	}
 }
@@ -9726,6 +10901,13 @@ bool UAC_Inventory::RemoveTagValueFromContainer(FS_ContainerSettings Container,
 
 void UAC_Inventory::S_RemoveTagValueFromContainer_Implementation(FS_UniqueID ContainerID, FGameplayTag Tag, ENetRole CallerLocalRole)
 {
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveTagValueFromContainer_Implementation(ContainerID, Tag, CallerLocalRole); },
+		{ContainerID.ParentComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
 	FS_ContainerSettings OriginalContainer = ContainerID.ParentComponent->GetContainerByUniqueID(ContainerID);
 	if(!OriginalContainer.IsValid())
 	{
@@ -9755,559 +10937,1423 @@ void UAC_Inventory::S_RemoveTagValueFromContainer_Implementation(FS_UniqueID Con
 		}
 		else
 		{
-			Internal_RemoveTagValueFromContainer(OriginalContainer, Tag);
-			C_RemoveTagValueFromContainer(ContainerID, Tag);
+			Internal_RemoveTagValueFromContainer(OriginalContainer, Tag);
+			C_RemoveTagValueFromContainer(ContainerID, Tag);
+		}
+	}
+	else
+	{
+		Internal_RemoveTagValueFromContainer(OriginalContainer, Tag);
+		C_RemoveTagValueFromContainer(ContainerID, Tag);
+	}
+	
+	for(const auto& CurrentListener : ContainerID.ParentComponent->Listeners)
+	{
+		//Update all clients that are currently listening to this component's replication calls.
+		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
+		{
+			CurrentListener->C_RemoveTagValueFromContainer(ContainerID, Tag);
+		}
+	}
+}
+
+bool UAC_Inventory::S_RemoveTagValueFromContainer_Validate(FS_UniqueID ContainerID, FGameplayTag Tag, ENetRole CallerLocalRole)
+{
+	return true;
+}
+
+void UAC_Inventory::C_RemoveTagValueFromContainer_Implementation(FS_UniqueID ContainerID, FGameplayTag Tag)
+{
+	if(UKismetSystemLibrary::IsServer(this))
+	{
+		return;
+	}
+	
+	FS_ContainerSettings OriginalContainer = ContainerID.ParentComponent->GetContainerByUniqueID(ContainerID);
+	if(OriginalContainer.IsValid())
+	{
+		Internal_RemoveTagValueFromContainer(OriginalContainer, Tag);
+	}
+}
+
+void UAC_Inventory::Internal_RemoveTagValueFromContainer(FS_ContainerSettings Container, FGameplayTag Tag)
+{
+	UAC_Inventory* ParentComponent = Container.UniqueID.ParentComponent;
+	
+	if(!IsValid(ParentComponent))
+	{
+		return;
+	}
+
+	FS_TagValue FoundTagValue;
+	int32 TagIndex;
+	if(FTagFragment* TagFragment = FindFragment<FTagFragment>(ParentComponent->ContainerSettings[Container.ContainerIndex].ContainerFragments))
+	{
+		if(UFL_InventoryFramework::DoesTagValuesHaveTag(TagFragment->TagValues, Tag, FoundTagValue, TagIndex))
+		{
+			TagFragment->TagValues.RemoveAt(TagIndex);
+			ParentComponent->MarkContainerDirty(Container.UniqueID.IdentityNumber);
+			ParentComponent->ContainerTagValueUpdated.Broadcast(Container, FoundTagValue, FoundTagValue.Value * -1);
+			UFL_ExternalObjects::BroadcastTagValueUpdated(FoundTagValue, true, FoundTagValue.Value * -1, FS_InventoryItem(), Container);
+		}
+	}
+}
+
+bool UAC_Inventory::CanTagValueBeRemovedFromContainer_Implementation(FGameplayTag Tag,
+	FS_ContainerSettings Container)
+{
+	return true;
+}
+
+TArray<FS_ContainerSettings> UAC_Inventory::GetContainersByTag(FGameplayTag Tag)
+{
+	TArray<FS_ContainerSettings> FoundContainers;
+	
+	for(auto& CurrentContainer : ContainerSettings)
+	{
+		if(UFL_InventoryFramework::GetContainersTags(CurrentContainer).HasTagExact(Tag))
+		{
+			FoundContainers.Add(CurrentContainer);
+		}
+	}
+
+	return FoundContainers;
+}
+
+TArray<FS_ContainerSettings> UAC_Inventory::GetContainersByTagValue(FGameplayTag Tag)
+{
+	TArray<FS_ContainerSettings> FoundContainers;
+	
+	for(auto& CurrentContainer : ContainerSettings)
+	{
+		FS_TagValue FoundTagValue;
+		int32 TagIndex;
+		if(UFL_InventoryFramework::DoesTagValuesHaveTag(UFL_InventoryFramework::GetContainersTagValues(CurrentContainer), Tag, FoundTagValue, TagIndex))
+		{
+			FoundContainers.Add(CurrentContainer);
+		}
+	}
+
+	return FoundContainers;
+}
+
+TArray<FS_ContainerSettings> UAC_Inventory::GetContainersByTagQuery(FGameplayTagQuery TagQuery)
+{
+	TArray<FS_ContainerSettings> FoundContainers;
+	if(TagQuery.IsEmpty())
+	{
+		return FoundContainers;
+	}
+
+	for(auto& CurrentContainer : ContainerSettings)
+	{
+		if(TagQuery.Matches(UFL_InventoryFramework::GetContainersTags(CurrentContainer)))
+		{
+			FoundContainers.Add(CurrentContainer);
+		}
+	}
+
+	return FoundContainers;
+}
+
+TArray<FS_ContainerSettings> UAC_Inventory::GetContainersByType(TEnumAsByte<EContainerType> ContainerType)
+{
+	TArray<FS_ContainerSettings> FoundContainers;
+
+	for(auto& CurrentContainer : ContainerSettings)
+	{
+		if(CurrentContainer.ContainerType == ContainerType)
+		{
+			FoundContainers.Add(CurrentContainer);
+		}
+	}
+	
+	return FoundContainers;
+}
+
+FS_UniqueID UAC_Inventory::GenerateUniqueID()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE("GenerateUniqueID")
+	FS_UniqueID GeneratedUniqueID;
+	
+	if(!GetOwner()->HasAuthority())
+	{
+		return GeneratedUniqueID;
+	}
+	
+	const int32 RandomInt = UKismetMathLibrary::RandomIntegerInRange(1, 2147483647);
+	
+	GeneratedUniqueID.IdentityNumber = RandomInt;
+	GeneratedUniqueID.ParentComponent = this;
+
+	if(IsUniqueIDInUse(GeneratedUniqueID))
+	{
+		GeneratedUniqueID = GenerateUniqueID();
+	}
+
+	return GeneratedUniqueID;
+}
+
+FS_UniqueID UAC_Inventory::GenerateUniqueIDWithSeed(FRandomStream Seed)
+{
+	FS_UniqueID GeneratedUniqueID;
+	
+	const int32 RandomInt = UKismetMathLibrary::RandomIntegerInRangeFromStream(Seed, 1, 2147483647);
+	
+	GeneratedUniqueID.IdentityNumber = RandomInt;
+	GeneratedUniqueID.ParentComponent = this;
+
+	if(IsUniqueIDInUse(GeneratedUniqueID))
+	{
+		FRandomStream NewSeed;
+		NewSeed.Initialize(Seed.GetInitialSeed() + 1);
+		GeneratedUniqueID = GenerateUniqueIDWithSeed(NewSeed);
+	}
+	
+	return GeneratedUniqueID;
+}
+
+bool UAC_Inventory::IsUniqueIDInUse(FS_UniqueID UniqueID)
+{
+	if(!UFL_InventoryFramework::IsUniqueIDValid(UniqueID))
+	{
+		return false;
+	}
+	
+	for(auto& CurrentContainer : ContainerSettings)
+	{
+		if(CurrentContainer.UniqueID == UniqueID)
+		{
+			return true;
+		}
+
+		for(auto& CurrentItem : CurrentContainer.Items)
+		{
+			if(CurrentItem.UniqueID == UniqueID)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void UAC_Inventory::AddTagsToComponent(const FGameplayTagContainer Tags, bool Broadcast)
+{
+	S_AddTagsToComponent(Tags);
+}
+
+void UAC_Inventory::S_AddTagsToComponent_Implementation(FGameplayTagContainer Tags, bool Broadcast)
+{
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AddTagsToComponent_Implementation(Tags, Broadcast); }))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
+	WakeNetDormancy();
+
+	for(auto& CurrentTag : Tags)
+	{
+		if(!TagsContainer.HasTagExact(CurrentTag))
+		{
+			TagsContainer.AddTag(CurrentTag);
+			MARK_PROPERTY_DIRTY_FROM_NAME(UAC_Inventory, TagsContainer, this);
+			if(Broadcast)
+			{
+				ComponentTagAdded.Broadcast(CurrentTag);
+			}
+		}
+	}
+
+	if(Broadcast)
+	{
+		MC_TagsAddedToComponent(Tags);
+	}
+}
+
+void UAC_Inventory::MC_TagsAddedToComponent_Implementation(FGameplayTagContainer Tags)
+{
+	if(!GetOwner()->HasAuthority())
+	{
+		for(auto& CurrentTag : Tags)
+		{
+			ComponentTagAdded.Broadcast(CurrentTag);
+		}
+	}
+}
+
+void UAC_Inventory::RemoveTagsFromComponent(const FGameplayTagContainer Tags, bool Broadcast)
+{
+	S_RemoveTagsFromComponent(Tags);
+}
+
+void UAC_Inventory::SetTagValueForComponent(const FS_TagValue TagValue, bool AddIfNotFound,
+                                            const TSubclassOf<UO_TagValueCalculation> CalculationClass, const bool Broadcast)
+{
+	S_SetTagValueForComponent(TagValue, AddIfNotFound, CalculationClass, Broadcast);
+}
+
+float UAC_Inventory::PreComponentTagValueCalculation(FS_TagValue TagValue, UAC_Inventory* Component,
+	TSubclassOf<UO_TagValueCalculation> CalculationClass)
+{
+	if(!IsValid(CalculationClass))
+	{
+		return TagValue.Value;
+	}
+	
+	UO_TagValueCalculation* Calculator = Cast<UO_TagValueCalculation>(CalculationClass->GetDefaultObject());
+	return Calculator->CalculateComponentTagValue(TagValue, Component);
+}
+
+void UAC_Inventory::S_SetTagValueForComponent_Implementation(FS_TagValue TagValue, bool AddIfNotFound,
+                                                             TSubclassOf<UO_TagValueCalculation> CalculationClass, bool Broadcast)
+{
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_SetTagValueForComponent_Implementation(TagValue, AddIfNotFound, CalculationClass, Broadcast); },
+		{CalculationClass.Get()}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
+	WakeNetDormancy();
+
+	float OldValue = 0;
+	const int32 TagValueIndex = ComponentTagValues.FindTagValueIndex(TagValue.Tag);
+	if(ComponentTagValues.Items.IsValidIndex(TagValueIndex))
+	{
+		OldValue = ComponentTagValues.Items[TagValueIndex].TagValue.Value;
+		if(IsValid(CalculationClass))
+		{
+			TagValue.Value = PreComponentTagValueCalculation(TagValue, this, CalculationClass);
+			UO_TagValueCalculation* Calculator = Cast<UO_TagValueCalculation>(CalculationClass.GetDefaultObject());
+			if(IsValid(Calculator))
+			{
+				//Find out if the new value has hit some sort of threshold or limit.
+				if(Calculator->ShouldValueBeRemovedFromComponent(TagValue, this))
+				{
+					//New value has hit some sort of defined limit and should be removed,
+					//cancel this function and start removing the tag.
+					ComponentTagValues.RemoveTagValue(TagValue.Tag);
+					MARK_PROPERTY_DIRTY_FROM_NAME(UAC_Inventory, ComponentTagValues, this);
+					MC_TagValueRemovedFromComponent(TagValue);
+					return;
+				}
+			}
+		}
+
+		ComponentTagValues.SetTagValue(TagValue);
+	}
+	else
+	{
+		if(AddIfNotFound)
+		{
+			ComponentTagValues.SetTagValue(TagValue);
+		}
+		else
+		{
+			return;
+		}
+	}
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(UAC_Inventory, ComponentTagValues, this);
+
+	if(Broadcast)
+	{
+		MC_TagValueUpdatedForComponent(TagValue, OldValue);
+	}
+}
+
+void UAC_Inventory::MC_TagValueUpdatedForComponent_Implementation(FS_TagValue TagValue, float OldValue)
+{
+	ComponentTagValueUpdated.Broadcast(TagValue, OldValue);
+}
+
+void UAC_Inventory::RemoveTagValueFromComponent(const FGameplayTag TagValue, bool Broadcast)
+{
+	S_RemoveTagValueFromComponent(TagValue, Broadcast);
+}
+
+void UAC_Inventory::S_RemoveTagValueFromComponent_Implementation(FGameplayTag TagValue, bool Broadcast)
+{
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveTagValueFromComponent_Implementation(TagValue, Broadcast); }))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
+	WakeNetDormancy();
+
+	const int32 TagValueIndex = ComponentTagValues.FindTagValueIndex(TagValue);
+	if(ComponentTagValues.Items.IsValidIndex(TagValueIndex))
+	{
+		const FS_TagValue FoundTagValue = ComponentTagValues.Items[TagValueIndex].TagValue;
+		ComponentTagValues.RemoveTagValue(TagValue);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UAC_Inventory, ComponentTagValues, this);
+		if(Broadcast)
+		{
+			MC_TagValueRemovedFromComponent(FoundTagValue);
+		}
+	}
+}
+
+void UAC_Inventory::MC_TagValueRemovedFromComponent_Implementation(FS_TagValue TagValue)
+{
+	ComponentTagValueRemoved.Broadcast(TagValue);
+}
+
+TArray<FS_TagValue> UAC_Inventory::GetComponentTagValues() const
+{
+	return ComponentTagValues.GetTagValues();
+}
+
+void UAC_Inventory::C_SetClientReceivedContainerData_Implementation(UAC_Inventory* OtherComponent, bool HasReceived)
+{
+	OtherComponent->ClientReceivedContainerData = HasReceived;
+}
+
+void UAC_Inventory::S_RemoveTagsFromComponent_Implementation(FGameplayTagContainer Tags, bool Broadcast)
+{
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RemoveTagsFromComponent_Implementation(Tags, Broadcast); }))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
+	WakeNetDormancy();
+
+	//Append the two tag containers and call the TagsModified delegate on the way. - V
+	for(auto& CurrentTag : Tags)
+	{
+		if(TagsContainer.HasTagExact(CurrentTag))
+		{
+			TagsContainer.RemoveTag(CurrentTag);
+			MARK_PROPERTY_DIRTY_FROM_NAME(UAC_Inventory, TagsContainer, this);
+			if(Broadcast)
+			{
+				ComponentTagRemoved.Broadcast(CurrentTag);
+			}
+		}
+	}
+
+	if(Broadcast)
+	{
+		MC_TagsRemovedFromComponent(Tags);
+	}
+}
+
+void UAC_Inventory::MC_TagsRemovedFromComponent_Implementation(FGameplayTagContainer Tags)
+{
+	if(!GetOwner()->HasAuthority())
+	{
+		for(auto& CurrentTag : Tags)
+		{
+			ComponentTagRemoved.Broadcast(CurrentTag);
+		}
+	}
+}
+
+void UAC_Inventory::S_AddListener_Implementation(UAC_Inventory* Component)
+{
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_AddListener_Implementation(Component); },
+		{Component}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
+	Listeners.AddUnique(Component);
+	WakeNetDormancy();
+	RefreshContainerHashTimer();
+}
+
+void UAC_Inventory::C_RequestServerDataFromOtherComponent_Implementation(UAC_Inventory* OtherComponent, bool CallDataReceived)
+{
+	if(!IsValid(OtherComponent))
+	{
+		return;
+	}
+	
+	if(IsValid(GetOwner()->GetInstigatorController()))
+	{
+		if(GetOwner()->GetInstigatorController()->IsLocalPlayerController())
+		{
+			if(!OtherComponent->ClientReceivedContainerData)
+			{
+				S_SendDataFromOtherComponent(OtherComponent, CallDataReceived);
+
+				//Both Send and Receive RPC's are reliable, it's safe
+				//to assume we'll receive the container data "eventually".
+				//This prevents the server RPC from being spammed.
+				OtherComponent->ClientReceivedContainerData = true;
+			}
+			else
+			{
+				if(CallDataReceived)
+				{
+					OnDataReceivedFromOtherComponent(OtherComponent);
+				}
+			}
+		}
+	}
+}
+
+void UAC_Inventory::S_SendDataFromOtherComponent_Implementation(UAC_Inventory* OtherComponent, bool CallDataReceived)
+{
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_SendDataFromOtherComponent_Implementation(OtherComponent, CallDataReceived); },
+		{OtherComponent}))
+	{
+		return;
+	}
+	const FRPCBudgetScope BudgetScope(this);
+
+	if(!OtherComponent)
+	{
+		return;
+	}
+	
+	const bool CallComponentStarted = !Initialized;
+	
+	if(OtherComponent->Initialized)
+	{
+		OtherComponent->C_RequestServerContainerData(false);
+	}
+	else
+	{
+		OtherComponent->StartComponent();
+	}
+	
+	OtherComponent->S_AddListener(this);
+
+	//Wipe the tile map before sending it to the clients.
+	//This results in much smaller RPC's (around 20% on average)
+	//and generating it takes very little CPU time.
+	TArray<FS_ContainerSettings> TempContainers = OtherComponent->ContainerSettings;
+	for(auto& CurrentContainer : TempContainers)
+	{
+		CurrentContainer.TileMap.Empty();
+	}
+	
+	C_ReceiveDataFromOtherComponent(OtherComponent, TempContainers, CallDataReceived, CallComponentStarted);
+}
+
+void UAC_Inventory::C_ReceiveDataFromOtherComponent_Implementation(UAC_Inventory* OtherComponent, const TArray<FS_ContainerSettings> &Containers, bool CallDataReceived, bool CallComponentStarted)
+{
+	if(!OtherComponent)
+	{
+		return;
+	}
+	
+	OtherComponent->ContainerSettings = Containers;
+	
+	//Clients receive container settings with no tile map, rebuild them.
+	for(auto& CurrentContainer : OtherComponent->ContainerSettings)
+	{
+		OtherComponent->RebuildTileMap(CurrentContainer);
+	}
+
+	OtherComponent->RefreshIDMap();
+	OtherComponent->RebuildContainerStateHashes();
+	
+	OtherComponent->Initialized = true;
+	
+	if(CallComponentStarted)
+	{
+		OtherComponent->ComponentStarted.Broadcast();
+	}
+	
+	if(CallDataReceived)
+	{
+		OnDataReceivedFromOtherComponent(OtherComponent);
+	}
+}
+
+void UAC_Inventory::C_AddItemToNetworkQueue_Implementation(FS_UniqueID ItemID)
+{
+	if(UKismetSystemLibrary::IsStandalone(this) || UKismetSystemLibrary::IsServer(this))
+	{
+		return;
+	}
+	
+	if(IsValid(ItemID.ParentComponent))
+	{
+		ItemID.ParentComponent->Internal_AddToNetworkQueue(ItemID);
+	}
+}
+
+void UAC_Inventory::C_RemoveItemFromNetworkQueue_Implementation(FS_UniqueID ItemID)
+{
+	if(UKismetSystemLibrary::IsStandalone(this) || UKismetSystemLibrary::IsServer(this))
+	{
+		return;
+	}
+	if(IsValid(ItemID.ParentComponent))
+	{
+		ItemID.ParentComponent->Internal_RemoveFromNetworkQueue(ItemID);
+	}
+}
+
+
+TFunction<void()> UAC_Inventory::MakeRejectedRequest(const TArray<FS_UniqueID>& ItemIDs, int32 PredictionID)
+{
+	TArray<TPair<TWeakObjectPtr<UAC_Inventory>, int32>> WeakItemIDs;
+	WeakItemIDs.Reserve(ItemIDs.Num());
+	for(const FS_UniqueID& CurrentID : ItemIDs)
+	{
+		if(CurrentID.IsValid())
+		{
+			WeakItemIDs.Emplace(CurrentID.ParentComponent.Get(), CurrentID.IdentityNumber);
+		}
+	}
+
+	return [WeakThis = TWeakObjectPtr<UAC_Inventory>(this), WeakItemIDs, PredictionID]()
+	{
+		UAC_Inventory* Requester = WeakThis.Get();
+		if(!Requester)
+		{
+			return;
+		}
+
+		for(const TPair<TWeakObjectPtr<UAC_Inventory>, int32>& CurrentID : WeakItemIDs)
+		{
+			if(UAC_Inventory* ParentComponent = CurrentID.Key.Get())
+			{
+				Requester->C_RemoveItemFromNetworkQueue(FS_UniqueID(CurrentID.Value, ParentComponent));
+			}
+		}
+
+		if(PredictionID > 0)
+		{
+			Requester->C_RejectPrediction(PredictionID);
+		}
+	};
+}
+
+void UAC_Inventory::C_AddAllContainerItemsToNetworkQueue_Implementation(FS_UniqueID ContainerID)
+{
+	FS_ContainerSettings FoundContainer = GetContainerByUniqueID(ContainerID);
+	if(!FoundContainer.IsValid() || FoundContainer.Items.IsEmpty())
+	{
+		return;
+	}
+
+	//Add the container to the network queue.
+	//The container should not be interactable in any way while
+	//it is in the queue.
+	ContainerID.ParentComponent->Internal_AddToNetworkQueue(ContainerID);
+	for(auto& CurrentItem : FoundContainer.Items)
+	{
+		C_AddItemToNetworkQueue(CurrentItem.UniqueID);
+	}
+}
+
+void UAC_Inventory::C_RemoveAllContainerItemsFromNetworkQueue_Implementation(FS_UniqueID ContainerID)
+{
+	FS_ContainerSettings FoundContainer = GetContainerByUniqueID(ContainerID);
+
+	if(!FoundContainer.IsValid() || FoundContainer.Items.IsEmpty())
+	{
+		return;
+	}
+
+	for(auto& CurrentItem : FoundContainer.Items)
+	{
+		C_RemoveItemFromNetworkQueue(CurrentItem.UniqueID);
+	}
+}
+
+void UAC_Inventory::Internal_AddToNetworkQueue(FS_UniqueID ItemID)
+{
+	if(NetworkQueue.Contains(ItemID))
+	{
+		return;
+	}
+
+	NetworkQueue.Add(ItemID, FPlatformTime::Seconds());
+
+	FS_InventoryItem FoundItem = GetItemByUniqueID(ItemID);
+	if(FoundItem.IsValid())
+	{
+		UW_InventoryItem* ItemWidget = UFL_InventoryFramework::GetWidgetForItem(FoundItem);
+		ItemAddedToNetworkQueue(FoundItem, ItemWidget);
+		if(ItemWidget)
+		{
+			ItemWidget->ParentItemAddedToNetworkQueue();
 		}
 	}
-	else
+
+	//Start sweeping for entries the server never answered.
+	const float Timeout = UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->NetworkQueueTimeout;
+	if(Timeout > 0 && GetWorld() && !GetWorld()->GetTimerManager().IsTimerActive(NetworkQueueEvictionTimer))
 	{
-		Internal_RemoveTagValueFromContainer(OriginalContainer, Tag);
-		C_RemoveTagValueFromContainer(ContainerID, Tag);
+		GetWorld()->GetTimerManager().SetTimer(NetworkQueueEvictionTimer, this, &UAC_Inventory::EvictExpiredNetworkQueueEntries,
+			FMath::Max(Timeout * 0.5f, 0.25f), true);
+	}
+}
+
+void UAC_Inventory::Internal_RemoveFromNetworkQueue(FS_UniqueID ItemID)
+{
+	if(NetworkQueue.Remove(ItemID) == 0)
+	{
+		return;
 	}
 	
-	for(const auto& CurrentListener : ContainerID.ParentComponent->Listeners)
+	FS_InventoryItem FoundItem = GetItemByUniqueID(ItemID);
+	if(FoundItem.IsValid())
 	{
-		//Update all clients that are currently listening to this component's replication calls.
-		if(CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy && CurrentListener != this)
+		UW_InventoryItem* ItemWidget = UFL_InventoryFramework::GetWidgetForItem(FoundItem);
+		ItemRemovedFromNetworkQueue(FoundItem, ItemWidget);
+		if(ItemWidget)
 		{
-			CurrentListener->C_RemoveTagValueFromContainer(ContainerID, Tag);
+			ItemWidget->ParentItemRemovedFromNetworkQueue();
 		}
 	}
+
+	if(NetworkQueue.IsEmpty() && GetWorld())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(NetworkQueueEvictionTimer);
+	}
 }
 
-bool UAC_Inventory::S_RemoveTagValueFromContainer_Validate(FS_UniqueID ContainerID, FGameplayTag Tag, ENetRole CallerLocalRole)
+bool UAC_Inventory::IsItemInNetworkQueue(FS_UniqueID ItemID) const
 {
-	return true;
+	return NetworkQueue.Contains(ItemID);
 }
 
-void UAC_Inventory::C_RemoveTagValueFromContainer_Implementation(FS_UniqueID ContainerID, FGameplayTag Tag)
+TArray<FS_UniqueID> UAC_Inventory::GetNetworkQueue() const
 {
-	if(UKismetSystemLibrary::IsServer(this))
+	TArray<FS_UniqueID> QueuedIDs;
+	NetworkQueue.GenerateKeyArray(QueuedIDs);
+	return QueuedIDs;
+}
+
+void UAC_Inventory::EvictExpiredNetworkQueueEntries()
+{
+	const float Timeout = UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->NetworkQueueTimeout;
+	if(Timeout <= 0)
 	{
 		return;
 	}
 	
-	FS_ContainerSettings OriginalContainer = ContainerID.ParentComponent->GetContainerByUniqueID(ContainerID);
-	if(OriginalContainer.IsValid())
+	const double CurrentTime = FPlatformTime::Seconds();
+	TArray<FS_UniqueID> ExpiredEntries;
+	for(auto& CurrentEntry : NetworkQueue)
 	{
-		Internal_RemoveTagValueFromContainer(OriginalContainer, Tag);
+		if(CurrentTime - CurrentEntry.Value >= Timeout)
+		{
+			ExpiredEntries.Add(CurrentEntry.Key);
+		}
 	}
-}
 
-void UAC_Inventory::Internal_RemoveTagValueFromContainer(FS_ContainerSettings Container, FGameplayTag Tag)
-{
-	UAC_Inventory* ParentComponent = Container.UniqueID.ParentComponent;
-	
-	if(!IsValid(ParentComponent))
+	for(auto& CurrentEntry : ExpiredEntries)
 	{
-		return;
+		NetworkQueueEvictions++;
+		Internal_RemoveFromNetworkQueue(CurrentEntry);
 	}
 
-	FS_TagValue FoundTagValue;
-	int32 TagIndex;
-	if(FTagFragment* TagFragment = FindFragment<FTagFragment>(ParentComponent->ContainerSettings[Container.ContainerIndex].ContainerFragments))
+	if(ExpiredEntries.IsValidIndex(0))
 	{
-		if(UFL_InventoryFramework::DoesTagValuesHaveTag(TagFragment->TagValues, Tag, FoundTagValue, TagIndex))
-		{
-			TagFragment->TagValues.RemoveAt(TagIndex);
-			ParentComponent->ContainerTagValueUpdated.Broadcast(Container, FoundTagValue, FoundTagValue.Value * -1);
-			UFL_ExternalObjects::BroadcastTagValueUpdated(FoundTagValue, true, FoundTagValue.Value * -1, FS_InventoryItem(), Container);
-		}
+		UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Evicted %d entries from the network queue after waiting %.1f seconds for the server - AC_Inventory.cpp -> EvictExpiredNetworkQueueEntries"),
+			ExpiredEntries.Num(), Timeout), true, false);
 	}
 }
 
-bool UAC_Inventory::CanTagValueBeRemovedFromContainer_Implementation(FGameplayTag Tag,
-	FS_ContainerSettings Container)
+int32 UAC_Inventory::BeginPrediction(TArray<UAC_Inventory*> Components)
 {
-	return true;
-}
+	FS_PredictedOperation NewPrediction;
+	LastPredictionID++;
+	NewPrediction.PredictionID = LastPredictionID;
 
-TArray<FS_ContainerSettings> UAC_Inventory::GetContainersByTag(FGameplayTag Tag)
-{
-	TArray<FS_ContainerSettings> FoundContainers;
-	
-	for(auto& CurrentContainer : ContainerSettings)
+	for(auto& CurrentComponent : Components)
 	{
-		if(UFL_InventoryFramework::GetContainersTags(CurrentContainer).HasTagExact(Tag))
+		if(!IsValid(CurrentComponent))
 		{
-			FoundContainers.Add(CurrentContainer);
+			continue;
+		}
+
+		//From and To component are often the same component.
+		bool AlreadyCaptured = false;
+		for(auto& CurrentSnapshot : NewPrediction.Snapshots)
+		{
+			if(CurrentSnapshot.Component == CurrentComponent)
+			{
+				AlreadyCaptured = true;
+				break;
+			}
+		}
+
+		if(AlreadyCaptured)
+		{
+			continue;
+		}
+
+		FS_PredictionSnapshot NewSnapshot;
+		NewSnapshot.Component = CurrentComponent;
+		NewSnapshot.Containers = CurrentComponent->ContainerSettings;
+
+		//These belong to the live data, RestorePredictionSnapshot takes them from there.
+		for(auto& CurrentContainer : NewSnapshot.Containers)
+		{
+			CurrentContainer.Widget = nullptr;
+			CurrentContainer.ExternalObjects.Empty();
+			for(auto& CurrentItem : CurrentContainer.Items)
+			{
+				CurrentItem.Widget = nullptr;
+				CurrentItem.ItemComponents.Empty();
+				CurrentItem.ExternalObjects.Empty();
+			}
 		}
+		NewPrediction.Snapshots.Add(MoveTemp(NewSnapshot));
 	}
 
-	return FoundContainers;
+	PendingPredictions.Add(NewPrediction.PredictionID, NewPrediction);
+	return NewPrediction.PredictionID;
 }
 
-TArray<FS_ContainerSettings> UAC_Inventory::GetContainersByTagValue(FGameplayTag Tag)
+void UAC_Inventory::ConfirmPrediction(int32 PredictionID, TArray<UAC_Inventory*> Components)
 {
-	TArray<FS_ContainerSettings> FoundContainers;
-	
-	for(auto& CurrentContainer : ContainerSettings)
+	TArray<UAC_Inventory*> ConfirmedComponents;
+	TArray<int32> ComponentHashes;
+	for(auto& CurrentComponent : Components)
 	{
-		FS_TagValue FoundTagValue;
-		int32 TagIndex;
-		if(UFL_InventoryFramework::DoesTagValuesHaveTag(UFL_InventoryFramework::GetContainersTagValues(CurrentContainer), Tag, FoundTagValue, TagIndex))
+		if(IsValid(CurrentComponent) && !ConfirmedComponents.Contains(CurrentComponent))
 		{
-			FoundContainers.Add(CurrentContainer);
+			ConfirmedComponents.Add(CurrentComponent);
+			ComponentHashes.Add(static_cast<int32>(CurrentComponent->ComponentStateHash));
 		}
 	}
 
-	return FoundContainers;
+	C_ConfirmPrediction(PredictionID, OperationSequence, ConfirmedComponents, ComponentHashes);
 }
 
-TArray<FS_ContainerSettings> UAC_Inventory::GetContainersByTagQuery(FGameplayTagQuery TagQuery)
+void UAC_Inventory::C_ConfirmPrediction_Implementation(int32 PredictionID, int32 Sequence, const TArray<UAC_Inventory*>& Components, const TArray<int32>& ComponentHashes)
 {
-	TArray<FS_ContainerSettings> FoundContainers;
-	if(TagQuery.IsEmpty())
+	if(!PendingPredictions.Remove(PredictionID))
 	{
-		return FoundContainers;
+		return;
 	}
 
-	for(auto& CurrentContainer : ContainerSettings)
+	//Every prediction still waiting was made after this one and has already claimed its sequence.
+	int32 LaterPredictions = 0;
+	for(auto& CurrentPrediction : PendingPredictions)
 	{
-		if(TagQuery.Matches(UFL_InventoryFramework::GetContainersTags(CurrentContainer)))
+		if(CurrentPrediction.Key > PredictionID)
 		{
-			FoundContainers.Add(CurrentContainer);
+			LaterPredictions++;
 		}
 	}
+	OperationSequence = Sequence + LaterPredictions;
 
-	return FoundContainers;
-}
-
-TArray<FS_ContainerSettings> UAC_Inventory::GetContainersByType(TEnumAsByte<EContainerType> ContainerType)
-{
-	TArray<FS_ContainerSettings> FoundContainers;
+	//Later predictions are still applied on top of this one, their confirmation checks the final state.
+	if(LaterPredictions > 0)
+	{
+		return;
+	}
 
-	for(auto& CurrentContainer : ContainerSettings)
+	for(int32 CurrentIndex = 0; CurrentIndex < Components.Num() && ComponentHashes.IsValidIndex(CurrentIndex); CurrentIndex++)
 	{
-		if(CurrentContainer.ContainerType == ContainerType)
+		UAC_Inventory* CurrentComponent = Components[CurrentIndex];
+		if(!IsValid(CurrentComponent) || !CurrentComponent->NetworkQueue.IsEmpty())
 		{
-			FoundContainers.Add(CurrentContainer);
+			continue;
+		}
+
+		if(static_cast<int32>(CurrentComponent->ComponentStateHash) != ComponentHashes[CurrentIndex])
+		{
+			UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Predicted operation %d ended up different on the server, resyncing %s - AC_Inventory.cpp -> C_ConfirmPrediction"),
+				PredictionID, *GetNameSafe(CurrentComponent->GetOwner())), true, false);
+			RequestComponentResync(CurrentComponent);
 		}
 	}
-	
-	return FoundContainers;
 }
 
-FS_UniqueID UAC_Inventory::GenerateUniqueID()
+void UAC_Inventory::C_RejectPrediction_Implementation(int32 PredictionID)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE("GenerateUniqueID")
-	FS_UniqueID GeneratedUniqueID;
-	
-	if(!GetOwner()->HasAuthority())
+	FS_PredictedOperation RejectedPrediction;
+	if(!PendingPredictions.RemoveAndCopyValue(PredictionID, RejectedPrediction))
 	{
-		return GeneratedUniqueID;
+		return;
 	}
-	
-	const int32 RandomInt = UKismetMathLibrary::RandomIntegerInRange(1, 2147483647);
-	
-	GeneratedUniqueID.IdentityNumber = RandomInt;
-	GeneratedUniqueID.ParentComponent = this;
 
-	if(IsUniqueIDInUse(GeneratedUniqueID))
+	UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Server rejected predicted operation %d, rolling back - AC_Inventory.cpp -> C_RejectPrediction"), PredictionID), true, false);
+
+	TArray<UAC_Inventory*> AffectedComponents;
+	for(auto& CurrentSnapshot : RejectedPrediction.Snapshots)
 	{
-		GeneratedUniqueID = GenerateUniqueID();
+		UAC_Inventory* SnapshotComponent = CurrentSnapshot.Component;
+		if(!IsValid(SnapshotComponent))
+		{
+			continue;
+		}
+
+		SnapshotComponent->RestorePredictionSnapshot(CurrentSnapshot.Containers);
+		AffectedComponents.AddUnique(SnapshotComponent);
 	}
 
-	return GeneratedUniqueID;
-}
+	/**Anything predicted after the rejected operation was built on top of it.
+	 * The server might still accept those, so neither our snapshot nor our
+	 * current data can be trusted anymore. Drop them as well.*/
+	TArray<int32> LaterPredictions;
+	for(auto& CurrentPrediction : PendingPredictions)
+	{
+		if(CurrentPrediction.Key > PredictionID)
+		{
+			LaterPredictions.Add(CurrentPrediction.Key);
+			for(auto& CurrentSnapshot : CurrentPrediction.Value.Snapshots)
+			{
+				if(IsValid(CurrentSnapshot.Component))
+				{
+					AffectedComponents.AddUnique(CurrentSnapshot.Component);
+				}
+			}
+		}
+	}
 
-FS_UniqueID UAC_Inventory::GenerateUniqueIDWithSeed(FRandomStream Seed)
-{
-	FS_UniqueID GeneratedUniqueID;
-	
-	const int32 RandomInt = UKismetMathLibrary::RandomIntegerInRangeFromStream(Seed, 1, 2147483647);
-	
-	GeneratedUniqueID.IdentityNumber = RandomInt;
-	GeneratedUniqueID.ParentComponent = this;
+	for(const int32 CurrentPredictionID : LaterPredictions)
+	{
+		PendingPredictions.Remove(CurrentPredictionID);
+	}
 
-	if(IsUniqueIDInUse(GeneratedUniqueID))
+	/**The snapshot overwrote anything the server replicated to these
+	 * components after the prediction was made, such as changes made
+	 * by other listeners. Always get the servers version.*/
+	for(auto& CurrentComponent : AffectedComponents)
 	{
-		FRandomStream NewSeed;
-		NewSeed.Initialize(Seed.GetInitialSeed() + 1);
-		GeneratedUniqueID = GenerateUniqueIDWithSeed(NewSeed);
+		RequestComponentResync(CurrentComponent);
 	}
-	
-	return GeneratedUniqueID;
+
+	PredictionRejected.Broadcast(PredictionID);
 }
 
-bool UAC_Inventory::IsUniqueIDInUse(FS_UniqueID UniqueID)
+void UAC_Inventory::RestorePredictionSnapshot(const TArray<FS_ContainerSettings>& Containers)
 {
-	if(!UFL_InventoryFramework::IsUniqueIDValid(UniqueID))
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::RestorePredictionSnapshot)
+
+	//The prediction might have moved items between containers, so look them up by ID.
+	TMap<int32, const FS_InventoryItem*> LiveItems;
+	TMap<int32, const FS_ContainerSettings*> LiveContainers;
+	for(const FS_ContainerSettings& CurrentContainer : ContainerSettings)
 	{
-		return false;
+		LiveContainers.Add(CurrentContainer.UniqueID.IdentityNumber, &CurrentContainer);
+		for(const FS_InventoryItem& CurrentItem : CurrentContainer.Items)
+		{
+			LiveItems.Add(CurrentItem.UniqueID.IdentityNumber, &CurrentItem);
+		}
 	}
-	
-	for(auto& CurrentContainer : ContainerSettings)
+
+	TArray<FS_ContainerSettings> RestoredContainers = Containers;
+	for(FS_ContainerSettings& CurrentContainer : RestoredContainers)
 	{
-		if(CurrentContainer.UniqueID == UniqueID)
+		CurrentContainer.UniqueID.ParentComponent = this;
+		if(const FS_ContainerSettings* const* LiveContainer = LiveContainers.Find(CurrentContainer.UniqueID.IdentityNumber))
 		{
-			return true;
+			CurrentContainer.Widget = (*LiveContainer)->Widget;
+			CurrentContainer.ExternalObjects = (*LiveContainer)->ExternalObjects;
 		}
 
-		for(auto& CurrentItem : CurrentContainer.Items)
+		for(FS_InventoryItem& CurrentItem : CurrentContainer.Items)
 		{
-			if(CurrentItem.UniqueID == UniqueID)
+			CurrentItem.UniqueID.ParentComponent = this;
+			if(const FS_InventoryItem* const* LiveItem = LiveItems.Find(CurrentItem.UniqueID.IdentityNumber))
 			{
-				return true;
+				CurrentItem.ItemInstance = (*LiveItem)->ItemInstance;
+				CurrentItem.ItemComponents = (*LiveItem)->ItemComponents;
+				CurrentItem.ExternalObjects = (*LiveItem)->ExternalObjects;
+			}
+			else if(!IsValid(CurrentItem.ItemInstance))
+			{
+				//Removed by the prediction and destroyed since, don't bring it back.
+				CurrentItem.ItemInstance = nullptr;
 			}
 		}
 	}
 
-	return false;
+	//Snapshot still has its tile map, only the ID map has to be regenerated.
+	ContainerSettings = MoveTemp(RestoredContainers);
+	RefreshIDMap();
+	RebuildContainerStateHashes();
+
+	//Item widgets were not part of the snapshot, let the container widgets create them again.
+	for(const FS_ContainerSettings& CurrentContainer : ContainerSettings)
+	{
+		if(IsValid(CurrentContainer.Widget))
+		{
+			CurrentContainer.Widget->ConstructContainers(CurrentContainer, this, true);
+		}
+	}
 }
 
-void UAC_Inventory::AddTagsToComponent(const FGameplayTagContainer Tags, bool Broadcast)
+void UAC_Inventory::RequestComponentResync(UAC_Inventory* Component)
 {
-	S_AddTagsToComponent(Tags);
+	if(!IsValid(Component))
+	{
+		return;
+	}
+
+	if(Component == this)
+	{
+		S_SendContainerDataToClient(false);
+	}
+	else
+	{
+		S_SendDataFromOtherComponent(Component, false);
+	}
 }
 
-void UAC_Inventory::S_AddTagsToComponent_Implementation(FGameplayTagContainer Tags, bool Broadcast)
+FRandomStream UAC_Inventory::NextOperationSeed()
 {
-	for(auto& CurrentTag : Tags)
+	if(OperationSeedBase == 0)
 	{
-		if(!TagsContainer.HasTagExact(CurrentTag))
-		{
-			TagsContainer.AddTag(CurrentTag);
-			if(Broadcast)
-			{
-				ComponentTagAdded.Broadcast(CurrentTag);
-			}
-		}
+		OperationSeedBase = UKismetMathLibrary::RandomIntegerInRange(1, MAX_int32 - 1);
 	}
 
-	if(Broadcast)
+	return GetOperationSeed(OperationSeedBase, AdvanceOperationSequence());
+}
+
+FRandomStream UAC_Inventory::GetOperationSeed(int32 SeedBase, int32 Sequence)
+{
+	/**Seeds are ratcheted by +1 while an operation generates ID's,
+	 * so keep them within the same range the random seeds used to be in.*/
+	const uint32 Hash = HashCombineFast(static_cast<uint32>(SeedBase), GetTypeHash(Sequence));
+	return FRandomStream(1 + static_cast<int32>(Hash % 214748364));
+}
+
+int32 UAC_Inventory::AdvanceOperationSequence()
+{
+	OperationSequence++;
+	return OperationSequence;
+}
+
+FRandomStream UAC_Inventory::MakeOperationSeed(const TCHAR* Operation, int32 Sequence, const TArray<int32>& Values)
+{
+	//Names and values are hashed by content, pointers and FName indexes differ between machines.
+	uint32 Hash = HashCombineFast(FCrc::StrCrc32(Operation), GetTypeHash(Sequence));
+	for(const int32 CurrentValue : Values)
 	{
-		MC_TagsAddedToComponent(Tags);
+		Hash = HashCombineFast(Hash, GetTypeHash(CurrentValue));
 	}
+
+	return FRandomStream(1 + static_cast<int32>(Hash % 214748364));
 }
 
-void UAC_Inventory::MC_TagsAddedToComponent_Implementation(FGameplayTagContainer Tags)
+void UAC_Inventory::AdjustComponentStateHash(uint32 AddedHash, uint32 RemovedHash)
 {
-	if(!GetOwner()->HasAuthority())
+	ComponentStateHash += AddedHash - RemovedHash;
+}
+
+void UAC_Inventory::WakeNetDormancy()
+{
+	if(!CanManageNetDormancy())
 	{
-		for(auto& CurrentTag : Tags)
-		{
-			ComponentTagAdded.Broadcast(CurrentTag);
-		}
+		return;
+	}
+
+	AActor* Owner = GetOwner();
+	if(Owner->NetDormancy > DORM_Awake)
+	{
+		Owner->SetNetDormancy(DORM_Awake);
 	}
+
+	//Always restart the countdown, the component has to be idle for the whole delay.
+	GetWorld()->GetTimerManager().SetTimer(NetDormancyTimer, this, &UAC_Inventory::TryEnterNetDormancy, FMath::Max(NetDormancyDelay, 0.1f), false);
 }
 
-void UAC_Inventory::RemoveTagsFromComponent(const FGameplayTagContainer Tags, bool Broadcast)
+bool UAC_Inventory::CanManageNetDormancy() const
 {
-	S_RemoveTagsFromComponent(Tags);
+	if(!ManageNetDormancy || !GetWorld() || GetNetMode() == NM_Standalone)
+	{
+		return false;
+	}
+
+	const AActor* Owner = GetOwner();
+	if(!Owner || !Owner->HasAuthority() || !Owner->GetIsReplicated())
+	{
+		return false;
+	}
+
+	/**Anything owned by a player connection needs its client RPC's,
+	 * which can't be sent while the actor is dormant.*/
+	return Owner->GetNetConnection() == nullptr;
 }
 
-void UAC_Inventory::SetTagValueForComponent(const FS_TagValue TagValue, bool AddIfNotFound,
-                                            const TSubclassOf<UO_TagValueCalculation> CalculationClass, const bool Broadcast)
+void UAC_Inventory::TryEnterNetDormancy()
 {
-	S_SetTagValueForComponent(TagValue, AddIfNotFound, CalculationClass, Broadcast);
-}
+	if(!CanManageNetDormancy())
+	{
+		return;
+	}
+
+	//Listeners that were destroyed without removing themselves shouldn't keep us awake.
+	Listeners.RemoveAll([](const TObjectPtr<UAC_Inventory>& Listener)
+	{
+		return !IsValid(Listener);
+	});
 
-float UAC_Inventory::PreComponentTagValueCalculation(FS_TagValue TagValue, UAC_Inventory* Component,
-	TSubclassOf<UO_TagValueCalculation> CalculationClass)
-{
-	if(!IsValid(CalculationClass))
+	if(Listeners.IsValidIndex(0))
 	{
-		return TagValue.Value;
+		//Someone is still interacting with this component, check again later.
+		GetWorld()->GetTimerManager().SetTimer(NetDormancyTimer, this, &UAC_Inventory::TryEnterNetDormancy, FMath::Max(NetDormancyDelay, 0.1f), false);
+		return;
 	}
-	
-	UO_TagValueCalculation* Calculator = Cast<UO_TagValueCalculation>(CalculationClass->GetDefaultObject());
-	return Calculator->CalculateComponentTagValue(TagValue, Component);
+
+	GetOwner()->SetNetDormancy(DORM_DormantAll);
 }
 
-void UAC_Inventory::S_SetTagValueForComponent_Implementation(FS_TagValue TagValue, bool AddIfNotFound,
-                                                             TSubclassOf<UO_TagValueCalculation> CalculationClass, bool Broadcast)
+uint32 UAC_Inventory::GetItemStateHash(const FS_InventoryItem& Item)
 {
-	float OldValue = 0;
-	FS_TagValue FoundTagValue;
-	int32 TagValueIndex;
-	if(UFL_InventoryFramework::DoesTagValuesHaveTag(TagValuesContainer, TagValue.Tag, FoundTagValue, TagValueIndex))
+	uint32 Hash = GetTypeHash(Item.UniqueID.IdentityNumber);
+	Hash = HashCombineFast(Hash, Item.ItemAsset ? Item.ItemAsset->GetAssetPathHash() : GetTypeHash(FSoftObjectPath()));
+	Hash = HashCombineFast(Hash, GetTypeHash(Item.TileIndex));
+	Hash = HashCombineFast(Hash, GetTypeHash(static_cast<uint8>(Item.Rotation.GetValue())));
+	Hash = HashCombineFast(Hash, GetTypeHash(Item.Count));
+
+	for(const TInstancedStruct<FCoreFragment>& CurrentFragment : Item.ItemFragments)
 	{
-		OldValue = FoundTagValue.Value;
-		if(IsValid(CalculationClass))
+		if(const FTagFragment* TagFragment = CurrentFragment.GetPtr<FTagFragment>())
 		{
-			TagValue.Value = PreComponentTagValueCalculation(TagValue, this, CalculationClass);
-			UO_TagValueCalculation* Calculator = Cast<UO_TagValueCalculation>(CalculationClass.GetDefaultObject());
-			if(IsValid(Calculator))
+			//Tags are summed rather than combined so the order they were added in doesn't matter.
+			uint32 TagsHash = 0;
+			for(const FGameplayTag& CurrentTag : TagFragment->Tags)
 			{
-				//Find out if the new value has hit some sort of threshold or limit.
-				if(Calculator->ShouldValueBeRemovedFromComponent(TagValue, this))
-				{
-					//New value has hit some sort of defined limit and should be removed,
-					//cancel this function and start removing the tag.
-					TagValuesContainer.RemoveAt(TagValueIndex);
-					MC_TagValueRemovedFromComponent(TagValue);
-					return;
-				}
+				TagsHash += GetTypeHash(CurrentTag);
 			}
-		}
-	}
-	else
-	{
-		if(AddIfNotFound)
-		{
-			TagValuesContainer.Add(TagValue);
-		}
-		else
-		{
-			return;
+			for(const FS_TagValue& CurrentTagValue : TagFragment->TagValues)
+			{
+				TagsHash += HashCombineFast(GetTypeHash(CurrentTagValue.Tag), GetTypeHash(CurrentTagValue.Value));
+			}
+			Hash = HashCombineFast(Hash, TagsHash);
+			break;
 		}
 	}
 
-	if(Broadcast)
+	return Hash;
+}
+
+void UAC_Inventory::UpdateItemStateHash(const FS_InventoryItem& Item)
+{
+	SubtractItemStateHash(Item.UniqueID.IdentityNumber);
+	JournalItemChanged(Item.UniqueID.IdentityNumber);
+
+	if(!Item.UniqueID.IsValid() || !ContainerSettings.IsValidIndex(Item.ContainerIndex))
 	{
-		MC_TagValueUpdatedForComponent(TagValue, OldValue);
+		return;
 	}
+
+	/**Some callers pass in a copy of the item from before it was modified,
+	 * so prefer the version inside the container.*/
+	const FS_ContainerSettings& Container = ContainerSettings[Item.ContainerIndex];
+	const bool ItemInContainer = Container.Items.IsValidIndex(Item.ItemIndex) && Container.Items[Item.ItemIndex].UniqueID.IdentityNumber == Item.UniqueID.IdentityNumber;
+	const uint32 ItemHash = GetItemStateHash(ItemInContainer ? Container.Items[Item.ItemIndex] : Item);
+
+	//Summing keeps the hash independent of item order and lets us subtract items out of it again.
+	ContainerStateHashes.FindOrAdd(Container.UniqueID.IdentityNumber) += ItemHash;
+	AdjustComponentStateHash(ItemHash, 0);
+	//The journal writes the item itself, so it doesn't need the whole container.
+	DirtyContainers.Add(Container.UniqueID.IdentityNumber);
+	ItemStateHashes.Add(Item.UniqueID.IdentityNumber, TPair<int32, uint32>(Container.UniqueID.IdentityNumber, ItemHash));
 }
 
-void UAC_Inventory::MC_TagValueUpdatedForComponent_Implementation(FS_TagValue TagValue, float OldValue)
+void UAC_Inventory::RemoveItemStateHash(const FS_UniqueID& ItemID)
 {
-	ComponentTagValueUpdated.Broadcast(TagValue, OldValue);
+	SubtractItemStateHash(ItemID.IdentityNumber);
+	JournalItemChanged(ItemID.IdentityNumber);
 }
 
-void UAC_Inventory::RemoveTagValueFromComponent(const FGameplayTag TagValue, bool Broadcast)
+void UAC_Inventory::SubtractItemStateHash(int32 ItemID)
 {
-	S_RemoveTagValueFromComponent(TagValue, Broadcast);
+	TPair<int32, uint32> OldContribution;
+	if(!ItemStateHashes.RemoveAndCopyValue(ItemID, OldContribution))
+	{
+		return;
+	}
+
+	if(uint32* ContainerHash = ContainerStateHashes.Find(OldContribution.Key))
+	{
+		*ContainerHash -= OldContribution.Value;
+		AdjustComponentStateHash(0, OldContribution.Value);
+	}
+	DirtyContainers.Add(OldContribution.Key);
 }
 
-void UAC_Inventory::S_RemoveTagValueFromComponent_Implementation(FGameplayTag TagValue, bool Broadcast)
+void UAC_Inventory::RebuildContainerStateHash(const FS_ContainerSettings& Container)
 {
-	FS_TagValue FoundTagValue;
-	int32 TagValueIndex;
-	if(UFL_InventoryFramework::DoesTagValuesHaveTag(TagValuesContainer, TagValue, FoundTagValue, TagValueIndex))
+	const int32 ContainerID = Container.UniqueID.IdentityNumber;
+	for(auto It = ItemStateHashes.CreateIterator(); It; ++It)
 	{
-		TagValuesContainer.RemoveAt(TagValueIndex);
-		if(Broadcast)
+		if(It.Value().Key == ContainerID)
 		{
-			MC_TagValueRemovedFromComponent(FoundTagValue);
+			It.RemoveCurrent();
 		}
 	}
-}
-
-void UAC_Inventory::MC_TagValueRemovedFromComponent_Implementation(FS_TagValue TagValue)
-{
-	ComponentTagValueRemoved.Broadcast(TagValue);
-}
 
-void UAC_Inventory::C_SetClientReceivedContainerData_Implementation(UAC_Inventory* OtherComponent, bool HasReceived)
-{
-	OtherComponent->ClientReceivedContainerData = HasReceived;
+	AddContainerStateHash(Container);
 }
 
-void UAC_Inventory::S_RemoveTagsFromComponent_Implementation(FGameplayTagContainer Tags, bool Broadcast)
+void UAC_Inventory::AddContainerStateHash(const FS_ContainerSettings& Container)
 {
-	//Append the two tag containers and call the TagsModified delegate on the way. - V
-	for(auto& CurrentTag : Tags)
+	const int32 ContainerID = Container.UniqueID.IdentityNumber;
+	MarkContainerDirty(ContainerID);
+	uint32& ContainerHash = ContainerStateHashes.FindOrAdd(ContainerID);
+	const uint32 OldContainerHash = ContainerHash;
+	ContainerHash = 0;
+	for(const FS_InventoryItem& CurrentItem : Container.Items)
 	{
-		if(TagsContainer.HasTagExact(CurrentTag))
+		if(CurrentItem.UniqueID.IsValid())
 		{
-			TagsContainer.RemoveTag(CurrentTag);
-			if(Broadcast)
-			{
-				ComponentTagRemoved.Broadcast(CurrentTag);
-			}
+			const uint32 ItemHash = GetItemStateHash(CurrentItem);
+			ContainerHash += ItemHash;
+			ItemStateHashes.Add(CurrentItem.UniqueID.IdentityNumber, TPair<int32, uint32>(ContainerID, ItemHash));
 		}
 	}
+	AdjustComponentStateHash(ContainerHash, OldContainerHash);
+}
 
-	if(Broadcast)
+void UAC_Inventory::RebuildContainerStateHashes()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(RebuildContainerStateHashes)
+
+	//Containers that had a hash but are gone have been removed, which the next save has to know about.
+	for(const TPair<int32, uint32>& CurrentHash : ContainerStateHashes)
 	{
-		MC_TagsRemovedFromComponent(Tags);
+		MarkContainerDirty(CurrentHash.Key);
 	}
-}
+	ContainerStateHashes.Empty(ContainerSettings.Num());
+	ItemStateHashes.Empty();
+	AdjustComponentStateHash(0, ComponentStateHash);
 
-void UAC_Inventory::MC_TagsRemovedFromComponent_Implementation(FGameplayTagContainer Tags)
-{
-	if(!GetOwner()->HasAuthority())
+	//ItemStateHashes is already empty, so there's nothing to take out of it per container.
+	for(const FS_ContainerSettings& CurrentContainer : ContainerSettings)
 	{
-		for(auto& CurrentTag : Tags)
-		{
-			ComponentTagRemoved.Broadcast(CurrentTag);
-		}
+		AddContainerStateHash(CurrentContainer);
 	}
 }
 
-void UAC_Inventory::S_AddListener_Implementation(UAC_Inventory* Component)
+int32 UAC_Inventory::GetContainerStateHash(int32 ContainerID) const
 {
-	Listeners.AddUnique(Component);
+	const uint32* ContainerHash = ContainerStateHashes.Find(ContainerID);
+	return ContainerHash ? static_cast<int32>(*ContainerHash) : 0;
 }
 
-void UAC_Inventory::C_RequestServerDataFromOtherComponent_Implementation(UAC_Inventory* OtherComponent, bool CallDataReceived)
+void UAC_Inventory::RefreshContainerHashTimer()
 {
-	if(!IsValid(OtherComponent))
+	UWorld* World = GetWorld();
+	if(!World || !GetOwner())
 	{
 		return;
 	}
-	
-	if(IsValid(GetOwner()->GetInstigatorController()))
+
+	const float ContainerHashInterval = UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->ContainerHashInterval;
+	bool HasRecipients = GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy;
+	for(const auto& CurrentListener : Listeners)
 	{
-		if(GetOwner()->GetInstigatorController()->IsLocalPlayerController())
-		{
-			if(!OtherComponent->ClientReceivedContainerData)
-			{
-				S_SendDataFromOtherComponent(OtherComponent, CallDataReceived);
+		HasRecipients |= IsValid(CurrentListener) && CurrentListener != this;
+	}
 
-				//Both Send and Receive RPC's are reliable, it's safe
-				//to assume we'll receive the container data "eventually".
-				//This prevents the server RPC from being spammed.
-				OtherComponent->ClientReceivedContainerData = true;
-			}
-			else
-			{
-				if(CallDataReceived)
-				{
-					OnDataReceivedFromOtherComponent(OtherComponent);
-				}
-			}
-		}
+	const bool ShouldRun = HasRecipients && ContainerHashInterval > 0 && GetOwner()->HasAuthority() && GetNetMode() != NM_Standalone;
+	FTimerManager& TimerManager = World->GetTimerManager();
+	if(ShouldRun && !TimerManager.IsTimerActive(ContainerHashTimer))
+	{
+		TimerManager.SetTimer(ContainerHashTimer, this, &UAC_Inventory::SendContainerStateHashes, ContainerHashInterval, true);
+	}
+	else if(!ShouldRun)
+	{
+		TimerManager.ClearTimer(ContainerHashTimer);
 	}
 }
 
-void UAC_Inventory::S_SendDataFromOtherComponent_Implementation(UAC_Inventory* OtherComponent, bool CallDataReceived)
+void UAC_Inventory::SendContainerStateHashes()
 {
-	if(!OtherComponent)
+	if(!Initialized || !GetOwner()->HasAuthority())
 	{
 		return;
 	}
-	
-	const bool CallComponentStarted = !Initialized;
-	
-	if(OtherComponent->Initialized)
+
+	//Stops the timer once the owning client and every listener are gone.
+	RefreshContainerHashTimer();
+
+	TArray<FS_ContainerStateHash> Hashes;
+	Hashes.Reserve(ContainerSettings.Num());
+	for(const FS_ContainerSettings& CurrentContainer : ContainerSettings)
 	{
-		OtherComponent->C_RequestServerContainerData(false);
+		FS_ContainerStateHash& NewHash = Hashes.AddDefaulted_GetRef();
+		NewHash.ContainerID = CurrentContainer.UniqueID.IdentityNumber;
+		NewHash.Hash = GetContainerStateHash(CurrentContainer.UniqueID.IdentityNumber);
 	}
-	else
+
+	//Host and server owned components have no client to send the hashes to.
+	if(GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy)
 	{
-		OtherComponent->StartComponent();
+		C_VerifyContainerStateHashes(this, Hashes);
 	}
-	
-	OtherComponent->S_AddListener(this);
 
-	//Wipe the tile map before sending it to the clients.
-	//This results in much smaller RPC's (around 20% on average)
-	//and generating it takes very little CPU time.
-	TArray<FS_ContainerSettings> TempContainers = OtherComponent->ContainerSettings;
-	for(auto& CurrentContainer : TempContainers)
+	for(const auto& CurrentListener : Listeners)
 	{
-		CurrentContainer.TileMap.Empty();
+		if(IsValid(CurrentListener) && CurrentListener != this && CurrentListener->GetOwner()->GetRemoteRole() == ROLE_AutonomousProxy)
+		{
+			CurrentListener->C_VerifyContainerStateHashes(this, Hashes);
+		}
 	}
-	
-	C_ReceiveDataFromOtherComponent(OtherComponent, TempContainers, CallDataReceived, CallComponentStarted);
 }
 
-void UAC_Inventory::C_ReceiveDataFromOtherComponent_Implementation(UAC_Inventory* OtherComponent, const TArray<FS_ContainerSettings> &Containers, bool CallDataReceived, bool CallComponentStarted)
+void UAC_Inventory::C_VerifyContainerStateHashes_Implementation(UAC_Inventory* Component, const TArray<FS_ContainerStateHash>& Hashes)
 {
-	if(!OtherComponent)
+	if(UKismetSystemLibrary::IsServer(this) || !IsValid(Component) || !Component->Initialized)
 	{
 		return;
 	}
-	
-	OtherComponent->ContainerSettings = Containers;
-	
-	//Clients receive container settings with no tile map, rebuild them.
-	for(auto& CurrentContainer : OtherComponent->ContainerSettings)
+
+	//Anything waiting on the server is expected to mismatch.
+	if(!Component->NetworkQueue.IsEmpty() || !PendingPredictions.IsEmpty())
 	{
-		OtherComponent->RebuildTileMap(CurrentContainer);
+		Component->SuspectedDesyncedContainers.Empty();
+		return;
 	}
 
-	OtherComponent->RefreshIDMap();
-	
-	OtherComponent->Initialized = true;
-	
-	if(CallComponentStarted)
+	TSet<int32> MismatchedContainers;
+	TSet<int32> ServerContainers;
+	for(const FS_ContainerStateHash& CurrentHash : Hashes)
 	{
-		OtherComponent->ComponentStarted.Broadcast();
+		ServerContainers.Add(CurrentHash.ContainerID);
+		const bool ContainerFound = Component->ContainerStateHashes.Contains(CurrentHash.ContainerID);
+		if(!ContainerFound || Component->GetContainerStateHash(CurrentHash.ContainerID) != CurrentHash.Hash)
+		{
+			MismatchedContainers.Add(CurrentHash.ContainerID);
+		}
 	}
-	
-	if(CallDataReceived)
+
+	//Containers the server no longer has.
+	for(const FS_ContainerSettings& CurrentContainer : Component->ContainerSettings)
 	{
-		OnDataReceivedFromOtherComponent(OtherComponent);
+		if(!ServerContainers.Contains(CurrentContainer.UniqueID.IdentityNumber))
+		{
+			MismatchedContainers.Add(CurrentContainer.UniqueID.IdentityNumber);
+		}
 	}
-}
 
-void UAC_Inventory::C_AddItemToNetworkQueue_Implementation(FS_UniqueID ItemID)
-{
-	if(UKismetSystemLibrary::IsStandalone(this) || UKismetSystemLibrary::IsServer(this))
+	TArray<int32> ContainersToResync;
+	for(const int32 CurrentContainer : MismatchedContainers)
 	{
-		return;
+		if(Component->SuspectedDesyncedContainers.Contains(CurrentContainer))
+		{
+			ContainersToResync.Add(CurrentContainer);
+		}
 	}
-	
-	if(IsValid(ItemID.ParentComponent))
+
+	Component->SuspectedDesyncedContainers = MismatchedContainers;
+
+	if(ContainersToResync.IsValidIndex(0))
 	{
-		UAC_Inventory* ParentComponent = ItemID.ParentComponent;
-		if(!ParentComponent->NetworkQueue.Contains(ItemID))
+		for(const int32 CurrentContainer : ContainersToResync)
 		{
-			ParentComponent->NetworkQueue.AddUnique(ItemID);
-			FS_InventoryItem FoundItem = ParentComponent->GetItemByUniqueID(ItemID);
-			if(FoundItem.IsValid())
-			{
-				UW_InventoryItem* ItemWidget = UFL_InventoryFramework::GetWidgetForItem(FoundItem);
-				ParentComponent->ItemAddedToNetworkQueue(FoundItem, ItemWidget);
-				if(ItemWidget)
-				{
-					ItemWidget->ParentItemAddedToNetworkQueue();
-				}
-			}
+			Component->SuspectedDesyncedContainers.Remove(CurrentContainer);
 		}
+		S_RequestContainerResync(Component, ContainersToResync);
 	}
 }
 
-void UAC_Inventory::C_RemoveItemFromNetworkQueue_Implementation(FS_UniqueID ItemID)
+void UAC_Inventory::S_RequestContainerResync_Implementation(UAC_Inventory* Component, const TArray<int32>& ContainerIDs)
 {
-	if(UKismetSystemLibrary::IsStandalone(this) || UKismetSystemLibrary::IsServer(this))
+	if(!URPCBudgetSubsystem::AdmitRequest(this, [=, this]() { S_RequestContainerResync_Implementation(Component, ContainerIDs); },
+		{Component}))
 	{
 		return;
 	}
-	if(IsValid(ItemID.ParentComponent))
+	const FRPCBudgetScope BudgetScope(this);
+
+	if(!IsValid(Component) || !Component->Initialized)
+	{
+		return;
+	}
+
+	//Clients can only resync their own component or components they are listening to.
+	if(Component != this && !Component->Listeners.Contains(this))
+	{
+		return;
+	}
+
+	TArray<FS_ContainerSettings> Containers;
+	TArray<int32> RemovedContainerIDs;
+	for(const int32 CurrentContainerID : ContainerIDs)
 	{
-		UAC_Inventory* ParentComponent = ItemID.ParentComponent;
-		if(ParentComponent->NetworkQueue.Contains(ItemID))
+		const FS_ContainerSettings* FoundContainer = Component->ContainerSettings.FindByPredicate([CurrentContainerID](const FS_ContainerSettings& Container)
 		{
-			ParentComponent->NetworkQueue.Remove(ItemID);
-			FS_InventoryItem FoundItem = ParentComponent->GetItemByUniqueID(ItemID);
-			if(FoundItem.IsValid())
-			{
-				UW_InventoryItem* ItemWidget = UFL_InventoryFramework::GetWidgetForItem(FoundItem);
-				ParentComponent->ItemRemovedFromNetworkQueue(FoundItem, ItemWidget);
-				if(ItemWidget)
-				{
-					ItemWidget->ParentItemRemovedFromNetworkQueue();
-				}
-			}
+			return Container.UniqueID.IdentityNumber == CurrentContainerID;
+		});
+
+		if(!FoundContainer)
+		{
+			RemovedContainerIDs.Add(CurrentContainerID);
+			continue;
 		}
+
+		//The server might have drifted too, make sure the next hash it sends is correct.
+		Component->RebuildContainerStateHash(*FoundContainer);
+		Containers.Add(*FoundContainer);
 	}
-}
 
+	UFL_InventoryFramework::LogIFPMessage(this, FString::Printf(TEXT("Resyncing %d containers of %s - AC_Inventory.cpp -> S_RequestContainerResync"),
+		ContainerIDs.Num(), *GetNameSafe(Component->GetOwner())), true, false);
 
-void UAC_Inventory::C_AddAllContainerItemsToNetworkQueue_Implementation(FS_UniqueID ContainerID)
+	C_ReceiveResyncedContainers(Component, UFL_InventoryFramework::SanitizeContainersForClientRPC(Containers), RemovedContainerIDs);
+}
+
+void UAC_Inventory::C_ReceiveResyncedContainers_Implementation(UAC_Inventory* Component, const TArray<FS_ContainerSettings>& Containers,
+	const TArray<int32>& RemovedContainerIDs)
 {
-	FS_ContainerSettings FoundContainer = GetContainerByUniqueID(ContainerID);
-	if(!FoundContainer.IsValid() || FoundContainer.Items.IsEmpty())
+	if(UKismetSystemLibrary::IsServer(this) || !IsValid(Component))
 	{
 		return;
 	}
 
-	//Add the container to the network queue.
-	//The container should not be interactable in any way while
-	//it is in the queue.
-	ContainerID.ParentComponent->NetworkQueue.AddUnique(ContainerID);
-	for(auto& CurrentItem : FoundContainer.Items)
+	for(const int32 CurrentContainerID : RemovedContainerIDs)
 	{
-		C_AddItemToNetworkQueue(CurrentItem.UniqueID);
+		const int32 ContainerIndex = Component->ContainerSettings.IndexOfByPredicate([CurrentContainerID](const FS_ContainerSettings& Container)
+		{
+			return Container.UniqueID.IdentityNumber == CurrentContainerID;
+		});
+		if(ContainerIndex != INDEX_NONE)
+		{
+			const FS_ContainerSettings RemovedContainer = Component->ContainerSettings[ContainerIndex];
+			Component->ContainerSettings.RemoveAt(ContainerIndex);
+			Component->ContainerRemoved.Broadcast(RemovedContainer);
+		}
 	}
-}
 
-void UAC_Inventory::C_RemoveAllContainerItemsFromNetworkQueue_Implementation(FS_UniqueID ContainerID)
-{
-	FS_ContainerSettings FoundContainer = GetContainerByUniqueID(ContainerID);
+	for(const FS_ContainerSettings& CurrentContainer : Containers)
+	{
+		const int32 ContainerIndex = Component->ContainerSettings.IndexOfByPredicate([&CurrentContainer](const FS_ContainerSettings& Container)
+		{
+			return Container.UniqueID.IdentityNumber == CurrentContainer.UniqueID.IdentityNumber;
+		});
 
-	if(!FoundContainer.IsValid() || FoundContainer.Items.IsEmpty())
+		FS_ContainerSettings& TargetContainer = ContainerIndex == INDEX_NONE ? Component->ContainerSettings.Add_GetRef(CurrentContainer) : Component->ContainerSettings[ContainerIndex];
+		if(ContainerIndex != INDEX_NONE)
+		{
+			//Keep the client only references.
+			UW_Container* Widget = TargetContainer.Widget;
+			TArray<TObjectPtr<UObject>> ExternalObjects = TargetContainer.ExternalObjects;
+			TargetContainer = CurrentContainer;
+			TargetContainer.Widget = Widget;
+			TargetContainer.ExternalObjects = ExternalObjects;
+		}
+	}
+
+	Component->RefreshIndexes();
+	for(FS_ContainerSettings& CurrentContainer : Component->ContainerSettings)
 	{
-		return;
+		Component->RebuildTileMap(CurrentContainer);
 	}
+	Component->RefreshIDMap();
+	Component->RebuildContainerStateHashes();
 
-	for(auto& CurrentItem : FoundContainer.Items)
+	for(const FS_ContainerSettings& CurrentContainer : Containers)
 	{
-		C_RemoveItemFromNetworkQueue(CurrentItem.UniqueID);
+		const FS_ContainerSettings UpdatedContainer = Component->GetContainerByUniqueID(CurrentContainer.UniqueID);
+		if(IsValid(UpdatedContainer.Widget))
+		{
+			UpdatedContainer.Widget->ConstructContainers(UpdatedContainer, Component, true);
+		}
 	}
 }
 
@@ -10378,6 +12424,20 @@ void UAC_Inventory::PostLoad()
 	UFL_InventoryFramework::UpdateLegacyContainerSettingsCode(ContainerSettings, this);
 	
 	// end of transition code
+
+	// 3.2 Transition code
+
+	//TagValuesContainer used to be a plain array, move the authored values over to the fast array.
+	for(const FS_TagValue& CurrentTagValue : TagValuesContainer)
+	{
+		if(!ComponentTagValues.Items.IsValidIndex(ComponentTagValues.FindTagValueIndex(CurrentTagValue.Tag)))
+		{
+			ComponentTagValues.SetTagValue(CurrentTagValue);
+		}
+	}
+	TagValuesContainer.Empty();
+
+	// end of transition code
 }
 
 void UAC_Inventory::OnComponentCreated()
@@ -10445,6 +12505,11 @@ void UAC_Inventory::BeginPlay()
 
 	ItemFailedSpawn.AddDynamic(this, &UAC_Inventory::LogItemFailedToSpawn);
 
+	//Start the idle countdown, the owner goes to sleep if nobody interacts with it.
+	WakeNetDormancy();
+
+	RefreshContainerHashTimer();
+
 	/**Fun fact: If you send a client RPC while the client is still being constructed,
 	 * the RPC will execute before BeginPlay.
 	 * Because of this, we check if the inventory has been initialized and also ensure
@@ -10468,6 +12533,16 @@ void UAC_Inventory::BeginPlay()
 	}
 }
 
+void UAC_Inventory::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	//Whatever changed this frame still has to make it into the journal.
+	StopJournal();
+
+	CancelStartComponent();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UAC_Inventory::LogItemFailedToSpawn(FS_InventoryItem Item, FString Reason)
 {
 	UFL_InventoryFramework::LogIFPMessage(this, Reason, true, DebugMessages);
@@ -5,6 +5,7 @@
 
 #include "Core/Components/AC_Inventory.h"
 #include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Data/SG_InventorySerialization.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
 
@@ -50,3 +51,57 @@ void UAsync_SortAndMoveItems::SortFinished()
 	TargetComponent->SortingFinished.RemoveDynamic(this, &UAsync_SortAndMoveItems::SortFinished);
 	RemoveFromRoot();
 }
+
+UAsync_SerializeContainers* UAsync_SerializeContainers::SaveContainersForActor_Async(USG_InventorySerialization* SaveGame, AActor* Actor)
+{
+	UAsync_SerializeContainers* NewAsyncObject = NewObject<UAsync_SerializeContainers>();
+	NewAsyncObject->TargetSaveGame = SaveGame;
+	NewAsyncObject->TargetActor = Actor;
+	NewAsyncObject->Saving = true;
+	NewAsyncObject->RegisterWithGameInstance(Actor);
+	return NewAsyncObject;
+}
+
+UAsync_SerializeContainers* UAsync_SerializeContainers::LoadContainersForActor_Async(USG_InventorySerialization* SaveGame, AActor* Actor)
+{
+	UAsync_SerializeContainers* NewAsyncObject = NewObject<UAsync_SerializeContainers>();
+	NewAsyncObject->TargetSaveGame = SaveGame;
+	NewAsyncObject->TargetActor = Actor;
+	NewAsyncObject->Saving = false;
+	NewAsyncObject->RegisterWithGameInstance(Actor);
+	return NewAsyncObject;
+}
+
+void UAsync_SerializeContainers::Activate()
+{
+	Super::Activate();
+
+	if(!IsValid(TargetSaveGame) || !IsValid(TargetActor))
+	{
+		SerializationFinished(false);
+		return;
+	}
+
+	const FContainerSerializationFinished OnFinished = FContainerSerializationFinished::CreateUObject(this, &UAsync_SerializeContainers::SerializationFinished);
+	if(Saving)
+	{
+		TargetSaveGame->SaveContainersForActorAsync(TargetActor, OnFinished);
+	}
+	else
+	{
+		TargetSaveGame->LoadContainersForActorAsync(TargetActor, OnFinished);
+	}
+}
+
+void UAsync_SerializeContainers::SerializationFinished(bool WasSuccessful)
+{
+	if(WasSuccessful)
+	{
+		Success.Broadcast();
+	}
+	else
+	{
+		Fail.Broadcast();
+	}
+	SetReadyToDestroy();
+}
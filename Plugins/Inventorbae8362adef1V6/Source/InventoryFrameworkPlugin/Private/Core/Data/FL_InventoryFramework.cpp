@@ -30,6 +30,10 @@
 #include "Core/Fragments/IF_ItemOverrideSettings.h"
 #include "Core/Fragments/IF_RandomItemCount.h"
 #include "UObject/UObjectGlobals.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 
 #if WITH_EDITOR
 
@@ -582,26 +586,7 @@ void UFL_InventoryFramework::GetTraitsByClassForItem(UDA_CoreItem* Item, TSubcla
         return;
     }
     
-    for(auto& CurrentObject : Item->TraitsAndComponents)
-    {
-        if(IsValid(CurrentObject))
-        {
-            if(AllowChildren)
-            {
-                if(CurrentObject->GetClass()->IsChildOf(Class))
-                {
-                    FoundTraits.Add(CurrentObject);
-                }
-            }
-            else
-            {
-                if(CurrentObject->GetClass() == Class)
-                {
-                    FoundTraits.Add(CurrentObject);
-                }
-            }
-        }
-    }
+    Item->FindTraitsByClass(Class, AllowChildren, FoundTraits);
 }
 
 UItemTrait* UFL_InventoryFramework::GetTraitByClassForItem(UDA_CoreItem* Item,
@@ -614,28 +599,7 @@ UItemTrait* UFL_InventoryFramework::GetTraitByClassForItem(UDA_CoreItem* Item,
         return nullptr;
     }
     
-    for(auto& CurrentObject : Item->TraitsAndComponents)
-    {
-        if(IsValid(CurrentObject))
-        {
-            if(AllowChildren)
-            {
-                if(CurrentObject->GetClass()->IsChildOf(Class) || CurrentObject->GetClass() == Class)
-                {
-                    return CurrentObject;
-                }
-            }
-            else
-            {
-                if(CurrentObject->GetClass() == Class)
-                {
-                    return CurrentObject;
-                }
-            }
-        }
-    }
-
-    return nullptr;
+    return Item->FindTraitByClass(Class, AllowChildren);
 }
 
 TArray<int32> UFL_InventoryFramework::GetOverlappingTiles(FS_ContainerSettings Container)
@@ -684,15 +648,9 @@ TArray<UIDA_Currency*> UFL_InventoryFramework::GetAcceptedCurrencies(FS_Inventor
     }
 
     //Find out if we have a Pricing object attached to the item.
-    for(auto& CurrentObject : Item.ItemAsset->TraitsAndComponents)
+    if(UIT_Pricing* PricingTrait = Item.ItemAsset->FindTrait<UIT_Pricing>())
     {
-        if(IsValid(CurrentObject))
-        {
-            if(CurrentObject->GetClass() == UIT_Pricing::StaticClass())
-            {
-                AcceptedCurrencies.Append(Cast<UIT_Pricing>(CurrentObject)->DefaultAcceptedCurrencies);
-            }
-        }
+        AcceptedCurrencies.Append(PricingTrait->DefaultAcceptedCurrencies);
     }
 
     return AcceptedCurrencies;
@@ -835,16 +793,9 @@ float UFL_InventoryFramework::GetItemPrice(FS_InventoryItem Item, bool IncludeCh
     }
 
     //Find out if this asset has the Pricing object.
-    for(TObjectPtr<UItemTrait>& CurrentObject : Item.ItemAsset->TraitsAndComponents)
+    if(UIT_Pricing* PricingTrait = Item.ItemAsset->FindTrait<UIT_Pricing>())
     {
-        if(IsValid(CurrentObject))
-        {
-            if(CurrentObject->GetClass() == UIT_Pricing::StaticClass())
-            {
-                ItemPrice = Cast<UIT_Pricing>(CurrentObject)->Price;
-                break;
-            }
-        }
+        ItemPrice = PricingTrait->Price;
     }
 
     return ItemPrice * Item.Count + ChildItemsPrice;
@@ -1158,7 +1109,7 @@ bool UFL_InventoryFramework::IsItemInNetworkQueue(FS_InventoryItem Item)
 {
     if(IsItemValid(Item))
     {
-        return Item.UniqueID.ParentComponent->NetworkQueue.Contains(Item.UniqueID);
+        return Item.UniqueID.ParentComponent->IsItemInNetworkQueue(Item.UniqueID);
     }
     return false;
 }
@@ -1600,6 +1551,112 @@ TArray<FS_ContainerSettings> UFL_InventoryFramework::SanitizeContainersForClient
     return Containers;
 }
 
+/**Bump this whenever the layout of the compressed container data changes.*/
+static constexpr int32 CompressedContainersVersion = 1;
+
+bool UFL_InventoryFramework::CompressContainers(const TArray<FS_ContainerSettings>& Containers, TArray<uint8>& CompressedData)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UFL_InventoryFramework::CompressContainers)
+    
+    CompressedData.Empty();
+
+    TArray<uint8> RawData;
+    FMemoryWriter MemoryWriter(RawData, true);
+    /**Not using FSaveGameArchive, it would skip any property
+     * that isn't flagged as SaveGame.*/
+    FObjectAndNameAsStringProxyArchive Archive(MemoryWriter, false);
+
+    /**Properties that still match their default value are skipped,
+     * which is most of them for a typical item.*/
+    const FS_ContainerSettings DefaultContainer;
+    int32 ContainerCount = Containers.Num();
+    Archive << ContainerCount;
+    for(const FS_ContainerSettings& CurrentContainer : Containers)
+    {
+        FS_ContainerSettings::StaticStruct()->SerializeItem(Archive, const_cast<FS_ContainerSettings*>(&CurrentContainer), &DefaultContainer);
+    }
+
+    if(Archive.IsError())
+    {
+        return false;
+    }
+
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, RawData.Num());
+    TArray<uint8> CompressedPayload;
+    CompressedPayload.SetNumUninitialized(CompressedSize);
+    if(!FCompression::CompressMemory(NAME_Zlib, CompressedPayload.GetData(), CompressedSize, RawData.GetData(), RawData.Num()))
+    {
+        return false;
+    }
+    CompressedPayload.SetNum(CompressedSize);
+
+    FMemoryWriter HeaderWriter(CompressedData);
+    int32 Version = CompressedContainersVersion;
+    int32 UncompressedSize = RawData.Num();
+    HeaderWriter << Version;
+    HeaderWriter << UncompressedSize;
+    CompressedData.Append(CompressedPayload);
+
+    return true;
+}
+
+bool UFL_InventoryFramework::DecompressContainers(const TArray<uint8>& CompressedData, TArray<FS_ContainerSettings>& Containers)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UFL_InventoryFramework::DecompressContainers)
+    
+    Containers.Empty();
+
+    constexpr int32 HeaderSize = sizeof(int32) * 2;
+    if(CompressedData.Num() <= HeaderSize)
+    {
+        return false;
+    }
+
+    FMemoryReader HeaderReader(CompressedData);
+    int32 Version = 0;
+    int32 UncompressedSize = 0;
+    HeaderReader << Version;
+    HeaderReader << UncompressedSize;
+
+    //Guard against corrupted or malicious data asking for absurd allocations.
+    if(Version != CompressedContainersVersion || UncompressedSize <= 0 || UncompressedSize > 256 * 1024 * 1024)
+    {
+        return false;
+    }
+
+    TArray<uint8> RawData;
+    RawData.SetNumUninitialized(UncompressedSize);
+    if(!FCompression::UncompressMemory(NAME_Zlib, RawData.GetData(), UncompressedSize, CompressedData.GetData() + HeaderSize, CompressedData.Num() - HeaderSize))
+    {
+        return false;
+    }
+
+    FMemoryReader MemoryReader(RawData, true);
+    FObjectAndNameAsStringProxyArchive Archive(MemoryReader, true);
+
+    const FS_ContainerSettings DefaultContainer;
+    int32 ContainerCount = 0;
+    Archive << ContainerCount;
+    if(ContainerCount < 0 || ContainerCount > UncompressedSize)
+    {
+        return false;
+    }
+
+    Containers.SetNum(ContainerCount);
+    for(FS_ContainerSettings& CurrentContainer : Containers)
+    {
+        FS_ContainerSettings::StaticStruct()->SerializeItem(Archive, &CurrentContainer, &DefaultContainer);
+    }
+
+    if(Archive.IsError())
+    {
+        Containers.Empty();
+        return false;
+    }
+
+    return true;
+}
+
 FGameplayTagContainer UFL_InventoryFramework::GetContainersTags(FS_ContainerSettings Container)
 {
     FTagFragment TagFragment = UF_Tags::GetTagFragmentFromContainer(Container);
@@ -1757,7 +1814,7 @@ bool UFL_InventoryFramework::IsContainerInNetworkQueue(FS_ContainerSettings Cont
 {
     if(IsValid(Container.UniqueID.ParentComponent))
     {
-        return Container.UniqueID.ParentComponent->NetworkQueue.Contains(Container.UniqueID);
+        return Container.UniqueID.ParentComponent->IsItemInNetworkQueue(Container.UniqueID);
     }
     return false;
 }
@@ -0,0 +1,904 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Data/InventoryJournal.h"
+
+#include "InventoryFrameworkPlugin.h"
+#include "Core/Components/AC_Inventory.h"
+#include "Core/Data/DS_InventoryFrameworkSettingsRuntime.h"
+#include "Core/Fragments/F_Tags.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+//"IFPJ", written at the start of every journal.
+static constexpr uint32 JournalMagic = 0x4A504649;
+
+/**Bump this whenever the layout of the records changes, which includes
+ * ContainerSaveVersion changing the layout of USG_InventorySerialization::WriteSingleItem.
+ * Older versions must keep being readable.
+ * 2 - Items are added through AddItem records instead of Add.*/
+static constexpr int32 JournalVersion = 2;
+
+/**Everything a compaction hands between the game thread and the worker.*/
+struct FInventoryJournalCompaction
+{
+	TArray<FS_ContainerSettings> Containers;
+
+	TArray<FLoadedItemInstance> ItemInstances;
+
+	bool Success = false;
+};
+
+void FInventoryJournal::WriteHeader(TArray<uint8>& OutData)
+{
+	FMemoryWriter Writer(OutData, true, true);
+	uint32 Magic = JournalMagic;
+	int32 Version = JournalVersion;
+	Writer << Magic;
+	Writer << Version;
+}
+
+/**Every record is its size, a checksum and the payload, so a record that
+ * was only partially written when the game crashed can be detected.*/
+void FInventoryJournal::WriteRecord(TArray<uint8>& OutData, int64 RecordSequence, EInventoryJournalOperation Operation, TFunctionRef<void(FArchive&)> WritePayload)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload, true);
+	uint8 OperationValue = static_cast<uint8>(Operation);
+	PayloadWriter << RecordSequence;
+	PayloadWriter << OperationValue;
+	WritePayload(PayloadWriter);
+
+	uint32 Size = Payload.Num();
+	uint32 Checksum = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+	FMemoryWriter Writer(OutData, true, true);
+	Writer << Size;
+	Writer << Checksum;
+	Writer.Serialize(Payload.GetData(), Payload.Num());
+}
+
+static const FTagFragment* FindTagFragment(const FS_InventoryItem& Item)
+{
+	for(const TInstancedStruct<FCoreFragment>& CurrentFragment : Item.ItemFragments)
+	{
+		if(const FTagFragment* TagFragment = CurrentFragment.GetPtr<FTagFragment>())
+		{
+			return TagFragment;
+		}
+	}
+
+	return nullptr;
+}
+
+static FInventoryJournalItemState GetJournalItemState(const FS_InventoryItem& Item, int32 ContainerID)
+{
+	FInventoryJournalItemState State;
+	State.ContainerID = ContainerID;
+	State.TileIndex = Item.TileIndex;
+	State.Rotation = static_cast<uint8>(Item.Rotation.GetValue());
+	State.Count = Item.Count;
+
+	if(const FTagFragment* TagFragment = FindTagFragment(Item))
+	{
+		//Same as GetItemStateHash, the order the tags were added in doesn't matter.
+		for(const FGameplayTag& CurrentTag : TagFragment->Tags)
+		{
+			State.TagsHash += GetTypeHash(CurrentTag);
+		}
+		for(const FS_TagValue& CurrentTagValue : TagFragment->TagValues)
+		{
+			State.TagsHash += HashCombineFast(GetTypeHash(CurrentTagValue.Tag), GetTypeHash(CurrentTagValue.Value));
+		}
+	}
+
+	return State;
+}
+
+static const FS_InventoryItem* FindLiveItem(const UAC_Inventory* Inventory, int32 ItemID)
+{
+	if(const FS_IDMapEntry* Entry = Inventory->ID_Map.Find(ItemID))
+	{
+		if(!Entry->IsContainer && Inventory->ContainerSettings.IsValidIndex(Entry->Directions.X))
+		{
+			const TArray<FS_InventoryItem>& Items = Inventory->ContainerSettings[Entry->Directions.X].Items;
+			if(Items.IsValidIndex(Entry->Directions.Y) && Items[Entry->Directions.Y].UniqueID.IdentityNumber == ItemID)
+			{
+				return &Items[Entry->Directions.Y];
+			}
+		}
+	}
+
+	for(const FS_ContainerSettings& CurrentContainer : Inventory->ContainerSettings)
+	{
+		for(const FS_InventoryItem& CurrentItem : CurrentContainer.Items)
+		{
+			if(CurrentItem.UniqueID.IdentityNumber == ItemID)
+			{
+				return &CurrentItem;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+static int32 FindJournalContainer(const TArray<FS_ContainerSettings>& Containers, int32 ContainerID)
+{
+	return Containers.IndexOfByPredicate([ContainerID](const FS_ContainerSettings& Container)
+	{
+		return Container.UniqueID.IdentityNumber == ContainerID;
+	});
+}
+
+/**Where every item is while a journal is being replayed, so records don't
+ * have to search every container for their item.
+ * Records that replace whole containers invalidate it, it is then
+ * rebuilt the next time an item is looked up.*/
+struct FJournalReplayIndex
+{
+	//ItemID to its container and item index.
+	TMap<int32, FIntPoint> Items;
+
+	bool Valid = false;
+
+	void Build(const TArray<FS_ContainerSettings>& Containers)
+	{
+		Items.Reset();
+		for(int32 ContainerIndex = 0; ContainerIndex < Containers.Num(); ContainerIndex++)
+		{
+			const TArray<FS_InventoryItem>& ContainerItems = Containers[ContainerIndex].Items;
+			for(int32 ItemIndex = 0; ItemIndex < ContainerItems.Num(); ItemIndex++)
+			{
+				//Keep the first one, same as searching the containers would.
+				const int32 ItemID = ContainerItems[ItemIndex].UniqueID.IdentityNumber;
+				if(ItemID > 0 && !Items.Contains(ItemID))
+				{
+					Items.Add(ItemID, FIntPoint(ContainerIndex, ItemIndex));
+				}
+			}
+		}
+		Valid = true;
+	}
+
+	void Reindex(const TArray<FS_ContainerSettings>& Containers, int32 ContainerIndex, int32 FirstItemIndex)
+	{
+		const TArray<FS_InventoryItem>& ContainerItems = Containers[ContainerIndex].Items;
+		for(int32 ItemIndex = FirstItemIndex; ItemIndex < ContainerItems.Num(); ItemIndex++)
+		{
+			if(FIntPoint* Location = Items.Find(ContainerItems[ItemIndex].UniqueID.IdentityNumber))
+			{
+				*Location = FIntPoint(ContainerIndex, ItemIndex);
+			}
+		}
+	}
+};
+
+static bool FindJournalItem(const TArray<FS_ContainerSettings>& Containers, FJournalReplayIndex& ReplayIndex, int32 ItemID, int32& OutContainerIndex, int32& OutItemIndex)
+{
+	if(!ReplayIndex.Valid)
+	{
+		ReplayIndex.Build(Containers);
+	}
+
+	const FIntPoint* Location = ReplayIndex.Items.Find(ItemID);
+	if(!Location)
+	{
+		return false;
+	}
+
+	OutContainerIndex = Location->X;
+	OutItemIndex = Location->Y;
+	return true;
+}
+
+/**Remove an item and its item instance, keeping the item instances
+ * of the items after it pointing at the right item.*/
+static FS_InventoryItem RemoveJournalItem(TArray<FS_ContainerSettings>& Containers, TArray<FLoadedItemInstance>& ItemInstances, FJournalReplayIndex& ReplayIndex,
+	int32 ContainerIndex, int32 ItemIndex, TOptional<FLoadedItemInstance>& OutItemInstance)
+{
+	FS_InventoryItem Item = MoveTemp(Containers[ContainerIndex].Items[ItemIndex]);
+	Containers[ContainerIndex].Items.RemoveAt(ItemIndex);
+	if(ReplayIndex.Valid)
+	{
+		ReplayIndex.Items.Remove(Item.UniqueID.IdentityNumber);
+		ReplayIndex.Reindex(Containers, ContainerIndex, ItemIndex);
+	}
+
+	for(int32 InstanceIndex = ItemInstances.Num() - 1; InstanceIndex >= 0; InstanceIndex--)
+	{
+		FLoadedItemInstance& CurrentInstance = ItemInstances[InstanceIndex];
+		if(CurrentInstance.ContainerIndex != ContainerIndex)
+		{
+			continue;
+		}
+
+		if(CurrentInstance.ItemIndex == ItemIndex)
+		{
+			OutItemInstance = MoveTemp(CurrentInstance);
+			ItemInstances.RemoveAtSwap(InstanceIndex);
+		}
+		else if(CurrentInstance.ItemIndex > ItemIndex)
+		{
+			CurrentInstance.ItemIndex--;
+		}
+	}
+
+	return Item;
+}
+
+static void AddJournalItem(TArray<FS_ContainerSettings>& Containers, TArray<FLoadedItemInstance>& ItemInstances, FJournalReplayIndex& ReplayIndex,
+	int32 ContainerIndex, FS_InventoryItem&& Item, TOptional<FLoadedItemInstance>& ItemInstance)
+{
+	TArray<FS_InventoryItem>& Items = Containers[ContainerIndex].Items;
+	const int32 ItemIndex = Items.Add(MoveTemp(Item));
+	Items[ItemIndex].ContainerIndex = ContainerIndex;
+	Items[ItemIndex].ItemIndex = ItemIndex;
+	if(ReplayIndex.Valid)
+	{
+		ReplayIndex.Items.FindOrAdd(Items[ItemIndex].UniqueID.IdentityNumber, FIntPoint(ContainerIndex, ItemIndex));
+	}
+
+	if(ItemInstance.IsSet())
+	{
+		FLoadedItemInstance& NewInstance = ItemInstances.Add_GetRef(MoveTemp(ItemInstance.GetValue()));
+		NewInstance.ContainerIndex = ContainerIndex;
+		NewInstance.ItemIndex = ItemIndex;
+	}
+}
+
+/**Add @NewItem to the container at @TargetContainerIndex, replacing the item with the same ID if there already is one.*/
+static void ReplaceJournalItem(TArray<FS_ContainerSettings>& Containers, TArray<FLoadedItemInstance>& ItemInstances, FJournalReplayIndex& ReplayIndex,
+	int32 TargetContainerIndex, FS_InventoryItem&& NewItem, TOptional<FLoadedItemInstance>& NewItemInstance)
+{
+	int32 ContainerIndex = INDEX_NONE;
+	int32 ItemIndex = INDEX_NONE;
+	if(FindJournalItem(Containers, ReplayIndex, NewItem.UniqueID.IdentityNumber, ContainerIndex, ItemIndex))
+	{
+		TOptional<FLoadedItemInstance> OldItemInstance;
+		RemoveJournalItem(Containers, ItemInstances, ReplayIndex, ContainerIndex, ItemIndex, OldItemInstance);
+	}
+
+	AddJournalItem(Containers, ItemInstances, ReplayIndex, TargetContainerIndex, MoveTemp(NewItem), NewItemInstance);
+}
+
+/**Records hold the state the item ended up in, rather than what changed,
+ * so a record can be applied on top of containers that already have it.
+ * The payload is read completely before anything is modified.*/
+static bool ApplyJournalRecord(EInventoryJournalOperation Operation, FArchive& Payload, TArray<FS_ContainerSettings>& Containers, TArray<FLoadedItemInstance>& ItemInstances,
+	FJournalReplayIndex& ReplayIndex)
+{
+	int32 ContainerIndex = INDEX_NONE;
+	int32 ItemIndex = INDEX_NONE;
+
+	switch(Operation)
+	{
+	case EInventoryJournalOperation::AddItem:
+		{
+			int32 ContainerID = 0;
+			FS_InventoryItem NewItem;
+			TOptional<FLoadedItemInstance> ItemInstance;
+			Payload << ContainerID;
+			const int32 TargetContainerIndex = FindJournalContainer(Containers, ContainerID);
+			if(Payload.IsError() || TargetContainerIndex == INDEX_NONE || !USG_InventorySerialization::ReadSingleItem(Payload, NewItem, ItemInstance))
+			{
+				return false;
+			}
+
+			ReplaceJournalItem(Containers, ItemInstances, ReplayIndex, TargetContainerIndex, MoveTemp(NewItem), ItemInstance);
+			return true;
+		}
+	case EInventoryJournalOperation::Add:
+		{
+			int32 ContainerID = 0;
+			TArray<uint8> ItemData;
+			Payload << ContainerID;
+			Payload << ItemData;
+
+			//Journals before version 2 wrote the item as a container of its own.
+			TArray<FS_ContainerSettings> ItemContainers;
+			TArray<FLoadedItemInstance> ItemContainerInstances;
+			const int32 TargetContainerIndex = FindJournalContainer(Containers, ContainerID);
+			if(Payload.IsError() || TargetContainerIndex == INDEX_NONE || !USG_InventorySerialization::ReadContainers(ItemData, ItemContainers, ItemContainerInstances) ||
+				!ItemContainers.IsValidIndex(0) || !ItemContainers[0].Items.IsValidIndex(0))
+			{
+				return false;
+			}
+
+			TOptional<FLoadedItemInstance> ItemInstance;
+			if(ItemContainerInstances.IsValidIndex(0))
+			{
+				ItemInstance = MoveTemp(ItemContainerInstances[0]);
+			}
+			ReplaceJournalItem(Containers, ItemInstances, ReplayIndex, TargetContainerIndex, MoveTemp(ItemContainers[0].Items[0]), ItemInstance);
+			return true;
+		}
+	case EInventoryJournalOperation::Remove:
+		{
+			int32 ItemID = 0;
+			Payload << ItemID;
+			if(Payload.IsError())
+			{
+				return false;
+			}
+
+			if(FindJournalItem(Containers, ReplayIndex, ItemID, ContainerIndex, ItemIndex))
+			{
+				TOptional<FLoadedItemInstance> ItemInstance;
+				RemoveJournalItem(Containers, ItemInstances, ReplayIndex, ContainerIndex, ItemIndex, ItemInstance);
+			}
+			return true;
+		}
+	case EInventoryJournalOperation::Move:
+		{
+			int32 ItemID = 0;
+			int32 ContainerID = 0;
+			int32 TileIndex = -1;
+			uint8 Rotation = 0;
+			Payload << ItemID;
+			Payload << ContainerID;
+			Payload << TileIndex;
+			Payload << Rotation;
+
+			const int32 TargetContainerIndex = FindJournalContainer(Containers, ContainerID);
+			if(Payload.IsError() || TargetContainerIndex == INDEX_NONE || !FindJournalItem(Containers, ReplayIndex, ItemID, ContainerIndex, ItemIndex))
+			{
+				return false;
+			}
+
+			if(ContainerIndex != TargetContainerIndex)
+			{
+				TOptional<FLoadedItemInstance> ItemInstance;
+				FS_InventoryItem Item = RemoveJournalItem(Containers, ItemInstances, ReplayIndex, ContainerIndex, ItemIndex, ItemInstance);
+				AddJournalItem(Containers, ItemInstances, ReplayIndex, TargetContainerIndex, MoveTemp(Item), ItemInstance);
+				ContainerIndex = TargetContainerIndex;
+				ItemIndex = Containers[ContainerIndex].Items.Num() - 1;
+			}
+
+			FS_InventoryItem& Item = Containers[ContainerIndex].Items[ItemIndex];
+			Item.TileIndex = TileIndex;
+			Item.Rotation = static_cast<ERotation>(Rotation);
+			return true;
+		}
+	case EInventoryJournalOperation::CountChange:
+		{
+			int32 ItemID = 0;
+			int32 Count = 0;
+			Payload << ItemID;
+			Payload << Count;
+			if(Payload.IsError() || !FindJournalItem(Containers, ReplayIndex, ItemID, ContainerIndex, ItemIndex))
+			{
+				return false;
+			}
+
+			Containers[ContainerIndex].Items[ItemIndex].Count = Count;
+			return true;
+		}
+	case EInventoryJournalOperation::TagChange:
+		{
+			int32 ItemID = 0;
+			TArray<uint8> TagData;
+			Payload << ItemID;
+			Payload << TagData;
+			if(Payload.IsError() || !FindJournalItem(Containers, ReplayIndex, ItemID, ContainerIndex, ItemIndex))
+			{
+				return false;
+			}
+
+			FTagFragment TagFragment;
+			FMemoryReader TagReader(TagData, true);
+			//Tags and TagValues never reference objects, so this never has to find one.
+			FObjectAndNameAsStringProxyArchive TagArchive(TagReader, false);
+			FTagFragment::StaticStruct()->SerializeItem(TagArchive, &TagFragment, nullptr);
+			if(TagReader.IsError())
+			{
+				return false;
+			}
+
+			TArray<TInstancedStruct<FCoreFragment>>& Fragments = Containers[ContainerIndex].Items[ItemIndex].ItemFragments;
+			TInstancedStruct<FCoreFragment>* ExistingFragment = Fragments.FindByPredicate([](const TInstancedStruct<FCoreFragment>& Fragment)
+			{
+				return Fragment.GetPtr<FTagFragment>() != nullptr;
+			});
+			if(ExistingFragment)
+			{
+				ExistingFragment->InitializeAs<FTagFragment>(MoveTemp(TagFragment));
+			}
+			else
+			{
+				Fragments.Add(TInstancedStruct<FCoreFragment>::Make<FTagFragment>(MoveTemp(TagFragment)));
+			}
+			return true;
+		}
+	case EInventoryJournalOperation::Containers:
+		{
+			TArray<uint8> PatchData;
+			Payload << PatchData;
+			//Containers might have been added, removed or reordered.
+			ReplayIndex.Valid = false;
+			return !Payload.IsError() && USG_InventorySerialization::ApplyContainerPatch(PatchData, Containers, ItemInstances);
+		}
+	default:
+		return false;
+	}
+}
+
+FInventoryJournal::~FInventoryJournal()
+{
+	Stop();
+}
+
+bool FInventoryJournal::Start(UAC_Inventory* Inventory, const FString& InFilePath, int64 LoadedSequence, bool DiscardUnloadedRecords)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FInventoryJournal::Start)
+
+	Stop();
+	FilePath = InFilePath;
+	Sequence = 0;
+
+	/**Saves remember the sequence of the last record they contain, if we started
+	 * over from 0 they would think they're newer than this journal.*/
+	if(FPaths::FileExists(FilePath))
+	{
+		ReadRecords(FilePath, [this](int64 RecordSequence, EInventoryJournalOperation Operation, FArchive& Payload)
+		{
+			Sequence = FMath::Max(Sequence, RecordSequence);
+			return true;
+		});
+	}
+
+	//The journal is replaced by a snapshot of the component, anything it has that the component doesn't would be lost.
+	if(Sequence > LoadedSequence && !DiscardUnloadedRecords)
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("Inventory journal %s has records up to %lld, but the component was only loaded up to %lld. Load it with LoadContainersFromJournal or LoadContainersForActor before starting the journal"),
+			*FilePath, Sequence, FMath::Max<int64>(LoadedSequence, 0));
+		FilePath.Empty();
+		Sequence = 0;
+		return false;
+	}
+
+	TArray<uint8> SnapshotData;
+	if(!USG_InventorySerialization::WriteContainers(Inventory->ContainerSettings, true, SnapshotData))
+	{
+		return false;
+	}
+
+	TArray<uint8> FileData;
+	WriteHeader(FileData);
+	WriteRecord(FileData, ++Sequence, EInventoryJournalOperation::Snapshot, [&SnapshotData](FArchive& Archive)
+	{
+		Archive << SnapshotData;
+	});
+
+	//Written next to the old journal first, so it isn't lost if we crash halfway through.
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	if(!FFileHelper::SaveArrayToFile(FileData, *TempFilePath) || !IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("Could not write inventory journal %s"), *FilePath);
+		return false;
+	}
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if(!Writer.IsValid())
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("Could not open inventory journal %s"), *FilePath);
+		return false;
+	}
+
+	CacheItemStates(Inventory, nullptr);
+	return true;
+}
+
+void FInventoryJournal::Stop()
+{
+	if(Writer.IsValid())
+	{
+		Writer->Close();
+		Writer.Reset();
+	}
+
+	RunID++;
+	RecordsSinceCompaction = 0;
+	Compacting = false;
+	RecordsDuringCompaction.Empty();
+	ItemStates.Empty();
+	ChangedItems.Empty();
+	ChangedContainers.Empty();
+}
+
+void FInventoryJournal::ItemChanged(int32 ItemID)
+{
+	if(ItemID > 0)
+	{
+		ChangedItems.Add(ItemID);
+	}
+}
+
+void FInventoryJournal::ContainerChanged(int32 ContainerID)
+{
+	if(ContainerID > 0)
+	{
+		ChangedContainers.Add(ContainerID);
+	}
+}
+
+void FInventoryJournal::Flush(UAC_Inventory* Inventory)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FInventoryJournal::Flush)
+
+	if(!Writer.IsValid() || !IsValid(Inventory) || !HasPendingChanges())
+	{
+		return;
+	}
+
+	for(const int32 ItemID : ChangedItems)
+	{
+		const FS_InventoryItem* Item = FindLiveItem(Inventory, ItemID);
+		const FInventoryJournalItemState* PreviousState = ItemStates.Find(ItemID);
+		if(!Item || !Inventory->ContainerSettings.IsValidIndex(Item->ContainerIndex))
+		{
+			if(PreviousState)
+			{
+				ItemStates.Remove(ItemID);
+				AppendRecord(EInventoryJournalOperation::Remove, [ItemID](FArchive& Archive)
+				{
+					int32 RemovedItemID = ItemID;
+					Archive << RemovedItemID;
+				});
+			}
+			continue;
+		}
+
+		const FS_ContainerSettings& Container = Inventory->ContainerSettings[Item->ContainerIndex];
+		int32 ContainerID = Container.UniqueID.IdentityNumber;
+
+		//The patch of its container already has the item, as long as it didn't come from a container that isn't being patched.
+		if(ChangedContainers.Contains(ContainerID) && (!PreviousState || ChangedContainers.Contains(PreviousState->ContainerID)))
+		{
+			continue;
+		}
+
+		const FInventoryJournalItemState NewState = GetJournalItemState(*Item, ContainerID);
+		if(!PreviousState)
+		{
+			//Goes through the same code as the save format, minus its header and string table.
+			AppendRecord(EInventoryJournalOperation::AddItem, [&ContainerID, Item](FArchive& Archive)
+			{
+				Archive << ContainerID;
+				USG_InventorySerialization::WriteSingleItem(Archive, *Item, true);
+			});
+			ItemStates.Add(ItemID, NewState);
+			continue;
+		}
+
+		if(PreviousState->ContainerID != NewState.ContainerID || PreviousState->TileIndex != NewState.TileIndex || PreviousState->Rotation != NewState.Rotation)
+		{
+			AppendRecord(EInventoryJournalOperation::Move, [ItemID, &NewState](FArchive& Archive)
+			{
+				int32 MovedItemID = ItemID;
+				int32 NewContainerID = NewState.ContainerID;
+				int32 NewTileIndex = NewState.TileIndex;
+				uint8 NewRotation = NewState.Rotation;
+				Archive << MovedItemID;
+				Archive << NewContainerID;
+				Archive << NewTileIndex;
+				Archive << NewRotation;
+			});
+		}
+
+		if(PreviousState->Count != NewState.Count)
+		{
+			AppendRecord(EInventoryJournalOperation::CountChange, [ItemID, &NewState](FArchive& Archive)
+			{
+				int32 ChangedItemID = ItemID;
+				int32 NewCount = NewState.Count;
+				Archive << ChangedItemID;
+				Archive << NewCount;
+			});
+		}
+
+		if(PreviousState->TagsHash != NewState.TagsHash)
+		{
+			//Same as the save format, the item has already been validated.
+			const FTagFragment* LiveTagFragment = FindTagFragment(*Item);
+			FTagFragment TagFragment = LiveTagFragment ? *LiveTagFragment : FTagFragment();
+			TagFragment.Tags.AddTagFast(IFP_SkipValidation);
+			TagFragment.Tags.RemoveTag(IFP_IncludeLootTables);
+
+			TArray<uint8> TagData;
+			FMemoryWriter TagWriter(TagData, true);
+			FObjectAndNameAsStringProxyArchive TagArchive(TagWriter, false);
+			FTagFragment::StaticStruct()->SerializeItem(TagArchive, &TagFragment, nullptr);
+
+			AppendRecord(EInventoryJournalOperation::TagChange, [ItemID, &TagData](FArchive& Archive)
+			{
+				int32 ChangedItemID = ItemID;
+				Archive << ChangedItemID;
+				Archive << TagData;
+			});
+		}
+
+		ItemStates.Add(ItemID, NewState);
+	}
+
+	if(!ChangedContainers.IsEmpty())
+	{
+		TArray<uint8> PatchData;
+		if(USG_InventorySerialization::WriteContainerPatch(Inventory->ContainerSettings, ChangedContainers, true, PatchData))
+		{
+			AppendRecord(EInventoryJournalOperation::Containers, [&PatchData](FArchive& Archive)
+			{
+				Archive << PatchData;
+			});
+		}
+		CacheItemStates(Inventory, &ChangedContainers);
+	}
+
+	ChangedItems.Reset();
+	ChangedContainers.Reset();
+	Writer->Flush();
+
+	const int32 RecordsBeforeCompaction = UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->JournalRecordsBeforeCompaction;
+	if(RecordsBeforeCompaction > 0 && RecordsSinceCompaction >= RecordsBeforeCompaction)
+	{
+		Compact(Inventory);
+	}
+}
+
+void FInventoryJournal::Compact(UAC_Inventory* Inventory)
+{
+	check(IsInGameThread());
+
+	if(!Writer.IsValid() || Compacting || !IsValid(Inventory))
+	{
+		return;
+	}
+
+	TSharedRef<FInventoryJournalCompaction> Task = MakeShared<FInventoryJournalCompaction>();
+	USG_InventorySerialization::SnapshotContainers(Inventory->ContainerSettings, Task->Containers, Task->ItemInstances);
+
+	//The snapshot contains everything up to the last record, so it takes over its sequence.
+	const int64 SnapshotSequence = Sequence;
+	const uint32 CompactionRunID = RunID;
+	const FString CompactionPath = FilePath + TEXT(".compact");
+	Compacting = true;
+	RecordsSinceCompaction = 0;
+	RecordsDuringCompaction.Reset();
+
+	TWeakPtr<FInventoryJournal> WeakThis = AsShared();
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Task, WeakThis, SnapshotSequence, CompactionRunID, CompactionPath]()
+	{
+		TArray<uint8> SnapshotData;
+		if(USG_InventorySerialization::WriteContainerSnapshot(Task->Containers, Task->ItemInstances, true, SnapshotData))
+		{
+			TArray<uint8> FileData;
+			WriteHeader(FileData);
+			WriteRecord(FileData, SnapshotSequence, EInventoryJournalOperation::Snapshot, [&SnapshotData](FArchive& Archive)
+			{
+				Archive << SnapshotData;
+			});
+			Task->Success = FFileHelper::SaveArrayToFile(FileData, *CompactionPath);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Task, WeakThis, CompactionRunID, CompactionPath]()
+		{
+			TSharedPtr<FInventoryJournal> Journal = WeakThis.Pin();
+			if(!Journal.IsValid() || Journal->RunID != CompactionRunID)
+			{
+				//The journal has been stopped or restarted, this snapshot is no longer the latest.
+				IFileManager::Get().Delete(*CompactionPath, false, false, true);
+				return;
+			}
+
+			Journal->FinishCompaction(Task->Success, CompactionPath);
+		});
+	});
+}
+
+void FInventoryJournal::FinishCompaction(bool Success, const FString& CompactionPath)
+{
+	Compacting = false;
+	if(!Success)
+	{
+		//Nothing is lost, the old journal still has every record.
+		UE_LOG(LogInventoryFramework, Warning, TEXT("Could not compact inventory journal %s"), *FilePath);
+		IFileManager::Get().Delete(*CompactionPath, false, false, true);
+		RecordsDuringCompaction.Empty();
+		return;
+	}
+
+	Writer->Close();
+	Writer.Reset();
+
+	//Records written while the snapshot was being made come after it.
+	const bool Compacted = FFileHelper::SaveArrayToFile(RecordsDuringCompaction, *CompactionPath, &IFileManager::Get(), FILEWRITE_Append) &&
+		IFileManager::Get().Move(*FilePath, *CompactionPath, true, true);
+	RecordsDuringCompaction.Empty();
+	if(!Compacted)
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("Could not replace inventory journal %s with its compacted version"), *FilePath);
+		IFileManager::Get().Delete(*CompactionPath, false, false, true);
+	}
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if(!Writer.IsValid())
+	{
+		UE_LOG(LogInventoryFramework, Error, TEXT("Could not reopen inventory journal %s, no further changes will be journaled"), *FilePath);
+		Stop();
+	}
+}
+
+FString FInventoryJournal::GetJournalPath(const FString& JournalName)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("IFP"), TEXT("Journal"), FPaths::MakeValidFileName(JournalName) + TEXT(".ifpj"));
+}
+
+bool FInventoryJournal::Replay(const FString& JournalPath, int64 AfterSequence, TArray<FS_ContainerSettings>& InOutContainers, TArray<FLoadedItemInstance>& InOutItemInstances,
+	int64* OutLastSequence)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FInventoryJournal::Replay)
+
+	bool HasBase = AfterSequence >= 0;
+	int64 LastSequence = AfterSequence;
+	//Built once the first record needs to find an item.
+	FJournalReplayIndex ReplayIndex;
+	ReadRecords(JournalPath, [&](int64 RecordSequence, EInventoryJournalOperation Operation, FArchive& Payload)
+	{
+		if(Operation == EInventoryJournalOperation::Snapshot)
+		{
+			if(HasBase && RecordSequence <= LastSequence)
+			{
+				return true;
+			}
+
+			TArray<uint8> SnapshotData;
+			TArray<FS_ContainerSettings> SnapshotContainers;
+			TArray<FLoadedItemInstance> SnapshotItemInstances;
+			Payload << SnapshotData;
+			if(Payload.IsError() || !USG_InventorySerialization::ReadContainers(SnapshotData, SnapshotContainers, SnapshotItemInstances))
+			{
+				UE_LOG(LogInventoryFramework, Warning, TEXT("Snapshot %lld in inventory journal %s could not be read"), RecordSequence, *JournalPath);
+				return false;
+			}
+
+			InOutContainers = MoveTemp(SnapshotContainers);
+			InOutItemInstances = MoveTemp(SnapshotItemInstances);
+			ReplayIndex.Valid = false;
+			LastSequence = RecordSequence;
+			HasBase = true;
+			return true;
+		}
+
+		if(!HasBase || RecordSequence <= LastSequence)
+		{
+			return true;
+		}
+
+		if(RecordSequence != LastSequence + 1)
+		{
+			UE_LOG(LogInventoryFramework, Warning, TEXT("Inventory journal %s is missing records %lld to %lld, replay stopped"), *JournalPath, LastSequence + 1, RecordSequence - 1);
+			return false;
+		}
+
+		if(!ApplyJournalRecord(Operation, Payload, InOutContainers, InOutItemInstances, ReplayIndex))
+		{
+			UE_LOG(LogInventoryFramework, Warning, TEXT("Record %lld in inventory journal %s could not be applied, replay stopped"), RecordSequence, *JournalPath);
+			return false;
+		}
+
+		LastSequence = RecordSequence;
+		return true;
+	});
+
+	if(OutLastSequence)
+	{
+		*OutLastSequence = LastSequence;
+	}
+	return HasBase;
+}
+
+bool FInventoryJournal::ReadRecords(const FString& JournalPath, TFunctionRef<bool(int64 RecordSequence, EInventoryJournalOperation Operation, FArchive& Payload)> RecordRead)
+{
+	TArray<uint8> FileData;
+	if(!FFileHelper::LoadFileToArray(FileData, *JournalPath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData, true);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if(Reader.IsError() || Magic != JournalMagic || Version > JournalVersion)
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("%s is not an inventory journal, or is from a newer version"), *JournalPath);
+		return false;
+	}
+
+	while(Reader.Tell() < Reader.TotalSize())
+	{
+		uint32 Size = 0;
+		uint32 Checksum = 0;
+		Reader << Size;
+		Reader << Checksum;
+		if(Reader.IsError() || Size > Reader.TotalSize() - Reader.Tell())
+		{
+			UE_LOG(LogInventoryFramework, Warning, TEXT("Inventory journal %s ends in an incomplete record, it was interrupted while writing"), *JournalPath);
+			break;
+		}
+
+		TArray<uint8> Payload;
+		Payload.SetNumUninitialized(Size);
+		Reader.Serialize(Payload.GetData(), Size);
+		if(FCrc::MemCrc32(Payload.GetData(), Payload.Num()) != Checksum)
+		{
+			UE_LOG(LogInventoryFramework, Warning, TEXT("Inventory journal %s has a corrupt record, everything after it is ignored"), *JournalPath);
+			break;
+		}
+
+		FMemoryReader PayloadReader(Payload, true);
+		int64 RecordSequence = 0;
+		uint8 Operation = 0;
+		PayloadReader << RecordSequence;
+		PayloadReader << Operation;
+		if(PayloadReader.IsError() || !RecordRead(RecordSequence, static_cast<EInventoryJournalOperation>(Operation), PayloadReader))
+		{
+			break;
+		}
+	}
+
+	return true;
+}
+
+void FInventoryJournal::AppendRecord(EInventoryJournalOperation Operation, TFunctionRef<void(FArchive&)> WritePayload)
+{
+	TArray<uint8> Record;
+	WriteRecord(Record, ++Sequence, Operation, WritePayload);
+	Writer->Serialize(Record.GetData(), Record.Num());
+	RecordsSinceCompaction++;
+
+	if(Compacting)
+	{
+		RecordsDuringCompaction.Append(Record);
+	}
+}
+
+void FInventoryJournal::CacheItemStates(const UAC_Inventory* Inventory, const TSet<int32>* OnlyContainers)
+{
+	if(OnlyContainers)
+	{
+		for(auto It = ItemStates.CreateIterator(); It; ++It)
+		{
+			if(OnlyContainers->Contains(It.Value().ContainerID))
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+	else
+	{
+		ItemStates.Empty();
+	}
+
+	for(const FS_ContainerSettings& CurrentContainer : Inventory->ContainerSettings)
+	{
+		const int32 ContainerID = CurrentContainer.UniqueID.IdentityNumber;
+		if(OnlyContainers && !OnlyContainers->Contains(ContainerID))
+		{
+			continue;
+		}
+
+		for(const FS_InventoryItem& CurrentItem : CurrentContainer.Items)
+		{
+			if(CurrentItem.UniqueID.IdentityNumber > 0)
+			{
+				ItemStates.Add(CurrentItem.UniqueID.IdentityNumber, GetJournalItemState(CurrentItem, ContainerID));
+			}
+		}
+	}
+}
@@ -3,98 +3,1704 @@
 
 #include "Core/Data/SG_InventorySerialization.h"
 
+#include "InventoryFrameworkPlugin.h"
 #include "Core/Components/AC_Inventory.h"
+#include "Core/Data/DS_InventoryFrameworkSettingsRuntime.h"
 #include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Data/InventoryJournal.h"
+#include "Core/Fragments/F_Tags.h"
+#include "Core/Fragments/FL_IFP_FragmentHelpers.h"
 #include "Core/Interfaces/I_Inventory.h"
+#include "Core/Items/DA_CoreItem.h"
 #include "Core/Objects/Parents/ItemInstance.h"
+#include "Engine/AssetManager.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Async/Async.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+//"IFPB", written at the start of every container save.
+static constexpr uint32 ContainerSaveMagic = 0x42504649;
+
+//"IFPP", written at the start of every patch written by WriteContainerPatch.
+static constexpr uint32 ContainerPatchMagic = 0x50504649;
+
+/**Bump this whenever the layout written by WriteContainers changes.
+ * Older versions must keep being readable.
+ * 2 - Fragments have flags saying how they were serialized.*/
+static constexpr int32 ContainerSaveVersion = 2;
+
+//The fragment was written by its FFragmentSerializer::Serialize instead of tagged properties.
+static constexpr uint8 FragmentFlag_CustomSerialize = 1 << 0;
+
+/**Every path is only written once, items and fragments refer to them by index.*/
+struct FContainerSaveStringTable
+{
+	TArray<FString> Strings;
+
+	TMap<FString, int32> Indexes;
+
+	/**Write the strings themselves instead of their index, for a single item
+	 * where a table would cost more than it saves. See WriteSingleItem.*/
+	bool Inline = false;
+
+	void Write(FArchive& Archive, const FString& String)
+	{
+		if(Inline)
+		{
+			FString InlineString = String;
+			Archive << InlineString;
+			return;
+		}
+
+		int32 Index = Add(String);
+		Archive << Index;
+	}
+
+	int32 Add(const FString& String)
+	{
+		if(String.IsEmpty())
+		{
+			return INDEX_NONE;
+		}
+
+		if(const int32* ExistingIndex = Indexes.Find(String))
+		{
+			return *ExistingIndex;
+		}
+
+		const int32 NewIndex = Strings.Add(String);
+		Indexes.Add(String, NewIndex);
+		return NewIndex;
+	}
+};
+
+static TMap<FName, FFragmentSerializer>& GetFragmentSerializers()
+{
+	static TMap<FName, FFragmentSerializer> FragmentSerializers;
+	return FragmentSerializers;
+}
+
+//Old fragment path to the fragment it has become.
+static TMap<FString, const UScriptStruct*>& GetFragmentRedirects()
+{
+	static TMap<FString, const UScriptStruct*> FragmentRedirects;
+	return FragmentRedirects;
+}
+
+/**True if @FragmentType has any property that can point to an object.
+ * Those objects would have to be found or loaded when the fragment is
+ * read or written, which can only be done on the game thread.*/
+static bool FragmentHasObjectReferences(const UScriptStruct* FragmentType)
+{
+	TArray<const FStructProperty*> EncounteredStructs;
+	for(TFieldIterator<FProperty> PropertyIterator(FragmentType); PropertyIterator; ++PropertyIterator)
+	{
+		if(PropertyIterator->ContainsObjectReference(EncounteredStructs, EPropertyObjectReferenceType::Strong | EPropertyObjectReferenceType::Weak))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**Fragments are written with tagged properties unless they have their own
+ * Serialize, so fields can be added or removed without breaking older saves.*/
+static void EncodeFragment(const UScriptStruct* FragmentType, const uint8* FragmentMemory, int32& OutVersion, uint8& OutFlags, TArray<uint8>& OutData)
+{
+	const FFragmentSerializer* Serializer = USG_InventorySerialization::FindFragmentSerializer(FragmentType);
+	OutVersion = Serializer ? Serializer->Version : 0;
+	OutFlags = 0;
+
+	FMemoryWriter FragmentWriter(OutData, true);
+	FObjectAndNameAsStringProxyArchive FragmentArchive(FragmentWriter, false);
+	if(Serializer && Serializer->Serialize)
+	{
+		OutFlags |= FragmentFlag_CustomSerialize;
+		Serializer->Serialize(FragmentArchive, const_cast<uint8*>(FragmentMemory));
+	}
+	else
+	{
+		const_cast<UScriptStruct*>(FragmentType)->SerializeItem(FragmentArchive, const_cast<uint8*>(FragmentMemory), nullptr);
+	}
+}
+
+/**Read a fragment written by EncodeFragment into @OutFragment.
+ * @CanResolveObjects should only be true on the game thread.
+ * @OutUpgraded is true if the fragment went through its Upgrade.*/
+static bool DecodeFragment(const UScriptStruct* FragmentType, bool Redirected, int32 Version, uint8 Flags, const TArray<uint8>& FragmentData,
+	bool CanResolveObjects, TInstancedStruct<FCoreFragment>& OutFragment, bool& OutUpgraded)
+{
+	const FFragmentSerializer* Serializer = USG_InventorySerialization::FindFragmentSerializer(FragmentType);
+	const bool SavedWithSerialize = (Flags & FragmentFlag_CustomSerialize) != 0;
+	const bool UsesSerialize = Serializer && Serializer->Serialize;
+	const int32 CurrentVersion = Serializer ? Serializer->Version : 0;
+
+	OutUpgraded = false;
+	OutFragment.InitializeAsScriptStruct(FragmentType);
+	FMemoryReader FragmentReader(FragmentData, true);
+	FObjectAndNameAsStringProxyArchive FragmentArchive(FragmentReader, CanResolveObjects);
+	bool FragmentRead = true;
+	if(Version == CurrentVersion && !Redirected && SavedWithSerialize == UsesSerialize)
+	{
+		if(SavedWithSerialize)
+		{
+			Serializer->Serialize(FragmentArchive, OutFragment.GetMutableMemory());
+		}
+		else
+		{
+			const_cast<UScriptStruct*>(FragmentType)->SerializeItem(FragmentArchive, OutFragment.GetMutableMemory(), nullptr);
+		}
+	}
+	else if(Serializer && Serializer->Upgrade)
+	{
+		FragmentRead = Serializer->Upgrade(FragmentArchive, Version, SavedWithSerialize, OutFragment.GetMutableMemory());
+		OutUpgraded = true;
+	}
+	else if(!SavedWithSerialize)
+	{
+		//No upgrade, tagged properties still match every property that kept its name.
+		const_cast<UScriptStruct*>(FragmentType)->SerializeItem(FragmentArchive, OutFragment.GetMutableMemory(), nullptr);
+	}
+	else
+	{
+		FragmentRead = false;
+	}
+
+	if(!FragmentRead || FragmentReader.IsError())
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("Fragment %s (version %d) could not be read, it will be skipped"), *FragmentType->GetName(), Version);
+		return false;
+	}
+
+	return true;
+}
+
+static void WriteFragment(FArchive& Archive, const UScriptStruct* FragmentType, const uint8* FragmentMemory, FContainerSaveStringTable& StringTable)
+{
+	FString TypePath;
+	int32 Version = 0;
+	uint8 Flags = 0;
+	TArray<uint8> FragmentData;
+	if(FragmentType == FSerializedFragment::StaticStruct())
+	{
+		//Already encoded by SnapshotContainers or ReadContainers, written back as it is.
+		const FSerializedFragment& SerializedFragment = *reinterpret_cast<const FSerializedFragment*>(FragmentMemory);
+		TypePath = SerializedFragment.TypePath;
+		Version = SerializedFragment.Version;
+		Flags = SerializedFragment.Flags;
+		FragmentData = SerializedFragment.Data;
+	}
+	else
+	{
+		TypePath = FragmentType->GetPathName();
+		EncodeFragment(FragmentType, FragmentMemory, Version, Flags, FragmentData);
+	}
+
+	//The size is written first so the reader can skip fragments it doesn't know.
+	StringTable.Write(Archive, TypePath);
+	Archive << Version;
+	Archive << Flags;
+	Archive << FragmentData;
+}
+
+/**Tag a container or item so it skips validation when it is loaded.
+ * Items also stop including their loot tables, they have already been rolled.*/
+static void TagAsValidated(FTagFragment& TagFragment, bool IsItem)
+{
+	TagFragment.Tags.AddTagFast(IFP_SkipValidation);
+	if(IsItem)
+	{
+		TagFragment.Tags.RemoveTag(IFP_IncludeLootTables);
+	}
+}
+
+static void WriteFragments(FArchive& Archive, const TArray<TInstancedStruct<FCoreFragment>>& Fragments, FContainerSaveStringTable& StringTable, bool MarkAsValidated, bool IsItem)
+{
+	/**Same as GetContainersForSaveState, containers and items that have already
+	 * been validated are tagged so the validation is skipped when loading.
+	 * The tag fragment is copied so the live data isn't touched.*/
+	FTagFragment ValidatedTags;
+	bool HasTagFragment = false;
+	int32 FragmentCount = 0;
+	for(const TInstancedStruct<FCoreFragment>& CurrentFragment : Fragments)
+	{
+		if(!CurrentFragment.IsValid())
+		{
+			continue;
+		}
+
+		FragmentCount++;
+		if(CurrentFragment.GetScriptStruct() == FTagFragment::StaticStruct())
+		{
+			HasTagFragment = true;
+			ValidatedTags = CurrentFragment.Get<FTagFragment>();
+		}
+	}
+
+	if(MarkAsValidated)
+	{
+		TagAsValidated(ValidatedTags, IsItem);
+
+		if(!HasTagFragment)
+		{
+			FragmentCount++;
+		}
+	}
+
+	Archive << FragmentCount;
+	for(const TInstancedStruct<FCoreFragment>& CurrentFragment : Fragments)
+	{
+		if(!CurrentFragment.IsValid())
+		{
+			continue;
+		}
+
+		const UScriptStruct* FragmentType = CurrentFragment.GetScriptStruct();
+		if(MarkAsValidated && FragmentType == FTagFragment::StaticStruct())
+		{
+			WriteFragment(Archive, FragmentType, reinterpret_cast<const uint8*>(&ValidatedTags), StringTable);
+			continue;
+		}
+
+		WriteFragment(Archive, FragmentType, CurrentFragment.GetMemory(), StringTable);
+	}
+
+	if(MarkAsValidated && !HasTagFragment)
+	{
+		WriteFragment(Archive, FTagFragment::StaticStruct(), reinterpret_cast<const uint8*>(&ValidatedTags), StringTable);
+	}
+}
+
+/**A fragment type of a save, with everything needed to read it.*/
+struct FLoadedFragmentType
+{
+	const UScriptStruct* Type = nullptr;
+
+	const FFragmentSerializer* Serializer = nullptr;
+
+	//Saved under another path, see RegisterFragmentRedirect.
+	bool Redirected = false;
+
+	//See FragmentHasObjectReferences.
+	bool HasObjectReferences = false;
+};
+
+/**Resolves the fragment types of a save. Each path is only looked up once.*/
+struct FContainerLoadStringTable
+{
+	TArray<FString> Strings;
+
+	//ContainerSaveVersion of the save being read.
+	int32 SaveVersion = 0;
+
+	TMap<int32, FLoadedFragmentType> FragmentTypes;
+
+	//How many fragments of each type went through their Upgrade.
+	TMap<const UScriptStruct*, int32> UpgradedFragments;
+
+	//The strings are written where they are used, see FContainerSaveStringTable::Inline.
+	bool Inline = false;
+
+	const FString* GetString(int32 Index) const
+	{
+		return Strings.IsValidIndex(Index) ? &Strings[Index] : nullptr;
+	}
+
+	/**Read what FContainerSaveStringTable::Write wrote. Inline strings are
+	 * added to Strings, so everything after this can stick to indexes.*/
+	int32 Read(FArchive& Archive)
+	{
+		int32 Index = INDEX_NONE;
+		if(!Inline)
+		{
+			Archive << Index;
+			return Index;
+		}
+
+		FString String;
+		Archive << String;
+		if(!String.IsEmpty())
+		{
+			Index = Strings.Find(String);
+			if(Index == INDEX_NONE)
+			{
+				Index = Strings.Add(MoveTemp(String));
+			}
+		}
+		return Index;
+	}
+
+	const FLoadedFragmentType* GetFragmentType(int32 Index)
+	{
+		if(const FLoadedFragmentType* ExistingType = FragmentTypes.Find(Index))
+		{
+			return ExistingType->Type ? ExistingType : nullptr;
+		}
+
+		FLoadedFragmentType LoadedType;
+		if(const FString* Path = GetString(Index))
+		{
+			if(const UScriptStruct* const* RedirectedType = GetFragmentRedirects().Find(*Path))
+			{
+				LoadedType.Type = *RedirectedType;
+				LoadedType.Redirected = true;
+			}
+			else
+			{
+				//The safe version, this can run on a worker thread while garbage is being collected.
+				LoadedType.Type = FindObjectSafe<UScriptStruct>(nullptr, **Path);
+			}
+
+			if(LoadedType.Type && !LoadedType.Type->IsChildOf(FCoreFragment::StaticStruct()))
+			{
+				LoadedType.Type = nullptr;
+			}
+
+			if(!LoadedType.Type)
+			{
+				UE_LOG(LogInventoryFramework, Warning, TEXT("Fragment %s no longer exists, it will be skipped while loading"), **Path);
+			}
+			else
+			{
+				LoadedType.HasObjectReferences = FragmentHasObjectReferences(LoadedType.Type);
+			}
+		}
+
+		LoadedType.Serializer = USG_InventorySerialization::FindFragmentSerializer(LoadedType.Type);
+		const FLoadedFragmentType& AddedType = FragmentTypes.Add(Index, LoadedType);
+		return AddedType.Type ? &AddedType : nullptr;
+	}
+
+	//One line per fragment type, rather than one per fragment.
+	void LogUpgradedFragments() const
+	{
+		for(const TPair<const UScriptStruct*, int32>& CurrentType : UpgradedFragments)
+		{
+			UE_LOG(LogInventoryFramework, Log, TEXT("Upgraded %d %s fragments from an older save"), CurrentType.Value, *CurrentType.Key->GetName());
+		}
+	}
+};
+
+static bool IsValidCount(FArchive& Archive, int32 Count)
+{
+	//Every entry takes at least one byte, anything bigger is a corrupt save.
+	return Count >= 0 && Count <= Archive.TotalSize() - Archive.Tell();
+}
+
+static bool ReadFragments(FArchive& Archive, TArray<TInstancedStruct<FCoreFragment>>& OutFragments, FContainerLoadStringTable& StringTable)
+{
+	int32 FragmentCount = 0;
+	Archive << FragmentCount;
+	if(!IsValidCount(Archive, FragmentCount))
+	{
+		return false;
+	}
+
+	OutFragments.Empty(FragmentCount);
+	for(int32 FragmentIndex = 0; FragmentIndex < FragmentCount; FragmentIndex++)
+	{
+		int32 Version = 0;
+		uint8 Flags = 0;
+		TArray<uint8> FragmentData;
+		const int32 TypeIndex = StringTable.Read(Archive);
+		Archive << Version;
+		if(StringTable.SaveVersion >= 2)
+		{
+			Archive << Flags;
+		}
+		Archive << FragmentData;
+		if(Archive.IsError())
+		{
+			return false;
+		}
+
+		const FLoadedFragmentType* LoadedType = StringTable.GetFragmentType(TypeIndex);
+		if(!LoadedType)
+		{
+			continue;
+		}
+
+		/**Objects can't be found outside of the game thread, not even ones that are
+		 * already in memory, garbage collection could be running.
+		 * ApplyLoadedContainers reads these once it's back on the game thread.*/
+		const bool IsGameThread = IsInGameThread();
+		if(LoadedType->HasObjectReferences && !IsGameThread)
+		{
+			FSerializedFragment SerializedFragment;
+			SerializedFragment.TypePath = *StringTable.GetString(TypeIndex);
+			SerializedFragment.Type = const_cast<UScriptStruct*>(LoadedType->Type);
+			SerializedFragment.Redirected = LoadedType->Redirected;
+			SerializedFragment.Version = Version;
+			SerializedFragment.Flags = Flags;
+			SerializedFragment.Data = MoveTemp(FragmentData);
+			OutFragments.Add(TInstancedStruct<FCoreFragment>::Make<FSerializedFragment>(MoveTemp(SerializedFragment)));
+			continue;
+		}
+
+		TInstancedStruct<FCoreFragment> Fragment;
+		bool Upgraded = false;
+		if(!DecodeFragment(LoadedType->Type, LoadedType->Redirected, Version, Flags, FragmentData, IsGameThread, Fragment, Upgraded))
+		{
+			continue;
+		}
+
+		if(Upgraded)
+		{
+			StringTable.UpgradedFragments.FindOrAdd(LoadedType->Type)++;
+		}
+
+		OutFragments.Add(MoveTemp(Fragment));
+	}
+
+	return true;
+}
+
+/**@SnapshotInstance The item instance from SnapshotContainers,
+ * only used if the item doesn't have its item instance object.*/
+static void WriteContainerItem(FArchive& Archive, const FS_InventoryItem& Item, FContainerSaveStringTable& StringTable, bool MarkAsValidated,
+	const FLoadedItemInstance* SnapshotInstance)
+{
+	const FSoftObjectPath AssetPath = Item.ItemAssetSoftReference.IsNull()
+		? FSoftObjectPath(Item.ItemAsset)
+		: Item.ItemAssetSoftReference.ToSoftObjectPath();
+
+	int32 ItemIdentityNumber = Item.UniqueID.IdentityNumber;
+	int32 TileIndex = Item.TileIndex;
+	uint8 Rotation = Item.Rotation.GetValue();
+	int32 Count = Item.Count;
+	Archive << ItemIdentityNumber;
+	StringTable.Write(Archive, AssetPath.ToString());
+	Archive << TileIndex;
+	Archive << Rotation;
+	Archive << Count;
+	WriteFragments(Archive, Item.ItemFragments, StringTable, MarkAsValidated, true);
+
+	FString InstanceClassPath;
+	TArray<uint8> InstanceData;
+	if(IsValid(Item.ItemInstance))
+	{
+		InstanceClassPath = Item.ItemInstance->GetClass()->GetPathName();
+		FMemoryWriter InstanceWriter(InstanceData, true);
+		FSaveGameArchive InstanceArchive(InstanceWriter);
+		Item.ItemInstance->Serialize(InstanceArchive);
+	}
+	else if(SnapshotInstance)
+	{
+		InstanceClassPath = SnapshotInstance->ObjectClass.ToString();
+		InstanceData = SnapshotInstance->PropertyData;
+	}
+
+	StringTable.Write(Archive, InstanceClassPath);
+	if(!InstanceClassPath.IsEmpty())
+	{
+		Archive << InstanceData;
+	}
+}
+
+/**@SnapshotInstances Item instances from SnapshotContainers, keyed by container and item index.
+ * Only used for items that don't have their item instance object.*/
+static void WriteContainer(FArchive& Archive, const FS_ContainerSettings& Container, int32 ContainerIndex, FContainerSaveStringTable& StringTable, bool MarkAsValidated,
+	const TMap<FIntPoint, const FLoadedItemInstance*>* SnapshotInstances)
+{
+	int32 IdentityNumber = Container.UniqueID.IdentityNumber;
+	uint8 ContainerType = Container.ContainerType.GetValue();
+	uint8 Style = Container.Style.GetValue();
+	uint8 InfinityDirection = Container.InfinityDirection.GetValue();
+	FIntPoint Dimensions = Container.Dimensions;
+	FIntPoint BelongsToItem = Container.BelongsToItem;
+	Archive << IdentityNumber;
+	StringTable.Write(Archive, Container.ContainerIdentifier.IsValid() ? Container.ContainerIdentifier.ToString() : FString());
+	Archive << ContainerType;
+	Archive << Style;
+	Archive << InfinityDirection;
+	Archive << Dimensions;
+	Archive << BelongsToItem;
+	WriteFragments(Archive, Container.ContainerFragments, StringTable, MarkAsValidated, false);
+
+	int32 ItemCount = Container.Items.Num();
+	Archive << ItemCount;
+	for(int32 ItemIndex = 0; ItemIndex < Container.Items.Num(); ItemIndex++)
+	{
+		const FLoadedItemInstance* const* SnapshotInstance = SnapshotInstances ? SnapshotInstances->Find(FIntPoint(ContainerIndex, ItemIndex)) : nullptr;
+		WriteContainerItem(Archive, Container.Items[ItemIndex], StringTable, MarkAsValidated, SnapshotInstance ? *SnapshotInstance : nullptr);
+	}
+}
+
+/**Read what WriteContainerItem wrote. @OutItemInstance is only set if the item had one.*/
+static bool ReadContainerItem(FArchive& Archive, FS_InventoryItem& Item, FContainerLoadStringTable& StringTable, TOptional<FLoadedItemInstance>& OutItemInstance)
+{
+	uint8 Rotation = 0;
+	Archive << Item.UniqueID.IdentityNumber;
+	const int32 AssetIndex = StringTable.Read(Archive);
+	Archive << Item.TileIndex;
+	Archive << Rotation;
+	Archive << Item.Count;
+	Item.Rotation = static_cast<ERotation>(Rotation);
+	if(const FString* AssetPath = StringTable.GetString(AssetIndex))
+	{
+		Item.ItemAssetSoftReference = TSoftObjectPtr<UDA_CoreItem>(FSoftObjectPath(*AssetPath));
+	}
+
+	if(!ReadFragments(Archive, Item.ItemFragments, StringTable))
+	{
+		return false;
+	}
+
+	const int32 InstanceClassIndex = StringTable.Read(Archive);
+	if(InstanceClassIndex != INDEX_NONE)
+	{
+		FLoadedItemInstance& ItemInstance = OutItemInstance.Emplace();
+		if(const FString* ClassPath = StringTable.GetString(InstanceClassIndex))
+		{
+			ItemInstance.ObjectClass = FSoftClassPath(*ClassPath);
+		}
+		Archive << ItemInstance.PropertyData;
+	}
+
+	return !Archive.IsError();
+}
+
+static bool ReadContainer(FArchive& Archive, FS_ContainerSettings& Container, int32 ContainerIndex, FContainerLoadStringTable& StringTable, TArray<FLoadedItemInstance>& OutItemInstances)
+{
+	uint8 ContainerType = 0;
+	uint8 Style = 0;
+	uint8 InfinityDirection = 0;
+	Archive << Container.UniqueID.IdentityNumber;
+	const int32 IdentifierIndex = StringTable.Read(Archive);
+	Archive << ContainerType;
+	Archive << Style;
+	Archive << InfinityDirection;
+	Archive << Container.Dimensions;
+	Archive << Container.BelongsToItem;
+	Container.ContainerIndex = ContainerIndex;
+	Container.ContainerType = static_cast<EContainerType>(ContainerType);
+	Container.Style = static_cast<EContainerStyle>(Style);
+	Container.InfinityDirection = static_cast<EContainerInfinityDirection>(InfinityDirection);
+	if(const FString* Identifier = StringTable.GetString(IdentifierIndex))
+	{
+		Container.ContainerIdentifier = FGameplayTag::RequestGameplayTag(FName(*Identifier), false);
+	}
+
+	if(!ReadFragments(Archive, Container.ContainerFragments, StringTable))
+	{
+		return false;
+	}
+
+	int32 ItemCount = 0;
+	Archive << ItemCount;
+	if(Archive.IsError() || !IsValidCount(Archive, ItemCount))
+	{
+		return false;
+	}
+
+	Container.Items.SetNum(ItemCount);
+	for(int32 ItemIndex = 0; ItemIndex < ItemCount; ItemIndex++)
+	{
+		FS_InventoryItem& Item = Container.Items[ItemIndex];
+		Item.ContainerIndex = ContainerIndex;
+		Item.ItemIndex = ItemIndex;
+
+		TOptional<FLoadedItemInstance> ItemInstance;
+		if(!ReadContainerItem(Archive, Item, StringTable, ItemInstance))
+		{
+			return false;
+		}
+
+		if(ItemInstance.IsSet())
+		{
+			FLoadedItemInstance& AddedInstance = OutItemInstances.Add_GetRef(MoveTemp(ItemInstance.GetValue()));
+			AddedInstance.ContainerIndex = ContainerIndex;
+			AddedInstance.ItemIndex = ItemIndex;
+		}
+	}
+
+	return true;
+}
+
+/**Write the header and string table, followed by the @Body that uses the string table.*/
+static bool FinishSave(uint32 Magic, FContainerSaveStringTable& StringTable, const TArray<uint8>& Body, TArray<uint8>& OutData)
+{
+	OutData.Reset();
+	FMemoryWriter Writer(OutData, true);
+	int32 Version = ContainerSaveVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << StringTable.Strings;
+	Writer.Serialize(const_cast<uint8*>(Body.GetData()), Body.Num());
+	return !Writer.IsError();
+}
+
+static bool ReadSaveHeader(FArchive& Archive, uint32 ExpectedMagic, FContainerLoadStringTable& OutStringTable)
+{
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Archive << Magic;
+	Archive << Version;
+	if(Archive.IsError() || Magic != ExpectedMagic)
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("Container save is not in the IFP save format"));
+		return false;
+	}
+
+	if(Version > ContainerSaveVersion)
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("Container save is version %d, this build only reads up to version %d"), Version, ContainerSaveVersion);
+		return false;
+	}
+
+	OutStringTable.SaveVersion = Version;
+	Archive << OutStringTable.Strings;
+	return !Archive.IsError();
+}
+
+//Same limit as DecompressContainers, anything bigger is a corrupt save.
+static constexpr int32 MaxUncompressedSaveSize = 256 * 1024 * 1024;
+
+static bool CompressContainerSave(const TArray<uint8>& RawData, TArray<uint8>& OutCompressedData)
+{
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, RawData.Num());
+	OutCompressedData.SetNumUninitialized(CompressedSize);
+	if(!FCompression::CompressMemory(NAME_Zlib, OutCompressedData.GetData(), CompressedSize, RawData.GetData(), RawData.Num()))
+	{
+		OutCompressedData.Reset();
+		return false;
+	}
+
+	OutCompressedData.SetNum(CompressedSize);
+	return true;
+}
+
+static bool DecompressContainerSave(const TArray<uint8>& CompressedData, int32 UncompressedSize, TArray<uint8>& OutRawData)
+{
+	if(UncompressedSize <= 0 || UncompressedSize > MaxUncompressedSaveSize)
+	{
+		return false;
+	}
+
+	OutRawData.SetNumUninitialized(UncompressedSize);
+	return FCompression::UncompressMemory(NAME_Zlib, OutRawData.GetData(), UncompressedSize, CompressedData.GetData(), CompressedData.Num());
+}
+
+/**Remember how far the journal of @Inventory was, so loading the record
+ * knows which records it still has to replay.*/
+static void UpdateRecordJournal(FContainerRecord& Record, UAC_Inventory* Inventory)
+{
+	if(!Inventory->IsJournaling())
+	{
+		Record.JournalPath.Empty();
+		Record.JournalSequence = 0;
+		return;
+	}
+
+	//Everything up to now is part of the save, so it has to be in the journal too.
+	Inventory->FlushJournal();
+	Record.JournalPath = Inventory->GetJournal()->GetFilePath();
+	Record.JournalSequence = Inventory->GetJournal()->GetSequence();
+}
+
+/**Everything an async save or load hands between the game thread and the worker.*/
+struct FAsyncContainerTask
+{
+	TArray<FS_ContainerSettings> Containers;
+
+	TArray<FLoadedItemInstance> ItemInstances;
+
+	bool MarkAsValidated = false;
+
+	FContainerRecord Record;
+
+	//Set by ReadContainerRecord when loading.
+	FString JournalPath;
+
+	int64 JournalSequence = 0;
+
+	bool Success = false;
+};
 
 void USG_InventorySerialization::SaveItemInstance(UItemInstance* ItemInstance)
 {
-	if(!IsValid(ItemInstance))
+	if(!IsValid(ItemInstance))
+	{
+		return;
+	}
+
+	//Prepare a record of the object
+	FItemInstanceRecord ObjectRecord;
+	FMemoryWriter MemoryWriter = FMemoryWriter(ObjectRecord.PropertyData, true);
+	FSaveGameArchive SaveGameArchive = FSaveGameArchive(MemoryWriter);
+
+	//Start serializing the record
+	FS_InventoryItem ItemData = ItemInstance->GetItemData();
+	ObjectRecord.ObjectClass = ItemInstance->GetClass();
+	ObjectRecord.ContainerIndex = ItemData.ContainerIndex;
+	ObjectRecord.ItemIndex = ItemData.ItemIndex;
+	ObjectRecord.ItemID = ItemData.UniqueID.IdentityNumber;
+	ItemInstance->Serialize(SaveGameArchive);
+
+	//Saving the same item again replaces its old record.
+	const int32 ExistingIndex = FindItemInstanceRecord(ItemData);
+	if(ExistingIndex != INDEX_NONE)
+	{
+		ItemInstanceRecords[ExistingIndex] = MoveTemp(ObjectRecord);
+		return;
+	}
+
+	const int32 NewIndex = ItemInstanceRecords.Add(MoveTemp(ObjectRecord));
+	if(ItemInstanceRecords[NewIndex].ItemID > 0)
+	{
+		ItemInstanceRecordIndexes.Add(ItemInstanceRecords[NewIndex].ItemID, NewIndex);
+	}
+	else
+	{
+		LegacyItemInstanceRecordIndexes.Add(FIntPoint(ItemData.ContainerIndex, ItemData.ItemIndex), NewIndex);
+	}
+}
+
+void USG_InventorySerialization::LoadItemInstance(FS_InventoryItem Item)
+{
+	if(!Item.IsValid() || !IsValid(Item.ItemInstance))
+	{
+		return;
+	}
+
+	if(!UFL_InventoryFramework::AreItemDirectionsValid(Item.UniqueID, Item.ContainerIndex, Item.ItemIndex))
+	{
+		return;
+	}
+
+	const int32 RecordIndex = FindItemInstanceRecord(Item);
+	if(RecordIndex != INDEX_NONE)
+	{
+		ReadItemInstanceRecord(ItemInstanceRecords[RecordIndex], Item.ItemInstance);
+	}
+}
+
+int32 USG_InventorySerialization::LoadAllItemInstances(UAC_Inventory* Inventory)
+{
+	if(!IsValid(Inventory))
+	{
+		return 0;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(USG_InventorySerialization::LoadAllItemInstances)
+
+	int32 LoadedCount = 0;
+	for(const FItemInstanceRecord& CurrentRecord : ItemInstanceRecords)
+	{
+		FIntPoint Directions(CurrentRecord.ContainerIndex, CurrentRecord.ItemIndex);
+		if(CurrentRecord.ItemID > 0)
+		{
+			const FS_IDMapEntry* IDMapEntry = Inventory->ID_Map.Find(CurrentRecord.ItemID);
+			if(!IDMapEntry || IDMapEntry->IsContainer)
+			{
+				continue;
+			}
+			Directions = IDMapEntry->Directions;
+		}
+
+		if(!Inventory->ContainerSettings.IsValidIndex(Directions.X) || !Inventory->ContainerSettings[Directions.X].Items.IsValidIndex(Directions.Y))
+		{
+			continue;
+		}
+
+		UItemInstance* ItemInstance = Inventory->ContainerSettings[Directions.X].Items[Directions.Y].ItemInstance;
+		if(!IsValid(ItemInstance) || (CurrentRecord.ObjectClass && !ItemInstance->IsA(CurrentRecord.ObjectClass)))
+		{
+			continue;
+		}
+
+		ReadItemInstanceRecord(CurrentRecord, ItemInstance);
+		LoadedCount++;
+	}
+
+	return LoadedCount;
+}
+
+int32 USG_InventorySerialization::FindItemInstanceRecord(const FS_InventoryItem& Item)
+{
+	if(!ItemInstanceRecordIndexesBuilt)
+	{
+		RefreshItemInstanceRecordIndexes();
+	}
+
+	if(Item.UniqueID.IdentityNumber > 0)
+	{
+		if(const int32* RecordIndex = ItemInstanceRecordIndexes.Find(Item.UniqueID.IdentityNumber))
+		{
+			return *RecordIndex;
+		}
+	}
+
+	const int32* RecordIndex = LegacyItemInstanceRecordIndexes.Find(FIntPoint(Item.ContainerIndex, Item.ItemIndex));
+	return RecordIndex ? *RecordIndex : INDEX_NONE;
+}
+
+void USG_InventorySerialization::RefreshItemInstanceRecordIndexes()
+{
+	ItemInstanceRecordIndexes.Empty(ItemInstanceRecords.Num());
+	LegacyItemInstanceRecordIndexes.Empty();
+	for(int32 RecordIndex = 0; RecordIndex < ItemInstanceRecords.Num(); RecordIndex++)
+	{
+		//Older saves could have the same item more than once, the last one is the newest.
+		const FItemInstanceRecord& CurrentRecord = ItemInstanceRecords[RecordIndex];
+		if(CurrentRecord.ItemID > 0)
+		{
+			ItemInstanceRecordIndexes.Add(CurrentRecord.ItemID, RecordIndex);
+		}
+		else
+		{
+			LegacyItemInstanceRecordIndexes.Add(FIntPoint(CurrentRecord.ContainerIndex, CurrentRecord.ItemIndex), RecordIndex);
+		}
+	}
+	ItemInstanceRecordIndexesBuilt = true;
+}
+
+void USG_InventorySerialization::ReadItemInstanceRecord(const FItemInstanceRecord& Record, UItemInstance* ItemInstance)
+{
+	FMemoryReader Reader = FMemoryReader(Record.PropertyData, true);
+	FSaveGameArchive Archive = FSaveGameArchive(Reader);
+	ItemInstance->Serialize(Archive);
+}
+
+bool USG_InventorySerialization::SaveContainersForActor(AActor* Actor)
+{
+	UAC_Inventory* Inventory = GetInventoryForActor(Actor);
+	if(!Inventory)
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, "Could not save containers for actor, it has no inventory component");
+		return false;
+	}
+
+	const FString ActorName = Actor->GetName();
+	FContainerRecord* ContainerRecord = FindContainerRecord(ActorName);
+	if(!ContainerRecord)
+	{
+		ContainerRecord = &ContainerRecords.AddDefaulted_GetRef();
+		ContainerRecord->ActorName = ActorName;
+	}
+
+	ContainerRecord->Patches.Empty();
+	ContainerRecord->CanBePatched = false;
+	ContainerRecord->UncompressedSize = 0;
+	ContainerRecord->Generation++;
+	if(!WriteContainers(Inventory->ContainerSettings, Inventory->Initialized, ContainerRecord->Data))
+	{
+		return false;
+	}
+
+	//Patches refer to containers by IdentityNumber, which are only assigned once the component has started.
+	ContainerRecord->CanBePatched = Inventory->Initialized;
+	UpdateRecordJournal(*ContainerRecord, Inventory);
+	Inventory->ClearDirtyContainers();
+	return true;
+}
+
+bool USG_InventorySerialization::SaveDirtyContainersForActor(AActor* Actor)
+{
+	UAC_Inventory* Inventory = GetInventoryForActor(Actor);
+	if(!Inventory)
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, "Could not save containers for actor, it has no inventory component");
+		return false;
+	}
+
+	FContainerRecord* ContainerRecord = FindContainerRecord(Actor->GetName());
+	const int32 PatchesBeforeCompaction = UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->ContainerPatchesBeforeCompaction;
+	if(!ContainerRecord || !ContainerRecord->CanBePatched || !Inventory->Initialized || ContainerRecord->Patches.Num() >= PatchesBeforeCompaction)
+	{
+		//Compact everything into a new snapshot.
+		return SaveContainersForActor(Actor);
+	}
+
+	if(Inventory->GetDirtyContainers().IsEmpty())
+	{
+		UpdateRecordJournal(*ContainerRecord, Inventory);
+		return true;
+	}
+
+	FContainerPatch& Patch = ContainerRecord->Patches.AddDefaulted_GetRef();
+	if(!WriteContainerPatch(Inventory->ContainerSettings, Inventory->GetDirtyContainers(), true, Patch.Data))
+	{
+		ContainerRecord->Patches.Pop();
+		return false;
+	}
+
+	UpdateRecordJournal(*ContainerRecord, Inventory);
+	Inventory->ClearDirtyContainers();
+	return true;
+}
+
+bool USG_InventorySerialization::LoadContainersForActor(AActor* Actor)
+{
+	UAC_Inventory* Inventory = GetInventoryForActor(Actor);
+	if(!Inventory)
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, "Could not load containers for actor, it has no inventory component");
+		return false;
+	}
+
+	const FString ActorName = Actor->GetName();
+	const FContainerRecord* ContainerRecord = FindContainerRecord(ActorName);
+	if(!ContainerRecord)
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, "Could not load containers for actor, it had not been saved in the past");
+		return false;
+	}
+
+	TArray<FS_ContainerSettings> Containers;
+	TArray<FLoadedItemInstance> ItemInstances;
+	int64 JournalSequence = 0;
+	if(!ReadContainerRecord(*ContainerRecord, Containers, ItemInstances, &JournalSequence))
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, FString::Printf(TEXT("Could not load containers for %s, the save is corrupt or from a newer version"), *ActorName));
+		return false;
+	}
+
+	ApplyLoadedContainers(Inventory, MoveTemp(Containers), ItemInstances);
+
+	//The component now matches the save, so nothing is dirty.
+	Inventory->ClearDirtyContainers();
+	Inventory->SetLoadedJournal(ContainerRecord->JournalPath, JournalSequence);
+	return true;
+}
+
+bool USG_InventorySerialization::WriteContainers(const TArray<FS_ContainerSettings>& Containers, bool MarkAsValidated, TArray<uint8>& OutData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USG_InventorySerialization::WriteContainers)
+
+	FContainerSaveStringTable StringTable;
+
+	/**The body is written first so the string table is complete,
+	 * then both are written after the header.*/
+	TArray<uint8> Body;
+	FMemoryWriter BodyWriter(Body, true);
+
+	int32 ContainerCount = Containers.Num();
+	BodyWriter << ContainerCount;
+	for(int32 ContainerIndex = 0; ContainerIndex < Containers.Num(); ContainerIndex++)
+	{
+		WriteContainer(BodyWriter, Containers[ContainerIndex], ContainerIndex, StringTable, MarkAsValidated, nullptr);
+	}
+
+	return !BodyWriter.IsError() && FinishSave(ContainerSaveMagic, StringTable, Body, OutData);
+}
+
+bool USG_InventorySerialization::WriteContainerSnapshot(const TArray<FS_ContainerSettings>& Containers, const TArray<FLoadedItemInstance>& ItemInstances, bool MarkAsValidated, TArray<uint8>& OutData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USG_InventorySerialization::WriteContainerSnapshot)
+
+	TMap<FIntPoint, const FLoadedItemInstance*> SnapshotInstances;
+	SnapshotInstances.Reserve(ItemInstances.Num());
+	for(const FLoadedItemInstance& CurrentInstance : ItemInstances)
+	{
+		SnapshotInstances.Add(FIntPoint(CurrentInstance.ContainerIndex, CurrentInstance.ItemIndex), &CurrentInstance);
+	}
+
+	FContainerSaveStringTable StringTable;
+	TArray<uint8> Body;
+	FMemoryWriter BodyWriter(Body, true);
+
+	int32 ContainerCount = Containers.Num();
+	BodyWriter << ContainerCount;
+	for(int32 ContainerIndex = 0; ContainerIndex < Containers.Num(); ContainerIndex++)
+	{
+		WriteContainer(BodyWriter, Containers[ContainerIndex], ContainerIndex, StringTable, MarkAsValidated, &SnapshotInstances);
+	}
+
+	return !BodyWriter.IsError() && FinishSave(ContainerSaveMagic, StringTable, Body, OutData);
+}
+
+bool USG_InventorySerialization::ReadContainers(const TArray<uint8>& Data, TArray<FS_ContainerSettings>& OutContainers, TArray<FLoadedItemInstance>& OutItemInstances)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USG_InventorySerialization::ReadContainers)
+
+	OutContainers.Reset();
+	OutItemInstances.Reset();
+
+	FMemoryReader Reader(Data, true);
+	FContainerLoadStringTable StringTable;
+	if(!ReadSaveHeader(Reader, ContainerSaveMagic, StringTable))
+	{
+		return false;
+	}
+
+	int32 ContainerCount = 0;
+	Reader << ContainerCount;
+	if(Reader.IsError() || !IsValidCount(Reader, ContainerCount))
+	{
+		return false;
+	}
+
+	OutContainers.SetNum(ContainerCount);
+	for(int32 ContainerIndex = 0; ContainerIndex < ContainerCount; ContainerIndex++)
+	{
+		if(!ReadContainer(Reader, OutContainers[ContainerIndex], ContainerIndex, StringTable, OutItemInstances))
+		{
+			return false;
+		}
+	}
+
+	StringTable.LogUpgradedFragments();
+	return !Reader.IsError();
+}
+
+void USG_InventorySerialization::WriteSingleItem(FArchive& Archive, const FS_InventoryItem& Item, bool MarkAsValidated)
+{
+	FContainerSaveStringTable StringTable;
+	StringTable.Inline = true;
+	WriteContainerItem(Archive, Item, StringTable, MarkAsValidated, nullptr);
+}
+
+bool USG_InventorySerialization::ReadSingleItem(FArchive& Archive, FS_InventoryItem& OutItem, TOptional<FLoadedItemInstance>& OutItemInstance)
+{
+	FContainerLoadStringTable StringTable;
+	StringTable.Inline = true;
+	StringTable.SaveVersion = ContainerSaveVersion;
+	const bool Success = ReadContainerItem(Archive, OutItem, StringTable, OutItemInstance);
+	StringTable.LogUpgradedFragments();
+	return Success;
+}
+
+bool USG_InventorySerialization::WriteContainerPatch(const TArray<FS_ContainerSettings>& Containers, const TSet<int32>& DirtyContainers, bool MarkAsValidated, TArray<uint8>& OutData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USG_InventorySerialization::WriteContainerPatch)
+
+	FContainerSaveStringTable StringTable;
+	TArray<uint8> Body;
+	FMemoryWriter BodyWriter(Body, true);
+
+	/**The order of every container is always written, it's cheap and
+	 * takes care of removed and reordered containers.*/
+	TArray<int32> ContainerOrder;
+	ContainerOrder.Reserve(Containers.Num());
+	int32 ChangedCount = 0;
+	for(const FS_ContainerSettings& CurrentContainer : Containers)
+	{
+		ContainerOrder.Add(CurrentContainer.UniqueID.IdentityNumber);
+		if(DirtyContainers.Contains(CurrentContainer.UniqueID.IdentityNumber))
+		{
+			ChangedCount++;
+		}
+	}
+
+	BodyWriter << ContainerOrder;
+	BodyWriter << ChangedCount;
+	for(int32 ContainerIndex = 0; ContainerIndex < Containers.Num(); ContainerIndex++)
+	{
+		if(DirtyContainers.Contains(Containers[ContainerIndex].UniqueID.IdentityNumber))
+		{
+			WriteContainer(BodyWriter, Containers[ContainerIndex], ContainerIndex, StringTable, MarkAsValidated, nullptr);
+		}
+	}
+
+	return !BodyWriter.IsError() && FinishSave(ContainerPatchMagic, StringTable, Body, OutData);
+}
+
+bool USG_InventorySerialization::ApplyContainerPatch(const TArray<uint8>& Data, TArray<FS_ContainerSettings>& InOutContainers, TArray<FLoadedItemInstance>& InOutItemInstances)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USG_InventorySerialization::ApplyContainerPatch)
+
+	FMemoryReader Reader(Data, true);
+	FContainerLoadStringTable StringTable;
+	if(!ReadSaveHeader(Reader, ContainerPatchMagic, StringTable))
+	{
+		return false;
+	}
+
+	TArray<int32> ContainerOrder;
+	int32 ChangedCount = 0;
+	Reader << ContainerOrder;
+	Reader << ChangedCount;
+	if(Reader.IsError() || !IsValidCount(Reader, ChangedCount))
+	{
+		return false;
+	}
+
+	TArray<FS_ContainerSettings> ChangedContainers;
+	TArray<FLoadedItemInstance> ChangedItemInstances;
+	ChangedContainers.SetNum(ChangedCount);
+	for(int32 ChangedIndex = 0; ChangedIndex < ChangedCount; ChangedIndex++)
+	{
+		if(!ReadContainer(Reader, ChangedContainers[ChangedIndex], ChangedIndex, StringTable, ChangedItemInstances))
+		{
+			return false;
+		}
+	}
+	StringTable.LogUpgradedFragments();
+
+	TMap<int32, int32> ChangedIndexes;
+	for(int32 ChangedIndex = 0; ChangedIndex < ChangedContainers.Num(); ChangedIndex++)
+	{
+		ChangedIndexes.Add(ChangedContainers[ChangedIndex].UniqueID.IdentityNumber, ChangedIndex);
+	}
+
+	TMap<int32, int32> ExistingIndexes;
+	for(int32 ExistingIndex = 0; ExistingIndex < InOutContainers.Num(); ExistingIndex++)
+	{
+		ExistingIndexes.Add(InOutContainers[ExistingIndex].UniqueID.IdentityNumber, ExistingIndex);
+	}
+
+	//Old index to new index, so item instances can follow their container.
+	TMap<int32, int32> ChangedRemap;
+	TMap<int32, int32> ExistingRemap;
+
+	TArray<FS_ContainerSettings> MergedContainers;
+	MergedContainers.Reserve(ContainerOrder.Num());
+	for(const int32 ContainerID : ContainerOrder)
+	{
+		const int32 NewIndex = MergedContainers.Num();
+		if(const int32* ChangedIndex = ChangedIndexes.Find(ContainerID))
+		{
+			MergedContainers.Add(MoveTemp(ChangedContainers[*ChangedIndex]));
+			ChangedRemap.Add(*ChangedIndex, NewIndex);
+		}
+		else if(const int32* ExistingIndex = ExistingIndexes.Find(ContainerID))
+		{
+			MergedContainers.Add(MoveTemp(InOutContainers[*ExistingIndex]));
+			ExistingRemap.Add(*ExistingIndex, NewIndex);
+		}
+		else
+		{
+			UE_LOG(LogInventoryFramework, Warning, TEXT("Container patch refers to container %d, which is not in the save it is patching"), ContainerID);
+			return false;
+		}
+
+		FS_ContainerSettings& MergedContainer = MergedContainers.Last();
+		MergedContainer.ContainerIndex = NewIndex;
+		for(FS_InventoryItem& CurrentItem : MergedContainer.Items)
+		{
+			CurrentItem.ContainerIndex = NewIndex;
+		}
+	}
+
+	TArray<FLoadedItemInstance> MergedItemInstances;
+	MergedItemInstances.Reserve(InOutItemInstances.Num() + ChangedItemInstances.Num());
+	for(FLoadedItemInstance& CurrentInstance : InOutItemInstances)
+	{
+		if(const int32* NewIndex = ExistingRemap.Find(CurrentInstance.ContainerIndex))
+		{
+			CurrentInstance.ContainerIndex = *NewIndex;
+			MergedItemInstances.Add(MoveTemp(CurrentInstance));
+		}
+	}
+	for(FLoadedItemInstance& CurrentInstance : ChangedItemInstances)
+	{
+		if(const int32* NewIndex = ChangedRemap.Find(CurrentInstance.ContainerIndex))
+		{
+			CurrentInstance.ContainerIndex = *NewIndex;
+			MergedItemInstances.Add(MoveTemp(CurrentInstance));
+		}
+	}
+
+	InOutContainers = MoveTemp(MergedContainers);
+	InOutItemInstances = MoveTemp(MergedItemInstances);
+	return true;
+}
+
+bool USG_InventorySerialization::ReadContainerRecord(const FContainerRecord& Record, TArray<FS_ContainerSettings>& OutContainers, TArray<FLoadedItemInstance>& OutItemInstances,
+	int64* OutJournalSequence)
+{
+	if(OutJournalSequence)
+	{
+		*OutJournalSequence = Record.JournalSequence;
+	}
+
+	if(Record.UncompressedSize > 0)
+	{
+		TArray<uint8> RawData;
+		if(!DecompressContainerSave(Record.Data, Record.UncompressedSize, RawData) || !ReadContainers(RawData, OutContainers, OutItemInstances))
+		{
+			return false;
+		}
+	}
+	else if(!ReadContainers(Record.Data, OutContainers, OutItemInstances))
+	{
+		return false;
+	}
+
+	for(const FContainerPatch& CurrentPatch : Record.Patches)
 	{
+		if(!ApplyContainerPatch(CurrentPatch.Data, OutContainers, OutItemInstances))
+		{
+			return false;
+		}
+	}
+
+	if(!Record.JournalPath.IsEmpty() && FPaths::FileExists(Record.JournalPath))
+	{
+		//The save is still valid if the journal can't be replayed, it is only missing what happened after it.
+		FInventoryJournal::Replay(Record.JournalPath, Record.JournalSequence, OutContainers, OutItemInstances, OutJournalSequence);
+	}
+
+	return true;
+}
+
+void USG_InventorySerialization::SaveContainersForActorAsync(AActor* Actor, FContainerSerializationFinished OnFinished)
+{
+	check(IsInGameThread());
+
+	UAC_Inventory* Inventory = GetInventoryForActor(Actor);
+	if(!Inventory)
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, "Could not save containers for actor, it has no inventory component");
+		OnFinished.ExecuteIfBound(false);
 		return;
 	}
 
-	//Prepare a record of the object
-	FItemInstanceRecord ObjectRecord;
-	FMemoryWriter MemoryWriter = FMemoryWriter(ObjectRecord.PropertyData, true);
-	FSaveGameArchive SaveGameArchive = FSaveGameArchive(MemoryWriter);
+	const FString ActorName = Actor->GetName();
+	const FContainerRecord* ExistingRecord = FindContainerRecord(ActorName);
+	const uint32 Generation = ExistingRecord ? ExistingRecord->Generation : 0;
+	const int32 PatchCount = ExistingRecord ? ExistingRecord->Patches.Num() : 0;
 
-	//Start serializing the record
-	FS_InventoryItem ItemData = ItemInstance->GetItemData();
-	ObjectRecord.ObjectClass = ItemInstance->GetClass();
-	ObjectRecord.ContainerIndex = ItemData.ContainerIndex;
-	ObjectRecord.ItemIndex = ItemData.ItemIndex;
-	ItemInstance->Serialize(SaveGameArchive);
-	ItemInstanceRecords.Add(ObjectRecord);
+	TSharedRef<FAsyncContainerTask> Task = MakeShared<FAsyncContainerTask>();
+	Task->MarkAsValidated = Inventory->Initialized;
+	SnapshotContainers(Inventory->ContainerSettings, Task->Containers, Task->ItemInstances);
+	UpdateRecordJournal(Task->Record, Inventory);
+
+	//Anything that changes from now on is not part of this save.
+	Inventory->ClearDirtyContainers();
+
+	TWeakObjectPtr<USG_InventorySerialization> WeakThis = this;
+	TWeakObjectPtr<UAC_Inventory> WeakInventory = Inventory;
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Task, WeakThis, WeakInventory, ActorName, Generation, PatchCount, OnFinished]()
+	{
+		TArray<uint8> RawData;
+		Task->Success = WriteContainerSnapshot(Task->Containers, Task->ItemInstances, Task->MarkAsValidated, RawData) &&
+			CompressContainerSave(RawData, Task->Record.Data);
+		Task->Record.UncompressedSize = RawData.Num();
+
+		AsyncTask(ENamedThreads::GameThread, [Task, WeakThis, WeakInventory, ActorName, Generation, PatchCount, OnFinished]()
+		{
+			USG_InventorySerialization* SaveGame = WeakThis.Get();
+			FContainerRecord* ContainerRecord = SaveGame ? SaveGame->FindContainerRecord(ActorName) : nullptr;
+			if(ContainerRecord && ContainerRecord->Generation != Generation)
+			{
+				//A full save has been made while we were working, that one is newer.
+				Task->Success = false;
+			}
+
+			if(!SaveGame || !Task->Success)
+			{
+				//The changes we cleared never made it into a save.
+				if(UAC_Inventory* Inventory = WeakInventory.Get())
+				{
+					Inventory->MarkAllContainersDirty();
+				}
+				OnFinished.ExecuteIfBound(false);
+				return;
+			}
+
+			if(!ContainerRecord)
+			{
+				ContainerRecord = &SaveGame->ContainerRecords.AddDefaulted_GetRef();
+				ContainerRecord->ActorName = ActorName;
+			}
+
+			/**Patches written while we were working only contain changes made after
+			 * the snapshot, so they still apply on top of it.*/
+			ContainerRecord->Patches.RemoveAt(0, FMath::Min(PatchCount, ContainerRecord->Patches.Num()));
+			ContainerRecord->Data = MoveTemp(Task->Record.Data);
+			ContainerRecord->UncompressedSize = Task->Record.UncompressedSize;
+			ContainerRecord->CanBePatched = Task->MarkAsValidated;
+			ContainerRecord->Generation++;
+
+			//Patches written while we were working have already moved the journal further along.
+			if(ContainerRecord->JournalPath != Task->Record.JournalPath || ContainerRecord->JournalSequence < Task->Record.JournalSequence)
+			{
+				ContainerRecord->JournalPath = Task->Record.JournalPath;
+				ContainerRecord->JournalSequence = Task->Record.JournalSequence;
+			}
+			OnFinished.ExecuteIfBound(true);
+		});
+	});
 }
 
-void USG_InventorySerialization::LoadItemInstance(FS_InventoryItem Item)
+void USG_InventorySerialization::LoadContainersForActorAsync(AActor* Actor, FContainerSerializationFinished OnFinished)
 {
-	if(!Item.IsValid())
+	check(IsInGameThread());
+
+	UAC_Inventory* Inventory = GetInventoryForActor(Actor);
+	if(!Inventory)
 	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, "Could not load containers for actor, it has no inventory component");
+		OnFinished.ExecuteIfBound(false);
 		return;
 	}
 
-	if(!UFL_InventoryFramework::AreItemDirectionsValid(Item.UniqueID, Item.ContainerIndex, Item.ItemIndex))
+	const FContainerRecord* ContainerRecord = FindContainerRecord(Actor->GetName());
+	if(!ContainerRecord)
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, "Could not load containers for actor, it had not been saved in the past");
+		OnFinished.ExecuteIfBound(false);
+		return;
+	}
+
+	//The record is copied, the save game might be modified while the worker is reading it.
+	TSharedRef<FAsyncContainerTask> Task = MakeShared<FAsyncContainerTask>();
+	Task->Record = *ContainerRecord;
+
+	TWeakObjectPtr<UAC_Inventory> WeakInventory = Inventory;
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Task, WeakInventory, OnFinished]()
+	{
+		Task->Success = ReadContainerRecord(Task->Record, Task->Containers, Task->ItemInstances, &Task->JournalSequence);
+		Task->JournalPath = Task->Record.JournalPath;
+		Task->Record = FContainerRecord();
+
+		AsyncTask(ENamedThreads::GameThread, [Task, WeakInventory, OnFinished]()
+		{
+			if(!WeakInventory.IsValid() || !Task->Success)
+			{
+				UFL_InventoryFramework::LogIFPMessage(WeakInventory.Get(), "Could not load containers, the save is corrupt or from a newer version");
+				OnFinished.ExecuteIfBound(false);
+				return;
+			}
+
+			//Stream in the item assets first, so ApplyLoadedContainers doesn't have to load them synchronously.
+			TArray<FSoftObjectPath> AssetsToLoad;
+			for(const FS_ContainerSettings& CurrentContainer : Task->Containers)
+			{
+				for(const FS_InventoryItem& CurrentItem : CurrentContainer.Items)
+				{
+					if(!CurrentItem.ItemAssetSoftReference.IsNull() && !CurrentItem.ItemAssetSoftReference.IsValid())
+					{
+						AssetsToLoad.AddUnique(CurrentItem.ItemAssetSoftReference.ToSoftObjectPath());
+					}
+				}
+			}
+
+			auto Apply = [Task, WeakInventory, OnFinished]()
+			{
+				UAC_Inventory* Inventory = WeakInventory.Get();
+				if(!Inventory)
+				{
+					OnFinished.ExecuteIfBound(false);
+					return;
+				}
+
+				ApplyLoadedContainers(Inventory, MoveTemp(Task->Containers), Task->ItemInstances);
+				Inventory->ClearDirtyContainers();
+				Inventory->SetLoadedJournal(Task->JournalPath, Task->JournalSequence);
+				OnFinished.ExecuteIfBound(true);
+			};
+
+			if(AssetsToLoad.IsEmpty())
+			{
+				Apply();
+				return;
+			}
+
+			UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad, FStreamableDelegate::CreateLambda(Apply));
+		});
+	});
+}
+
+/**Encode every fragment that can reference objects into an FSerializedFragment,
+ * so nothing on another thread has to look those objects up.
+ * @ObjectReferences caches FragmentHasObjectReferences for every type.*/
+static void SnapshotFragments(TArray<TInstancedStruct<FCoreFragment>>& Fragments, TMap<const UScriptStruct*, bool>& ObjectReferences)
+{
+	for(TInstancedStruct<FCoreFragment>& CurrentFragment : Fragments)
+	{
+		const UScriptStruct* FragmentType = CurrentFragment.GetScriptStruct();
+		if(!FragmentType || FragmentType == FSerializedFragment::StaticStruct())
+		{
+			continue;
+		}
+
+		bool* HasObjectReferences = ObjectReferences.Find(FragmentType);
+		if(!HasObjectReferences)
+		{
+			HasObjectReferences = &ObjectReferences.Add(FragmentType, FragmentHasObjectReferences(FragmentType));
+		}
+
+		if(!*HasObjectReferences)
+		{
+			continue;
+		}
+
+		FSerializedFragment SerializedFragment;
+		SerializedFragment.TypePath = FragmentType->GetPathName();
+		SerializedFragment.Type = const_cast<UScriptStruct*>(FragmentType);
+		EncodeFragment(FragmentType, CurrentFragment.GetMemory(), SerializedFragment.Version, SerializedFragment.Flags, SerializedFragment.Data);
+		CurrentFragment.InitializeAs<FSerializedFragment>(MoveTemp(SerializedFragment));
+	}
+}
+
+/**Turn every FSerializedFragment back into the fragment it was saved as.
+ * Fragments that can't be read are removed.*/
+static void ResolveSerializedFragments(TArray<TInstancedStruct<FCoreFragment>>& Fragments)
+{
+	for(int32 FragmentIndex = Fragments.Num() - 1; FragmentIndex >= 0; FragmentIndex--)
+	{
+		const FSerializedFragment* SerializedFragment = Fragments[FragmentIndex].GetPtr<FSerializedFragment>();
+		if(!SerializedFragment)
+		{
+			continue;
+		}
+
+		const UScriptStruct* FragmentType = SerializedFragment->Type;
+		if(!FragmentType)
+		{
+			Fragments.RemoveAt(FragmentIndex);
+			continue;
+		}
+
+		TInstancedStruct<FCoreFragment> Fragment;
+		bool Upgraded = false;
+		if(DecodeFragment(FragmentType, SerializedFragment->Redirected, SerializedFragment->Version, SerializedFragment->Flags, SerializedFragment->Data, true, Fragment, Upgraded))
+		{
+			Fragments[FragmentIndex] = MoveTemp(Fragment);
+		}
+		else
+		{
+			Fragments.RemoveAt(FragmentIndex);
+		}
+	}
+}
+
+void USG_InventorySerialization::SnapshotContainers(const TArray<FS_ContainerSettings>& Containers, TArray<FS_ContainerSettings>& OutContainers, TArray<FLoadedItemInstance>& OutItemInstances)
+{
+	check(IsInGameThread());
+	TRACE_CPUPROFILER_EVENT_SCOPE(USG_InventorySerialization::SnapshotContainers)
+
+	OutContainers = Containers;
+	OutItemInstances.Reset();
+	TMap<const UScriptStruct*, bool> ObjectReferences;
+	for(int32 ContainerIndex = 0; ContainerIndex < OutContainers.Num(); ContainerIndex++)
+	{
+		FS_ContainerSettings& Container = OutContainers[ContainerIndex];
+		Container.UniqueID.ParentComponent = nullptr;
+		Container.Widget = nullptr;
+		Container.ExternalObjects.Empty();
+		SnapshotFragments(Container.ContainerFragments, ObjectReferences);
+
+		for(int32 ItemIndex = 0; ItemIndex < Container.Items.Num(); ItemIndex++)
+		{
+			FS_InventoryItem& Item = Container.Items[ItemIndex];
+			if(Item.ItemAssetSoftReference.IsNull())
+			{
+				Item.ItemAssetSoftReference = Item.ItemAsset.Get();
+			}
+
+			if(IsValid(Item.ItemInstance))
+			{
+				FLoadedItemInstance& ItemInstance = OutItemInstances.AddDefaulted_GetRef();
+				ItemInstance.ContainerIndex = ContainerIndex;
+				ItemInstance.ItemIndex = ItemIndex;
+				ItemInstance.ObjectClass = Item.ItemInstance->GetClass();
+				FMemoryWriter Writer(ItemInstance.PropertyData, true);
+				FSaveGameArchive Archive(Writer);
+				Item.ItemInstance->Serialize(Archive);
+			}
+
+			Item.UniqueID.ParentComponent = nullptr;
+			Item.ItemAsset = nullptr;
+			Item.ItemInstance = nullptr;
+			Item.Widget = nullptr;
+			Item.ItemComponents.Empty();
+			Item.ExternalObjects.Empty();
+			SnapshotFragments(Item.ItemFragments, ObjectReferences);
+		}
+	}
+}
+
+void USG_InventorySerialization::MarkContainersAsValidated(TArray<FS_ContainerSettings>& Containers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USG_InventorySerialization::MarkContainersAsValidated)
+
+	for(FS_ContainerSettings& Container : Containers)
+	{
+		TagAsValidated(*FindFragment<FTagFragment>(Container.ContainerFragments, true), false);
+		for(FS_InventoryItem& Item : Container.Items)
+		{
+			TagAsValidated(*FindFragment<FTagFragment>(Item.ItemFragments, true), true);
+		}
+	}
+}
+
+void USG_InventorySerialization::ApplyLoadedContainers(UAC_Inventory* Inventory, TArray<FS_ContainerSettings>&& Containers, const TArray<FLoadedItemInstance>& ItemInstances)
+{
+	check(IsInGameThread());
+
+	if(!IsValid(Inventory))
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(USG_InventorySerialization::ApplyLoadedContainers)
+
+	if(Inventory->Initialized)
+	{
+		UFL_InventoryFramework::LogIFPMessage(Inventory, "Containers were loaded into a component that has already started. Load them before StartComponent is called.");
+	}
+
+	Inventory->ContainerSettings = MoveTemp(Containers);
+	Inventory->ID_Map.Empty();
+
+	for(int32 ContainerIndex = 0; ContainerIndex < Inventory->ContainerSettings.Num(); ContainerIndex++)
+	{
+		FS_ContainerSettings& Container = Inventory->ContainerSettings[ContainerIndex];
+		Container.ContainerIndex = ContainerIndex;
+		Container.UniqueID.ParentComponent = Inventory;
+		ResolveSerializedFragments(Container.ContainerFragments);
+		if(Container.UniqueID.IsValid())
+		{
+			Inventory->AddUniqueIDToIDMap(Container.UniqueID, FIntPoint(ContainerIndex, -1), true);
+		}
+
+		/**Build the TileMap while we are already going through the items.
+		 * InitializeTileMap keeps it for containers that skip validation.*/
+		const bool SupportsTileMap = Container.SupportsTileMap();
+		Container.TileMap.Reset();
+		Container.IndexCoordinates.Reset();
+		if(SupportsTileMap)
+		{
+			const int32 TileCount = Container.Dimensions.X * Container.Dimensions.Y;
+			Container.TileMap.Init(-1, TileCount);
+			Container.IndexCoordinates.Reserve(TileCount);
+			for(int32 Y = 0; Y < Container.Dimensions.Y; Y++)
+			{
+				for(int32 X = 0; X < Container.Dimensions.X; X++)
+				{
+					Container.IndexCoordinates.Add(FIntPoint(X, Y), Y * Container.Dimensions.X + X);
+				}
+			}
+		}
+
+		for(int32 ItemIndex = 0; ItemIndex < Container.Items.Num(); ItemIndex++)
+		{
+			FS_InventoryItem& Item = Container.Items[ItemIndex];
+			Item.ContainerIndex = ContainerIndex;
+			Item.ItemIndex = ItemIndex;
+			Item.UniqueID.ParentComponent = Inventory;
+			ResolveSerializedFragments(Item.ItemFragments);
+			Item.ItemAsset = Item.ItemAssetSoftReference.LoadSynchronous();
+			if(!Item.ItemAsset)
+			{
+				UFL_InventoryFramework::LogIFPMessage(Inventory, FString::Printf(TEXT("Item asset %s could not be loaded"), *Item.ItemAssetSoftReference.ToString()));
+			}
+
+			if(Item.UniqueID.IsValid())
+			{
+				Inventory->AddUniqueIDToIDMap(Item.UniqueID, FIntPoint(ContainerIndex, ItemIndex));
+			}
+
+			if(SupportsTileMap && Item.ItemAsset && Container.TileMap.IsValidIndex(Item.TileIndex))
+			{
+				Inventory->AddItemToUninitializedTileMap(Item, Container);
+			}
+		}
+	}
+
+	for(const FLoadedItemInstance& CurrentInstance : ItemInstances)
+	{
+		if(!Inventory->ContainerSettings.IsValidIndex(CurrentInstance.ContainerIndex) ||
+			!Inventory->ContainerSettings[CurrentInstance.ContainerIndex].Items.IsValidIndex(CurrentInstance.ItemIndex))
+		{
+			continue;
+		}
+
+		UClass* InstanceClass = CurrentInstance.ObjectClass.TryLoadClass<UItemInstance>();
+		if(!InstanceClass)
+		{
+			UFL_InventoryFramework::LogIFPMessage(Inventory, FString::Printf(TEXT("Item instance class %s could not be loaded"), *CurrentInstance.ObjectClass.ToString()));
+			continue;
+		}
+
+		/**This becomes the template CreateItemInstanceForItem
+		 * duplicates when the component starts.*/
+		FS_InventoryItem& Item = Inventory->ContainerSettings[CurrentInstance.ContainerIndex].Items[CurrentInstance.ItemIndex];
+		UItemInstance* ItemInstance = NewObject<UItemInstance>(Inventory->GetOwner(), InstanceClass);
+		FMemoryReader Reader(CurrentInstance.PropertyData, true);
+		FSaveGameArchive Archive(Reader);
+		ItemInstance->Serialize(Archive);
+		Item.ItemInstance = ItemInstance;
+
+		if(Inventory->Initialized && Inventory->GetOwner()->HasAuthority())
+		{
+			Inventory->CreateItemInstanceForItem(Item);
+		}
+	}
+
+	Inventory->RebuildContainerStateHashes();
+}
+
+void USG_InventorySerialization::RegisterFragmentVersion(const UScriptStruct* FragmentType, int32 Version)
+{
+	check(IsInGameThread());
+
+	if(!FragmentType)
+	{
+		return;
+	}
+
+	GetFragmentSerializers().FindOrAdd(FragmentType->GetFName()).Version = Version;
+}
+
+int32 USG_InventorySerialization::GetFragmentVersion(const UScriptStruct* FragmentType)
+{
+	const FFragmentSerializer* Serializer = FindFragmentSerializer(FragmentType);
+	return Serializer ? Serializer->Version : 0;
+}
+
+void USG_InventorySerialization::RegisterFragmentSerializer(const UScriptStruct* FragmentType, FFragmentSerializer Serializer)
+{
+	check(IsInGameThread());
+
+	if(!FragmentType || !FragmentType->IsChildOf(FCoreFragment::StaticStruct()))
+	{
+		return;
+	}
+
+	GetFragmentSerializers().Add(FragmentType->GetFName(), MoveTemp(Serializer));
+}
+
+void USG_InventorySerialization::RegisterFragmentRedirect(const FString& OldPath, const UScriptStruct* NewType)
+{
+	check(IsInGameThread());
+
+	if(OldPath.IsEmpty() || !NewType)
 	{
 		return;
 	}
-	
-	for(auto& CurrentRecord : ItemInstanceRecords)
-	{
-		if(CurrentRecord.ContainerIndex == Item.ContainerIndex && CurrentRecord.ItemIndex == Item.ItemIndex)
-		{
-			UItemInstance* ItemInstance = Item.ItemInstance;
-			FMemoryReader Reader = FMemoryReader(CurrentRecord.PropertyData, true);
-			FSaveGameArchive Archive = FSaveGameArchive(Reader);
-			ItemInstance->Serialize(Archive);
-			
-			break;
-		}
-	}
-}
-
-void USG_InventorySerialization::SaveContainersForActor(AActor* Actor)
-{
-	// if(!Actor)
-	// {
-	// 	return;
-	// }
-	//
-	// if(!Actor->Implements<II_Inventory>())
-	// {
-	// 	return;
-	// }
-	//
-	// UAC_Inventory* Inventory = nullptr;
-	// II_Inventory::Execute_GetInventoryComponent(Actor, Inventory);
-	// if(!Inventory)
-	// {
-	// 	UFL_InventoryFramework::LogIFPMessage(Actor, "Could not save actor, failed GetInventoryComponent");
-	// }
-	//
-	// int32 ActorIndex = SavedActors.Find(Actor);
-	// if(ActorIndex == INDEX_NONE)
-	// {
-	// 	SavedActors.Add(Actor);
-	// 	ActorIndex = SavedActors.Num();
-	// }
-
-	// FContainerRecord ContainerRecord;
-	// ContainerRecord.ActorName = Actor->GetName();
-	//
-	// FMemoryWriter MemoryWriter = FMemoryWriter(ContainerRecord.PropertyData, true);
-	// FSaveGameArchive ContainerArchive = FSaveGameArchive(MemoryWriter);
-}
-
-void USG_InventorySerialization::LoadContainersForActor(AActor* Actor)
-{
-	// int32 ActorIndex = SavedActors.Find(Actor);
-	// if(ActorIndex == INDEX_NONE)
-	// {
-	// 	UFL_InventoryFramework::LogIFPMessage(Actor, "Could not load containers for actor, it had not been saved in the past");
-	// 	return;
-	// }
+
+	GetFragmentRedirects().Add(OldPath, NewType);
+}
+
+const FFragmentSerializer* USG_InventorySerialization::FindFragmentSerializer(const UScriptStruct* FragmentType)
+{
+	return FragmentType ? GetFragmentSerializers().Find(FragmentType->GetFName()) : nullptr;
+}
+
+UAC_Inventory* USG_InventorySerialization::GetInventoryForActor(AActor* Actor)
+{
+	if(!IsValid(Actor))
+	{
+		return nullptr;
+	}
+
+	UAC_Inventory* Inventory = nullptr;
+	if(Actor->Implements<UI_Inventory>())
+	{
+		II_Inventory::Execute_GetInventoryComponent(Actor, Inventory);
+	}
+
+	if(!Inventory)
+	{
+		Inventory = Actor->FindComponentByClass<UAC_Inventory>();
+	}
+
+	return Inventory;
+}
+
+FContainerRecord* USG_InventorySerialization::FindContainerRecord(const FString& ActorName)
+{
+	return ContainerRecords.FindByPredicate([&ActorName](const FContainerRecord& Record)
+	{
+		return Record.ActorName == ActorName;
+	});
 }
@@ -14,7 +14,7 @@ bool FItemContainersFragment::IsCompatibleWithItem(UObject* ItemOwner, const FS_
 		return false;
 	}
 
-	if(!Item.ItemAssetSoftReference.LoadSynchronous()->GetDefaultContainers().IsValidIndex(0))
+	if(!Item.ItemAssetSoftReference.LoadSynchronous()->HasDefaultContainers())
 	{
 		return false;
 	}
@@ -46,6 +46,12 @@ TArray<FS_ContainerSettings> UDA_CoreItem::GetDefaultContainers()
 
 TArray<FIntPoint> UDA_CoreItem::GetItemsPureShape(TEnumAsByte<ERotation> Rotation)
 {
+	if(IsRuntimeCacheValid())
+	{
+		const int32 ShapeIndex = RuntimeCache.ShapeIndexes.IsValidIndex(Rotation) ? RuntimeCache.ShapeIndexes[Rotation] : -1;
+		return Shapes.IsValidIndex(ShapeIndex) ? Shapes[ShapeIndex].Shape : TArray<FIntPoint>();
+	}
+	
 	TArray<FIntPoint> ReturnShape;
 
 	for(auto& CurrentShape : Shapes)
@@ -61,6 +67,11 @@ TArray<FIntPoint> UDA_CoreItem::GetItemsPureShape(TEnumAsByte<ERotation> Rotatio
 
 TArray<FIntPoint> UDA_CoreItem::GetDisabledTiles()
 {
+	if(IsRuntimeCacheValid())
+	{
+		return RuntimeCache.DisabledTiles;
+	}
+	
 	TArray<FIntPoint> DisabledTiles;
 
 	//Find out if this asset has the CustomShape object.
@@ -81,6 +92,11 @@ TArray<FIntPoint> UDA_CoreItem::GetDisabledTiles()
 
 FIntPoint UDA_CoreItem::GetAnchorPoint()
 {
+	if(IsRuntimeCacheValid())
+	{
+		return RuntimeCache.AnchorPoint;
+	}
+	
 	FIntPoint AnchorPoint = FIntPoint(0, 0);
 
 	//Find out if this asset has the CustomShape object.
@@ -109,6 +125,177 @@ TArray<UAC_LootTable*> UDA_CoreItem::GetLootTables()
 	return TArray<UAC_LootTable*>();
 }
 
+bool UDA_CoreItem::HasDefaultContainers()
+{
+	if(IsRuntimeCacheValid())
+	{
+		return !RuntimeCache.DefaultContainers.IsEmpty();
+	}
+
+	return !GetDefaultContainers().IsEmpty();
+}
+
+bool UDA_CoreItem::HasLootTables()
+{
+	if(IsRuntimeCacheValid())
+	{
+		return !RuntimeCache.LootTables.IsEmpty();
+	}
+
+	return !GetLootTables().IsEmpty();
+}
+
+FGameplayTagContainer UDA_CoreItem::GetDefaultTags()
+{
+	if(IsRuntimeCacheValid())
+	{
+		return RuntimeCache.DefaultTags;
+	}
+
+	FGameplayTagContainer Tags;
+	if(const FTagFragment* TagFragment = FindFragment<FTagFragment>(ItemStructFragments))
+	{
+		Tags.AppendTags(TagFragment->Tags);
+	}
+	if(const FTagFragment* TagFragment = FindFragment<FTagFragment>(ItemAssetFragments))
+	{
+		Tags.AppendTags(TagFragment->Tags);
+	}
+
+	return Tags;
+}
+
+UItemTrait* UDA_CoreItem::FindTraitByExactClass(const UClass* Class)
+{
+	if(IsRuntimeCacheValid())
+	{
+		const TObjectPtr<UItemTrait>* Trait = RuntimeCache.TraitsByClass.Find(Class);
+		return Trait ? Trait->Get() : nullptr;
+	}
+
+	for(TObjectPtr<UItemTrait>& CurrentObject : TraitsAndComponents)
+	{
+		if(IsValid(CurrentObject) && CurrentObject->GetClass() == Class)
+		{
+			return CurrentObject;
+		}
+	}
+
+	return nullptr;
+}
+
+UItemTrait* UDA_CoreItem::FindTraitByClass(const UClass* Class, bool AllowChildren)
+{
+	if(!AllowChildren)
+	{
+		return FindTraitByExactClass(Class);
+	}
+
+	if(IsRuntimeCacheValid())
+	{
+		const TArray<TObjectPtr<UItemTrait>>* Traits = RuntimeCache.TraitsByClassHierarchy.Find(Class);
+		return Traits ? (*Traits)[0].Get() : nullptr;
+	}
+
+	for(TObjectPtr<UItemTrait>& CurrentObject : TraitsAndComponents)
+	{
+		if(IsValid(CurrentObject) && CurrentObject->IsA(Class))
+		{
+			return CurrentObject;
+		}
+	}
+
+	return nullptr;
+}
+
+void UDA_CoreItem::FindTraitsByClass(const UClass* Class, bool AllowChildren, TArray<UItemTrait*>& FoundTraits)
+{
+	FoundTraits.Reset();
+
+	if(IsRuntimeCacheValid())
+	{
+		if(const TArray<TObjectPtr<UItemTrait>>* Traits = RuntimeCache.TraitsByClassHierarchy.Find(Class))
+		{
+			for(const TObjectPtr<UItemTrait>& CurrentTrait : *Traits)
+			{
+				if(AllowChildren || CurrentTrait->GetClass() == Class)
+				{
+					FoundTraits.Add(CurrentTrait);
+				}
+			}
+		}
+		return;
+	}
+
+	for(TObjectPtr<UItemTrait>& CurrentObject : TraitsAndComponents)
+	{
+		if(IsValid(CurrentObject) && (AllowChildren ? CurrentObject->IsA(Class) : CurrentObject->GetClass() == Class))
+		{
+			FoundTraits.Add(CurrentObject);
+		}
+	}
+}
+
+void UDA_CoreItem::BuildRuntimeCache()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDA_CoreItem::BuildRuntimeCache)
+
+	//Invalidate the cache first, so the getters below compute everything from scratch.
+	RuntimeCache = FItemAssetRuntimeCache();
+
+	FItemAssetRuntimeCache NewCache;
+	NewCache.TraitCount = TraitsAndComponents.Num();
+	NewCache.ItemDimensions = ItemDimensions;
+	NewCache.ShapeCount = Shapes.Num();
+
+	for(TObjectPtr<UItemTrait>& CurrentObject : TraitsAndComponents)
+	{
+		if(!IsValid(CurrentObject))
+		{
+			continue;
+		}
+
+		if(!NewCache.TraitsByClass.Contains(CurrentObject->GetClass()))
+		{
+			NewCache.TraitsByClass.Add(CurrentObject->GetClass(), CurrentObject);
+		}
+
+		for(const UClass* CurrentClass = CurrentObject->GetClass(); CurrentClass && CurrentClass->IsChildOf(UItemTrait::StaticClass()); CurrentClass = CurrentClass->GetSuperClass())
+		{
+			NewCache.TraitsByClassHierarchy.FindOrAdd(CurrentClass).Add(CurrentObject);
+		}
+	}
+
+	NewCache.DisabledTiles = GetDisabledTiles();
+	NewCache.AnchorPoint = GetAnchorPoint();
+
+	NewCache.ShapeIndexes.Init(-1, 4);
+	for(int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ShapeIndex++)
+	{
+		const int32 Rotation = Shapes[ShapeIndex].Rotation;
+		if(NewCache.ShapeIndexes.IsValidIndex(Rotation) && NewCache.ShapeIndexes[Rotation] == -1)
+		{
+			NewCache.ShapeIndexes[Rotation] = ShapeIndex;
+		}
+	}
+
+	NewCache.ItemComponents = GetItemComponentsFromTraits();
+	NewCache.DefaultTags = GetDefaultTags();
+	NewCache.DefaultContainers = GetDefaultContainers();
+	NewCache.LootTables.Append(GetLootTables());
+
+	NewCache.IsBuilt = true;
+	RuntimeCache = MoveTemp(NewCache);
+}
+
+bool UDA_CoreItem::IsRuntimeCacheValid() const
+{
+	return RuntimeCache.IsBuilt
+		&& RuntimeCache.TraitCount == TraitsAndComponents.Num()
+		&& RuntimeCache.ItemDimensions == ItemDimensions
+		&& RuntimeCache.ShapeCount == Shapes.Num();
+}
+
 int32 UDA_CoreItem::FindObjectIndex(UItemTrait* Object)
 {
 	for(int32 Index = 0; Index < TraitsAndComponents.Num(); Index++)
@@ -126,8 +313,23 @@ FPrimaryAssetId UDA_CoreItem::GetPrimaryAssetId() const
 	return FPrimaryAssetId(AssetRegistryCategory, GetFName());
 }
 
+uint32 UDA_CoreItem::GetAssetPathHash() const
+{
+	if(!AssetPathHash.IsSet())
+	{
+		AssetPathHash = GetTypeHash(FSoftObjectPath(this));
+	}
+
+	return AssetPathHash.GetValue();
+}
+
 TArray<TSoftClassPtr<UItemComponent>> UDA_CoreItem::GetItemComponentsFromTraits()
 {
+	if(IsRuntimeCacheValid())
+	{
+		return RuntimeCache.ItemComponents;
+	}
+	
 	TArray<TSoftClassPtr<UItemComponent>> Components;
 	
 	for(auto& CurrentTrait : TraitsAndComponents)
@@ -157,6 +359,8 @@ void UDA_CoreItem::BakeShapes()
 
 	TArray<FIntPoint> ReturnShape;
 	
+	//The cache might be holding on to the disabled tiles from before the edit.
+	RuntimeCache = FItemAssetRuntimeCache();
 	const TArray<FIntPoint> DisabledTiles = GetDisabledTiles();
 	
 	for(int32 ColumnY = 0; ColumnY < ItemDimensions.Y; ColumnY++)
@@ -208,6 +412,8 @@ void UDA_CoreItem::BakeShapes()
 		}
 	}
 
+	BuildRuntimeCache();
+
 	#endif
 }
 
@@ -374,10 +580,14 @@ UTexture2D* UDA_CoreItem::GetThumbnailTexture()
 	return nullptr;
 }
 
+#endif
+
 void UDA_CoreItem::PostLoad()
 {
 	Super::PostLoad();
 
+#if WITH_EDITOR
+
 	if(Shapes.IsEmpty())
 	{
 		BakeShapes();
@@ -427,8 +637,14 @@ void UDA_CoreItem::PostLoad()
 	}
 	
 	// end of transition code
+
+#endif
+
+	BuildRuntimeCache();
 }
 
+#if WITH_EDITOR
+
 TArray<TSoftObjectPtr<UScriptStruct>> UDA_CoreItem::GetDisallowedItemStructFragments() const
 {
 	TArray<TSoftObjectPtr<UScriptStruct>> DisallowedClasses;
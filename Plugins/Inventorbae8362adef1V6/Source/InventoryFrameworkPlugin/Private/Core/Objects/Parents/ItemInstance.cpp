@@ -5,12 +5,21 @@
 
 #include "Core/Components/AC_Inventory.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 void UItemInstance::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UItemInstance, ItemID);
+	FDoRepLifetimeParams PushModelParams;
+	PushModelParams.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UItemInstance, ItemID, PushModelParams);
+}
+
+void UItemInstance::SetItemID(FS_UniqueID NewItemID)
+{
+	ItemID = NewItemID;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UItemInstance, ItemID, this);
 }
 
 void UItemInstance::StartPlay_Implementation()
@@ -64,6 +73,14 @@ FS_ContainerSettings UItemInstance::GetContainerSettings()
 	return FS_ContainerSettings();
 }
 
+void UItemInstance::MarkSaveGameDataDirty()
+{
+	if(UAC_Inventory* Inventory = GetInventoryComponent())
+	{
+		Inventory->MarkItemInstanceDirty(this);
+	}
+}
+
 void UItemInstance::RemoveObject()
 {
 	MarkAsGarbage();
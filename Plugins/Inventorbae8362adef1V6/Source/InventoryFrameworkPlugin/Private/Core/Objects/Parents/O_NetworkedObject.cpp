@@ -5,6 +5,7 @@
 #include "Engine/BlueprintGeneratedClass.h"
 #include "GameFramework/Actor.h"
 #include "Engine/NetDriver.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 
 AActor* UO_NetworkedObject::GetOwningActor() const
@@ -44,10 +45,30 @@ void UO_NetworkedObject::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
 	//Replicate any blueprint variables labeled for replication.
 	if (const UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(GetClass()))
 	{
+		const int32 FirstBlueprintProperty = OutLifetimeProps.Num();
 		BPClass->GetLifetimeBlueprintReplicationList(OutLifetimeProps);
+
+		if(UsePushModelForBlueprintProperties())
+		{
+			for(int32 PropertyIndex = FirstBlueprintProperty; PropertyIndex < OutLifetimeProps.Num(); PropertyIndex++)
+			{
+				OutLifetimeProps[PropertyIndex].bIsPushBased = true;
+			}
+		}
 	}
 }
 
+void UO_NetworkedObject::MarkReplicatedPropertyDirty(FName PropertyName)
+{
+	const FProperty* Property = FindFProperty<FProperty>(GetClass(), PropertyName);
+	if(!Property || !Property->HasAnyPropertyFlags(CPF_Net))
+	{
+		return;
+	}
+
+	MARK_PROPERTY_DIRTY(this, Property);
+}
+
 int32 UO_NetworkedObject::GetFunctionCallspace(UFunction* Function, FFrame* Stack)
 {
 	// return UObject::GetFunctionCallspace(Function, Stack);
@@ -0,0 +1,489 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Subsystems/InventoryRegionStorageSubsystem.h"
+
+#include "InventoryFrameworkPlugin.h"
+#include "Core/Components/AC_Inventory.h"
+#include "Core/Data/DS_InventoryFrameworkSettingsRuntime.h"
+#include "Core/Data/FL_InventoryFramework.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
+
+//"IFPR", written at the start of every cell file.
+static constexpr uint32 RegionFileMagic = 0x52504649;
+
+//Bump this whenever the layout of the cell index changes.
+static constexpr int32 RegionFileVersion = 1;
+
+bool UInventoryRegionStorageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UInventoryRegionStorageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	StorageDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("IFP"), TEXT("Regions"), MapName);
+	TimeUntilFlush = UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->RegionFlushInterval;
+}
+
+void UInventoryRegionStorageSubsystem::Deinitialize()
+{
+	FlushDirtyCellsAndWait();
+
+	Super::Deinitialize();
+}
+
+void UInventoryRegionStorageSubsystem::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryRegionStorageSubsystem::Tick)
+
+	TArray<FIntPoint> FinishedWrites;
+	for(const TPair<FIntPoint, FInventoryRegionCellWrite>& CurrentWrite : CellWrites)
+	{
+		if(CurrentWrite.Value.Task.IsCompleted())
+		{
+			FinishedWrites.Add(CurrentWrite.Key);
+		}
+	}
+	for(const FIntPoint& CurrentCell : FinishedWrites)
+	{
+		FinishCellWrite(CurrentCell);
+	}
+
+	const float FlushInterval = UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->RegionFlushInterval;
+	if(FlushInterval <= 0)
+	{
+		return;
+	}
+
+	TimeUntilFlush -= DeltaTime;
+	if(TimeUntilFlush <= 0)
+	{
+		TimeUntilFlush = FlushInterval;
+		FlushDirtyCells();
+	}
+}
+
+TStatId UInventoryRegionStorageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInventoryRegionStorageSubsystem, STATGROUP_Tickables);
+}
+
+void UInventoryRegionStorageSubsystem::SetStorageDirectory(const FString& Directory)
+{
+	if(StorageDirectory == Directory)
+	{
+		return;
+	}
+
+	//Anything pending belongs to the old directory.
+	FlushDirtyCellsAndWait();
+	StorageDirectory = Directory;
+	CellIndexes.Empty();
+	InventoryCells.Empty();
+}
+
+bool UInventoryRegionStorageSubsystem::SaveInventory(AActor* Actor, const FString& StorageKey)
+{
+	UAC_Inventory* Inventory = USG_InventorySerialization::GetInventoryForActor(Actor);
+	if(!Inventory)
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, "Could not save inventory to its region, the actor has no inventory component");
+		return false;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryRegionStorageSubsystem::SaveInventory)
+
+	const FString Key = GetStorageKey(Actor, StorageKey);
+	const FIntPoint Cell = GetCellForLocation(Actor->GetActorLocation());
+
+	TSharedPtr<FInventoryRegionSnapshot> Snapshot = MakeShared<FInventoryRegionSnapshot>();
+	Snapshot->MarkAsValidated = Inventory->Initialized;
+	USG_InventorySerialization::SnapshotContainers(Inventory->ContainerSettings, Snapshot->Containers, Snapshot->ItemInstances);
+
+	//The actor moved to another cell since it was last saved, take it out of the old one.
+	const FIntPoint* PreviousCell = InventoryCells.Find(Key);
+	if(PreviousCell && *PreviousCell != Cell)
+	{
+		FInventoryRegionPendingCell& PreviousPendingCell = PendingCells.FindOrAdd(*PreviousCell);
+		PreviousPendingCell.SavedInventories.Remove(Key);
+		PreviousPendingCell.RemovedInventories.Add(Key);
+	}
+
+	FInventoryRegionPendingCell& PendingCell = PendingCells.FindOrAdd(Cell);
+	PendingCell.RemovedInventories.Remove(Key);
+	PendingCell.SavedInventories.Add(Key, Snapshot);
+	InventoryCells.Add(Key, Cell);
+
+	Inventory->ClearDirtyContainers();
+	return true;
+}
+
+bool UInventoryRegionStorageSubsystem::LoadInventory(AActor* Actor, const FString& StorageKey)
+{
+	UAC_Inventory* Inventory = USG_InventorySerialization::GetInventoryForActor(Actor);
+	if(!Inventory)
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, "Could not load inventory from its region, the actor has no inventory component");
+		return false;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryRegionStorageSubsystem::LoadInventory)
+
+	const FString Key = GetStorageKey(Actor, StorageKey);
+	const FIntPoint* KnownCell = InventoryCells.Find(Key);
+	const FIntPoint Cell = KnownCell ? *KnownCell : GetCellForLocation(Actor->GetActorLocation());
+
+	//Saves that haven't been written yet are newer than what's on disk.
+	if(const FInventoryRegionPendingCell* PendingCell = PendingCells.Find(Cell))
+	{
+		if(PendingCell->RemovedInventories.Contains(Key))
+		{
+			return false;
+		}
+
+		if(const TSharedPtr<FInventoryRegionSnapshot>* Snapshot = PendingCell->SavedInventories.Find(Key))
+		{
+			/**The snapshot is already in the shape ApplyLoadedContainers wants,
+			 * so it is copied instead of being written and read again.
+			 * The snapshot itself is still needed for the next flush.*/
+			TArray<FS_ContainerSettings> Containers = (*Snapshot)->Containers;
+			if((*Snapshot)->MarkAsValidated)
+			{
+				USG_InventorySerialization::MarkContainersAsValidated(Containers);
+			}
+
+			USG_InventorySerialization::ApplyLoadedContainers(Inventory, MoveTemp(Containers), (*Snapshot)->ItemInstances);
+			Inventory->ClearDirtyContainers();
+			InventoryCells.Add(Key, Cell);
+			return true;
+		}
+	}
+
+	WaitForCellWrite(Cell);
+
+	const FInventoryRegionCellIndex* CellIndex = GetCellIndex(Cell);
+	const FInventoryRegionEntry* Entry = CellIndex ? CellIndex->FindEntry(Key) : nullptr;
+	if(!Entry)
+	{
+		return false;
+	}
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetCellFilePath(Cell)));
+	if(!Reader)
+	{
+		return false;
+	}
+
+	//Only this inventory is read, the rest of the cell is never touched.
+	TArray<uint8> Data;
+	Data.SetNumUninitialized(Entry->Size);
+	Reader->Seek(CellIndex->DataStart + Entry->Offset);
+	Reader->Serialize(Data.GetData(), Entry->Size);
+	if(Reader->IsError())
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, FString::Printf(TEXT("Could not read %s from %s"), *Key, *GetCellFilePath(Cell)));
+		return false;
+	}
+
+	TArray<FS_ContainerSettings> Containers;
+	TArray<FLoadedItemInstance> ItemInstances;
+	if(!USG_InventorySerialization::ReadContainers(Data, Containers, ItemInstances))
+	{
+		UFL_InventoryFramework::LogIFPMessage(Actor, FString::Printf(TEXT("Could not load %s from its region, the save is corrupt or from a newer version"), *Key));
+		return false;
+	}
+
+	USG_InventorySerialization::ApplyLoadedContainers(Inventory, MoveTemp(Containers), ItemInstances);
+	Inventory->ClearDirtyContainers();
+	InventoryCells.Add(Key, Cell);
+	return true;
+}
+
+void UInventoryRegionStorageSubsystem::RemoveInventory(AActor* Actor, const FString& StorageKey)
+{
+	if(!IsValid(Actor))
+	{
+		return;
+	}
+
+	const FString Key = GetStorageKey(Actor, StorageKey);
+	const FIntPoint* KnownCell = InventoryCells.Find(Key);
+	const FIntPoint Cell = KnownCell ? *KnownCell : GetCellForLocation(Actor->GetActorLocation());
+
+	FInventoryRegionPendingCell& PendingCell = PendingCells.FindOrAdd(Cell);
+	PendingCell.SavedInventories.Remove(Key);
+	PendingCell.RemovedInventories.Add(Key);
+	InventoryCells.Remove(Key);
+}
+
+void UInventoryRegionStorageSubsystem::FlushDirtyCells()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryRegionStorageSubsystem::FlushDirtyCells)
+
+	for(auto It = PendingCells.CreateIterator(); It; ++It)
+	{
+		//Only one write per cell at a time, this cell gets written by the next flush.
+		if(CellWrites.Contains(It.Key()))
+		{
+			continue;
+		}
+
+		WriteCell(It.Key(), MoveTemp(It.Value()));
+		It.RemoveCurrent();
+	}
+}
+
+void UInventoryRegionStorageSubsystem::FlushDirtyCellsAndWait()
+{
+	//Cells that were still being written when the first flush happened are flushed again.
+	while(!PendingCells.IsEmpty() || !CellWrites.IsEmpty())
+	{
+		FlushDirtyCells();
+
+		TArray<FIntPoint> WritingCells;
+		CellWrites.GetKeys(WritingCells);
+		for(const FIntPoint& CurrentCell : WritingCells)
+		{
+			WaitForCellWrite(CurrentCell);
+		}
+	}
+}
+
+FIntPoint UInventoryRegionStorageSubsystem::GetCellForLocation(const FVector& Location) const
+{
+	const float CellSize = FMath::Max(UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->RegionCellSize, 100.f);
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+FString UInventoryRegionStorageSubsystem::GetStorageKey(const AActor* Actor, const FString& StorageKey)
+{
+	if(!StorageKey.IsEmpty() || !Actor)
+	{
+		return StorageKey;
+	}
+
+	return Actor->GetName();
+}
+
+bool UInventoryRegionStorageSubsystem::ReadCellIndex(FArchive& Archive, FInventoryRegionCellIndex& OutIndex)
+{
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 EntryCount = 0;
+	Archive << Magic;
+	Archive << Version;
+	Archive << EntryCount;
+	if(Archive.IsError() || Magic != RegionFileMagic || Version > RegionFileVersion)
+	{
+		return false;
+	}
+
+	if(EntryCount < 0 || EntryCount > Archive.TotalSize())
+	{
+		return false;
+	}
+
+	OutIndex.Entries.SetNum(EntryCount);
+	OutIndex.EntryIndexes.Reserve(EntryCount);
+	for(int32 EntryIndex = 0; EntryIndex < EntryCount; EntryIndex++)
+	{
+		FInventoryRegionEntry& CurrentEntry = OutIndex.Entries[EntryIndex];
+		Archive << CurrentEntry.Key;
+		Archive << CurrentEntry.Offset;
+		Archive << CurrentEntry.Size;
+		OutIndex.EntryIndexes.Add(CurrentEntry.Key, EntryIndex);
+	}
+	OutIndex.DataStart = Archive.Tell();
+
+	return !Archive.IsError();
+}
+
+bool UInventoryRegionStorageSubsystem::WriteCellFile(const FString& FilePath, const TMap<FString, TArray<uint8>>& Entries, FInventoryRegionCellIndex& OutIndex)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryRegionStorageSubsystem::WriteCellFile)
+
+	OutIndex = FInventoryRegionCellIndex();
+	if(Entries.IsEmpty())
+	{
+		//Nothing left in this cell.
+		return !IFileManager::Get().FileExists(*FilePath) || IFileManager::Get().Delete(*FilePath);
+	}
+
+	int64 Offset = 0;
+	OutIndex.Entries.Reserve(Entries.Num());
+	OutIndex.EntryIndexes.Reserve(Entries.Num());
+	for(const TPair<FString, TArray<uint8>>& CurrentEntry : Entries)
+	{
+		FInventoryRegionEntry& NewEntry = OutIndex.AddEntry(CurrentEntry.Key);
+		NewEntry.Offset = Offset;
+		NewEntry.Size = CurrentEntry.Value.Num();
+		Offset += NewEntry.Size;
+	}
+
+	/**Write to a temporary file first and swap it in once it's complete,
+	 * so a crash while writing never leaves a broken cell behind.*/
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if(!Writer)
+		{
+			return false;
+		}
+
+		uint32 Magic = RegionFileMagic;
+		int32 Version = RegionFileVersion;
+		int32 EntryCount = OutIndex.Entries.Num();
+		*Writer << Magic;
+		*Writer << Version;
+		*Writer << EntryCount;
+		for(FInventoryRegionEntry& CurrentEntry : OutIndex.Entries)
+		{
+			*Writer << CurrentEntry.Key;
+			*Writer << CurrentEntry.Offset;
+			*Writer << CurrentEntry.Size;
+		}
+		OutIndex.DataStart = Writer->Tell();
+
+		for(const FInventoryRegionEntry& CurrentEntry : OutIndex.Entries)
+		{
+			const TArray<uint8>& Data = Entries.FindChecked(CurrentEntry.Key);
+			Writer->Serialize(const_cast<uint8*>(Data.GetData()), Data.Num());
+		}
+
+		if(!Writer->Close())
+		{
+			return false;
+		}
+	}
+
+	return IFileManager::Get().Move(*FilePath, *TempFilePath, true, true);
+}
+
+FString UInventoryRegionStorageSubsystem::GetCellFilePath(const FIntPoint& Cell) const
+{
+	return FPaths::Combine(StorageDirectory, FString::Printf(TEXT("Cell_%d_%d.ifpr"), Cell.X, Cell.Y));
+}
+
+const FInventoryRegionCellIndex* UInventoryRegionStorageSubsystem::GetCellIndex(const FIntPoint& Cell)
+{
+	if(const FInventoryRegionCellIndex* CellIndex = CellIndexes.Find(Cell))
+	{
+		return CellIndex;
+	}
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetCellFilePath(Cell)));
+	if(!Reader)
+	{
+		return nullptr;
+	}
+
+	FInventoryRegionCellIndex CellIndex;
+	if(!ReadCellIndex(*Reader, CellIndex))
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("%s is not a valid IFP region file"), *GetCellFilePath(Cell));
+		return nullptr;
+	}
+
+	for(const FInventoryRegionEntry& CurrentEntry : CellIndex.Entries)
+	{
+		InventoryCells.FindOrAdd(CurrentEntry.Key, Cell);
+	}
+
+	return &CellIndexes.Add(Cell, MoveTemp(CellIndex));
+}
+
+void UInventoryRegionStorageSubsystem::WaitForCellWrite(const FIntPoint& Cell)
+{
+	if(FInventoryRegionCellWrite* CellWrite = CellWrites.Find(Cell))
+	{
+		CellWrite->Task.Wait();
+		FinishCellWrite(Cell);
+	}
+}
+
+void UInventoryRegionStorageSubsystem::FinishCellWrite(const FIntPoint& Cell)
+{
+	FInventoryRegionCellWrite CellWrite;
+	if(!CellWrites.RemoveAndCopyValue(Cell, CellWrite))
+	{
+		return;
+	}
+
+	if(CellWrite.Index->DataStart < 0)
+	{
+		//We no longer know what's on disk, read it again next time.
+		UE_LOG(LogInventoryFramework, Warning, TEXT("Failed to write %s"), *GetCellFilePath(Cell));
+		CellIndexes.Remove(Cell);
+		return;
+	}
+
+	CellIndexes.Add(Cell, MoveTemp(*CellWrite.Index));
+}
+
+void UInventoryRegionStorageSubsystem::WriteCell(const FIntPoint& Cell, FInventoryRegionPendingCell&& PendingCell)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryRegionStorageSubsystem::WriteCell)
+
+	//Reading the index is cheap and lets the worker copy entries without parsing the file itself.
+	const FInventoryRegionCellIndex* ExistingIndex = GetCellIndex(Cell);
+	TSharedPtr<const FInventoryRegionCellIndex> OldIndex = ExistingIndex ? MakeShared<const FInventoryRegionCellIndex>(*ExistingIndex) : nullptr;
+
+	FInventoryRegionCellWrite& CellWrite = CellWrites.Add(Cell);
+	CellWrite.Index = MakeShared<FInventoryRegionCellIndex>();
+	CellWrite.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[FilePath = GetCellFilePath(Cell), OldIndex, PendingCell = MoveTemp(PendingCell), NewIndex = CellWrite.Index]()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryRegionStorageSubsystem::WriteCellTask)
+
+		TMap<FString, TArray<uint8>> Entries;
+
+		/**Copy over the existing entries without decoding them. Saved ones
+		 * are copied as well, so they keep their old save if the new one fails.*/
+		if(OldIndex.IsValid())
+		{
+			TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+			for(const FInventoryRegionEntry& CurrentEntry : OldIndex->Entries)
+			{
+				if(!Reader || PendingCell.RemovedInventories.Contains(CurrentEntry.Key))
+				{
+					continue;
+				}
+
+				TArray<uint8>& Data = Entries.Add(CurrentEntry.Key);
+				Data.SetNumUninitialized(CurrentEntry.Size);
+				Reader->Seek(OldIndex->DataStart + CurrentEntry.Offset);
+				Reader->Serialize(Data.GetData(), CurrentEntry.Size);
+			}
+
+			if(Reader && Reader->IsError())
+			{
+				//Writing now would lose the entries we couldn't read.
+				NewIndex->DataStart = -1;
+				return;
+			}
+		}
+
+		for(const TPair<FString, TSharedPtr<FInventoryRegionSnapshot>>& CurrentSave : PendingCell.SavedInventories)
+		{
+			TArray<uint8> Data;
+			if(!USG_InventorySerialization::WriteContainerSnapshot(CurrentSave.Value->Containers, CurrentSave.Value->ItemInstances, CurrentSave.Value->MarkAsValidated, Data))
+			{
+				UE_LOG(LogInventoryFramework, Warning, TEXT("Failed to write the inventory %s, it keeps its previous save"), *CurrentSave.Key);
+				continue;
+			}
+			Entries.Add(CurrentSave.Key, MoveTemp(Data));
+		}
+
+		if(!WriteCellFile(FilePath, Entries, *NewIndex))
+		{
+			NewIndex->DataStart = -1;
+		}
+	});
+}
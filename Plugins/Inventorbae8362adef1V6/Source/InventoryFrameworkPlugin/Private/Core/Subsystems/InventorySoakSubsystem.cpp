@@ -0,0 +1,573 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Subsystems/InventorySoakSubsystem.h"
+
+#include "InventoryFrameworkPlugin.h"
+#include "Core/Components/AC_Inventory.h"
+#include "Core/Data/DS_InventoryFrameworkSettingsRuntime.h"
+#include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Items/DA_CoreItem.h"
+#include "Core/Subsystems/RPCBudgetSubsystem.h"
+#include "Core/Subsystems/RPCProfilerSubsystem.h"
+#include "Engine/Engine.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+
+//How many operations a single component can have waiting on the server before the workload backs off.
+static constexpr int32 MaxPendingOperationsPerComponent = 16;
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommand StartInventorySoakCommand(
+	TEXT("IFP.Soak.Start"),
+	TEXT("Start the inventory soak in every world of this process. Optional arguments: operations per second (default 5), duration in seconds (default 60, 0 runs until stopped)."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const float OperationsPerSecond = Args.IsValidIndex(0) ? FCString::Atof(*Args[0]) : 5;
+		const float Duration = Args.IsValidIndex(1) ? FCString::Atof(*Args[1]) : 60;
+		UInventorySoakSubsystem::StartSoak(OperationsPerSecond, Duration);
+	}));
+
+static FAutoConsoleCommand StopInventorySoakCommand(
+	TEXT("IFP.Soak.Stop"),
+	TEXT("Stop the inventory soak in every world of this process and log the reports."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		UInventorySoakSubsystem::StopSoak();
+	}));
+
+#endif
+
+static double GetPercentile(TArray<double> Values, double Percentile)
+{
+	if(!Values.IsValidIndex(0))
+	{
+		return 0;
+	}
+
+	Values.Sort();
+	return Values[FMath::Clamp(FMath::CeilToInt(Values.Num() * Percentile) - 1, 0, Values.Num() - 1)];
+}
+
+static double GetMean(const TArray<double>& Values)
+{
+	if(!Values.IsValidIndex(0))
+	{
+		return 0;
+	}
+
+	double Total = 0;
+	for(const double CurrentValue : Values)
+	{
+		Total += CurrentValue;
+	}
+	return Total / Values.Num();
+}
+
+bool UInventorySoakSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+bool UInventorySoakSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UInventorySoakSubsystem::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventorySoakSubsystem::Tick)
+
+	if(!Running)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	const bool HasAuthority = World->GetNetMode() != NM_Client;
+	if(HasAuthority)
+	{
+		FrameTimes.Add(DeltaTime);
+	}
+
+	UpdatePendingOperations();
+
+	if(EndTime > 0 && FPlatformTime::Seconds() >= EndTime)
+	{
+		Stop();
+		return;
+	}
+
+	OperationBudget += OperationsPerSecond * DeltaTime;
+	const int32 Operations = FMath::FloorToInt(OperationBudget);
+	OperationBudget -= Operations;
+
+	//Only drive the local player, a server without a local player would otherwise drive a remote players component.
+	const APlayerController* LocalController = UGameplayStatics::GetPlayerController(World, 0);
+	UAC_Inventory* LocalComponent = LocalController && LocalController->IsLocalController() ? UFL_InventoryFramework::GetLocalInventoryComponent(World) : nullptr;
+
+	for(int32 OperationIndex = 0; OperationIndex < Operations; OperationIndex++)
+	{
+		if(IsValid(LocalComponent))
+		{
+			RunClientWorkload(LocalComponent);
+		}
+
+		if(HasAuthority)
+		{
+			RunLootWorkload();
+		}
+	}
+}
+
+TStatId UInventorySoakSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInventorySoakSubsystem, STATGROUP_Tickables);
+}
+
+void UInventorySoakSubsystem::StartSoak(float OperationsPerSecond, float Duration)
+{
+	if(!GEngine)
+	{
+		return;
+	}
+
+	if(URPCProfilerSubsystem* Profiler = GEngine->GetEngineSubsystem<URPCProfilerSubsystem>())
+	{
+		Profiler->StartRecording();
+	}
+
+	for(const FWorldContext& CurrentContext : GEngine->GetWorldContexts())
+	{
+		const UWorld* World = CurrentContext.World();
+		if(UInventorySoakSubsystem* Soak = World ? World->GetSubsystem<UInventorySoakSubsystem>() : nullptr)
+		{
+			Soak->Start(OperationsPerSecond, Duration);
+		}
+	}
+}
+
+void UInventorySoakSubsystem::StopSoak()
+{
+	if(!GEngine)
+	{
+		return;
+	}
+
+	for(const FWorldContext& CurrentContext : GEngine->GetWorldContexts())
+	{
+		const UWorld* World = CurrentContext.World();
+		if(UInventorySoakSubsystem* Soak = World ? World->GetSubsystem<UInventorySoakSubsystem>() : nullptr)
+		{
+			if(Soak->IsRunning())
+			{
+				Soak->Stop();
+			}
+		}
+	}
+}
+
+void UInventorySoakSubsystem::Start(float NewOperationsPerSecond, float Duration)
+{
+	Running = true;
+	OperationsPerSecond = FMath::Max(NewOperationsPerSecond, 0.f);
+	OperationBudget = 0;
+	EndTime = Duration > 0 ? FPlatformTime::Seconds() + Duration : 0;
+
+	//Seeded by the world so every simulated client runs its own, repeatable, workload.
+	Random.Initialize(GetTypeHash(GetWorld()->GetName()));
+
+	PendingOperations.Empty();
+	Stats.Empty();
+	LootedItems.Empty();
+	FrameTimes.Empty();
+
+	if(const URPCBudgetSubsystem* Budget = GetWorld()->GetSubsystem<URPCBudgetSubsystem>())
+	{
+		RejectedRequestsAtStart = Budget->RejectedRequests;
+		DeferredRequestsAtStart = Budget->DeferredRequestsTotal;
+	}
+
+	UE_LOG(LogInventoryFramework, Log, TEXT("IFP soak started in %s, %.1f operations per second"), *GetWorld()->GetName(), OperationsPerSecond);
+}
+
+void UInventorySoakSubsystem::Stop()
+{
+	Running = false;
+
+	//Anything the server never answered counts as timed out.
+	for(const FInventorySoakPendingOperation& CurrentOperation : PendingOperations)
+	{
+		Stats.FindOrAdd(CurrentOperation.Operation).TimedOut++;
+	}
+	PendingOperations.Empty();
+
+	LogReport();
+
+	if(!GEngine)
+	{
+		return;
+	}
+
+	//The RPC profiler is shared by every world, only dump it once the last one is done.
+	for(const FWorldContext& CurrentContext : GEngine->GetWorldContexts())
+	{
+		const UWorld* World = CurrentContext.World();
+		const UInventorySoakSubsystem* Soak = World ? World->GetSubsystem<UInventorySoakSubsystem>() : nullptr;
+		if(Soak && Soak->IsRunning())
+		{
+			return;
+		}
+	}
+
+	URPCProfilerSubsystem* Profiler = GEngine->GetEngineSubsystem<URPCProfilerSubsystem>();
+	if(Profiler && Profiler->IsRecording())
+	{
+		Profiler->StopRecording();
+		Profiler->DumpToCSV(FString::Printf(TEXT("IFP_Soak_%s.csv"), *FDateTime::Now().ToString()));
+	}
+}
+
+void UInventorySoakSubsystem::RunClientWorkload(UAC_Inventory* Component)
+{
+	int32 ComponentPendingOperations = 0;
+	for(const FInventorySoakPendingOperation& CurrentOperation : PendingOperations)
+	{
+		if(CurrentOperation.Component == Component)
+		{
+			ComponentPendingOperations++;
+		}
+	}
+
+	if(ComponentPendingOperations >= MaxPendingOperationsPerComponent)
+	{
+		return;
+	}
+
+	//Start at a random operation and fall through to the others if it isn't possible right now.
+	const int32 FirstOperation = Random.RandRange(0, 2);
+	for(int32 Attempt = 0; Attempt < 3; Attempt++)
+	{
+		bool Success = false;
+		switch((FirstOperation + Attempt) % 3)
+		{
+			case 0: Success = TryMove(Component); break;
+			case 1: Success = TryStack(Component); break;
+			default: Success = TrySplit(Component); break;
+		}
+
+		if(Success)
+		{
+			return;
+		}
+	}
+}
+
+void UInventorySoakSubsystem::RunLootWorkload()
+{
+	for(FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if(!PlayerController)
+		{
+			continue;
+		}
+
+		UAC_Inventory* Component = PlayerController->FindComponentByClass<UAC_Inventory>();
+		if(!Component && PlayerController->GetPawn())
+		{
+			Component = PlayerController->GetPawn()->FindComponentByClass<UAC_Inventory>();
+		}
+
+		if(IsValid(Component) && Component->Initialized)
+		{
+			TryLoot(Component);
+		}
+	}
+}
+
+bool UInventorySoakSubsystem::TryMove(UAC_Inventory* Component)
+{
+	TArray<FS_InventoryItem> Items = GetAvailableItems(Component);
+	if(!Items.IsValidIndex(0))
+	{
+		return false;
+	}
+
+	const FS_InventoryItem Item = Items[Random.RandRange(0, Items.Num() - 1)];
+
+	TArray<int32> ContainerIndexes;
+	for(const FS_ContainerSettings& CurrentContainer : Component->ContainerSettings)
+	{
+		if(CurrentContainer.ContainerType == Inventory && CurrentContainer.Style != DataOnly)
+		{
+			ContainerIndexes.Add(CurrentContainer.ContainerIndex);
+		}
+	}
+
+	if(!ContainerIndexes.IsValidIndex(0))
+	{
+		return false;
+	}
+
+	const FS_ContainerSettings& Container = Component->ContainerSettings[ContainerIndexes[Random.RandRange(0, ContainerIndexes.Num() - 1)]];
+	bool SpotFound = false;
+	int32 AvailableTile = -1;
+	TEnumAsByte<ERotation> NeededRotation = Item.Rotation;
+	Component->GetFirstAvailableTile(Item, Container, TArray<int32>(), SpotFound, AvailableTile, NeededRotation);
+	if(!SpotFound || AvailableTile < 0)
+	{
+		return false;
+	}
+
+	TSet<int32> PredictionsBefore;
+	Component->PendingPredictions.GetKeys(PredictionsBefore);
+	Component->MoveItem(Item, Component, Component, Container.ContainerIndex, AvailableTile, Item.Count, true, true, false, NeededRotation);
+	AddPendingOperation(EInventorySoakOperation::Move, Component, {Item.UniqueID}, PredictionsBefore);
+	return true;
+}
+
+bool UInventorySoakSubsystem::TryStack(UAC_Inventory* Component)
+{
+	TArray<FS_InventoryItem> Items = GetAvailableItems(Component);
+	if(Items.Num() < 2)
+	{
+		return false;
+	}
+
+	const int32 StartIndex = Random.RandRange(0, Items.Num() - 1);
+	for(int32 FirstOffset = 0; FirstOffset < Items.Num(); FirstOffset++)
+	{
+		const FS_InventoryItem& Item1 = Items[(StartIndex + FirstOffset) % Items.Num()];
+		if(!Item1.ItemAsset->CanItemStack())
+		{
+			continue;
+		}
+
+		for(const FS_InventoryItem& Item2 : Items)
+		{
+			if(Item1.UniqueID == Item2.UniqueID || Item1.ItemAsset != Item2.ItemAsset || !UFL_InventoryFramework::CanStackItems(Item1, Item2))
+			{
+				continue;
+			}
+
+			TSet<int32> PredictionsBefore;
+			Component->PendingPredictions.GetKeys(PredictionsBefore);
+			int32 Item1RemainingCount;
+			int32 Item2NewStackCount;
+			Component->StackTwoItems(Item1, Item2, Item1RemainingCount, Item2NewStackCount);
+			AddPendingOperation(EInventorySoakOperation::Stack, Component, {Item1.UniqueID, Item2.UniqueID}, PredictionsBefore);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UInventorySoakSubsystem::TrySplit(UAC_Inventory* Component)
+{
+	TArray<FS_InventoryItem> Items = GetAvailableItems(Component);
+	Items.RemoveAll([](const FS_InventoryItem& Item)
+	{
+		return !Item.ItemAsset->CanItemStack() || Item.Count < 2;
+	});
+
+	if(!Items.IsValidIndex(0))
+	{
+		return false;
+	}
+
+	const FS_InventoryItem Item = Items[Random.RandRange(0, Items.Num() - 1)];
+	bool SpotFound = false;
+	int32 AvailableTile = -1;
+	TEnumAsByte<ERotation> NeededRotation = Item.Rotation;
+	Component->GetFirstAvailableTile(Item, Component->ContainerSettings[Item.ContainerIndex], TArray<int32>(), SpotFound, AvailableTile, NeededRotation);
+	if(!SpotFound || AvailableTile < 0)
+	{
+		return false;
+	}
+
+	TSet<int32> PredictionsBefore;
+	Component->PendingPredictions.GetKeys(PredictionsBefore);
+	int32 Item1RemainingCount;
+	int32 Item2NewStackCount;
+	Component->SplitItem(Item, Item.Count / 2, Component, Item.ContainerIndex, AvailableTile, Item1RemainingCount, Item2NewStackCount);
+	AddPendingOperation(EInventorySoakOperation::Split, Component, {Item.UniqueID}, PredictionsBefore);
+	return true;
+}
+
+bool UInventorySoakSubsystem::TryLoot(UAC_Inventory* Component)
+{
+	/**This runs on the server and finishes right away, so there is no latency to record.
+	 * The cost of looting shows up in the frame times instead.*/
+	FInventorySoakOperationStats& LootStats = Stats.FindOrAdd(EInventorySoakOperation::Loot);
+
+	//Discard whatever we looted last time so the inventory doesn't fill up.
+	FS_UniqueID LootedItemID;
+	if(LootedItems.RemoveAndCopyValue(Component, LootedItemID))
+	{
+		const FS_InventoryItem LootedItem = Component->GetItemByUniqueID(LootedItemID);
+		if(LootedItem.IsValid() && !Component->IsItemInNetworkQueue(LootedItemID))
+		{
+			bool Success = false;
+			Component->RemoveItemFromInventory(LootedItem, true, true, true, true, true, Success);
+			LootStats.Issued++;
+			LootStats.Completed++;
+			return true;
+		}
+	}
+
+	TArray<FS_InventoryItem> Items = GetAvailableItems(Component);
+	if(!Items.IsValidIndex(0))
+	{
+		return false;
+	}
+
+	const FS_InventoryItem& Template = Items[Random.RandRange(0, Items.Num() - 1)];
+	FS_InventoryItem NewItem;
+	NewItem.ItemAssetSoftReference = Template.ItemAssetSoftReference;
+	NewItem.ItemAsset = Template.ItemAsset;
+	NewItem.Count = 1;
+
+	bool Result = false;
+	FS_InventoryItem AddedItem;
+	int32 StackDelta = 0;
+	Component->TryAddNewItem(NewItem, TArray<FS_ContainerSettings>(), Component, true, true, Result, AddedItem, StackDelta);
+
+	LootStats.Issued++;
+	if(!Result)
+	{
+		LootStats.TimedOut++;
+		return false;
+	}
+
+	LootStats.Completed++;
+	LootedItems.Add(Component, AddedItem.UniqueID);
+	return true;
+}
+
+TArray<FS_InventoryItem> UInventorySoakSubsystem::GetAvailableItems(UAC_Inventory* Component) const
+{
+	TArray<FS_InventoryItem> Items;
+	for(const FS_ContainerSettings& CurrentContainer : Component->ContainerSettings)
+	{
+		if(CurrentContainer.ContainerType != Inventory || CurrentContainer.Style == DataOnly)
+		{
+			continue;
+		}
+
+		for(const FS_InventoryItem& CurrentItem : CurrentContainer.Items)
+		{
+			if(IsValid(CurrentItem.ItemAsset) && !Component->IsItemInNetworkQueue(CurrentItem.UniqueID))
+			{
+				Items.Add(CurrentItem);
+			}
+		}
+	}
+
+	return Items;
+}
+
+void UInventorySoakSubsystem::AddPendingOperation(EInventorySoakOperation Operation, UAC_Inventory* Component, const TArray<FS_UniqueID>& ItemIDs,
+	const TSet<int32>& PredictionsBefore)
+{
+	FInventorySoakPendingOperation& NewOperation = PendingOperations.AddDefaulted_GetRef();
+	NewOperation.Operation = Operation;
+	NewOperation.StartTime = FPlatformTime::Seconds();
+	NewOperation.Component = Component;
+	NewOperation.ItemIDs = ItemIDs;
+
+	for(const auto& CurrentPrediction : Component->PendingPredictions)
+	{
+		if(!PredictionsBefore.Contains(CurrentPrediction.Key))
+		{
+			NewOperation.PredictionIDs.Add(CurrentPrediction.Key);
+		}
+	}
+
+	Stats.FindOrAdd(Operation).Issued++;
+}
+
+void UInventorySoakSubsystem::UpdatePendingOperations()
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	const float QueueTimeout = UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->NetworkQueueTimeout;
+	const double Timeout = QueueTimeout > 0 ? QueueTimeout : 15;
+
+	for(int32 OperationIndex = PendingOperations.Num() - 1; OperationIndex >= 0; OperationIndex--)
+	{
+		const FInventorySoakPendingOperation& CurrentOperation = PendingOperations[OperationIndex];
+		const UAC_Inventory* Component = CurrentOperation.Component.Get();
+
+		bool Waiting = false;
+		if(Component)
+		{
+			Waiting = CurrentOperation.ItemIDs.ContainsByPredicate([Component](const FS_UniqueID& ItemID) { return Component->IsItemInNetworkQueue(ItemID); })
+				|| CurrentOperation.PredictionIDs.ContainsByPredicate([Component](const int32 PredictionID) { return Component->PendingPredictions.Contains(PredictionID); });
+		}
+
+		const double Latency = CurrentTime - CurrentOperation.StartTime;
+		if(Waiting && Latency < Timeout)
+		{
+			continue;
+		}
+
+		FInventorySoakOperationStats& OperationStats = Stats.FindOrAdd(CurrentOperation.Operation);
+		if(!Component || Waiting)
+		{
+			OperationStats.TimedOut++;
+		}
+		else
+		{
+			OperationStats.Completed++;
+			OperationStats.Latencies.Add(Latency);
+		}
+
+		PendingOperations.RemoveAtSwap(OperationIndex);
+	}
+}
+
+void UInventorySoakSubsystem::LogReport() const
+{
+	const UWorld* World = GetWorld();
+	const ENetMode NetMode = World->GetNetMode();
+	const TCHAR* NetModeName = NetMode == NM_Client ? TEXT("Client") : NetMode == NM_ListenServer ? TEXT("Listen Server") : NetMode == NM_DedicatedServer ? TEXT("Dedicated Server") : TEXT("Standalone");
+
+	UE_LOG(LogInventoryFramework, Log, TEXT("IFP soak report for %s (%s)"), *World->GetName(), NetModeName);
+
+	for(const auto& CurrentStat : Stats)
+	{
+		const FInventorySoakOperationStats& OperationStats = CurrentStat.Value;
+		if(!OperationStats.Latencies.IsValidIndex(0))
+		{
+			UE_LOG(LogInventoryFramework, Log, TEXT("  %s: %d issued, %d completed, %d timed out"),
+				*StaticEnum<EInventorySoakOperation>()->GetNameStringByValue(static_cast<int64>(CurrentStat.Key)),
+				OperationStats.Issued, OperationStats.Completed, OperationStats.TimedOut);
+			continue;
+		}
+
+		UE_LOG(LogInventoryFramework, Log, TEXT("  %s: %d issued, %d completed, %d timed out, latency mean %.2f ms, p99 %.2f ms, max %.2f ms"),
+			*StaticEnum<EInventorySoakOperation>()->GetNameStringByValue(static_cast<int64>(CurrentStat.Key)),
+			OperationStats.Issued, OperationStats.Completed, OperationStats.TimedOut,
+			GetMean(OperationStats.Latencies) * 1000, GetPercentile(OperationStats.Latencies, 0.99) * 1000, GetPercentile(OperationStats.Latencies, 1) * 1000);
+	}
+
+	if(FrameTimes.IsValidIndex(0))
+	{
+		UE_LOG(LogInventoryFramework, Log, TEXT("  Frame time: mean %.2f ms, p99 %.2f ms, max %.2f ms over %d frames"),
+			GetMean(FrameTimes) * 1000, GetPercentile(FrameTimes, 0.99) * 1000, GetPercentile(FrameTimes, 1) * 1000, FrameTimes.Num());
+	}
+
+	if(const URPCBudgetSubsystem* Budget = World->GetSubsystem<URPCBudgetSubsystem>())
+	{
+		UE_LOG(LogInventoryFramework, Log, TEXT("  RPC budget: %d rejected, %d deferred"),
+			Budget->RejectedRequests - RejectedRequestsAtStart, Budget->DeferredRequestsTotal - DeferredRequestsAtStart);
+	}
+}
@@ -0,0 +1,74 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Subsystems/InventoryStartupSubsystem.h"
+
+#include "Core/Components/AC_Inventory.h"
+#include "Core/Data/DS_InventoryFrameworkSettingsRuntime.h"
+
+
+bool UInventoryStartupSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UInventoryStartupSubsystem::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryStartupSubsystem::Tick)
+
+	const double FrameBudget = UDS_InventoryFrameworkSettingsRuntime::GetIFPSettings()->StartComponentFrameBudgetMs / 1000.0;
+	const double StartTime = FPlatformTime::Seconds();
+	bool RanStep = false;
+
+	for(int32 CurrentIndex = 0; CurrentIndex < QueuedComponents.Num();)
+	{
+		UAC_Inventory* Component = QueuedComponents[CurrentIndex].Get();
+
+		//Component was destroyed, stopped or finished by a regular StartComponent.
+		if(!IsValid(Component) || !IsValid(Component->GetOwner()) || !Component->IsComponentStarting())
+		{
+			QueuedComponents.RemoveAt(CurrentIndex);
+			continue;
+		}
+
+		if(Component->IsStartWaitingForAssets() || Component->IsStartWaitingForLoot())
+		{
+			CurrentIndex++;
+			continue;
+		}
+
+		//Always run at least one step per frame, even if the budget is smaller than that step.
+		bool MoreWork = true;
+		while(MoreWork && !Component->IsStartWaitingForAssets() && !Component->IsStartWaitingForLoot() && (!RanStep || FPlatformTime::Seconds() - StartTime < FrameBudget))
+		{
+			MoreWork = Component->RunStartComponentStep();
+			RanStep = true;
+		}
+
+		if(!MoreWork)
+		{
+			QueuedComponents.RemoveAt(CurrentIndex);
+			continue;
+		}
+
+		if(FPlatformTime::Seconds() - StartTime >= FrameBudget)
+		{
+			return;
+		}
+
+		CurrentIndex++;
+	}
+}
+
+TStatId UInventoryStartupSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInventoryStartupSubsystem, STATGROUP_Tickables);
+}
+
+void UInventoryStartupSubsystem::QueueComponent(UAC_Inventory* Component)
+{
+	if(IsValid(Component))
+	{
+		QueuedComponents.AddUnique(Component);
+	}
+}
@@ -0,0 +1,237 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Subsystems/RPCBudgetSubsystem.h"
+
+#include "Core/Data/DS_InventoryFrameworkSettingsRuntime.h"
+#include "Core/Data/FL_InventoryFramework.h"
+#include "Engine/NetConnection.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+
+void FRPCTokenBucket::Refill(double CurrentTime, float BurstSize, float TokensPerSecond)
+{
+	if(LastRefillTime <= 0)
+	{
+		Tokens = BurstSize;
+	}
+	else
+	{
+		Tokens = FMath::Min<float>(BurstSize, Tokens + (CurrentTime - LastRefillTime) * TokensPerSecond);
+	}
+	LastRefillTime = CurrentTime;
+}
+
+bool FRPCTokenBucket::TrySpend()
+{
+	if(Tokens < 1)
+	{
+		return false;
+	}
+
+	Tokens -= 1;
+	return true;
+}
+
+bool URPCBudgetSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	//Server RPC's are only ever processed on the server.
+	return UKismetSystemLibrary::IsServer(Outer);
+}
+
+void URPCBudgetSubsystem::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(URPCBudgetSubsystem::Tick)
+
+	RefreshFrameCost();
+
+	const UDS_InventoryFrameworkSettingsRuntime* IFPSettings = GetDefault<UDS_InventoryFrameworkSettingsRuntime>();
+	const double FrameBudget = IFPSettings->RPCFrameBudgetMs / 1000.0;
+
+	//Work through the deferred requests in the order they arrived until we run out of budget.
+	int32 ProcessedRequests = 0;
+	while(DeferredRequests.IsValidIndex(ProcessedRequests) && (FrameBudget <= 0 || FrameCost < FrameBudget))
+	{
+		FDeferredRPCRequest CurrentRequest = MoveTemp(DeferredRequests[ProcessedRequests]);
+		ProcessedRequests++;
+
+		if(FRPCTokenBucket* Bucket = Buckets.Find(CurrentRequest.Connection))
+		{
+			Bucket->DeferredRequests = FMath::Max(Bucket->DeferredRequests - 1, 0);
+		}
+
+		//Component or connection might have been destroyed while the request was waiting.
+		if(!CurrentRequest.Requester.IsValid() || !CurrentRequest.Connection.ResolveObjectPtr())
+		{
+			continue;
+		}
+
+		//So might anything else the request was called with.
+		const bool HasStaleObject = CurrentRequest.ReferencedObjects.ContainsByPredicate([](const TWeakObjectPtr<const UObject>& ReferencedObject)
+		{
+			return !ReferencedObject.IsValid();
+		});
+		if(HasStaleObject)
+		{
+			RejectedRequests++;
+			if(CurrentRequest.RejectedRequest)
+			{
+				CurrentRequest.RejectedRequest();
+			}
+			continue;
+		}
+
+		ProcessingDeferredRequest = true;
+		CurrentRequest.Request();
+		ProcessingDeferredRequest = false;
+	}
+
+	if(ProcessedRequests > 0)
+	{
+		DeferredRequests.RemoveAt(0, ProcessedRequests);
+	}
+
+	//Forget about connections that have closed.
+	for(auto It = Buckets.CreateIterator(); It; ++It)
+	{
+		if(!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+TStatId URPCBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPCBudgetSubsystem, STATGROUP_Tickables);
+}
+
+bool URPCBudgetSubsystem::AdmitRequest(UActorComponent* Component, TFunction<void()> DeferredRequest, TArray<const UObject*> ReferencedObjects,
+	TFunction<void()> RejectedRequest)
+{
+	const UDS_InventoryFrameworkSettingsRuntime* IFPSettings = GetDefault<UDS_InventoryFrameworkSettingsRuntime>();
+	if(!IFPSettings->ThrottleServerRPCs || !IsValid(Component) || !Component->GetWorld())
+	{
+		return true;
+	}
+
+	URPCBudgetSubsystem* Subsystem = Component->GetWorld()->GetSubsystem<URPCBudgetSubsystem>();
+	if(!Subsystem)
+	{
+		return true;
+	}
+
+	/**Deferred requests already paid for their token when they first arrived,
+	 * and RPC's called from inside an admitted RPC are part of that request.*/
+	if(Subsystem->ProcessingDeferredRequest || Subsystem->ActiveScopes > 0)
+	{
+		return true;
+	}
+
+	//No connection means this is the listen server host or the server itself.
+	const AActor* Owner = Component->GetOwner();
+	UNetConnection* Connection = Owner ? Owner->GetNetConnection() : nullptr;
+	if(!Connection)
+	{
+		return true;
+	}
+
+	/**Requests without a way to tell the client they were rejected
+	 * would just be lost, they can only be deferred.*/
+	const bool CanBeRejected = RejectedRequest != nullptr;
+	FRPCTokenBucket& Bucket = Subsystem->Buckets.FindOrAdd(Connection);
+	if(CanBeRejected)
+	{
+		Bucket.Refill(FPlatformTime::Seconds(), IFPSettings->RPCBurstSize, IFPSettings->RPCTokensPerSecond);
+	}
+
+	if(CanBeRejected && !Bucket.TrySpend())
+	{
+		Subsystem->RejectedRequests++;
+		UFL_InventoryFramework::LogIFPMessage(Component, FString::Printf(TEXT("%s is sending RPC's faster than allowed, request rejected - RPCBudgetSubsystem.cpp -> AdmitRequest"),
+			*GetNameSafe(Owner)), true, false);
+		if(RejectedRequest)
+		{
+			RejectedRequest();
+		}
+		return false;
+	}
+
+	Subsystem->RefreshFrameCost();
+	const bool OverFrameBudget = IFPSettings->RPCFrameBudgetMs > 0 && Subsystem->FrameCost * 1000.0 >= IFPSettings->RPCFrameBudgetMs;
+
+	//If this connection already has requests waiting, this one has to wait too
+	//so it doesn't get processed before them.
+	if(!OverFrameBudget && Bucket.DeferredRequests == 0)
+	{
+		return true;
+	}
+
+	if(CanBeRejected && Bucket.DeferredRequests >= IFPSettings->MaxDeferredRPCsPerConnection)
+	{
+		Subsystem->RejectedRequests++;
+		UFL_InventoryFramework::LogIFPMessage(Component, FString::Printf(TEXT("%s has too many deferred RPC's, request rejected - RPCBudgetSubsystem.cpp -> AdmitRequest"),
+			*GetNameSafe(Owner)), true, false);
+		if(RejectedRequest)
+		{
+			RejectedRequest();
+		}
+		return false;
+	}
+
+	Bucket.DeferredRequests++;
+	Subsystem->DeferredRequestsTotal++;
+
+	FDeferredRPCRequest NewRequest;
+	NewRequest.Requester = Component;
+	NewRequest.Connection = Connection;
+	NewRequest.ReferencedObjects.Reserve(ReferencedObjects.Num());
+	for(const UObject* CurrentObject : ReferencedObjects)
+	{
+		//Null arguments are valid for some RPC's, there's nothing to go stale.
+		if(CurrentObject)
+		{
+			NewRequest.ReferencedObjects.Add(CurrentObject);
+		}
+	}
+	NewRequest.Request = MoveTemp(DeferredRequest);
+	NewRequest.RejectedRequest = MoveTemp(RejectedRequest);
+	Subsystem->DeferredRequests.Add(MoveTemp(NewRequest));
+	return false;
+}
+
+void URPCBudgetSubsystem::AddFrameCost(double Seconds)
+{
+	RefreshFrameCost();
+	FrameCost += Seconds;
+}
+
+void URPCBudgetSubsystem::RefreshFrameCost()
+{
+	//RPC's are received before the world ticks, so the budget is tracked per engine frame.
+	if(FrameCostFrame != GFrameCounter)
+	{
+		FrameCostFrame = GFrameCounter;
+		FrameCost = 0;
+	}
+}
+
+FRPCBudgetScope::FRPCBudgetScope(const UObject* WorldContext)
+{
+	const UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+	if(URPCBudgetSubsystem* FoundSubsystem = World ? World->GetSubsystem<URPCBudgetSubsystem>() : nullptr)
+	{
+		Subsystem = FoundSubsystem;
+		FoundSubsystem->ActiveScopes++;
+		StartTime = FPlatformTime::Seconds();
+	}
+}
+
+FRPCBudgetScope::~FRPCBudgetScope()
+{
+	if(URPCBudgetSubsystem* FoundSubsystem = Subsystem.Get())
+	{
+		FoundSubsystem->ActiveScopes--;
+		FoundSubsystem->AddFrameCost(FPlatformTime::Seconds() - StartTime);
+	}
+}
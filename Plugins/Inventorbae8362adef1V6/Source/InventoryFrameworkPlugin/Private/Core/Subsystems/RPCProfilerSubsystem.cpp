@@ -0,0 +1,208 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Subsystems/RPCProfilerSubsystem.h"
+
+#include "InventoryFrameworkPlugin.h"
+#include "Engine/ActorChannel.h"
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Net/RepLayout.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "UObject/CoreNet.h"
+
+//How many payload sizes are kept per RPC for the p99.
+static constexpr int32 MaxSamplesPerRPC = 4096;
+
+static URPCProfilerSubsystem* GetRPCProfiler()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<URPCProfilerSubsystem>() : nullptr;
+}
+
+static FAutoConsoleCommand StartRPCProfilerCommand(
+	TEXT("IFP.RPCProfiler.Start"),
+	TEXT("Clear all recorded inventory RPC data and start recording."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if(URPCProfilerSubsystem* Profiler = GetRPCProfiler())
+		{
+			Profiler->StartRecording();
+		}
+	}));
+
+static FAutoConsoleCommand StopRPCProfilerCommand(
+	TEXT("IFP.RPCProfiler.Stop"),
+	TEXT("Stop recording inventory RPC data."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if(URPCProfilerSubsystem* Profiler = GetRPCProfiler())
+		{
+			Profiler->StopRecording();
+		}
+	}));
+
+static FAutoConsoleCommand DumpRPCProfilerCommand(
+	TEXT("IFP.RPCProfiler.Dump"),
+	TEXT("Write the recorded inventory RPC data to a CSV in the profiling directory. Optional argument: file name."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if(URPCProfilerSubsystem* Profiler = GetRPCProfiler())
+		{
+			Profiler->DumpToCSV(Args.IsValidIndex(0) ? Args[0] : FString());
+		}
+	}));
+
+void URPCProfilerSubsystem::RecordRPC(UActorComponent* Component, UFunction* Function, void* Parameters)
+{
+	URPCProfilerSubsystem* Profiler = GetRPCProfiler();
+	if(!Profiler || !Profiler->Recording || !IsValid(Component) || !Function)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(URPCProfilerSubsystem::RecordRPC)
+
+	const AActor* Owner = Component->GetOwner();
+	if(!Owner)
+	{
+		return;
+	}
+
+	FRPCProfilerKey Key;
+	Key.ComponentClass = Component->GetClass()->GetFName();
+	Key.Function = Function->GetFName();
+	Key.Server = Owner->HasAuthority();
+
+	const int32 Bytes = Profiler->MeasureParameters(Component, Function, Parameters);
+
+	FRPCProfilerStats& RPCStats = Profiler->Stats.FindOrAdd(Key);
+	RPCStats.Calls++;
+	RPCStats.TotalBytes += Bytes;
+
+	//Reservoir sampling, so long sessions keep a representative set of sizes.
+	if(RPCStats.Samples.Num() < MaxSamplesPerRPC)
+	{
+		RPCStats.Samples.Add(Bytes);
+	}
+	else
+	{
+		const int32 SampleIndex = FMath::RandRange(0, RPCStats.Calls - 1);
+		if(SampleIndex < MaxSamplesPerRPC)
+		{
+			RPCStats.Samples[SampleIndex] = Bytes;
+		}
+	}
+
+#if COUNTERSTRACE_ENABLED
+	if(!RPCStats.BytesCounter.IsValid())
+	{
+		const FString CounterPrefix = FString::Printf(TEXT("IFP/RPC/%s/%s/%s"), Key.Server ? TEXT("Server") : TEXT("Client"),
+			*Key.ComponentClass.ToString(), *Key.Function.ToString());
+		RPCStats.BytesCounterName = CounterPrefix + TEXT("/Bytes");
+		RPCStats.CallsCounterName = CounterPrefix + TEXT("/Calls");
+		RPCStats.BytesCounter = MakeUnique<FCountersTrace::FCounterInt>(*RPCStats.BytesCounterName, TraceCounterDisplayHint_Memory);
+		RPCStats.CallsCounter = MakeUnique<FCountersTrace::FCounterInt>(*RPCStats.CallsCounterName, TraceCounterDisplayHint_None);
+	}
+	RPCStats.BytesCounter->Set(RPCStats.TotalBytes);
+	RPCStats.CallsCounter->Set(RPCStats.Calls);
+#endif
+}
+
+int32 URPCProfilerSubsystem::MeasureParameters(UActorComponent* Component, UFunction* Function, void* Parameters) const
+{
+	AActor* Owner = Component->GetOwner();
+	UNetDriver* NetDriver = Owner->GetNetDriver();
+	if(!NetDriver || !Parameters)
+	{
+		return 0;
+	}
+
+	/**Owned actors use their own connection. Multicasts go to every client,
+	 * so the first connection that has a channel for the actor is used.*/
+	UNetConnection* Connection = Owner->GetNetConnection();
+	if(!Connection)
+	{
+		Connection = NetDriver->ServerConnection;
+	}
+	UActorChannel* Channel = Connection ? Connection->FindActorChannelRef(Owner) : nullptr;
+	if(!Channel)
+	{
+		for(UNetConnection* ClientConnection : NetDriver->ClientConnections)
+		{
+			Channel = ClientConnection ? ClientConnection->FindActorChannelRef(Owner) : nullptr;
+			if(Channel)
+			{
+				Connection = ClientConnection;
+				break;
+			}
+		}
+	}
+
+	if(!Channel)
+	{
+		return 0;
+	}
+
+	const TSharedPtr<FRepLayout> RepLayout = NetDriver->GetFunctionRepLayout(Function);
+	if(!RepLayout.IsValid())
+	{
+		return 0;
+	}
+
+	FNetBitWriter Writer(Connection->PackageMap, 0);
+	RepLayout->SendPropertiesForRPC(Function, Channel, Writer, static_cast<uint8*>(Parameters));
+	return static_cast<int32>(Writer.GetNumBytes());
+}
+
+void URPCProfilerSubsystem::StartRecording()
+{
+	Stats.Empty();
+	Recording = true;
+	UE_LOG(LogInventoryFramework, Log, TEXT("IFP RPC profiler started"));
+}
+
+void URPCProfilerSubsystem::StopRecording()
+{
+	Recording = false;
+	UE_LOG(LogInventoryFramework, Log, TEXT("IFP RPC profiler stopped, %d RPC's recorded"), Stats.Num());
+}
+
+FString URPCProfilerSubsystem::DumpToCSV(const FString& FileName)
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Side,ComponentClass,Function,Calls,TotalBytes,MeanBytes,P99Bytes"));
+
+	for(auto& CurrentStat : Stats)
+	{
+		const FRPCProfilerStats& RPCStats = CurrentStat.Value;
+		TArray<int32> SortedSamples = RPCStats.Samples;
+		SortedSamples.Sort();
+		const int32 P99 = SortedSamples.IsValidIndex(0) ? SortedSamples[FMath::Clamp(FMath::CeilToInt(SortedSamples.Num() * 0.99) - 1, 0, SortedSamples.Num() - 1)] : 0;
+		const double Mean = RPCStats.Calls > 0 ? static_cast<double>(RPCStats.TotalBytes) / RPCStats.Calls : 0;
+
+		Lines.Add(FString::Printf(TEXT("%s,%s,%s,%d,%lld,%.2f,%d"),
+			CurrentStat.Key.Server ? TEXT("Server") : TEXT("Client"),
+			*CurrentStat.Key.ComponentClass.ToString(),
+			*CurrentStat.Key.Function.ToString(),
+			RPCStats.Calls, RPCStats.TotalBytes, Mean, P99));
+	}
+
+	const FString CleanFileName = FileName.IsEmpty()
+		? FString::Printf(TEXT("IFP_RPCProfile_%s.csv"), *FDateTime::Now().ToString())
+		: FPaths::GetCleanFilename(FileName);
+	const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("IFP"), CleanFileName);
+
+	if(!FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+	{
+		UE_LOG(LogInventoryFramework, Warning, TEXT("IFP RPC profiler could not write %s"), *FilePath);
+		return FString();
+	}
+
+	TRACE_BOOKMARK(TEXT("IFP RPC profile dumped: %s"), *CleanFileName);
+	UE_LOG(LogInventoryFramework, Log, TEXT("IFP RPC profile written to %s"), *FilePath);
+	return FilePath;
+}
@@ -124,11 +124,9 @@ TArray<FString> UIT_SocketManager::VerifyData_Implementation(UDA_CoreItem* ItemA
 	if(ItemAsset)
 	{
 		//Check if any sockets are inside a disabled tile.
-		TArray<UItemTrait*> CustomShapeData;
-		UFL_InventoryFramework::GetTraitsByClassForItem(ItemAsset, UIT_CustomShapeData::StaticClass(), CustomShapeData);
-		if(CustomShapeData.IsValidIndex(0))
+		if(UIT_CustomShapeData* CustomShapeData = UFL_InventoryFramework::GetTraitForItem<UIT_CustomShapeData>(ItemAsset))
 		{
-			TArray<FIntPoint> DisabledTiles = Cast<UIT_CustomShapeData>(CustomShapeData[0])->DisabledTiles;
+			TArray<FIntPoint> DisabledTiles = CustomShapeData->DisabledTiles;
 			for(auto& CurrentSocket : Sockets)
 			{
 				if(DisabledTiles.Contains(CurrentSocket.Value.Location))
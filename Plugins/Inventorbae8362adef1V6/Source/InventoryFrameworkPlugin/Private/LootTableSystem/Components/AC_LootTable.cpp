@@ -32,6 +32,16 @@ void UAC_LootTable::BeginPlay()
 		{
 			DestroyComponent();
 		});
+		return;
+	}
+
+	//Get the weights ready now, rather than during the first roll.
+	for(auto& CurrentPool : LootPools)
+	{
+		if(CurrentPool)
+		{
+			CurrentPool->BuildWeights();
+		}
 	}
 }
 
@@ -80,6 +90,12 @@ void UAC_LootTable::PreInventoryInitialized_Implementation(UAC_Inventory* Invent
 {
 	for(auto& CurrentPool : LootPools)
 	{
+		//Already rolled by the loot generation subsystem.
+		if(CurrentPool->IsBatchRolled())
+		{
+			continue;
+		}
+
 		CurrentPool->ProcessPreInitializationLoot(Inventory);
 	}
 }
@@ -88,6 +104,12 @@ void UAC_LootTable::PostInventoryInitialized_Implementation(UAC_Inventory* Inven
 {
 	for(auto& CurrentPool : LootPools)
 	{
+		//Already rolled by the loot generation subsystem.
+		if(CurrentPool->IsBatchRolled())
+		{
+			continue;
+		}
+
 		CurrentPool->ProcessPostInitializationLoot(Inventory);
 	}
 
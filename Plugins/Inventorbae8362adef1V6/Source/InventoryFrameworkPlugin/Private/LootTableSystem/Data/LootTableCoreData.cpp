@@ -0,0 +1,101 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "LootTableSystem/Data/LootTableCoreData.h"
+
+bool FLootAliasTable::Build(TConstArrayView<float> Weights)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FLootAliasTable::Build)
+
+	Reset();
+	Built = true;
+
+	const int32 Num = Weights.Num();
+	for(const float CurrentWeight : Weights)
+	{
+		TotalWeight += FMath::Max(CurrentWeight, 0.f);
+	}
+
+	if(Num == 0 || TotalWeight <= 0)
+	{
+		TotalWeight = 0;
+		return false;
+	}
+
+	Probabilities.SetNumUninitialized(Num);
+	Aliases.SetNumUninitialized(Num);
+
+	//Scale the weights so the average is 1. Every column ends up
+	//holding one "small" entry, topped up by a "large" one.
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(Num);
+	TArray<int32> Small;
+	TArray<int32> Large;
+	Small.Reserve(Num);
+	Large.Reserve(Num);
+
+	for(int32 CurrentIndex = 0; CurrentIndex < Num; CurrentIndex++)
+	{
+		Scaled[CurrentIndex] = FMath::Max(Weights[CurrentIndex], 0.f) * Num / TotalWeight;
+		if(Scaled[CurrentIndex] < 1)
+		{
+			Small.Add(CurrentIndex);
+		}
+		else
+		{
+			Large.Add(CurrentIndex);
+		}
+	}
+
+	while(!Small.IsEmpty() && !Large.IsEmpty())
+	{
+		const int32 SmallIndex = Small.Pop(EAllowShrinking::No);
+		const int32 LargeIndex = Large.Pop(EAllowShrinking::No);
+
+		Probabilities[SmallIndex] = Scaled[SmallIndex];
+		Aliases[SmallIndex] = LargeIndex;
+
+		Scaled[LargeIndex] = (Scaled[LargeIndex] + Scaled[SmallIndex]) - 1;
+		if(Scaled[LargeIndex] < 1)
+		{
+			Small.Add(LargeIndex);
+		}
+		else
+		{
+			Large.Add(LargeIndex);
+		}
+	}
+
+	//Whatever is left over is 1, give or take floating point errors.
+	for(const int32 CurrentIndex : Large)
+	{
+		Probabilities[CurrentIndex] = 1;
+		Aliases[CurrentIndex] = CurrentIndex;
+	}
+	for(const int32 CurrentIndex : Small)
+	{
+		Probabilities[CurrentIndex] = 1;
+		Aliases[CurrentIndex] = CurrentIndex;
+	}
+
+	return true;
+}
+
+void FLootAliasTable::Reset()
+{
+	Probabilities.Reset();
+	Aliases.Reset();
+	TotalWeight = 0;
+	Built = false;
+}
+
+int32 FLootAliasTable::Draw(const FRandomStream& Stream) const
+{
+	if(Probabilities.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Column = Stream.RandHelper(Probabilities.Num());
+	return Stream.GetFraction() < Probabilities[Column] ? Column : Aliases[Column];
+}
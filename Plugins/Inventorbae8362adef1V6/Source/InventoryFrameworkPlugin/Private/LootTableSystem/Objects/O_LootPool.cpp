@@ -24,11 +24,20 @@ void UO_LootPool::StartPlay_Implementation()
 {
 }
 
+void UO_LootPool::PostLoad()
+{
+	Super::PostLoad();
+
+	BuildWeights();
+}
+
 #if WITH_EDITOR
 void UO_LootPool::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	UObject::PostEditChangeProperty(PropertyChangedEvent);
 
+	InvalidateWeights();
+
 	PostPropertyChange(PropertyChangedEvent.GetPropertyName(), PropertyChangedEvent.GetMemberPropertyName());
 }
 #endif
@@ -99,3 +108,88 @@ void UO_LootPool::AddItemPreInitializeOnly(FS_InventoryItem Item, FS_ContainerSe
 void UO_LootPool::PreLoadAssets_Implementation()
 {
 }
+
+void UO_LootPool::SetWeightedItems(const TArray<FSimpleLootTable>& NewItems)
+{
+	WeightedItems = NewItems;
+	InvalidateWeights();
+}
+
+bool UO_LootPool::RollWeightedItem(const FRandomStream& Stream, FSimpleLootTable& Item)
+{
+	if(!WeightsAliasTable.IsBuilt())
+	{
+		BuildWeights();
+	}
+
+	const int32 PickedIndex = WeightsAliasTable.Draw(Stream);
+	if(!WeightedItems.IsValidIndex(PickedIndex))
+	{
+		return false;
+	}
+
+	Item = WeightedItems[PickedIndex];
+	return true;
+}
+
+TArray<FSimpleLootTable> UO_LootPool::RollWeightedItems(const FRandomStream& Stream, int32 Rolls)
+{
+	TArray<FSimpleLootTable> RolledItems;
+	RolledItems.Reserve(FMath::Max(Rolls, 0));
+
+	FSimpleLootTable RolledItem;
+	for(int32 CurrentRoll = 0; CurrentRoll < Rolls; CurrentRoll++)
+	{
+		if(!RollWeightedItem(Stream, RolledItem))
+		{
+			break;
+		}
+
+		RolledItems.Add(RolledItem);
+	}
+
+	return RolledItems;
+}
+
+void UO_LootPool::RollBatchedItems(const FRandomStream& Stream, TArray<FRolledLootItem>& OutItems) const
+{
+	const int32 Rolls = Stream.RandRange(RandomMinMaxRolls.X, RandomMinMaxRolls.Y);
+	OutItems.Reserve(OutItems.Num() + FMath::Max(Rolls, 0));
+	for(int32 CurrentRoll = 0; CurrentRoll < Rolls; CurrentRoll++)
+	{
+		const int32 PickedIndex = WeightsAliasTable.Draw(Stream);
+		if(!WeightedItems.IsValidIndex(PickedIndex))
+		{
+			return;
+		}
+
+		const FSimpleLootTable& PickedItem = WeightedItems[PickedIndex];
+		const int32 Count = Stream.RandRange(PickedItem.RandomMinMaxCount.X, PickedItem.RandomMinMaxCount.Y);
+		if(Count > 0)
+		{
+			OutItems.Add({PickedItem.Item, Count});
+		}
+	}
+}
+
+bool UO_LootPool::IsBatchRolled() const
+{
+	return RandomMinMaxRolls.Y > 0 && !WeightedItems.IsEmpty();
+}
+
+void UO_LootPool::BuildWeights()
+{
+	TArray<float> Weights;
+	Weights.Reserve(WeightedItems.Num());
+	for(const FSimpleLootTable& CurrentItem : WeightedItems)
+	{
+		Weights.Add(CurrentItem.Item ? CurrentItem.SpawnPercentage : 0.f);
+	}
+
+	WeightsAliasTable.Build(Weights);
+}
+
+void UO_LootPool::InvalidateWeights()
+{
+	WeightsAliasTable.Reset();
+}
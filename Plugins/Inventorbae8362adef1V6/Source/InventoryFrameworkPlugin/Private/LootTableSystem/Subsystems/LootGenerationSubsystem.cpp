@@ -0,0 +1,98 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "LootTableSystem/Subsystems/LootGenerationSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Core/Components/AC_Inventory.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "LootTableSystem/Objects/O_LootPool.h"
+
+
+bool ULootGenerationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	//Loot tables do not work on clients.
+	return Super::ShouldCreateSubsystem(Outer) && UKismetSystemLibrary::IsServer(Outer);
+}
+
+bool ULootGenerationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void ULootGenerationSubsystem::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(ULootGenerationSubsystem::Tick)
+
+	TArray<UAC_Inventory*> Inventories;
+	Inventories.Reserve(QueuedInventories.Num());
+	for(auto& CurrentInventory : QueuedInventories)
+	{
+		//Destroyed, stopped or finished by a regular StartComponent in the meantime.
+		if(CurrentInventory.IsValid() && CurrentInventory->IsStartWaitingForLoot())
+		{
+			Inventories.Add(CurrentInventory.Get());
+		}
+	}
+	QueuedInventories.Reset();
+
+	GenerateLoot(Inventories);
+}
+
+TStatId ULootGenerationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULootGenerationSubsystem, STATGROUP_Tickables);
+}
+
+void ULootGenerationSubsystem::QueueInventory(UAC_Inventory* Inventory)
+{
+	if(IsValid(Inventory))
+	{
+		QueuedInventories.AddUnique(Inventory);
+	}
+}
+
+void ULootGenerationSubsystem::RemoveInventory(UAC_Inventory* Inventory)
+{
+	QueuedInventories.Remove(Inventory);
+}
+
+void ULootGenerationSubsystem::GenerateLoot(TConstArrayView<UAC_Inventory*> Inventories)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(ULootGenerationSubsystem::GenerateLoot)
+
+	if(Inventories.IsEmpty())
+	{
+		return;
+	}
+
+	//Every inventories jobs are stored next to each other, remember where they start.
+	TArray<FLootRollJob> Jobs;
+	TArray<int32> FirstJobs;
+	FirstJobs.Reserve(Inventories.Num() + 1);
+	for(UAC_Inventory* CurrentInventory : Inventories)
+	{
+		FirstJobs.Add(Jobs.Num());
+		CurrentInventory->GatherLootRolls(Jobs);
+	}
+	FirstJobs.Add(Jobs.Num());
+
+	RollJobs(Jobs);
+
+	for(int32 CurrentIndex = 0; CurrentIndex < Inventories.Num(); CurrentIndex++)
+	{
+		const int32 FirstJob = FirstJobs[CurrentIndex];
+		Inventories[CurrentIndex]->ApplyLootRolls(TArrayView<FLootRollJob>(Jobs).Slice(FirstJob, FirstJobs[CurrentIndex + 1] - FirstJob));
+	}
+}
+
+void ULootGenerationSubsystem::RollJobs(TArrayView<FLootRollJob> Jobs)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(ULootGenerationSubsystem::RollJobs)
+
+	ParallelFor(Jobs.Num(), [&Jobs](int32 Index)
+	{
+		FLootRollJob& Job = Jobs[Index];
+		Job.Pool->RollBatchedItems(FRandomStream(Job.Seed), Job.RolledItems);
+	}, Jobs.Num() < 8 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
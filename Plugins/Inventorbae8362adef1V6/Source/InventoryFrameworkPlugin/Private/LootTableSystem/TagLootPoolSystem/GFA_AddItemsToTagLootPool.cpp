@@ -4,6 +4,7 @@
 #include "LootTableSystem/TagLootPoolSystem/GFA_AddItemsToTagLootPool.h"
 
 #include "GameFeaturesSubsystem.h"
+#include "Misc/DataValidation.h"
 
 void UGFA_AddItemsToTagLootPool::OnGameFeatureActivating(FGameFeatureActivatingContext& Context)
 {
@@ -16,7 +17,7 @@ void UGFA_AddItemsToTagLootPool::OnGameFeatureActivating(FGameFeatureActivatingC
 			UTagLootPoolStorage* TagLootPoolStorage = WorldContext.World()->GetSubsystem<UTagLootPoolStorage>();
 			if(!TagLootPoolStorage)
 			{
-				return;
+				continue;
 			}
 			
 			TagLootPoolStorage->AppendTagLootPoolMap(TagLootPools);
@@ -35,10 +36,41 @@ void UGFA_AddItemsToTagLootPool::OnGameFeatureDeactivating(FGameFeatureDeactivat
 			UTagLootPoolStorage* TagLootPoolStorage = WorldContext.World()->GetSubsystem<UTagLootPoolStorage>();
 			if(!TagLootPoolStorage)
 			{
-				return;
+				continue;
 			}
 			
 			TagLootPoolStorage->RemoveTagLootPoolMap(TagLootPools);
 		}
 	}
-}
\ No newline at end of file
+}
+
+#if WITH_EDITOR
+EDataValidationResult UGFA_AddItemsToTagLootPool::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+	for(auto& CurrentTag : TagLootPools)
+	{
+		TSet<TSoftObjectPtr<UDA_CoreItem>> FoundItems;
+		FoundItems.Reserve(CurrentTag.Value.Items.Num());
+		for(auto& CurrentItem : CurrentTag.Value.Items)
+		{
+			if(CurrentItem.Item.IsNull())
+			{
+				Context.AddWarning(FText::FromString(FString::Printf(TEXT("%s has an entry with no item, it will never be rolled"), *CurrentTag.Key.ToString())));
+				continue;
+			}
+
+			bool AlreadyInPool = false;
+			FoundItems.Add(CurrentItem.Item, &AlreadyInPool);
+			if(AlreadyInPool)
+			{
+				Context.AddWarning(FText::FromString(FString::Printf(TEXT("%s has been added to %s more than once, only the last entry is used"),
+					*CurrentItem.Item.GetAssetName(), *CurrentTag.Key.ToString())));
+			}
+		}
+	}
+
+	return Result;
+}
+#endif
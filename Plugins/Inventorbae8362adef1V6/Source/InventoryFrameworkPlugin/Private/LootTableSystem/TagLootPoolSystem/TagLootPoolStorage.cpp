@@ -10,6 +10,118 @@
 #include "LootTableSystem/TagLootPoolSystem/GFA_AddItemsToTagLootPool.h"
 
 
+static bool CanRollTagPoolItem(const FTagPoolItem& Item)
+{
+	return !Item.Item.IsNull() && Item.SpawnChance > 0;
+}
+
+void FTagLootPool::BuildAliasTable()
+{
+	TArray<float> Weights;
+	Weights.Reserve(Items.Num());
+	for(auto& CurrentItem : Items)
+	{
+		Weights.Add(CanRollTagPoolItem(CurrentItem) ? CurrentItem.SpawnChance : 0.f);
+	}
+	AliasTable.Build(Weights);
+}
+
+void FTagLootPool::RebuildIndex()
+{
+	ItemIndexes.Reset();
+	ItemIndexes.Reserve(Items.Num());
+	TotalSpawnChance = 0;
+
+	TArray<FTagPoolItem> UniqueItems;
+	UniqueItems.Reserve(Items.Num());
+	for(auto& CurrentItem : Items)
+	{
+		if(int32* ExistingIndex = ItemIndexes.Find(CurrentItem.Item))
+		{
+			UniqueItems[*ExistingIndex] = CurrentItem;
+			continue;
+		}
+
+		ItemIndexes.Add(CurrentItem.Item, UniqueItems.Add(CurrentItem));
+	}
+	Items = MoveTemp(UniqueItems);
+
+	for(auto& CurrentItem : Items)
+	{
+		if(CanRollTagPoolItem(CurrentItem))
+		{
+			TotalSpawnChance += CurrentItem.SpawnChance;
+		}
+	}
+
+	AliasTable.Reset();
+}
+
+const FTagPoolItem* FTagLootPool::FindItem(const TSoftObjectPtr<UDA_CoreItem>& Item) const
+{
+	const int32* ItemIndex = ItemIndexes.Find(Item);
+	return ItemIndex ? &Items[*ItemIndex] : nullptr;
+}
+
+void FTagLootPool::AddOrUpdateItem(const FTagPoolItem& Item)
+{
+	AliasTable.Reset();
+
+	if(int32* ExistingIndex = ItemIndexes.Find(Item.Item))
+	{
+		FTagPoolItem& ExistingItem = Items[*ExistingIndex];
+		if(CanRollTagPoolItem(ExistingItem))
+		{
+			TotalSpawnChance -= ExistingItem.SpawnChance;
+		}
+
+		/**While I could just set the spawn chance,
+		 * I am overriding the item struct in its entirety
+		 * because people might expand that struct to inlucde
+		 * other properties.*/
+		ExistingItem = Item;
+	}
+	else
+	{
+		ItemIndexes.Add(Item.Item, Items.Add(Item));
+	}
+
+	if(CanRollTagPoolItem(Item))
+	{
+		TotalSpawnChance += Item.SpawnChance;
+	}
+}
+
+bool FTagLootPool::RemoveItem(const TSoftObjectPtr<UDA_CoreItem>& Item)
+{
+	int32 RemovedIndex = INDEX_NONE;
+	if(!ItemIndexes.RemoveAndCopyValue(Item, RemovedIndex))
+	{
+		return false;
+	}
+
+	AliasTable.Reset();
+
+	if(CanRollTagPoolItem(Items[RemovedIndex]))
+	{
+		TotalSpawnChance -= Items[RemovedIndex].SpawnChance;
+	}
+
+	Items.RemoveAtSwap(RemovedIndex, EAllowShrinking::No);
+	if(Items.IsValidIndex(RemovedIndex))
+	{
+		ItemIndexes[Items[RemovedIndex].Item] = RemovedIndex;
+	}
+
+	if(Items.IsEmpty())
+	{
+		//Don't let floating point errors pile up.
+		TotalSpawnChance = 0;
+	}
+
+	return true;
+}
+
 bool UTagLootPoolStorage::ShouldCreateSubsystem(UObject* Outer) const
 {
 	//This subsystem should not exist on clients, loot tables do not work on clients anyways
@@ -47,63 +159,107 @@ TArray<FTagPoolItem> UTagLootPoolStorage::GetItemsFromTagPool(FGameplayTag Tag)
 	return TArray<FTagPoolItem>();
 }
 
+bool UTagLootPoolStorage::RollItemFromTagPool(FGameplayTag TagPool, const FRandomStream& Stream, FTagPoolItem& Item)
+{
+	FTagLootPool* TagLootPool = FindTagLootPool(TagPool);
+	if(!TagLootPool)
+	{
+		return false;
+	}
+
+	if(!TagLootPool->AliasTable.IsBuilt())
+	{
+		TagLootPool->BuildAliasTable();
+	}
+
+	const int32 PickedIndex = TagLootPool->AliasTable.Draw(Stream);
+	if(!TagLootPool->Items.IsValidIndex(PickedIndex))
+	{
+		return false;
+	}
+
+	Item = TagLootPool->Items[PickedIndex];
+	return true;
+}
+
 float UTagLootPoolStorage::GetItemsSpawnChance(FGameplayTag TagPool, TSoftObjectPtr<UDA_CoreItem> Item)
 {
-	if(FTagLootPool* TagLootPool = TagLootPools.Find(TagPool))
+	if(FTagLootPool* TagLootPool = FindTagLootPool(TagPool))
 	{
-		for(auto& CurrentItem : TagLootPool->Items)
+		if(const FTagPoolItem* FoundItem = TagLootPool->FindItem(Item))
 		{
-			if(CurrentItem.Item == Item)
-			{
-				return CurrentItem.SpawnChance;
-			}
+			return FoundItem->SpawnChance;
 		}
 	}
 
 	return 0;
 }
 
-void UTagLootPoolStorage::AddItemToTagLootPool(FGameplayTag TagPool, FTagPoolItem Item)
+float UTagLootPoolStorage::GetItemsRollChance(FGameplayTag TagPool, TSoftObjectPtr<UDA_CoreItem> Item)
 {
-	FTagLootPool* TagLootPool = TagLootPools.Find(TagPool);
-	if(!TagLootPool)
+	FTagLootPool* TagLootPool = FindTagLootPool(TagPool);
+	if(!TagLootPool || TagLootPool->TotalSpawnChance <= 0)
 	{
-		FTagLootPool NewLootPool;
-		NewLootPool.Items.Add(FTagPoolItem(Item));
-		TagLootPools.Add(TagPool, NewLootPool);
-		return;
+		return 0;
 	}
 
-	for(auto& CurrentItem : TagLootPool->Items)
+	const FTagPoolItem* FoundItem = TagLootPool->FindItem(Item);
+	if(!FoundItem || !CanRollTagPoolItem(*FoundItem))
 	{
-		if(CurrentItem.Item == Item.Item)
-		{
-			/**While I could just set the spawn chance,
-			 * I am overriding the item struct in its entirety
-			 * because people might expand that struct to inlucde
-			 * other properties.*/
-			CurrentItem = Item;
-			return;
-		}
+		return 0;
 	}
-	
-	TagLootPool->Items.AddUnique(FTagPoolItem(Item));
+
+	return FoundItem->SpawnChance / TagLootPool->TotalSpawnChance;
+}
+
+float UTagLootPoolStorage::GetTagPoolTotalSpawnChance(FGameplayTag TagPool)
+{
+	if(FTagLootPool* TagLootPool = FindTagLootPool(TagPool))
+	{
+		return TagLootPool->TotalSpawnChance;
+	}
+
+	return 0;
+}
+
+void UTagLootPoolStorage::AddItemToTagLootPool(FGameplayTag TagPool, FTagPoolItem Item)
+{
+	FTagLootPool* TagLootPool = FindTagLootPool(TagPool);
+	if(!TagLootPool)
+	{
+		TagLootPool = &TagLootPools.Add(TagPool);
+	}
+
+	TagLootPool->AddOrUpdateItem(Item);
 }
 
-void UTagLootPoolStorage::AppendTagLootPoolMap(TMap<FGameplayTag, FTagLootPool> TagPool)
+void UTagLootPoolStorage::AppendTagLootPoolMap(const TMap<FGameplayTag, FTagLootPool>& TagPool)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UTagLootPoolStorage::AppendTagLootPoolMap)
+	
 	for(auto& CurrentTag : TagPool)
 	{
+		FTagLootPool* TagLootPool = FindTagLootPool(CurrentTag.Key);
+		if(!TagLootPool)
+		{
+			TagLootPool = &TagLootPools.Add(CurrentTag.Key);
+		}
+
+		TagLootPool->Items.Reserve(TagLootPool->Items.Num() + CurrentTag.Value.Items.Num());
+		TagLootPool->ItemIndexes.Reserve(TagLootPool->ItemIndexes.Num() + CurrentTag.Value.Items.Num());
 		for(auto& CurrentItem : CurrentTag.Value.Items)
 		{
-			AddItemToTagLootPool(CurrentTag.Key, CurrentItem);
+			TagLootPool->AddOrUpdateItem(CurrentItem);
 		}
+
+		//Build it once here instead of during the first roll.
+		TagLootPool->BuildAliasTable();
 	}
 }
 
-void UTagLootPoolStorage::RemoveItemsFromTagLootPool(FGameplayTag TagPool, TArray<TSoftObjectPtr<UDA_CoreItem>> Items)
+void UTagLootPoolStorage::RemoveItemsFromTagLootPool(FGameplayTag TagPool, const TArray<TSoftObjectPtr<UDA_CoreItem>>& Items)
 {
-	FTagLootPool* TagLootPool = TagLootPools.Find(TagPool);
+	FTagLootPool* TagLootPool = FindTagLootPool(TagPool);
 	if(!TagLootPool)
 	{
 		return;
@@ -111,19 +267,47 @@ void UTagLootPoolStorage::RemoveItemsFromTagLootPool(FGameplayTag TagPool, TArra
 	
 	for(auto& CurrentItem : Items)
 	{
-		TagLootPool->Items.RemoveSingle(CurrentItem);
+		TagLootPool->RemoveItem(CurrentItem);
+	}
+
+	if(TagLootPool->Items.IsEmpty())
+	{
+		TagLootPools.Remove(TagPool);
+	}
+}
+
+void UTagLootPoolStorage::RemoveTagLootPoolMap(const TMap<FGameplayTag, FTagLootPool>& TagPool)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UTagLootPoolStorage::RemoveTagLootPoolMap)
+	
+	for(auto& CurrentTag : TagPool)
+	{
+		FTagLootPool* TagLootPool = FindTagLootPool(CurrentTag.Key);
+		if(!TagLootPool)
+		{
+			continue;
+		}
+
+		for(auto& CurrentItem : CurrentTag.Value.Items)
+		{
+			TagLootPool->RemoveItem(CurrentItem.Item);
+		}
+
 		if(TagLootPool->Items.IsEmpty())
 		{
-			TagLootPools.Remove(TagPool);
-			return;
+			TagLootPools.Remove(CurrentTag.Key);
 		}
 	}
 }
 
-void UTagLootPoolStorage::RemoveTagLootPoolMap(TMap<FGameplayTag, FTagLootPool> TagPool)
+FTagLootPool* UTagLootPoolStorage::FindTagLootPool(FGameplayTag Tag)
 {
-	for(auto& CurrentTag : TagPool)
+	FTagLootPool* TagLootPool = TagLootPools.Find(Tag);
+	if(TagLootPool && !TagLootPool->IsIndexValid())
 	{
-		RemoveItemsFromTagLootPool(CurrentTag.Key, CurrentTag.Value.GetItems());
+		//Items were modified without going through the pool.
+		TagLootPool->RebuildIndex();
 	}
+
+	return TagLootPool;
 }
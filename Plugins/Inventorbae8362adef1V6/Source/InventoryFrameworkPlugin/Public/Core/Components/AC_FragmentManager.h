@@ -19,6 +19,9 @@ public:
 	// Sets default values for this component's properties
 	UAC_FragmentManager();
 
+	//Feeds the RPC profiler, see URPCProfilerSubsystem.
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack) override;
+
 	UPROPERTY()
 	TObjectPtr<UAC_Inventory> Inventory = nullptr;
 	UFUNCTION(Category = "Fragment Manager", BlueprintPure)
@@ -18,6 +18,7 @@
 #include "TimerManager.h"
 #include "Blueprint/UserWidget.h" //Why is this suddenly required in 5.4.3 to package IFP?
 #include "Engine/EngineTypes.h"
+#include "Engine/StreamableManager.h"
 #include "AC_Inventory.generated.h"
 
 struct FItemOverrideSettings;
@@ -30,6 +31,9 @@ class UItemInstance;
 class UItemComponent;
 class UW_InventoryItem;
 class UAC_Inventory;
+class FInventoryJournal;
+class UAC_LootTable;
+struct FLootRollJob;
 
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(IFP_SkipValidation)
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(IFP_IncludeLootTables)
@@ -81,6 +85,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FItemAbilityActivated, FS_Inventory
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FItemAbilityEnded, FS_InventoryItem, Item, UIC_ItemAbility*, Ability);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FContainerAdded, FS_ContainerSettings, Container);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FContainerRemoved, FS_ContainerSettings, Container);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPredictionRejected, int32, PredictionID);
 
 DECLARE_DYNAMIC_DELEGATE_FourParams(FItemAssetLoaded, UDA_CoreItem*, ItemAsset, FS_InventoryItem, Item, int32, ContainerIndex, int32, ItemIndex);
 DECLARE_DYNAMIC_DELEGATE(FAllItemAssetsLoaded);
@@ -90,6 +95,87 @@ DECLARE_DYNAMIC_DELEGATE(FAllItemAssetsLoaded);
 #pragma endregion
 
 
+enum class EComponentStartStage : uint8
+{
+	None,
+	Prepare,
+	//Only used by StartComponentTimeSliced, waits for the item assets to finish loading.
+	LoadAssets,
+	InitializeIDs,
+	//Waits for ULootGenerationSubsystem to roll the loot pools, see UO_LootPool::RandomMinMaxRolls.
+	RollLoot,
+	LootTables,
+	//Rolls spawn chances and counts of every item on worker threads.
+	EvaluateItems,
+	InitializeItems,
+	Finalize,
+	ItemInstances,
+	Equip,
+	Finish
+};
+
+/**The part of initializing an item that only reads the item and its asset,
+ * which allows it to be evaluated on a worker thread.
+ * See UAC_Inventory::EvaluateItems.*/
+struct FItemStartEvaluation
+{
+	bool PassedSpawnChance = true;
+
+	//Only false for vendors, if the item has no currencies it can be exchanged for.
+	bool HasAcceptedCurrencies = true;
+
+	//-1 if the count should be left alone.
+	int32 Count = -1;
+
+	//The count came from a RandomItemCount fragment on the item struct, which has to be removed.
+	bool RemoveRandomCountFragment = false;
+};
+
+/**Where StartComponent is at, so it can be resumed on a later frame.
+ * See UAC_Inventory::StartComponentTimeSliced.*/
+USTRUCT()
+struct FComponentStartState
+{
+	GENERATED_BODY()
+
+	EComponentStartStage Stage = EComponentStartStage::None;
+
+	//Container, loot table or equipped item the current stage continues from.
+	int32 Cursor = 0;
+
+	bool RemoveSkipValidationTags = false;
+
+	bool TimeSliced = false;
+
+	//Every item rolls its spawn chance and count from this and its IdentityNumber.
+	int32 ItemSeed = 0;
+
+	//Keyed by the items IdentityNumber.
+	TMap<int32, FItemStartEvaluation> ItemEvaluations;
+
+	//How many of the LootTables have had their pools rolled by ULootGenerationSubsystem.
+	int32 RolledLootTables = 0;
+
+	bool LootQueued = false;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UActorComponent>> InventoryExtensions;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UAC_LootTable>> LootTables;
+
+	UPROPERTY()
+	TArray<FS_ContainerSettings> ContainersToRemove;
+
+	//We need to call ItemEquipStatusUpdated AFTER everything has been processed,
+	//so keep a record of all items that were equipped.
+	UPROPERTY()
+	TArray<FS_InventoryItem> EquippedItems;
+
+	TSharedPtr<FStreamableHandle> AssetsHandle;
+};
+
+
 /**The inventory component that hosts everything related to
  * your inventory. Including containers and items and handling
  * replication and management of everything related to them.
@@ -112,6 +198,9 @@ public:
 	virtual bool IsSupportedForNetworking () const override { return true; }
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	//Feeds the RPC profiler, see URPCProfilerSubsystem.
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack) override;
 	
 	//--------------------
 	// Variables
@@ -152,19 +241,73 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Networking")
 	TArray<TObjectPtr<UAC_Inventory>> Listeners;
 
-	/**List of items that are currently pending some networking event
-	 * This is a system that allows designers to communicate to the player
-	 * that an item or container is currently waiting to be processed by the server.
-	 * There is currently no way of finding out if an unreliable RPC failed.
-	 * So for all functions that want to use this system must be set to Reliable.*/
+	/**How many entries have been evicted from the NetworkQueue because the
+	 * server never answered in time. If this keeps going up, something is
+	 * either dropping RPC's or the timeout is too low.*/
 	UPROPERTY(BlueprintReadOnly, Category = "Networking")
-	TArray<FS_UniqueID> NetworkQueue;
+	int32 NetworkQueueEvictions = 0;
 
 	/**Used to keep track if a client has received the container data after
 	 * requesting it.*/
 	UPROPERTY(BlueprintReadOnly, Category = "Networking")
 	bool ClientReceivedContainerData = false;
 
+	/**If true, clients will apply MoveItem, StackTwoItems and SplitItem
+	 * locally the moment they are called instead of waiting for the server.
+	 * The server then confirms or rejects the operation. If rejected, the
+	 * client restores the containers it had before the operation.
+	 *
+	 * The client derives the seed from the operation and the OperationSequence it
+	 * expects the server to run it at, so both normally generate the same
+	 * UniqueID's for any new items or containers.
+	 * The server never takes ID's from the client. If its result differs,
+	 * the client resyncs the affected components when the operation is confirmed.
+	 *
+	 * Operations that the client can't fully resolve, such as moving into an
+	 * infinite container without a specific tile, are never predicted.*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Networking")
+	bool PredictItemOperations = false;
+
+	/**Operations this client has predicted and is waiting for the server to
+	 * confirm or reject, keyed by their PredictionID.*/
+	UPROPERTY(BlueprintReadOnly, Category = "Networking")
+	TMap<int32, FS_PredictedOperation> PendingPredictions;
+
+	/**If true, the server puts the owning actor into net dormancy whenever
+	 * nobody is listening to this component and it has been idle for NetDormancyDelay.
+	 * It is woken up again when a listener is added, an item is modified
+	 * or the component tags change.
+	 *
+	 * This is only ever applied to replicated actors that aren't owned by
+	 * a player connection. Player inventories are never put to sleep.
+	 * Only enable this on actors that do nothing else over the network
+	 * while idle, like loot crates, corpses and stashes. AI pawns and
+	 * vendors usually replicate other state and should leave this off.*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Networking")
+	bool ManageNetDormancy = false;
+
+	/**How long the component has to be idle before the owner is put to sleep.
+	 * Keeps containers that are frequently interacted with from
+	 * constantly opening and closing their actor channel.*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Networking", meta = (EditCondition = "ManageNetDormancy", ClampMin = 0, Units = "Seconds"))
+	float NetDormancyDelay = 5;
+
+	/**The server only seeds handed out by NextOperationSeed are derived from
+	 * this base and the OperationSequence. Never replicated, so clients
+	 * can't work out what the server is going to roll.
+	 * Assigned by the server the first time a seed is needed.*/
+	int32 OperationSeedBase = 0;
+
+	/**On the server, how many operations this component has run.
+	 * Only the server advances it, once per operation, and it is mixed into
+	 * the seed of every operation. The C_ RPC's send it along, so clients
+	 * can reproduce the seed of an operation after the server ran it.
+	 *
+	 * On the owning client, this is the sequence it expects the server to
+	 * be at, used for predictions and corrected by C_ConfirmPrediction.*/
+	UPROPERTY(BlueprintReadOnly, Category = "Networking")
+	int32 OperationSequence = 0;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
 	bool DebugMessages = true;
 
@@ -179,7 +322,16 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Replicated)
 	FGameplayTagContainer TagsContainer;
 
+	/**What tag values does this component have at the moment?
+	 * Same rules as the TagsContainer apply. This is a fast array,
+	 * so only the values that change are replicated.
+	 * Use GetComponentTagValues for a plain array.*/
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Replicated)
+	FS_TagValueArray ComponentTagValues;
+
+	/**Old plain array version of ComponentTagValues. Authored values are moved over
+	 * to ComponentTagValues on load. Blueprints reading it get the fast array values.*/
+	UPROPERTY(BlueprintGetter = GetComponentTagValues, Category = "Settings", meta = (DeprecatedProperty, DeprecationMessage = "Replaced with ComponentTagValues, use GetComponentTagValues"))
 	TArray<FS_TagValue> TagValuesContainer;
 
 	/**Tag to apply to items when they are equipped.*/
@@ -293,10 +445,104 @@ private:
 	//Used for functions using the FS_ItemSubLevel struct.
 	int32 CurrentSubLevel = -1;
 
+	/**List of items that are currently pending some networking event
+	 * This is a system that allows designers to communicate to the player
+	 * that an item or container is currently waiting to be processed by the server.
+	 * There is currently no way of finding out if an unreliable RPC failed.
+	 * So for all functions that want to use this system must be set to Reliable.
+	 *
+	 * The value is the real time (in seconds) the entry was added. Entries older than
+	 * NetworkQueueTimeout in the runtime settings are evicted automatically, so a
+	 * lost RPC can't lock an item forever.
+	 *
+	 * Use IsItemInNetworkQueue or GetNetworkQueue to read it.*/
+	UPROPERTY()
+	TMap<FS_UniqueID, double> NetworkQueue;
+
+	//Last PredictionID handed out by BeginPrediction.
+	int32 LastPredictionID = 0;
+
+	//Periodically evicts stale NetworkQueue entries. Only runs while the queue has entries.
+	FTimerHandle NetworkQueueEvictionTimer;
+
+	//Counts down to putting the owner to sleep. See ManageNetDormancy.
+	FTimerHandle NetDormancyTimer;
+
+	/**Server only, periodically sends the container hashes. See ContainerHashInterval.
+	 * Only runs while there is someone to send them to, see RefreshContainerHashTimer.*/
+	FTimerHandle ContainerHashTimer;
+
+	//Rolling hash of every container, keyed by the containers IdentityNumber.
+	TMap<int32, uint32> ContainerStateHashes;
+
+	//Sum of every hash in ContainerStateHashes. Sent along with C_ConfirmPrediction.
+	uint32 ComponentStateHash = 0;
+
+	/**What each item currently contributes to its containers hash, keyed by the
+	 * items IdentityNumber. X is the containers IdentityNumber, Y is the contribution.
+	 * This lets us take the old state of an item out of the hash without knowing what it was.*/
+	TMap<int32, TPair<int32, uint32>> ItemStateHashes;
+
+	/**Containers whose hash did not match the servers during the last check.
+	 * A container has to mismatch twice in a row before it is resynced,
+	 * so RPC's that are still in flight don't trigger a resync.*/
+	TSet<int32> SuspectedDesyncedContainers;
+
+	//Containers that changed since they were last saved. See MarkContainerDirty.
+	TSet<int32> DirtyContainers;
+
+	//Only valid while journaling. See StartJournal.
+	TSharedPtr<FInventoryJournal> Journal;
+
+	/**The journal the containers were loaded from and the sequence of the last record
+	 * they contain. StartJournal refuses to replace a journal with newer records.*/
+	FString LoadedJournalPath;
+
+	int64 LoadedJournalSequence = 0;
+
+	//Flushes the journal at the end of the frame anything changed in.
+	FTimerHandle JournalFlushTimer;
+
+	//Only valid while the component is starting. See RunStartComponentStep.
+	UPROPERTY(Transient)
+	FComponentStartState StartState;
+
+	/**Runs the checks of StartComponent and resets StartState.
+	 * Returns false if the component shouldn't be started.*/
+	bool BeginStartComponent(bool RemoveSkipValidationTags, bool TimeSliced);
+
+	void CancelStartComponent();
+
+	//The stages of StartComponent, see EComponentStartStage.
+	void PrepareStartComponent();
+
+	void InitializeContainerIDs(int32 ContainerIndex);
+
+	void InitializeLootTable(int32 CurrentTable);
+
+	/**Generate ID's, containers and loot tables for the items in QueuedLootTableItems,
+	 * then empty it.*/
+	void ProcessQueuedLootTableItems();
+
+	/**Evaluate every item in parallel, the results are applied by InitializeContainerItems.
+	 * Nothing else touches ContainerSettings while this is running.*/
+	void EvaluateItems();
+
+	void InitializeContainerItems(int32 ContainerIndex);
+
+	void FinalizeStartComponent();
+
+	void CreateItemInstancesForContainer(FS_ContainerSettings& CurrentContainer);
+
+	void FinishStartComponent(const FComponentStartState& FinishedState);
+
 #pragma region Delegates
 
 public:
 
+	/**The component has finished initializing and is ready to be used.
+	 * When started with StartComponentTimeSliced, this is called on the frame
+	 * the last stage finished.*/
 	UPROPERTY(BlueprintAssignable, BlueprintCallable, Category = "EventDispatchers")
 	FComponentStarted ComponentStarted;
 
@@ -433,6 +679,12 @@ public:
 	UPROPERTY(BlueprintAssignable, BlueprintCallable, Category = "EventDispatchers")
 	FItemAbilityEnded ItemAbilityEnded;
 
+	/**The server rejected an operation this client predicted.
+	 * The containers have already been restored by the time this
+	 * is called, this is where you'd want to refresh any widgets.*/
+	UPROPERTY(BlueprintAssignable, BlueprintCallable, Category = "EventDispatchers")
+	FPredictionRejected PredictionRejected;
+
 	FSortingFinished SortingFinished;
 
 #pragma endregion
@@ -457,6 +709,47 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
 	void StartComponent(bool RemoveSkipValidationTags = false);
 
+	/**Same as StartComponent, but the work is spread out over as many frames as needed.
+	 * Every component that is starting this way shares StartComponentFrameBudgetMs
+	 * from the runtime settings, so streaming in a lot of inventories at once
+	 * doesn't cause a hitch. Item assets are loaded in the background first.
+	 *
+	 * Bind to ComponentStarted or check IsComponentReady to know when it's done.
+	 * Calling StartComponent while this is in progress finishes it right away.
+	 * Clients, or a budget of 0, start the component immediately.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
+	void StartComponentTimeSliced(bool RemoveSkipValidationTags = false);
+
+	/**Is a time sliced StartComponent still in progress?*/
+	UFUNCTION(BlueprintPure, Category = "Inventory Component|Management")
+	bool IsComponentStarting() const;
+
+	/**Has the component been started and finished every stage of it?
+	 * Initialized is already true while item instances and equipment
+	 * are still being processed, this is not.*/
+	UFUNCTION(BlueprintPure, Category = "Inventory Component|Management")
+	bool IsComponentReady() const;
+
+	/**Run the next unit of work of a start that is in progress, which is
+	 * usually a single container, loot table or equipped item.
+	 * Returns true if there's more work left.
+	 * Used by UInventoryStartupSubsystem.*/
+	bool RunStartComponentStep();
+
+	//Is the start in progress waiting for the item assets to finish loading?
+	bool IsStartWaitingForAssets() const;
+
+	//Is the start in progress waiting for ULootGenerationSubsystem to roll its loot?
+	bool IsStartWaitingForLoot() const;
+
+	/**Add a job for every loot pool of the loot tables that haven't been rolled yet
+	 * and that use UO_LootPool::RandomMinMaxRolls. Only valid while starting.*/
+	void GatherLootRolls(TArray<FLootRollJob>& OutJobs);
+
+	/**Add the items rolled for the jobs from GatherLootRolls.
+	 * Everything is added in one go, then processed like any other loot table item.*/
+	void ApplyLootRolls(TArrayView<FLootRollJob> Jobs);
+
 	/**This should be called whenever you add or reorganize ContainerSettings.
 	 * This will update all containers ContainerIndex's and widgets if valid.
 	 * If a container doesn't have a valid UniqueID, this will also generate one.
@@ -491,6 +784,13 @@ public:
 	UFUNCTION(Client, Reliable, Category = "Inventory Component|Management")
 	void C_ReceiveServerContainerData(const TArray<FS_ContainerSettings> &ServerContainerSettings, bool CallServerDataReceived);
 
+	/**Same as C_ReceiveServerContainerData, but the containers have been compressed
+	 * with UFL_InventoryFramework::CompressContainers.
+	 * Item instances can't be resolved by path, so they are sent separately
+	 * in the order they appear in the containers.*/
+	UFUNCTION(Client, Reliable, Category = "Inventory Component|Management")
+	void C_ReceiveCompressedServerContainerData(const TArray<uint8>& CompressedContainers, const TArray<UItemInstance*>& ItemInstances, bool CallServerDataReceived);
+
 	/**This wipes all references to objects, widgets, and attachment widgets.
 	 * This should be called when you are sure you don't want any of the items or containers
 	 * to be displayed on the screen until you construct the containers again.
@@ -505,6 +805,82 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
 	TArray<FS_ContainerSettings> GetContainersForSaveState();
 
+	/**Same as GetContainersForSaveState, but the result is compressed into a
+	 * single byte array, which is much smaller for large inventories.
+	 * Use LoadContainersFromCompressedState to restore it.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
+	bool GetCompressedContainersForSaveState(TArray<uint8>& CompressedContainers);
+
+	/**Replace the ContainerSettings with containers retrieved from
+	 * GetCompressedContainersForSaveState.
+	 * This should be called before StartComponent.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
+	bool LoadContainersFromCompressedState(const TArray<uint8>& CompressedContainers);
+
+	/**Flag a container as changed since the last save, so it is included in
+	 * the next patch written by USG_InventorySerialization::SaveDirtyContainersForActor.
+	 * All item and container mutations already call this, it only needs to be
+	 * called when modifying ContainerSettings directly.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
+	void MarkContainerDirty(int32 ContainerID);
+
+	/**Flag the container of the item @ItemInstance belongs to as changed.
+	 * Changes to the SaveGame properties of an item instance aren't tracked,
+	 * without this they are left out of SaveDirtyContainersForActor.
+	 * UItemInstance::MarkSaveGameDataDirty calls this for you.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
+	void MarkItemInstanceDirty(UItemInstance* ItemInstance);
+
+	void MarkAllContainersDirty();
+
+	/**IdentityNumbers of the containers that changed since the last save.
+	 * IDs that are no longer in ContainerSettings belong to removed containers.*/
+	const TSet<int32>& GetDirtyContainers() const { return DirtyContainers; }
+
+	void ClearDirtyContainers();
+
+	/**Start appending every operation applied to this component to a journal on disk,
+	 * so nothing is lost if the game crashes between saves. See FInventoryJournal.
+	 * Saves made through USG_InventorySerialization remember how far the journal was,
+	 * and anything newer is replayed on top of them when they're loaded.
+	 * Delete the journal when loading an older save on purpose, otherwise
+	 * the newer journal is replayed on top of it.
+	 * Only works with authority and after the component has started.
+	 *
+	 * Starting replaces the journal with a snapshot of the component, so the order matters:
+	 * 1. LoadContainersForActor or LoadContainersFromJournal, which replay the journal.
+	 * 2. StartComponent.
+	 * 3. StartJournal.
+	 * If the journal has records the component hasn't loaded, for example the ones
+	 * written before a crash, this refuses to start rather than lose them.
+	 * @JournalName defaults to the name of the owner.
+	 * @DiscardUnloadedRecords Start anyway, throwing away whatever the component hasn't loaded.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
+	bool StartJournal(const FString& JournalName = TEXT(""), bool DiscardUnloadedRecords = false);
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
+	void StopJournal();
+
+	/**Write everything that changed this frame to the journal now,
+	 * instead of at the end of the frame.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
+	void FlushJournal();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Inventory Component|Management")
+	bool IsJournaling() const;
+
+	FInventoryJournal* GetJournal() const { return Journal.Get(); }
+
+	/**Remember that the containers were loaded from @JournalPath up to @Sequence.
+	 * Called by everything that loads containers, see StartJournal.*/
+	void SetLoadedJournal(const FString& JournalPath, int64 Sequence);
+
+	/**Replace the ContainerSettings with the latest snapshot in a journal
+	 * and every record after it, without needing a save game.
+	 * This should be called before StartComponent.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management")
+	bool LoadContainersFromJournal(const FString& JournalName = TEXT(""));
+
 	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Management", meta = (DisplayName = "Reset All Unique ID's"))
 	void ResetAllUniqueIDs();
 
@@ -605,19 +981,28 @@ public:
 	 * trick can be used to minimize plenty of RPC's.*/
 	UFUNCTION(Server, Reliable, WithValidation)
 	void S_MoveItem(FS_UniqueID ItemToMove, UAC_Inventory* FromComponent, UAC_Inventory* ToComponent, int32 ToContainer, int32 ToIndex,
-		int32 Count, bool CallItemMoved, bool CallItemAdded, bool SkipCollisionCheck, ERotation NewRotation, ENetRole CallerLocalRole);
+		int32 Count, bool CallItemMoved, bool CallItemAdded, bool SkipCollisionCheck, ERotation NewRotation, ENetRole CallerLocalRole,
+		int32 PredictionID);
 
 	/**Finalize the MoveItem request.
 	 * TODO: Try to replace @ItemContainers with the UniqueID of the containers to minimize the RPC size.*/
 	UFUNCTION(Client, Reliable)
 	void C_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory* FromComponent, UAC_Inventory* ToComponent, int32 ToContainer, int32 ToIndex,int32 Count,
-		bool CallItemMoved, bool CallItemAdded, bool SkipCollisionCheck, ERotation NewRotation, const TArray<FS_UniqueID> &ItemContainers, FRandomStream Seed);
+		bool CallItemMoved, bool CallItemAdded, bool SkipCollisionCheck, ERotation NewRotation, const TArray<FS_UniqueID> &ItemContainers, int32 Sequence);
 
 	/**Non-replicated version of MoveItem*/
 	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Items")
 	void Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory* FromComponent, UAC_Inventory* ToComponent, int32 ToContainer, int32 ToIndex, int32 Count,
 		bool CallItemMoved, bool CallItemAdded, bool SkipCollisionCheck, TEnumAsByte<ERotation> NewRotation, TArray<FS_ContainerSettings> ItemContainers, FRandomStream Seed);
 
+	/**Move the replication of a whole item hierarchy's item instances from
+	 * @FromComponent to @ToComponent in one pass. Every instance is unregistered,
+	 * given its new owner and registered again before any OnRep_ItemID is called,
+	 * so the instances never see a half moved hierarchy.
+	 * The value of each pair is the ItemID the instance had before the move.
+	 * Server only.*/
+	void TransferItemInstances(UAC_Inventory* FromComponent, UAC_Inventory* ToComponent, const TArray<TPair<TObjectPtr<UItemInstance>, FS_UniqueID>>& ItemInstances);
+
 	/**Swap the location of two items.
 	 * This can get heavy for networking, as this is simply calling MoveItem twice.*/
 	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Items")
@@ -654,7 +1039,7 @@ public:
 	void S_RemoveItemFromInventory(FS_UniqueID ItemID, bool CallItemRemoved, bool CallItemUnequipped, bool RemoveItemComponents, bool RemoveItemsContainers, bool RemoveItemInstance, ENetRole CallerLocalRole);
 	
 	UFUNCTION(Client, Reliable)
-	void C_RemoveItemFromInventory(FS_UniqueID ItemID, bool CallItemRemoved, bool CallItemUnequipped, bool RemoveItemComponents, bool RemoveItemsContainers, bool RemoveItemInstance, FRandomStream Seed);
+	void C_RemoveItemFromInventory(FS_UniqueID ItemID, bool CallItemRemoved, bool CallItemUnequipped, bool RemoveItemComponents, bool RemoveItemsContainers, bool RemoveItemInstance, int32 Sequence);
 
 	/**Remove an item from the inventory.
 	 * Because we want to keep widgets on the blueprint level, this is meant to be overriden.
@@ -733,7 +1118,7 @@ public:
 	 * to the server. If the client finds a way to add the item only for them, the moment they try to
 	 * interact with it in any way, the server will notice the data is not synced and will kick them.*/
 	UFUNCTION(Client, Reliable)
-	void C_TryAddNewItem(FS_InventoryItem Item, const TArray<FS_ContainerSettings> &ItemsContainers, UAC_Inventory* DestinationComponent, bool CallItemAdded, bool SkipStacking, FRandomStream Seed);
+	void C_TryAddNewItem(FS_InventoryItem Item, const TArray<FS_ContainerSettings> &ItemsContainers, UAC_Inventory* DestinationComponent, bool CallItemAdded, bool SkipStacking, int32 Sequence);
 	
 	void Internal_TryAddNewItem(FS_InventoryItem Item, TArray<FS_ContainerSettings> ItemsContainers, UAC_Inventory* DestinationComponent, bool CallItemAdded, bool SkipStacking, FRandomStream Seed, bool& Result, FS_InventoryItem& NewItem, int32& StackDelta);
 
@@ -767,7 +1152,7 @@ public:
 	void StackTwoItems(FS_InventoryItem Item1, FS_InventoryItem Item2, int32& Item1RemainingCount, int32& Item2NewStackCount);
 
 	UFUNCTION(Server, WithValidation, Reliable)
-	void S_StackTwoItems(FS_UniqueID Item1ID, FS_UniqueID Item2ID, ENetRole CallerLocalRole);
+	void S_StackTwoItems(FS_UniqueID Item1ID, FS_UniqueID Item2ID, ENetRole CallerLocalRole, int32 PredictionID);
 
 	UFUNCTION(Client, Reliable)
 	void C_StackTwoItems(FS_UniqueID Item1ID, FS_UniqueID Item2ID);
@@ -783,11 +1168,12 @@ public:
 		int32& Item1RemainingCount, int32& Item2NewStackCount);
 
 	UFUNCTION(Server, WithValidation, Reliable)
-	void S_SplitItem(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, int32 NewStackContainerIndex, int32 NewStackTileIndex, ENetRole CallerLocalRole);
+	void S_SplitItem(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, int32 NewStackContainerIndex, int32 NewStackTileIndex, ENetRole CallerLocalRole,
+		int32 PredictionID);
 
 	UFUNCTION(Client, Reliable)
 	void C_SplitItem(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, UDA_CoreItem* ItemDataAsset, int32 NewStackContainerIndex,
-		int32 NewStackTileIndex, FS_UniqueID NewStackUniqueID, FRandomStream Seed);
+		int32 NewStackTileIndex, FS_UniqueID NewStackUniqueID, int32 Sequence);
 
 	void Internal_SplitItem(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, int32 NewStackContainerIndex, int32 NewStackTileIndex, FS_UniqueID NewStackUniqueID,
 		int32& Item1RemainingCount, int32& Item2NewStackCount, FRandomStream Seed);
@@ -818,7 +1204,7 @@ public:
 	void S_ReduceItemCount(FS_UniqueID ItemID, int32 Count, bool RemoveItemIf0, ENetRole CallerLocalRole);
 
 	UFUNCTION(Client, Reliable)
-	void C_ReduceItemCount(FS_UniqueID ItemID, int32 Count, bool RemoveItemIf0, FRandomStream Seed);
+	void C_ReduceItemCount(FS_UniqueID ItemID, int32 Count, bool RemoveItemIf0, int32 Sequence);
 
 	void Internal_ReduceItemCount(FS_InventoryItem Item, int32 Count, bool RemoveItemIf0, FRandomStream Seed);
 
@@ -840,7 +1226,7 @@ public:
 	void S_MassReduceCount(UDA_CoreItem* Item, int32 Count, UAC_Inventory* TargetComponent, int32 ContainerIndex, bool RemoveItemsIf0, ENetRole CallerLocalRole);
 
 	UFUNCTION(Client, Reliable)
-	void C_MassReduceCount(UDA_CoreItem* Item, int32 Count, UAC_Inventory* TargetComponent, int32 ContainerIndex, FRandomStream Seed, bool RemoveItemsIf0);
+	void C_MassReduceCount(UDA_CoreItem* Item, int32 Count, UAC_Inventory* TargetComponent, int32 ContainerIndex, int32 Sequence, bool RemoveItemsIf0);
 
 	void Internal_MassReduceCount(UDA_CoreItem* Item, int32 Count, UAC_Inventory* TargetComponent, int32 ContainerIndex, FRandomStream Seed, bool RemoveItemsIf0);
 
@@ -885,7 +1271,7 @@ public:
 	void S_SortAndMoveItems(ESortingType SortType, FS_UniqueID ContainerID, float StaggerTimer, ENetRole CallerLocalRole);
 
 	UFUNCTION(Client, Reliable)
-	void C_SortAndMoveItems(ESortingType SortType, FS_UniqueID ContainerID, float StaggerTimer, FRandomStream Seed);
+	void C_SortAndMoveItems(ESortingType SortType, FS_UniqueID ContainerID, float StaggerTimer, int32 Sequence);
 
 	void Internal_SortAndMoveItems(TEnumAsByte<ESortingType> SortType, const FS_ContainerSettings& Container, float StaggerTimer, FRandomStream Seed);
 
@@ -947,7 +1333,7 @@ public:
 
 	UFUNCTION(Client, Reliable)
 	void C_MassSplitStack(FS_UniqueID ItemID, int32 StackSize, int32 SplitAmount, FS_UniqueID ContainerID,
-		FRandomStream Seed, int32 ItemCountReduction);
+		int32 Sequence, int32 ItemCountReduction);
 
 	/* To simplify the code, we use @AmountReduced on the server to let players who can't
 	 * perform the collision checks (for example, the destination being a container they
@@ -1440,7 +1826,7 @@ public:
 	void S_AdjustContainerSize(FS_ContainerSettings Container, FMargin Adjustments, bool ClampToItems, ENetRole CallerLocalRole);
 	
 	UFUNCTION(Client, Reliable, Category = "Inventory Component|Containers")
-	void C_AdjustContainerSize(FS_UniqueID ContainerID, FMargin Adjustments, bool ClampToItems, FRandomStream Seed);
+	void C_AdjustContainerSize(FS_UniqueID ContainerID, FMargin Adjustments, bool ClampToItems, int32 Sequence);
 
 	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Containers", meta = (DisplayName = "Adjust Container Size (Non-replicated)"))
 	bool Internal_AdjustContainerSize(FS_ContainerSettings Container, FMargin Adjustments, bool ClampToItems, FRandomStream Seed);
@@ -1663,6 +2049,11 @@ public:
 	UFUNCTION(NetMulticast, Unreliable)
 	void MC_TagValueRemovedFromComponent(FS_TagValue TagValue);
 
+	/**Get the tag values of this component as a plain array.
+	 * Replaces reading TagValuesContainer directly.*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Inventory Component|Component|Tags")
+	TArray<FS_TagValue> GetComponentTagValues() const;
+
 	/**Returns the total value of the @Tag from all items inside containers
 	 * matching the container type set in @ContainersToCheck*/
 	UFUNCTION(Category = "Inventory Component|Tags", BlueprintCallable)
@@ -1747,6 +2138,155 @@ public:
 	UFUNCTION(BlueprintCallable, Client, Reliable, Category = "Inventory Component|Networking||Client")
 	void C_RemoveAllContainerItemsFromNetworkQueue(FS_UniqueID ContainerID);
 
+	/**Non-replicated versions of the network queue functions.
+	 * These operate on this components NetworkQueue, so the @ItemID
+	 * should belong to this component.*/
+	void Internal_AddToNetworkQueue(FS_UniqueID ItemID);
+	void Internal_RemoveFromNetworkQueue(FS_UniqueID ItemID);
+
+	/**Is the item or container with this @ItemID waiting on the server?*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Inventory Component|Networking||Management")
+	bool IsItemInNetworkQueue(FS_UniqueID ItemID) const;
+
+	/**Get the ID of every item and container currently waiting on the server.*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Inventory Component|Networking||Management")
+	TArray<FS_UniqueID> GetNetworkQueue() const;
+
+	/**Remove any entries from the NetworkQueue that have been waiting
+	 * for longer than the NetworkQueueTimeout.*/
+	void EvictExpiredNetworkQueueEntries();
+
+	/**Build the callback for when the RPC budget rejects one of this components server requests.
+	 * It takes @ItemIDs back out of the clients NetworkQueue and rolls back @PredictionID.
+	 * The components are held through weak pointers, as the request might have been
+	 * waiting in the deferred queue while they were destroyed.*/
+	TFunction<void()> MakeRejectedRequest(const TArray<FS_UniqueID>& ItemIDs, int32 PredictionID = 0);
+
+	/**Snapshot the containers of every component in @Components and
+	 * register a new pending prediction for them.
+	 * Returns the PredictionID that should be sent along with the server RPC.*/
+	int32 BeginPrediction(TArray<UAC_Inventory*> Components);
+
+	/**Tell the client the server applied @PredictionID and send along the
+	 * OperationSequence and the resulting state hash of every component in @Components.*/
+	void ConfirmPrediction(int32 PredictionID, TArray<UAC_Inventory*> Components);
+
+	/**The server accepted a predicted operation. Nothing needs to be
+	 * applied, the client already did that, we only forget the snapshot.
+	 * @Sequence is where the servers OperationSequence ended up, so the next
+	 * prediction derives its seeds from the right sequence.
+	 * If no later predictions are waiting, the @ComponentHashes are compared
+	 * with our own and any component that ended up different is resynced.*/
+	UFUNCTION(Client, Reliable)
+	void C_ConfirmPrediction(int32 PredictionID, int32 Sequence, const TArray<UAC_Inventory*>& Components, const TArray<int32>& ComponentHashes);
+
+	/**The server rejected a predicted operation. Restore the snapshot and
+	 * drop any predictions made after it, since they were built on top of
+	 * the rejected one. The snapshot might be older than what the server
+	 * has replicated since, so every affected component is resynced.*/
+	UFUNCTION(Client, Reliable)
+	void C_RejectPrediction(int32 PredictionID);
+
+	/**Put the item data of @Containers back into ContainerSettings.
+	 * Items that still exist keep their current item instance and components,
+	 * items that were removed only get their instance back if it wasn't destroyed.
+	 * Container widgets are kept and rebuilt, since the item widgets might have moved.*/
+	void RestorePredictionSnapshot(const TArray<FS_ContainerSettings>& Containers);
+
+	/**Ask the server for the full container data of @Component.*/
+	void RequestComponentResync(UAC_Inventory* Component);
+
+	/**Ratchet the operation sequence and get a seed for something only the
+	 * server rolls, such as loot. Since the OperationSeedBase is never replicated,
+	 * don't use this for anything a client has to reproduce, use MakeOperationSeed.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Networking||Management")
+	FRandomStream NextOperationSeed();
+
+	/**Get the seed for @Sequence, derived from @SeedBase.*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Inventory Component|Networking||Management")
+	static FRandomStream GetOperationSeed(int32 SeedBase, int32 Sequence);
+
+	/**Server only, advance the OperationSequence for a new operation and return it.
+	 * Send the result along with the C_ RPC so clients can make the same seed.*/
+	int32 AdvanceOperationSequence();
+
+	/**Get the seed for an operation from the @Sequence the server ran it
+	 * at and the values it was called with. Identical requests get different
+	 * seeds, since the server advances the sequence for every operation.
+	 * @Operation keeps different operations with the same values apart.*/
+	static FRandomStream MakeOperationSeed(const TCHAR* Operation, int32 Sequence, const TArray<int32>& Values);
+
+	/**Keep the ComponentStateHash in sync with the ContainerStateHashes.*/
+	void AdjustComponentStateHash(uint32 AddedHash, uint32 RemovedHash);
+
+	/**Wake the owner up from net dormancy and restart the idle countdown.
+	 * Only does something on the server and if ManageNetDormancy is true.*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory Component|Networking||Management")
+	void WakeNetDormancy();
+
+	/**Can this component put its owner into dormancy? See ManageNetDormancy.*/
+	bool CanManageNetDormancy() const;
+
+	/**Put the owner to sleep if there are no listeners, otherwise check again
+	 * after NetDormancyDelay. Every server side modification calls WakeNetDormancy,
+	 * which restarts the countdown, so this only runs once the component is idle.*/
+	void TryEnterNetDormancy();
+
+	/**Get the hash of everything inside an item that clients need to agree on.
+	 * Used to build the rolling container hashes.*/
+	static uint32 GetItemStateHash(const FS_InventoryItem& Item);
+
+	/**Take the items old state out of its containers hash and add the current one.
+	 * This reads the item from the container if it's there, otherwise @Item is used.*/
+	void UpdateItemStateHash(const FS_InventoryItem& Item);
+
+	/**Take the item out of its containers hash.*/
+	void RemoveItemStateHash(const FS_UniqueID& ItemID);
+
+	/**Take what the item contributes out of its containers hash.
+	 * Unlike RemoveItemStateHash, this doesn't count as the item being removed.*/
+	void SubtractItemStateHash(int32 ItemID);
+
+	/**Tell the journal an item changed. See StartJournal.*/
+	void JournalItemChanged(int32 ItemID);
+
+	//Flush the journal at the end of this frame.
+	void ScheduleJournalFlush();
+
+	/**Throw away the hash of @Container and build it from scratch.*/
+	void RebuildContainerStateHash(const FS_ContainerSettings& Container);
+
+	/**Throw away all container hashes and build them from scratch.*/
+	void RebuildContainerStateHashes();
+
+	/**Hash @Container's items into its hash, without taking out whatever they contributed before.*/
+	void AddContainerStateHash(const FS_ContainerSettings& Container);
+
+	/**Get the rolling hash of the container with the @ContainerID IdentityNumber.*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Inventory Component|Networking||Management")
+	int32 GetContainerStateHash(int32 ContainerID) const;
+
+	/**Send the hash of every container to the owning client and all listeners.*/
+	void SendContainerStateHashes();
+
+	/**Start the ContainerHashTimer if this component has an owning client or
+	 * listeners to send the hashes to, otherwise stop it.*/
+	void RefreshContainerHashTimer();
+
+	/**The server has sent the hashes of @Component's containers.
+	 * Any container that mismatches twice in a row is requested from the server.*/
+	UFUNCTION(Client, Unreliable)
+	void C_VerifyContainerStateHashes(UAC_Inventory* Component, const TArray<FS_ContainerStateHash>& Hashes);
+
+	UFUNCTION(Server, Reliable)
+	void S_RequestContainerResync(UAC_Inventory* Component, const TArray<int32>& ContainerIDs);
+
+	/**Replace the client version of these containers with the servers
+	 * and remove the containers the server no longer has.
+	 * Any other container is left untouched.*/
+	UFUNCTION(Client, Reliable)
+	void C_ReceiveResyncedContainers(UAC_Inventory* Component, const TArray<FS_ContainerSettings>& Containers, const TArray<int32>& RemovedContainerIDs);
+
 #pragma endregion
 
 #pragma region Editor
@@ -1771,6 +2311,8 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION()
 	void LogItemFailedToSpawn(FS_InventoryItem Item, FString Reason);
 };
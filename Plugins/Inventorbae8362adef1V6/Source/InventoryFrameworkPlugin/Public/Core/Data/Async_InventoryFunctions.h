@@ -9,6 +9,7 @@
 #include "Async_InventoryFunctions.generated.h"
 
 class UAC_Inventory;
+class USG_InventorySerialization;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FSuccess);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FFail);
@@ -56,4 +57,41 @@ public:
 
 	UFUNCTION()
 	void SortFinished();
-};
\ No newline at end of file
+};
+
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API UAsync_SerializeContainers : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintAssignable)
+	FSuccess Success;
+
+	UPROPERTY(BlueprintAssignable)
+	FFail Fail;
+
+	UPROPERTY()
+	TObjectPtr<USG_InventorySerialization> TargetSaveGame = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<AActor> TargetActor = nullptr;
+
+	UPROPERTY()
+	bool Saving = true;
+
+	/**Save the containers of the @Actor into @SaveGame. The save is written on a worker thread.
+	 * See USG_InventorySerialization::SaveContainersForActorAsync.*/
+	UFUNCTION(Category="IFP Serialization", BlueprintCallable, DisplayName = "Save Containers for Actor (Async)", meta=(BlueprintInternalUseOnly="true"))
+	static UAsync_SerializeContainers* SaveContainersForActor_Async(USG_InventorySerialization* SaveGame, AActor* Actor);
+
+	/**Load the containers of the @Actor from @SaveGame. The save is read on a worker thread.
+	 * See USG_InventorySerialization::LoadContainersForActorAsync.*/
+	UFUNCTION(Category="IFP Serialization", BlueprintCallable, DisplayName = "Load Containers for Actor (Async)", meta=(BlueprintInternalUseOnly="true"))
+	static UAsync_SerializeContainers* LoadContainersForActor_Async(USG_InventorySerialization* SaveGame, AActor* Actor);
+
+	virtual void Activate() override;
+
+	void SerializationFinished(bool WasSuccessful);
+};
@@ -25,6 +25,13 @@ public:
 	UPROPERTY(Category = "Fragments", EditAnywhere, Config)
 	TArray<TSoftObjectPtr<const UScriptStruct>> DisabledFragments;
 
+	/**How many milliseconds per frame UAC_Inventory::StartComponentTimeSliced is allowed
+	 * to spend. This budget is shared by every component starting in the same frame.
+	 * Each frame still runs at least one step.
+	 * Set to 0 to start components immediately.*/
+	UPROPERTY(Category = "Items", EditAnywhere, Config, BlueprintReadOnly, meta = (ClampMin = 0, Units = "Milliseconds"))
+	float StartComponentFrameBudgetMs = 2;
+
 	/**IFP's default behavior for retrieving the local inventory component
 	 * is to get the player pawn and finding the inventory component from there.
 	 * Some projects prefer the controller. Checking this to true will alter
@@ -32,6 +39,80 @@ public:
 	 * local inventory component from the player controller. */
 	UPROPERTY(Category = "Fragments", EditAnywhere, Config)
 	bool LocalComponentOnController = false;
+
+	/**How long, in seconds, an item or container is allowed to stay in
+	 * a components NetworkQueue before it is automatically evicted.
+	 * If an RPC is dropped or the server never answers, the item would
+	 * otherwise stay locked forever.
+	 * Set to 0 to disable eviction.*/
+	UPROPERTY(Category = "Networking", EditAnywhere, Config, BlueprintReadOnly, meta = (ClampMin = 0, Units = "Seconds"))
+	float NetworkQueueTimeout = 15;
+
+	/**Should the full container resync (S_SendContainerDataToClient) be
+	 * serialized and compressed into a single byte array before being sent?
+	 * Large inventories compress very well, but the client has to spend
+	 * a little bit of time decompressing them.*/
+	UPROPERTY(Category = "Networking", EditAnywhere, Config, BlueprintReadOnly)
+	bool CompressContainerSnapshots = false;
+
+	/**How often, in seconds, the server sends the hash of every container
+	 * to the owning client and any listeners. Clients compare them against
+	 * their own and only request the containers that don't match.
+	 * Set to 0 to disable.*/
+	UPROPERTY(Category = "Networking", EditAnywhere, Config, BlueprintReadOnly, meta = (ClampMin = 0, Units = "Seconds"))
+	float ContainerHashInterval = 10;
+
+	/**How many patches SaveDirtyContainersForActor writes on top of an actors
+	 * save before compacting everything into a new full save.
+	 * More patches make autosaves cheaper, but loading has to apply all of them.*/
+	UPROPERTY(Category = "Saving", EditAnywhere, Config, BlueprintReadOnly, meta = (ClampMin = 0))
+	int32 ContainerPatchesBeforeCompaction = 10;
+
+	/**Size, in centimeters, of the square cells UInventoryRegionStorageSubsystem splits
+	 * the world into. Every cell is saved to its own file.*/
+	UPROPERTY(Category = "Saving", EditAnywhere, Config, BlueprintReadOnly, meta = (ClampMin = 100, Units = "Centimeters"))
+	float RegionCellSize = 25600;
+
+	/**How often, in seconds, UInventoryRegionStorageSubsystem writes the cells
+	 * that have changes. Set to 0 to only write them when FlushDirtyCells is called.*/
+	UPROPERTY(Category = "Saving", EditAnywhere, Config, BlueprintReadOnly, meta = (ClampMin = 0, Units = "Seconds"))
+	float RegionFlushInterval = 30;
+
+	/**How many records an inventory journal appends before it is compacted
+	 * into a new snapshot. See UAC_Inventory::StartJournal.
+	 * Set to 0 to never compact.*/
+	UPROPERTY(Category = "Saving", EditAnywhere, Config, BlueprintReadOnly, meta = (ClampMin = 0))
+	int32 JournalRecordsBeforeCompaction = 1000;
+
+	/**Should the server limit how often clients can call the inventory,
+	 * fragment manager and crafting server RPC's?
+	 * Every client connection gets a token bucket, each RPC costs a token.
+	 * RPC's from the listen server host are never limited.
+	 * RPC's that can't tell the client they were rejected, such as
+	 * S_AddListener, are never rejected, only deferred.
+	 * Off by default, a client that is rejected has to be able to recover.*/
+	UPROPERTY(Category = "Networking|Rate Limiting", EditAnywhere, Config, BlueprintReadOnly)
+	bool ThrottleServerRPCs = false;
+
+	/**How many tokens each connection regains per second.*/
+	UPROPERTY(Category = "Networking|Rate Limiting", EditAnywhere, Config, BlueprintReadOnly, meta = (EditCondition = "ThrottleServerRPCs", ClampMin = 0))
+	float RPCTokensPerSecond = 20;
+
+	/**How many tokens a connection can hold, which is how many
+	 * RPC's a client can burst before it gets rejected.*/
+	UPROPERTY(Category = "Networking|Rate Limiting", EditAnywhere, Config, BlueprintReadOnly, meta = (EditCondition = "ThrottleServerRPCs", ClampMin = 1))
+	int32 RPCBurstSize = 40;
+
+	/**How many milliseconds per frame the server is allowed to spend processing
+	 * these RPC's. Once used up, RPC's are deferred to the next frames.
+	 * Set to 0 to never defer.*/
+	UPROPERTY(Category = "Networking|Rate Limiting", EditAnywhere, Config, BlueprintReadOnly, meta = (EditCondition = "ThrottleServerRPCs", ClampMin = 0, Units = "Milliseconds"))
+	float RPCFrameBudgetMs = 2;
+
+	/**How many deferred RPC's a single connection can have waiting before any
+	 * new ones are rejected.*/
+	UPROPERTY(Category = "Networking|Rate Limiting", EditAnywhere, Config, BlueprintReadOnly, meta = (EditCondition = "ThrottleServerRPCs", ClampMin = 1))
+	int32 MaxDeferredRPCsPerConnection = 64;
 	
 	virtual FName GetCategoryName() const override { return FName("Plugins"); }
 	
@@ -7,6 +7,7 @@
 #include "Core/Data/IFP_CoreData.h"
 #include "Animation/AnimationAsset.h"
 #include "Core/Traits/ItemTrait.h"
+#include "Core/Items/DA_CoreItem.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "FL_InventoryFramework.generated.h"
 
@@ -232,6 +233,13 @@ class INVENTORYFRAMEWORKPLUGIN_API UFL_InventoryFramework : public UBlueprintFun
 	UFUNCTION(BlueprintCallable, Category = "IFP|Traits", meta=(DeterminesOutputType="Class", ReturnDisplayName = "Trait"))
 	static UItemTrait* GetTraitByClassForItem(UDA_CoreItem* Item, TSubclassOf<UItemTrait> Class, bool AllowChildren = false);
 
+	/**Native version of GetTraitByClassForItem that returns the trait as @T.*/
+	template<typename T>
+	static T* GetTraitForItem(UDA_CoreItem* Item, bool AllowChildren = false)
+	{
+		return IsValid(Item) ? Item->FindTrait<T>(AllowChildren) : nullptr;
+	}
+
 	/**The system is very strict on not allowing items to overlap one another, but the editor
 	 * utility widget can temporarily disable collision checks. This means that items can
 	 * start overlapping one another.
@@ -463,6 +471,18 @@ class INVENTORYFRAMEWORKPLUGIN_API UFL_InventoryFramework : public UBlueprintFun
 	UFUNCTION(Category = "IFP|Containers", BlueprintCallable)
 	static TArray<FS_ContainerSettings> SanitizeContainersForClientRPC(TArray<FS_ContainerSettings> Containers);
 
+	/**Serialize and compress the @Containers into a single byte array.
+	 * Object references are stored by path, so anything that can't be
+	 * resolved by path (components, widgets, item instances) should be
+	 * cleared before calling this, like GetContainersForSaveState does.
+	 * Returns false if the data could not be compressed.*/
+	UFUNCTION(Category = "IFP|Containers", BlueprintCallable)
+	static bool CompressContainers(const TArray<FS_ContainerSettings>& Containers, TArray<uint8>& CompressedData);
+
+	/**Restore containers that were compressed with CompressContainers.*/
+	UFUNCTION(Category = "IFP|Containers", BlueprintCallable)
+	static bool DecompressContainers(const TArray<uint8>& CompressedData, TArray<FS_ContainerSettings>& Containers);
+
 	/**Get a copy of the items tags. Modifying this container does NOT modify
 	 * the items tags. Use the appropriate functions to modify an items tags.*/
 	UFUNCTION(Category = "IFP|Containers|Tags", BlueprintCallable, BlueprintPure)
@@ -8,6 +8,7 @@
 #include "Animation/AnimMontage.h"
 #include "GameplayTagContainer.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "StructUtils/InstancedStruct.h"
 #include "IFP_CoreData.generated.h"
 
@@ -191,6 +192,99 @@ struct FS_TagValue
 };
 
 
+USTRUCT(BlueprintType)
+struct FS_TagValueArrayItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tag")
+	FS_TagValue TagValue;
+
+	FS_TagValueArrayItem(){}
+
+	FS_TagValueArrayItem(const FS_TagValue& InTagValue)
+	{
+		TagValue = InTagValue;
+	}
+};
+
+/**Fast array of tag values. Only the values that have been
+ * added, changed or removed get replicated, rather than the
+ * whole array being compared and sent.
+ *
+ * Always modify this through SetTagValue and RemoveTagValue
+ * so the items are marked dirty.*/
+USTRUCT(BlueprintType)
+struct FS_TagValueArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tag")
+	TArray<FS_TagValueArrayItem> Items;
+
+	TArray<FS_TagValue> GetTagValues() const
+	{
+		TArray<FS_TagValue> TagValues;
+		TagValues.Reserve(Items.Num());
+		for(const FS_TagValueArrayItem& CurrentItem : Items)
+		{
+			TagValues.Add(CurrentItem.TagValue);
+		}
+		return TagValues;
+	}
+
+	int32 FindTagValueIndex(const FGameplayTag& Tag) const
+	{
+		return Items.IndexOfByPredicate([&Tag](const FS_TagValueArrayItem& CurrentItem)
+		{
+			return CurrentItem.TagValue.Tag == Tag;
+		});
+	}
+
+	/**Update the value of an existing tag, or add it if it isn't in the array.*/
+	void SetTagValue(const FS_TagValue& TagValue)
+	{
+		const int32 TagValueIndex = FindTagValueIndex(TagValue.Tag);
+		if(Items.IsValidIndex(TagValueIndex))
+		{
+			Items[TagValueIndex].TagValue = TagValue;
+			MarkItemDirty(Items[TagValueIndex]);
+		}
+		else
+		{
+			MarkItemDirty(Items.Add_GetRef(FS_TagValueArrayItem(TagValue)));
+		}
+	}
+
+	bool RemoveTagValue(const FGameplayTag& Tag)
+	{
+		const int32 TagValueIndex = FindTagValueIndex(Tag);
+		if(!Items.IsValidIndex(TagValueIndex))
+		{
+			return false;
+		}
+
+		Items.RemoveAt(TagValueIndex);
+		MarkArrayDirty();
+		return true;
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FastArrayDeltaSerialize<FS_TagValueArrayItem, FS_TagValueArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FS_TagValueArray> : public TStructOpsTypeTraitsBase2<FS_TagValueArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+
 //Settings that are safe to overwrite.
 //It is up to you to handle how these settings interact with stackable items.
 USTRUCT(BlueprintType)
@@ -1285,4 +1379,52 @@ struct FRotationAndShape
 	}
 };
 
+/**Copy of a components containers, taken right before a client
+ * predicts an operation so the operation can be rolled back
+ * if the server rejects it.
+ * Only the item data is kept, widgets, item components and external
+ * objects are taken from the live containers when rolling back.*/
+USTRUCT(BlueprintType)
+struct FS_PredictionSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Category = "Prediction", BlueprintReadOnly)
+	TObjectPtr<UAC_Inventory> Component = nullptr;
+
+	UPROPERTY(Category = "Prediction", BlueprintReadOnly)
+	TArray<FS_ContainerSettings> Containers;
+};
+
+/**An operation the client has already applied locally and is
+ * now waiting for the server to confirm or reject.*/
+USTRUCT(BlueprintType)
+struct FS_PredictedOperation
+{
+	GENERATED_BODY()
+
+	/**Sequence number sent to the server alongside the request.
+	 * The server echoes it back in the confirm or reject RPC.*/
+	UPROPERTY(Category = "Prediction", BlueprintReadOnly)
+	int32 PredictionID = 0;
+
+	UPROPERTY(Category = "Prediction", BlueprintReadOnly)
+	TArray<FS_PredictionSnapshot> Snapshots;
+};
+
+/**The servers hash of a single container, periodically sent
+ * to clients so they can find out if their copy has drifted.*/
+USTRUCT(BlueprintType)
+struct FS_ContainerStateHash
+{
+	GENERATED_BODY()
+
+	//IdentityNumber of the containers UniqueID.
+	UPROPERTY(Category = "Networking", BlueprintReadOnly)
+	int32 ContainerID = -1;
+
+	UPROPERTY(Category = "Networking", BlueprintReadOnly)
+	int32 Hash = 0;
+};
+
 #pragma endregion
@@ -0,0 +1,148 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Data/SG_InventorySerialization.h"
+
+struct FS_ContainerSettings;
+class UAC_Inventory;
+
+enum class EInventoryJournalOperation : uint8
+{
+	//Every container of the component, replaces everything that came before it.
+	Snapshot,
+	//Written by journals before version 2, the item inside a container of its own. Only read.
+	Add,
+	Remove,
+	//Item changed container, tile or rotation.
+	Move,
+	CountChange,
+	TagChange,
+	//Containers that changed outside of their items, for example their tags or size.
+	Containers,
+	//The container ID followed by the item, see USG_InventorySerialization::WriteSingleItem.
+	AddItem
+};
+
+/**What the journal last wrote about an item, so it can tell what changed.*/
+struct FInventoryJournalItemState
+{
+	int32 ContainerID = 0;
+
+	int32 TileIndex = -1;
+
+	uint8 Rotation = 0;
+
+	int32 Count = 0;
+
+	uint32 TagsHash = 0;
+};
+
+/**Append-only journal of the operations applied to an inventory component.
+ *
+ * Taking a full snapshot after every trade or craft is too expensive, so instead
+ * every move, add, remove, count and tag change is appended to a file as a small
+ * record with a sequence number. Changes are collected during the frame and written
+ * once at the end of it, so an item that is removed and added again in the same frame
+ * is written as a single move.
+ * Changes to containers that aren't about their items, such as container tags,
+ * are written as a patch of the whole container.
+ *
+ * The journal starts with a snapshot of the component. Every
+ * JournalRecordsBeforeCompaction records, a new snapshot is written on a worker
+ * thread and the journal is compacted down to it.
+ *
+ * When loading, any record newer than the save is replayed on top of it,
+ * see USG_InventorySerialization::ReadContainerRecord.
+ *
+ * This is owned by the component, see UAC_Inventory::StartJournal.*/
+class INVENTORYFRAMEWORKPLUGIN_API FInventoryJournal : public TSharedFromThis<FInventoryJournal>
+{
+public:
+
+	~FInventoryJournal();
+
+	/**Replace the journal at @InFilePath with a snapshot of @Inventory and start
+	 * appending to it. Sequence numbers carry on from the journal that was there.
+	 * Refuses to start if that journal has records after @LoadedSequence, since
+	 * replacing it would lose them, unless @DiscardUnloadedRecords is true.*/
+	bool Start(UAC_Inventory* Inventory, const FString& InFilePath, int64 LoadedSequence, bool DiscardUnloadedRecords);
+
+	/**Close the file. Anything that hasn't been flushed is lost.*/
+	void Stop();
+
+	bool IsRunning() const { return Writer.IsValid(); }
+
+	void ItemChanged(int32 ItemID);
+
+	void ContainerChanged(int32 ContainerID);
+
+	bool HasPendingChanges() const { return !ChangedItems.IsEmpty() || !ChangedContainers.IsEmpty(); }
+
+	/**Write a record for everything that changed since the last flush.*/
+	void Flush(UAC_Inventory* Inventory);
+
+	/**Write a new snapshot on a worker thread and drop every record before it.*/
+	void Compact(UAC_Inventory* Inventory);
+
+	//Sequence number of the last record written.
+	int64 GetSequence() const { return Sequence; }
+
+	const FString& GetFilePath() const { return FilePath; }
+
+	//Saved/IFP/Journal/<JournalName>.ifpj
+	static FString GetJournalPath(const FString& JournalName);
+
+	/**Apply every record newer than @AfterSequence to containers read by
+	 * USG_InventorySerialization::ReadContainers. If the journal has a snapshot
+	 * newer than @AfterSequence, the containers are replaced by it first.
+	 * Pass in -1 to only load what is in the journal.
+	 * @OutLastSequence The sequence of the last record that was applied.
+	 * Safe to call outside of the game thread.
+	 * Returns false if there was nothing to replay on top of.*/
+	static bool Replay(const FString& JournalPath, int64 AfterSequence, TArray<FS_ContainerSettings>& InOutContainers, TArray<FLoadedItemInstance>& InOutItemInstances,
+		int64* OutLastSequence = nullptr);
+
+	/**Call @RecordRead for every record in the journal, until it returns false.
+	 * Reading stops at the first incomplete or corrupt record, which is
+	 * where the journal was when the game was interrupted.*/
+	static bool ReadRecords(const FString& JournalPath, TFunctionRef<bool(int64 RecordSequence, EInventoryJournalOperation Operation, FArchive& Payload)> RecordRead);
+
+	/**Append the magic and version every journal starts with to @OutData.*/
+	static void WriteHeader(TArray<uint8>& OutData);
+
+	/**Append a record to @OutData, see ReadRecords for how it's read back.*/
+	static void WriteRecord(TArray<uint8>& OutData, int64 RecordSequence, EInventoryJournalOperation Operation, TFunctionRef<void(FArchive&)> WritePayload);
+
+private:
+
+	void AppendRecord(EInventoryJournalOperation Operation, TFunctionRef<void(FArchive&)> WritePayload);
+
+	/**Remember the state of every item, or only of the items inside @OnlyContainers.*/
+	void CacheItemStates(const UAC_Inventory* Inventory, const TSet<int32>* OnlyContainers);
+
+	void FinishCompaction(bool Success, const FString& CompactionPath);
+
+	FString FilePath;
+
+	TUniquePtr<FArchive> Writer;
+
+	int64 Sequence = 0;
+
+	int32 RecordsSinceCompaction = 0;
+
+	//Bumped by Start and Stop, so a compaction can tell the journal was restarted while it was working.
+	uint32 RunID = 0;
+
+	TMap<int32, FInventoryJournalItemState> ItemStates;
+
+	TSet<int32> ChangedItems;
+
+	TSet<int32> ChangedContainers;
+
+	bool Compacting = false;
+
+	//Records appended while a compaction is running, they also have to end up in the compacted journal.
+	TArray<uint8> RecordsDuringCompaction;
+};
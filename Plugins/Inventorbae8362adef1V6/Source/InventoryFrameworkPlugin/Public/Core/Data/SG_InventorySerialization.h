@@ -3,13 +3,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Core/Data/IFP_CoreData.h"
 #include "GameFramework/SaveGame.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 #include "SG_InventorySerialization.generated.h"
 
 struct FS_InventoryItem;
+struct FS_ContainerSettings;
+class UAC_Inventory;
 class UItemInstance;
 
+DECLARE_DELEGATE_OneParam(FContainerSerializationFinished, bool /*Success*/);
+
 class INVENTORYFRAMEWORKPLUGIN_API FSaveGameArchive : public FObjectAndNameAsStringProxyArchive
 {
 public:
@@ -35,6 +40,12 @@ public:
 	UPROPERTY()
 	int32 ItemIndex = -1;
 
+	/**IdentityNumber of the item this object belonged to. Unlike the indexes,
+	 * this survives items being moved around. Records saved before this
+	 * existed are 0 and are found through ContainerIndex and ItemIndex.*/
+	UPROPERTY()
+	int32 ItemID = 0;
+
 	UPROPERTY()
 	TObjectPtr<UClass> ObjectClass = nullptr;
 
@@ -43,6 +54,130 @@ public:
 	TArray<uint8> PropertyData;
 };
 
+/**Containers that changed since the previous save, written by SaveDirtyContainersForActor.*/
+USTRUCT(BlueprintType)
+struct FContainerPatch
+{
+	GENERATED_BODY()
+
+public:
+
+	//See USG_InventorySerialization::WriteContainerPatch.
+	UPROPERTY()
+	TArray<uint8> Data;
+};
+
+/**The containers of a single actor, written by SaveContainersForActor.*/
+USTRUCT(BlueprintType)
+struct FContainerRecord
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY()
+	FString ActorName;
+
+	//Containers in the IFP binary save format. See USG_InventorySerialization::WriteContainers.
+	UPROPERTY()
+	TArray<uint8> Data;
+
+	//Applied on top of Data in order when loading.
+	UPROPERTY()
+	TArray<FContainerPatch> Patches;
+
+	//False if Data was saved before the component started, in which case it can't be patched.
+	UPROPERTY()
+	bool CanBePatched = false;
+
+	//If above 0, Data has been compressed. See SaveContainersForActorAsync.
+	UPROPERTY()
+	int32 UncompressedSize = 0;
+
+	/**The journal the component was writing when it was saved, if any.
+	 * Records after JournalSequence are replayed on top of this save when it's loaded.*/
+	UPROPERTY()
+	FString JournalPath;
+
+	UPROPERTY()
+	int64 JournalSequence = 0;
+
+	/**Bumped by every full save. An async save that finishes
+	 * after a newer full save has been made is thrown away.*/
+	uint32 Generation = 0;
+};
+
+/**How a fragment type is written into saves. See USG_InventorySerialization::RegisterFragmentSerializer.*/
+struct INVENTORYFRAMEWORKPLUGIN_API FFragmentSerializer
+{
+	//Saved with every fragment of this type, bump it whenever Serialize changes.
+	int32 Version = 0;
+
+	/**Read and write the fragment in your own layout instead of tagged properties.
+	 * Much faster for fragments that most items have, but there is no safety
+	 * net, any change to the layout needs a new Version and an Upgrade.
+	 * Can be called outside of the game thread.*/
+	TFunction<void(FArchive& Archive, void* Fragment)> Serialize;
+
+	/**Read a fragment that was saved with an older Version, before Serialize
+	 * was added, or under a path redirected with RegisterFragmentRedirect.
+	 * @Archive only contains what was saved for this fragment, @SavedWithSerialize
+	 * is false if it was saved with tagged properties.
+	 * Without an Upgrade, fragments saved with tagged properties are still read,
+	 * but any renamed property is lost.
+	 * Can be called outside of the game thread.*/
+	TFunction<bool(FArchive& Archive, int32 SavedVersion, bool SavedWithSerialize, void* Fragment)> Upgrade;
+};
+
+/**A fragment that is still in the form it was saved in.
+ * Fragments that can reference objects can't be read or written outside
+ * of the game thread, the archive would have to find those objects.
+ * SnapshotContainers and ReadContainers keep those fragments as this,
+ * ApplyLoadedContainers turns them back into the real fragment.
+ * This should never end up in a component that has started.*/
+USTRUCT()
+struct INVENTORYFRAMEWORKPLUGIN_API FSerializedFragment : public FCoreFragment
+{
+	GENERATED_BODY()
+
+	//The path the fragment was saved under, written back as is.
+	UPROPERTY()
+	FString TypePath;
+
+	//Resolved from TypePath when the save was read, so it doesn't have to be found again.
+	UPROPERTY()
+	TObjectPtr<UScriptStruct> Type = nullptr;
+
+	//TypePath was redirected to Type, see RegisterFragmentRedirect.
+	UPROPERTY()
+	bool Redirected = false;
+
+	UPROPERTY()
+	int32 Version = 0;
+
+	UPROPERTY()
+	uint8 Flags = 0;
+
+	UPROPERTY()
+	TArray<uint8> Data;
+
+	virtual bool DoNotShowInDropdown() override { return true; }
+};
+
+/**The SaveGame data of an item instance, without the object itself.
+ * Objects can only be created and serialized on the game thread,
+ * so this is what is handed to and from worker threads.*/
+struct INVENTORYFRAMEWORKPLUGIN_API FLoadedItemInstance
+{
+	int32 ContainerIndex = -1;
+
+	int32 ItemIndex = -1;
+
+	FSoftClassPath ObjectClass;
+
+	TArray<uint8> PropertyData;
+};
+
 /**Save game class that helps with serializing the ContainerSettings in an
  * inventory component.
  * This is only needed for serializing item instances.
@@ -56,15 +191,154 @@ class INVENTORYFRAMEWORKPLUGIN_API USG_InventorySerialization : public USaveGame
 	UPROPERTY()
 	TArray<FItemInstanceRecord> ItemInstanceRecords;
 
+	//The containers saved through SaveContainersForActor, one per actor.
+	UPROPERTY()
+	TArray<FContainerRecord> ContainerRecords;
+
+public:
+
 	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
 	void SaveItemInstance(UItemInstance* ItemInstance);
 
 	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
 	void LoadItemInstance(FS_InventoryItem Item);
 
-	UFUNCTION(Category = "IFP Serialization")
-	void SaveContainersForActor(AActor* Actor);
+	/**Load every record into the item instances of @Inventory's items.
+	 * Much faster than calling LoadItemInstance for every item.
+	 * Returns how many item instances were loaded.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	int32 LoadAllItemInstances(UAC_Inventory* Inventory);
+
+private:
+
+	/**Index of the record for @Item, or INDEX_NONE.*/
+	int32 FindItemInstanceRecord(const FS_InventoryItem& Item);
+
+	void RefreshItemInstanceRecordIndexes();
+
+	static void ReadItemInstanceRecord(const FItemInstanceRecord& Record, UItemInstance* ItemInstance);
+
+	//ItemID to its index in ItemInstanceRecords.
+	TMap<int32, int32> ItemInstanceRecordIndexes;
+
+	//ContainerIndex and ItemIndex to record index, for records without an ItemID.
+	TMap<FIntPoint, int32> LegacyItemInstanceRecordIndexes;
+
+	//False until the indexes have been built, for example after the save has been loaded.
+	bool ItemInstanceRecordIndexesBuilt = false;
+
+public:
+
+	/**Save all containers, items, fragments and item instances of the
+	 * @Actor's inventory component. Replaces any previous save of that actor.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	bool SaveContainersForActor(AActor* Actor);
+
+	/**Only save the containers of the @Actor's inventory component that changed
+	 * since it was last saved or loaded, as a patch on top of the previous save.
+	 * Once ContainerPatchesBeforeCompaction patches have been written, or the
+	 * actor has no save to patch, a full save is made instead.
+	 * Much cheaper than SaveContainersForActor for frequent autosaves.
+	 * Item instances have to call MarkSaveGameDataDirty after changing
+	 * their SaveGame properties, or the change is missed.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	bool SaveDirtyContainersForActor(AActor* Actor);
+
+	/**Replace the containers of the @Actor's inventory component with
+	 * the ones saved through SaveContainersForActor and SaveDirtyContainersForActor.
+	 * This should be called before the component is started.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	bool LoadContainersForActor(AActor* Actor);
+
+	/**Same as SaveContainersForActor, but only a copy of the containers is made
+	 * on the game thread. Writing and compressing the save happens on a worker
+	 * thread and the record is replaced once it's done.
+	 * Changes made while the save is in progress go into the next save.*/
+	void SaveContainersForActorAsync(AActor* Actor, FContainerSerializationFinished OnFinished = FContainerSerializationFinished());
+
+	/**Same as LoadContainersForActor, but the save is read on a worker thread and
+	 * the item assets are streamed in before the containers are given to the component.*/
+	void LoadContainersForActorAsync(AActor* Actor, FContainerSerializationFinished OnFinished = FContainerSerializationFinished());
+
+	/**Copy @Containers without any object references, so they can be handed
+	 * to another thread. Item instances are serialized into @OutItemInstances
+	 * and fragments that can reference objects into FSerializedFragment.
+	 * Game thread only.*/
+	static void SnapshotContainers(const TArray<FS_ContainerSettings>& Containers, TArray<FS_ContainerSettings>& OutContainers, TArray<FLoadedItemInstance>& OutItemInstances);
+
+	/**Write @Containers into the IFP binary save format.
+	 * Item asset, fragment and item instance class paths are only stored once,
+	 * every fragment is stored with its version and size, so fragments that
+	 * no longer exist can be skipped.
+	 * @MarkAsValidated Tag every container and item so they skip validation
+	 * when loaded. This should be true if the component has been started.*/
+	static bool WriteContainers(const TArray<FS_ContainerSettings>& Containers, bool MarkAsValidated, TArray<uint8>& OutData);
+
+	/**Same as WriteContainers, but item instances are taken from @ItemInstances
+	 * instead of the items. Safe to call outside of the game thread with
+	 * containers from SnapshotContainers.*/
+	static bool WriteContainerSnapshot(const TArray<FS_ContainerSettings>& Containers, const TArray<FLoadedItemInstance>& ItemInstances, bool MarkAsValidated, TArray<uint8>& OutData);
+
+	/**Read containers written by WriteContainers. This only creates structs,
+	 * so it is safe to call outside of the game thread. Item assets are not
+	 * resolved and item instances are returned as @OutItemInstances
+	 * so they can be created by ApplyLoadedContainers.
+	 * Outside of the game thread, fragments that can reference objects
+	 * are returned as FSerializedFragment, also read by ApplyLoadedContainers.*/
+	static bool ReadContainers(const TArray<uint8>& Data, TArray<FS_ContainerSettings>& OutContainers, TArray<FLoadedItemInstance>& OutItemInstances);
+
+	/**Write a single item, its fragments and item instance without the header
+	 * and string table of WriteContainers. Paths are written where they are used,
+	 * which is smaller for one item. Used by the journal's records.*/
+	static void WriteSingleItem(FArchive& Archive, const FS_InventoryItem& Item, bool MarkAsValidated);
+
+	/**Read an item written by WriteSingleItem. Same as ReadContainers,
+	 * this is safe to call outside of the game thread.*/
+	static bool ReadSingleItem(FArchive& Archive, FS_InventoryItem& OutItem, TOptional<FLoadedItemInstance>& OutItemInstance);
+
+	/**Write the containers whose IdentityNumber is in @DirtyContainers and the
+	 * order of all containers, so removed containers are dropped when applied.*/
+	static bool WriteContainerPatch(const TArray<FS_ContainerSettings>& Containers, const TSet<int32>& DirtyContainers, bool MarkAsValidated, TArray<uint8>& OutData);
+
+	/**Apply a patch written by WriteContainerPatch to containers read by ReadContainers.*/
+	static bool ApplyContainerPatch(const TArray<uint8>& Data, TArray<FS_ContainerSettings>& InOutContainers, TArray<FLoadedItemInstance>& InOutItemInstances);
+
+	/**Read the full save of a record, apply all of its patches and
+	 * replay anything its journal has that the save doesn't.
+	 * @OutJournalSequence The last journal record the containers include.*/
+	static bool ReadContainerRecord(const FContainerRecord& Record, TArray<FS_ContainerSettings>& OutContainers, TArray<FLoadedItemInstance>& OutItemInstances,
+		int64* OutJournalSequence = nullptr);
+
+	/**Tag @Containers and their items the same way WriteContainers does
+	 * with MarkAsValidated, for containers that are applied without
+	 * being written first, such as ones from SnapshotContainers.*/
+	static void MarkContainersAsValidated(TArray<FS_ContainerSettings>& Containers);
+
+	/**Give @Containers to @Inventory, building the TileMap, IndexCoordinates
+	 * and ID_Map in the same pass that resolves the item assets and
+	 * reads any FSerializedFragment. Game thread only.*/
+	static void ApplyLoadedContainers(UAC_Inventory* Inventory, TArray<FS_ContainerSettings>&& Containers, const TArray<FLoadedItemInstance>& ItemInstances);
+
+	/**Fragments are saved with the version registered here, so a future version
+	 * of the fragment knows what it is reading. Fragments that never registered are version 0.*/
+	static void RegisterFragmentVersion(const UScriptStruct* FragmentType, int32 Version);
+
+	static int32 GetFragmentVersion(const UScriptStruct* FragmentType);
+
+	/**Give a fragment its own Serialize and Upgrade. Fragments that are older than
+	 * the registered Version are upgraded while the save is being read, in the same pass.
+	 * Saves can be read on worker threads, so this should only be called
+	 * while your module starts up.*/
+	static void RegisterFragmentSerializer(const UScriptStruct* FragmentType, FFragmentSerializer Serializer);
+
+	/**Load fragments that were saved as @OldPath, for example "/Script/MyGame.MyOldFragment",
+	 * as @NewType. Its Upgrade is called with the old data.
+	 * Same as RegisterFragmentSerializer, only call this while your module starts up.*/
+	static void RegisterFragmentRedirect(const FString& OldPath, const UScriptStruct* NewType);
+
+	static const FFragmentSerializer* FindFragmentSerializer(const UScriptStruct* FragmentType);
+
+	FContainerRecord* FindContainerRecord(const FString& ActorName);
 
-	UFUNCTION(Category = "IFP Serialization")
-	void LoadContainersForActor(AActor* Actor);
+	static UAC_Inventory* GetInventoryForActor(AActor* Actor);
 };
@@ -6,12 +6,12 @@
 #include "GameplayTagContainer.h"
 #include "Core/Data/IFP_CoreData.h"
 #include "Core/Objects/Parents/O_ItemAssetValidation.h"
+#include "Core/Traits/ItemTrait.h"
 #include "Engine/DataAsset.h"
 #include "DA_CoreItem.generated.h"
 
 class UAC_LootTable;
 class UO_LootPool;
-class UItemTrait;
 class UW_InventoryItem;
 class UW_Container;
 class AA_ItemActor;
@@ -39,6 +39,54 @@ struct FShapeRotation
 	
 };
 
+/**Everything UDA_CoreItem would otherwise recompute every time it is asked for it.
+ * Built by UDA_CoreItem::BuildRuntimeCache when the asset is loaded or its shapes are baked.
+ *
+ * The cache is a snapshot of the asset at that time. Changes to the values inside
+ * a trait or fragment, such as the default containers, loot tables or tags,
+ * are not picked up until BuildRuntimeCache is called again.*/
+USTRUCT()
+struct FItemAssetRuntimeCache
+{
+	GENERATED_BODY()
+
+	bool IsBuilt = false;
+
+	/**What the cache was built from. If any of these no longer match the asset, the cache is stale.
+	 * This only catches traits being added or removed and the shape changing,
+	 * not edits inside of a trait.*/
+	int32 TraitCount = 0;
+
+	FIntPoint ItemDimensions = FIntPoint::ZeroValue;
+
+	int32 ShapeCount = 0;
+
+	//The first trait of every class, does not include parent classes.
+	TMap<const UClass*, TObjectPtr<UItemTrait>> TraitsByClass;
+
+	/**Every trait, listed under its own class and all of its parent classes
+	 * in the order they appear in TraitsAndComponents.*/
+	TMap<const UClass*, TArray<TObjectPtr<UItemTrait>>> TraitsByClassHierarchy;
+
+	TArray<FIntPoint> DisabledTiles;
+
+	FIntPoint AnchorPoint = FIntPoint::ZeroValue;
+
+	//Index into Shapes for every rotation, -1 if that rotation has no shape.
+	TArray<int32> ShapeIndexes;
+
+	TArray<TSoftClassPtr<UItemComponent>> ItemComponents;
+
+	//The tags of both the item struct and item asset tag fragments.
+	FGameplayTagContainer DefaultTags;
+
+	UPROPERTY(Transient)
+	TArray<FS_ContainerSettings> DefaultContainers;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAC_LootTable>> LootTables;
+};
+
 #if WITH_EDITORONLY_DATA
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FTraitAdded, UItemTrait*, Trait, UDA_CoreItem*, Asset);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FTraitRemoved, UItemTrait*, Trait, UDA_CoreItem*, Asset);
@@ -263,6 +311,16 @@ public:
 
 	UPROPERTY()
 	TArray<FShapeRotation> Shapes;
+
+private:
+
+	UPROPERTY(Transient)
+	FItemAssetRuntimeCache RuntimeCache;
+
+	//See GetAssetPathHash. Only built once it's asked for.
+	mutable TOptional<uint32> AssetPathHash;
+
+public:
 	
 
 	//--------------------
@@ -305,11 +363,77 @@ public:
 	 * These loot tables should only focus the containers that this item owns.*/
 	UFUNCTION(BlueprintCallable, Category = "IFP|ItemAsset|Getters", meta = (ReturnDisplayName = "Pools"))
 	virtual TArray<UAC_LootTable*> GetLootTables();
+
+	/**Same as checking if GetDefaultContainers is empty, without copying them.
+	 * Returns the value from when the runtime cache was built, see BuildRuntimeCache.*/
+	UFUNCTION(BlueprintCallable, Category = "IFP|ItemAsset|Getters", BlueprintPure)
+	bool HasDefaultContainers();
+
+	/**Same as checking if GetLootTables is empty, without copying them.
+	 * Returns the value from when the runtime cache was built, see BuildRuntimeCache.*/
+	UFUNCTION(BlueprintCallable, Category = "IFP|ItemAsset|Getters", BlueprintPure)
+	bool HasLootTables();
+
+	/**The tags of the tag fragments in both ItemStructFragments and ItemAssetFragments.
+	 * Returns the tags from when the runtime cache was built, see BuildRuntimeCache.*/
+	UFUNCTION(BlueprintCallable, Category = "IFP|ItemAsset|Getters", meta = (ReturnDisplayName = "Tags"))
+	FGameplayTagContainer GetDefaultTags();
+
+	/**Find the first trait that is exactly @Class, children are not included.*/
+	UItemTrait* FindTraitByExactClass(const UClass* Class);
+
+	/**Find the first trait of @Class. If @AllowChildren is true, traits
+	 * that are a child of @Class are also included.*/
+	UItemTrait* FindTraitByClass(const UClass* Class, bool AllowChildren = false);
+
+	void FindTraitsByClass(const UClass* Class, bool AllowChildren, TArray<UItemTrait*>& FoundTraits);
+
+	/**Native version of FindTraitByClass. Every trait in the runtime cache
+	 * is already sorted by class, so there is no need to cast the result.*/
+	template<typename T>
+	T* FindTrait(bool AllowChildren = false)
+	{
+		static_assert(TIsDerivedFrom<T, UItemTrait>::IsDerived, "T must be derived from UItemTrait");
+		return static_cast<T*>(FindTraitByClass(T::StaticClass(), AllowChildren));
+	}
+
+	template<typename T>
+	TArray<T*> FindTraits(bool AllowChildren = false)
+	{
+		static_assert(TIsDerivedFrom<T, UItemTrait>::IsDerived, "T must be derived from UItemTrait");
+		TArray<UItemTrait*> FoundTraits;
+		FindTraitsByClass(T::StaticClass(), AllowChildren, FoundTraits);
+
+		TArray<T*> TypedTraits;
+		TypedTraits.Reserve(FoundTraits.Num());
+		for(UItemTrait* CurrentTrait : FoundTraits)
+		{
+			TypedTraits.Add(static_cast<T*>(CurrentTrait));
+		}
+		return TypedTraits;
+	}
+
+	/**Precompute everything in FItemAssetRuntimeCache.
+	 * This is done when the asset is loaded and when its shapes are baked.
+	 * If you modify the asset or any of its traits during runtime,
+	 * you have to call this yourself.*/
+	UFUNCTION(BlueprintCallable, Category = "IFP|ItemAsset")
+	void BuildRuntimeCache();
+
+	/**Has the runtime cache been built and does it still match the asset?
+	 * If not, the getters ignore it and fall back to computing everything from scratch.*/
+	bool IsRuntimeCacheValid() const;
+
+	const FItemAssetRuntimeCache& GetRuntimeCache() const { return RuntimeCache; }
 	
 	int32 FindObjectIndex(UItemTrait* Object);
 
 	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
 
+	/**Hash of the path of this asset, which is the same on the server and clients.
+	 * Item state hashes use this for every change, so it's only built once.*/
+	uint32 GetAssetPathHash() const;
+
 	/**Get all the soft class item component references from this items traits.
 	 * This can be used to async load all item components at some convenient
 	 * time before these item components get constructed.*/
@@ -324,6 +448,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Developer", meta = (DevelopmentOnly))
 	void BakeShapes();
 
+	virtual void PostLoad() override;
+
 
 #if WITH_EDITOR
 
@@ -347,8 +473,6 @@ public:
 
 	UTexture2D* GetThumbnailTexture();
 
-	virtual void PostLoad() override;
-
 	UFUNCTION()
 	TArray<TSoftObjectPtr<UScriptStruct>> GetDisallowedItemStructFragments() const;
 
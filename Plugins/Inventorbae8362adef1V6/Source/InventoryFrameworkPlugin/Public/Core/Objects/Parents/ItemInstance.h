@@ -33,13 +33,19 @@ public:
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	virtual bool UsePushModelForBlueprintProperties() const override { return PushModelBlueprintProperties; }
+
 	virtual void StartPlay_Implementation() override;
 
 	/**The ID of the item this object belongs to.
 	 * Used to fetch the ItemData of the item this object
 	 * belongs to.*/
-	UPROPERTY(Category = "Item Data", BlueprintReadWrite, ReplicatedUsing = "OnRep_ItemID")
+	UPROPERTY(Category = "Item Data", BlueprintReadWrite, BlueprintSetter = "SetItemID", ReplicatedUsing = "OnRep_ItemID")
 	FS_UniqueID ItemID;
+
+	/**ItemID is push-based, so always update it through here.*/
+	UFUNCTION(Category = "Item Data", BlueprintSetter)
+	void SetItemID(FS_UniqueID NewItemID);
 	UFUNCTION()
 	void OnRep_ItemID(FS_UniqueID OldUniqueID);
 
@@ -61,6 +67,14 @@ public:
 	UPROPERTY(Category = "Settings", BlueprintReadOnly, EditAnywhere, SaveGame)
 	TEnumAsByte<ELifetimeCondition> ReplicationCondition;
 
+	/**If true, replicated blueprint variables on this class are push-based
+	 * and will only replicate after MarkReplicatedPropertyDirty is called
+	 * for them. This saves the server from comparing every variable on
+	 * every item instance each net update.
+	 * Only the class default is used.*/
+	UPROPERTY(Category = "Settings", BlueprintReadOnly, EditDefaultsOnly)
+	bool PushModelBlueprintProperties = false;
+
 	UFUNCTION(Category = "Item Data", BlueprintCallable, BlueprintPure, meta = (CompactNodeTitle = "Inventory"))
 	UAC_Inventory* GetInventoryComponent();
 	
@@ -71,6 +85,11 @@ public:
 	UFUNCTION(Category = "Item Data", BlueprintCallable, BlueprintPure, meta = (CompactNodeTitle = "Container Settings"))
 	FS_ContainerSettings GetContainerSettings();
 
+	/**Call this after changing any SaveGame property, so the container
+	 * of the item is included in the next SaveDirtyContainersForActor.*/
+	UFUNCTION(Category = "Item Data", BlueprintCallable)
+	void MarkSaveGameDataDirty();
+
 	virtual void RemoveObject() override;
 
 	virtual AActor* GetOwningActor() const override;
@@ -33,6 +33,16 @@ public:
 	virtual UWorld* GetWorld() const override;
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/**If true, any blueprint variables labeled for replication are registered
+	 * as push-based. They will then only replicate after MarkReplicatedPropertyDirty
+	 * has been called for them, rather than being compared every net update.*/
+	virtual bool UsePushModelForBlueprintProperties() const { return false; }
+
+	/**Flag a replicated property as dirty so it gets replicated.
+	 * Only needed for push-based properties, see UsePushModelForBlueprintProperties.*/
+	UFUNCTION(BlueprintCallable, Category = "Networking")
+	void MarkReplicatedPropertyDirty(FName PropertyName);
 	
 	virtual int32 GetFunctionCallspace(UFunction* Function, FFrame* Stack) override;
 	
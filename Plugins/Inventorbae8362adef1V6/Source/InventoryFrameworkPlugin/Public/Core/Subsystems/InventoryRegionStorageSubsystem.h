@@ -0,0 +1,186 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Data/IFP_CoreData.h"
+#include "Core/Data/SG_InventorySerialization.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "InventoryRegionStorageSubsystem.generated.h"
+
+class UAC_Inventory;
+
+/**Where a single inventory is inside a cell file.*/
+struct FInventoryRegionEntry
+{
+	FString Key;
+
+	//Relative to the end of the index.
+	int64 Offset = 0;
+
+	int32 Size = 0;
+};
+
+/**The index at the start of a cell file.
+ * Entries should only be added through AddEntry, so EntryIndexes stays in sync.*/
+struct FInventoryRegionCellIndex
+{
+	TArray<FInventoryRegionEntry> Entries;
+
+	//Key to index in Entries.
+	TMap<FString, int32> EntryIndexes;
+
+	//Where the entries start in the file.
+	int64 DataStart = 0;
+
+	const FInventoryRegionEntry* FindEntry(const FString& Key) const
+	{
+		const int32* EntryIndex = EntryIndexes.Find(Key);
+		return EntryIndex ? &Entries[*EntryIndex] : nullptr;
+	}
+
+	FInventoryRegionEntry& AddEntry(const FString& Key)
+	{
+		EntryIndexes.Add(Key, Entries.Num());
+		FInventoryRegionEntry& NewEntry = Entries.AddDefaulted_GetRef();
+		NewEntry.Key = Key;
+		return NewEntry;
+	}
+};
+
+/**An inventory that has been saved, but not written to its cell file yet.
+ * Only holds plain structs, so it can be encoded on a worker thread.*/
+struct FInventoryRegionSnapshot
+{
+	TArray<FS_ContainerSettings> Containers;
+
+	TArray<FLoadedItemInstance> ItemInstances;
+
+	bool MarkAsValidated = false;
+};
+
+/**A cell file being written on a worker thread.*/
+struct FInventoryRegionCellWrite
+{
+	UE::Tasks::FTask Task;
+
+	//The index of the new file. DataStart is -1 if the write failed.
+	TSharedPtr<FInventoryRegionCellIndex> Index;
+};
+
+/**All changes to a cell that haven't been written yet.*/
+struct FInventoryRegionPendingCell
+{
+	TMap<FString, TSharedPtr<FInventoryRegionSnapshot>> SavedInventories;
+
+	TSet<FString> RemovedInventories;
+};
+
+/**Persists the inventories of world actors, such as crates, corpses and player built
+ * storage, without needing one save file for the whole world.
+ *
+ * The world is split into square cells of RegionCellSize. Every cell is its own file,
+ * starting with an index of the inventories inside of it, so a single inventory
+ * can be loaded without reading the rest of the cell.
+ *
+ * Saving only takes a copy of the containers. Cells with changes are written on
+ * a worker thread every RegionFlushInterval seconds, or when FlushDirtyCells is called.
+ * Everything left is flushed when the world is torn down.
+ *
+ * Inventories are stored under the name of their actor by default, which only works
+ * for actors that are placed in the level or always spawned with the same name.
+ * Pass in a StorageKey for anything else.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API UInventoryRegionStorageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**Store the cell files in a different directory, for example one per save slot.
+	 * Should be called before anything is saved or loaded.
+	 * Defaults to Saved/IFP/Regions/<MapName>.*/
+	UFUNCTION(Category = "IFP|Serialization|Regions", BlueprintCallable)
+	void SetStorageDirectory(const FString& Directory);
+
+	/**Save the containers of @Actor's inventory component into the cell the actor is in.
+	 * The cell file is written in the background.*/
+	UFUNCTION(Category = "IFP|Serialization|Regions", BlueprintCallable)
+	bool SaveInventory(AActor* Actor, const FString& StorageKey = TEXT(""));
+
+	/**Load the containers of @Actor's inventory component from the cell the actor is in.
+	 * Only the index of the cell and this inventory are read from disk.
+	 * This should be called before the component is started.*/
+	UFUNCTION(Category = "IFP|Serialization|Regions", BlueprintCallable)
+	bool LoadInventory(AActor* Actor, const FString& StorageKey = TEXT(""));
+
+	/**Remove the saved inventory of @Actor, for example once a corpse despawns.*/
+	UFUNCTION(Category = "IFP|Serialization|Regions", BlueprintCallable)
+	void RemoveInventory(AActor* Actor, const FString& StorageKey = TEXT(""));
+
+	/**Start writing every cell that has changes on a worker thread.*/
+	UFUNCTION(Category = "IFP|Serialization|Regions", BlueprintCallable)
+	void FlushDirtyCells();
+
+	/**Write every cell that has changes and wait for it to finish.*/
+	void FlushDirtyCellsAndWait();
+
+	UFUNCTION(Category = "IFP|Serialization|Regions", BlueprintCallable, BlueprintPure)
+	FIntPoint GetCellForLocation(const FVector& Location) const;
+
+	UFUNCTION(Category = "IFP|Serialization|Regions", BlueprintCallable, BlueprintPure)
+	int32 GetDirtyCellCount() const { return PendingCells.Num(); }
+
+	static FString GetStorageKey(const AActor* Actor, const FString& StorageKey);
+
+	/**Read the index at the start of a cell file. Leaves @Archive at the start of the entries.*/
+	static bool ReadCellIndex(FArchive& Archive, FInventoryRegionCellIndex& OutIndex);
+
+	/**Write a cell file that contains every entry in @Entries.*/
+	static bool WriteCellFile(const FString& FilePath, const TMap<FString, TArray<uint8>>& Entries, FInventoryRegionCellIndex& OutIndex);
+
+private:
+
+	FString GetCellFilePath(const FIntPoint& Cell) const;
+
+	/**Get the index of a cell, reading it from disk the first time.
+	 * Returns nullptr if the cell has no file.*/
+	const FInventoryRegionCellIndex* GetCellIndex(const FIntPoint& Cell);
+
+	/**Wait for the cell's write to finish, if it has one in progress.*/
+	void WaitForCellWrite(const FIntPoint& Cell);
+
+	/**Pick up the index of a finished cell write.*/
+	void FinishCellWrite(const FIntPoint& Cell);
+
+	/**Write a single cell on a worker thread. Entries that didn't change
+	 * are copied over from the current file.*/
+	void WriteCell(const FIntPoint& Cell, FInventoryRegionPendingCell&& PendingCell);
+
+	FString StorageDirectory;
+
+	//Seconds until the next FlushDirtyCells.
+	float TimeUntilFlush = 0;
+
+	//Cells whose index has been read from disk or written by us.
+	TMap<FIntPoint, FInventoryRegionCellIndex> CellIndexes;
+
+	//Which cell every inventory we know of is stored in, so it can be moved when the actor changes cell.
+	TMap<FString, FIntPoint> InventoryCells;
+
+	TMap<FIntPoint, FInventoryRegionPendingCell> PendingCells;
+
+	//Cell writes that are running on a worker thread.
+	TMap<FIntPoint, FInventoryRegionCellWrite> CellWrites;
+};
@@ -0,0 +1,153 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Data/IFP_CoreData.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventorySoakSubsystem.generated.h"
+
+class UAC_Inventory;
+
+UENUM()
+enum class EInventorySoakOperation : uint8
+{
+	Move,
+	Stack,
+	Split,
+	Loot
+};
+
+/**An operation a simulated client has sent and is waiting on the server for.*/
+struct FInventorySoakPendingOperation
+{
+	EInventorySoakOperation Operation = EInventorySoakOperation::Move;
+
+	double StartTime = 0;
+
+	TWeakObjectPtr<UAC_Inventory> Component;
+
+	//The operation is done once none of these are in the components NetworkQueue.
+	TArray<FS_UniqueID> ItemIDs;
+
+	//Predictions started by the operation, if the component predicts operations.
+	TArray<int32> PredictionIDs;
+};
+
+struct FInventorySoakOperationStats
+{
+	int32 Issued = 0;
+
+	int32 Completed = 0;
+
+	int32 TimedOut = 0;
+
+	/**Seconds from issuing the operation until the server answered.
+	 * Loot operations run on the server itself, so they have no latency.*/
+	TArray<double> Latencies;
+};
+
+/**Soak test driver for the inventory networking.
+ *
+ * Every game world gets one of these. While running, the worlds local inventory
+ * component keeps issuing random moves, stacks and splits against itself and
+ * records how long the server takes to answer each of them. Worlds with authority
+ * also loot and discard items for every connected player and record their frame times.
+ * The RPC profiler records for the duration of the soak and is dumped once every
+ * world in the process has stopped.
+ *
+ * Start a multi-client PIE session, or a server and clients with -nullrhi, and run:
+ * IFP.Soak.Start [OperationsPerSecond] [DurationSeconds] - Start the soak in every world of this process.
+ * IFP.Soak.Stop - Stop it early.
+ *
+ * Each world logs its own report when it stops. Keep in mind that in a single process
+ * all worlds share a frame, so the server frame time includes the simulated clients.
+ *
+ * Crafting is not part of the workload, it lives in the IFP_Crafting module
+ * which this module can't depend on.
+ *
+ * The soak modifies real player inventories, so it is never created in
+ * shipping builds and the console commands don't exist there.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API UInventorySoakSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override { return Running; }
+
+	virtual TStatId GetStatId() const override;
+
+	/**Start the soak in every game world of this process and start the RPC profiler.*/
+	static void StartSoak(float OperationsPerSecond, float Duration);
+
+	/**Stop the soak in every game world of this process.*/
+	static void StopSoak();
+
+	UFUNCTION(Category = "IFP|Networking|Soak", BlueprintCallable)
+	void Start(float OperationsPerSecond = 5, float Duration = 60);
+
+	/**Stop issuing operations and log the report.*/
+	UFUNCTION(Category = "IFP|Networking|Soak", BlueprintCallable)
+	void Stop();
+
+	UFUNCTION(Category = "IFP|Networking|Soak", BlueprintCallable, BlueprintPure)
+	bool IsRunning() const { return Running; }
+
+private:
+
+	void RunClientWorkload(UAC_Inventory* Component);
+
+	void RunLootWorkload();
+
+	bool TryMove(UAC_Inventory* Component);
+
+	bool TryStack(UAC_Inventory* Component);
+
+	bool TrySplit(UAC_Inventory* Component);
+
+	/**Add a copy of an item the player already has, or remove the last
+	 * item we added for them. Only works with authority.*/
+	bool TryLoot(UAC_Inventory* Component);
+
+	/**Items that the workload can touch. Anything already waiting on the server is skipped.*/
+	TArray<FS_InventoryItem> GetAvailableItems(UAC_Inventory* Component) const;
+
+	void AddPendingOperation(EInventorySoakOperation Operation, UAC_Inventory* Component, const TArray<FS_UniqueID>& ItemIDs, const TSet<int32>& PredictionsBefore);
+
+	void UpdatePendingOperations();
+
+	void LogReport() const;
+
+	bool Running = false;
+
+	double EndTime = 0;
+
+	float OperationsPerSecond = 0;
+
+	//Fractional operations carried over to the next tick.
+	float OperationBudget = 0;
+
+	FRandomStream Random;
+
+	TArray<FInventorySoakPendingOperation> PendingOperations;
+
+	TMap<EInventorySoakOperation, FInventorySoakOperationStats> Stats;
+
+	//Items the loot workload added, keyed by the component they were added to.
+	TMap<TWeakObjectPtr<UAC_Inventory>, FS_UniqueID> LootedItems;
+
+	//Seconds every frame took while running. Only recorded with authority.
+	TArray<double> FrameTimes;
+
+	int32 RejectedRequestsAtStart = 0;
+
+	int32 DeferredRequestsAtStart = 0;
+};
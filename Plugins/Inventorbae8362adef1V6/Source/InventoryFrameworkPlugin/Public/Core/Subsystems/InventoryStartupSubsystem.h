@@ -0,0 +1,43 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventoryStartupSubsystem.generated.h"
+
+class UAC_Inventory;
+
+/**Spreads UAC_Inventory::StartComponentTimeSliced out over multiple frames.
+ *
+ * Every frame, the queued components are started one step at a time, in the order
+ * they were queued, until StartComponentFrameBudgetMs from the runtime settings is
+ * used up. The budget is shared by all of them, so streaming in a level with a lot
+ * of inventories costs the same per frame as streaming in one.
+ * Components that are still waiting for their item assets are skipped until they're loaded,
+ * the same goes for components waiting for ULootGenerationSubsystem to roll their loot.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API UInventoryStartupSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override { return !QueuedComponents.IsEmpty(); }
+
+	virtual TStatId GetStatId() const override;
+
+	void QueueComponent(UAC_Inventory* Component);
+
+	//How many components are still starting.
+	UFUNCTION(Category = "Inventory Startup", BlueprintPure)
+	int32 GetQueuedComponentCount() const { return QueuedComponents.Num(); }
+
+private:
+
+	TArray<TWeakObjectPtr<UAC_Inventory>> QueuedComponents;
+};
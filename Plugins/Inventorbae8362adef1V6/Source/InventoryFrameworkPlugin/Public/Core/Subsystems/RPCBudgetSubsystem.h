@@ -0,0 +1,132 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RPCBudgetSubsystem.generated.h"
+
+class UNetConnection;
+
+/**Token bucket for a single client connection.*/
+struct INVENTORYFRAMEWORKPLUGIN_API FRPCTokenBucket
+{
+	float Tokens = 0;
+
+	double LastRefillTime = 0;
+
+	//How many of this connections requests are currently waiting in the deferred queue.
+	int32 DeferredRequests = 0;
+
+	/**Add the tokens gained since the last refill at @CurrentTime, up to @BurstSize.
+	 * The first refill fills the bucket.*/
+	void Refill(double CurrentTime, float BurstSize, float TokensPerSecond);
+
+	/**Take one token if there is one. Returns false if the bucket ran dry.*/
+	bool TrySpend();
+};
+
+/**A server RPC that arrived while the frame budget was exhausted.*/
+struct FDeferredRPCRequest
+{
+	TWeakObjectPtr<UObject> Requester;
+
+	TObjectKey<UNetConnection> Connection;
+
+	/**Every object the request was called with. The request is dropped if any
+	 * of them is destroyed while it is waiting, since the TFunction does not
+	 * keep them alive.*/
+	TArray<TWeakObjectPtr<const UObject>> ReferencedObjects;
+
+	TFunction<void()> Request;
+
+	TFunction<void()> RejectedRequest;
+};
+
+/**Server-side guard for the S_ RPC's of the inventory, fragment manager and crafting components.
+ *
+ * Every client connection gets a token bucket and each RPC costs one token. If a connection
+ * runs dry, its requests are rejected. RPC's that have no way of telling the client they
+ * were rejected are exempt from this. On top of that, the time spent processing RPC's is tracked
+ * every frame. Once the frame budget is used up, requests are deferred to the following frames
+ * and processed in the order they arrived.
+ *
+ * Everything is configured in the runtime settings under Networking|Rate Limiting.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API URPCBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**Call this at the very start of a server RPC implementation.
+	 * Returns true if the RPC should be processed right now.
+	 * If false, the request was either rejected or @DeferredRequest has been
+	 * queued and will be called once there's budget available.
+	 *
+	 * @ReferencedObjects Every object @DeferredRequest uses besides @Component,
+	 * including the ones inside of structs. If any of them is destroyed while
+	 * the request is deferred, the request is dropped instead of being called.
+	 *
+	 * @RejectedRequest Called if the request is rejected or dropped, so the client
+	 * can be told to roll back whatever it did while waiting for the server.
+	 * It might be called after @ReferencedObjects have been destroyed,
+	 * so it should only hold on to them through weak pointers.
+	 * Without it, the client would never find out, so the request doesn't
+	 * cost a token and is never rejected. It can still be deferred.
+	 *
+	 * Requests coming from the listen server host or from inside
+	 * another RPC that was already admitted are always allowed.*/
+	static bool AdmitRequest(UActorComponent* Component, TFunction<void()> DeferredRequest, TArray<const UObject*> ReferencedObjects = {}, TFunction<void()> RejectedRequest = nullptr);
+
+	/**Add the time spent processing an RPC to this frame's budget.*/
+	void AddFrameCost(double Seconds);
+
+	/**How many requests have been rejected because a connection ran out of tokens
+	 * or had too many deferred requests.*/
+	UPROPERTY(Category = "RPC Budget", BlueprintReadOnly)
+	int32 RejectedRequests = 0;
+
+	/**How many requests have been pushed to a later frame.*/
+	UPROPERTY(Category = "RPC Budget", BlueprintReadOnly)
+	int32 DeferredRequestsTotal = 0;
+
+	//How many FRPCBudgetScope's are currently alive. Used to detect nested RPC calls.
+	int32 ActiveScopes = 0;
+
+private:
+
+	void RefreshFrameCost();
+
+	TMap<TObjectKey<UNetConnection>, FRPCTokenBucket> Buckets;
+
+	TArray<FDeferredRPCRequest> DeferredRequests;
+
+	//Seconds spent processing RPC's during FrameCostFrame.
+	double FrameCost = 0;
+
+	uint64 FrameCostFrame = 0;
+
+	bool ProcessingDeferredRequest = false;
+};
+
+/**Measures how long a server RPC took to process and adds it to the frame budget.*/
+struct INVENTORYFRAMEWORKPLUGIN_API FRPCBudgetScope
+{
+	explicit FRPCBudgetScope(const UObject* WorldContext);
+
+	~FRPCBudgetScope();
+
+private:
+
+	TWeakObjectPtr<URPCBudgetSubsystem> Subsystem;
+
+	double StartTime = 0;
+};
@@ -0,0 +1,94 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "RPCProfilerSubsystem.generated.h"
+
+/**Identifies a single RPC on a single component class, on one side of the connection.*/
+struct FRPCProfilerKey
+{
+	FName ComponentClass;
+
+	FName Function;
+
+	//Was this RPC sent by the server?
+	bool Server = false;
+
+	bool operator==(const FRPCProfilerKey& Other) const
+	{
+		return ComponentClass == Other.ComponentClass && Function == Other.Function && Server == Other.Server;
+	}
+
+	friend uint32 GetTypeHash(const FRPCProfilerKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.ComponentClass), GetTypeHash(Key.Function)), GetTypeHash(Key.Server));
+	}
+};
+
+struct FRPCProfilerStats
+{
+	int32 Calls = 0;
+
+	int64 TotalBytes = 0;
+
+	//Reservoir of payload sizes in bytes, used for the p99.
+	TArray<int32> Samples;
+
+#if COUNTERSTRACE_ENABLED
+	//Counters keep a pointer to their name, so it has to outlive them.
+	FString BytesCounterName;
+	FString CallsCounterName;
+	TUniquePtr<FCountersTrace::FCounterInt> BytesCounter;
+	TUniquePtr<FCountersTrace::FCounterInt> CallsCounter;
+#endif
+};
+
+/**Opt-in profiler that records how many times each inventory, fragment manager
+ * and crafting RPC is sent and how many bytes its parameters serialize to.
+ * The payload is measured the same way the net driver serializes it, so it does not
+ * include bunch and packet headers.
+ *
+ * This is only meant for profiling sessions, measuring means every RPC
+ * is serialized twice.
+ *
+ * Console commands:
+ * IFP.RPCProfiler.Start - Clear all recorded data and start recording.
+ * IFP.RPCProfiler.Stop - Stop recording.
+ * IFP.RPCProfiler.Dump [FileName] - Write the recorded data to a CSV inside the profiling directory.
+ *
+ * While recording, every RPC also has a bytes and calls counter in Insights.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API URPCProfilerSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**Call this before an RPC is sent. Does nothing if the profiler isn't recording.*/
+	static void RecordRPC(UActorComponent* Component, UFunction* Function, void* Parameters);
+
+	UFUNCTION(Category = "IFP|Networking|Profiler", BlueprintCallable)
+	void StartRecording();
+
+	UFUNCTION(Category = "IFP|Networking|Profiler", BlueprintCallable)
+	void StopRecording();
+
+	/**Write the recorded data to a CSV file. Returns the full path of the file,
+	 * or an empty string if it couldn't be written.*/
+	UFUNCTION(Category = "IFP|Networking|Profiler", BlueprintCallable)
+	FString DumpToCSV(const FString& FileName);
+
+	UFUNCTION(Category = "IFP|Networking|Profiler", BlueprintCallable, BlueprintPure)
+	bool IsRecording() const { return Recording; }
+
+private:
+
+	int32 MeasureParameters(UActorComponent* Component, UFunction* Function, void* Parameters) const;
+
+	TMap<FRPCProfilerKey, FRPCProfilerStats> Stats;
+
+	bool Recording = false;
+};
@@ -6,6 +6,8 @@
 #include "Core/Data/IFP_CoreData.h"
 #include "LootTableCoreData.generated.h"
 
+class UO_LootPool;
+
 
 USTRUCT(BlueprintType)
 struct FSimpleLootTable
@@ -21,3 +23,60 @@ struct FSimpleLootTable
 	UPROPERTY(Category = "Loot Table", BlueprintReadWrite, EditAnywhere)
 	FIntPoint RandomMinMaxCount = FIntPoint(1, 1);
 };
+
+/**Alias table (Vose's method) for picking an index out of a list of weights.
+ * Building the table is O(n), but every draw afterwards is O(1),
+ * no matter how many entries there are.
+ * Negative weights are treated as 0. Entries with a weight of 0 are never picked.*/
+struct INVENTORYFRAMEWORKPLUGIN_API FLootAliasTable
+{
+	/**Build the table from @Weights, replacing whatever was there.
+	 * Returns false if there is nothing that can be picked.*/
+	bool Build(TConstArrayView<float> Weights);
+
+	void Reset();
+
+	/**Has Build been called since the last Reset?
+	 * This can be true even if nothing can be picked.*/
+	bool IsBuilt() const { return Built; }
+
+	bool IsEmpty() const { return Probabilities.IsEmpty(); }
+
+	double GetTotalWeight() const { return TotalWeight; }
+
+	/**Pick an index using @Stream. Uses two values from the stream.
+	 * Returns INDEX_NONE if the table is empty.*/
+	int32 Draw(const FRandomStream& Stream) const;
+
+private:
+
+	//Chance of keeping the column that was landed on, instead of going to its alias.
+	TArray<float> Probabilities;
+
+	TArray<int32> Aliases;
+
+	double TotalWeight = 0;
+
+	bool Built = false;
+};
+
+struct FRolledLootItem
+{
+	UDA_CoreItem* Item = nullptr;
+
+	int32 Count = 0;
+};
+
+/**One loot pool being rolled by ULootGenerationSubsystem.
+ * Gathered and applied on the game thread, rolled on a worker thread.*/
+struct FLootRollJob
+{
+	UO_LootPool* Pool = nullptr;
+
+	//Index of the container inside of the inventory the items are added to.
+	int32 ContainerIndex = INDEX_NONE;
+
+	int32 Seed = 0;
+
+	TArray<FRolledLootItem> RolledItems;
+};
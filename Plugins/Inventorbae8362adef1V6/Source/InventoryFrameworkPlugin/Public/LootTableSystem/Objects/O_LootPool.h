@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Core/Data/IFP_CoreData.h"
+#include "LootTableSystem/Data/LootTableCoreData.h"
 #include "UObject/Object.h"
 #include "O_LootPool.generated.h"
 
@@ -27,6 +28,26 @@ public:
 	UPROPERTY(Category = "Loot Table", BlueprintReadWrite)
 	int32 ItemsSpawned = 0;
 
+	/**Items RollWeightedItem can pick from. The SpawnPercentage of each
+	 * entry is its weight, relative to the other entries.
+	 * If you want to change this at runtime, use SetWeightedItems.*/
+	UPROPERTY(Category = "Loot Pool", EditAnywhere, BlueprintReadOnly)
+	TArray<FSimpleLootTable> WeightedItems;
+
+	/**How many times WeightedItems is rolled before the inventory is initialized.
+	 * These rolls are done by ULootGenerationSubsystem on worker threads, together with
+	 * every other inventory that is starting, before any ProcessPreInitializationLoot is called.
+	 * Pools that are rolled this way do not get ProcessPreInitializationLoot or
+	 * ProcessPostInitializationLoot called, so they are never rolled twice.
+	 * Leave at 0 if this pool does its own rolling.*/
+	UPROPERTY(Category = "Loot Pool", EditAnywhere, BlueprintReadWrite, meta = (ClampMin = 0))
+	FIntPoint RandomMinMaxRolls = FIntPoint(0, 0);
+
+	/**The container the items rolled through RandomMinMaxRolls are added to.
+	 * If the loot table was created by an item, only that items containers are used.*/
+	UPROPERTY(Category = "Loot Pool", EditAnywhere, BlueprintReadWrite)
+	FGameplayTag TargetContainer;
+
 	UFUNCTION(Category = "Loot Pool", BlueprintNativeEvent)
 	void StartPlay();
 
@@ -73,7 +94,49 @@ public:
 	UFUNCTION(Category = "Loot Pool", BlueprintCallable, DisplayName = "Add Item (Pre-initialize only)")
 	void AddItemPreInitializeOnly(FS_InventoryItem Item, FS_ContainerSettings Container, bool IncludeLootTable = true);
 
+	UFUNCTION(Category = "Loot Pool", BlueprintCallable)
+	void SetWeightedItems(const TArray<FSimpleLootTable>& NewItems);
+
+	/**Pick one entry out of WeightedItems using @Stream.
+	 * This does not depend on how many items are in the pool,
+	 * the weights are only processed once until they change.
+	 * Returns false if no entry has a SpawnPercentage above 0.*/
+	UFUNCTION(Category = "Loot Pool", BlueprintCallable)
+	bool RollWeightedItem(const FRandomStream& Stream, FSimpleLootTable& Item);
+
+	/**Call RollWeightedItem @Rolls amount of times.
+	 * The same entry can be picked more than once.*/
+	UFUNCTION(Category = "Loot Pool", BlueprintCallable)
+	TArray<FSimpleLootTable> RollWeightedItems(const FRandomStream& Stream, int32 Rolls = 1);
+
+	/**Process the weights of WeightedItems so they are ready to be rolled.
+	 * This is done automatically, but can be called early to avoid
+	 * doing it during the first roll.*/
+	UFUNCTION(Category = "Loot Pool", BlueprintCallable)
+	void BuildWeights();
+
+	/**The weights will be processed again on the next roll.*/
+	UFUNCTION(Category = "Loot Pool", BlueprintCallable)
+	void InvalidateWeights();
+
+	bool AreWeightsBuilt() const { return WeightsAliasTable.IsBuilt(); }
+
+	/**Is this pool rolled by ULootGenerationSubsystem through RandomMinMaxRolls?*/
+	UFUNCTION(Category = "Loot Pool", BlueprintCallable, BlueprintPure)
+	bool IsBatchRolled() const;
+
+	/**Roll WeightedItems RandomMinMaxRolls amount of times and add the results to @OutItems.
+	 * This only reads from the pool, so it is safe to call from a worker thread,
+	 * as long as BuildWeights has been called on the game thread first.*/
+	void RollBatchedItems(const FRandomStream& Stream, TArray<FRolledLootItem>& OutItems) const;
+
+	virtual void PostLoad() override;
+
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
+
+private:
+
+	FLootAliasTable WeightsAliasTable;
 };
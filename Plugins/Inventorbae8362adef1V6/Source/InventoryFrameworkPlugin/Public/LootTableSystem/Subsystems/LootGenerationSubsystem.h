@@ -0,0 +1,59 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LootTableSystem/Data/LootTableCoreData.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LootGenerationSubsystem.generated.h"
+
+class UAC_Inventory;
+
+/**Rolls the loot of every inventory that is starting in one batch.
+ *
+ * Inventories started through StartComponentTimeSliced queue themselves here
+ * once their ID's are generated. At the next tick, the loot pools of every queued
+ * inventory that use RandomMinMaxRolls are gathered into one list and rolled in
+ * parallel on worker threads. Each pool gets its own seed, derived from the
+ * inventories operation seed and the position of the pool, so the results do not
+ * depend on how the work was split up.
+ * The rolled items are then added to each inventory in one go.
+ *
+ * Inventories started through the regular StartComponent are rolled on their own,
+ * right away, through the same path.
+ * Like the rest of the loot table system, this only exists on the server.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API ULootGenerationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override { return !QueuedInventories.IsEmpty(); }
+
+	virtual TStatId GetStatId() const override;
+
+	void QueueInventory(UAC_Inventory* Inventory);
+
+	void RemoveInventory(UAC_Inventory* Inventory);
+
+	/**Gather, roll and apply the loot of @Inventories right away.*/
+	static void GenerateLoot(TConstArrayView<UAC_Inventory*> Inventories);
+
+	/**Roll @Jobs, in parallel if there are enough of them.
+	 * Only touches the pools through UO_LootPool::RollBatchedItems.*/
+	static void RollJobs(TArrayView<FLootRollJob> Jobs);
+
+	UFUNCTION(Category = "Loot Generation", BlueprintPure)
+	int32 GetQueuedInventoryCount() const { return QueuedInventories.Num(); }
+
+private:
+
+	TArray<TWeakObjectPtr<UAC_Inventory>> QueuedInventories;
+};
@@ -20,7 +20,8 @@ class INVENTORYFRAMEWORKPLUGIN_API UGFA_AddItemsToTagLootPool : public UGameFeat
 
 public:
 
-	/**Items to add to the world's global tag loot pools.*/
+	/**Items to add to the world's global tag loot pools.
+	 * If an item is in the same pool more than once, only the last one is used.*/
 	UPROPERTY(Category = "Tag Loot Pool", EditAnywhere, meta = (ForceInlineRow))
 	TMap<FGameplayTag, FTagLootPool> TagLootPools;
 
@@ -30,4 +31,8 @@ public:
 	virtual void OnGameFeatureActivating(FGameFeatureActivatingContext& Context) override;
 
 	virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
+
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
 };
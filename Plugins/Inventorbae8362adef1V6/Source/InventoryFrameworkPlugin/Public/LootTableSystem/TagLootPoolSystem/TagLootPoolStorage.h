@@ -6,6 +6,7 @@
 #include "GameplayTagContainer.h"
 #include "Core/Items/DA_CoreItem.h"
 #include "Engine/DeveloperSettings.h"
+#include "LootTableSystem/Data/LootTableCoreData.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "TagLootPoolStorage.generated.h"
 
@@ -73,6 +74,35 @@ struct FTagLootPool
 		}
 		return FoundItems;
 	}
+
+	/**Weights of Items, built by UTagLootPoolStorage and
+	 * reset whenever the items change.*/
+	FLootAliasTable AliasTable;
+
+	/**Where each item is inside of Items. Kept up to date by
+	 * AddOrUpdateItem and RemoveItem, if you modify Items
+	 * directly, call RebuildIndex.*/
+	TMap<TSoftObjectPtr<UDA_CoreItem>, int32> ItemIndexes;
+
+	//Sum of the SpawnChance of every item that can be rolled.
+	double TotalSpawnChance = 0;
+
+	void BuildAliasTable();
+
+	/**Rebuild ItemIndexes and TotalSpawnChance from Items.
+	 * If an item is in there more than once, the last one is kept.*/
+	void RebuildIndex();
+
+	bool IsIndexValid() const { return ItemIndexes.Num() == Items.Num(); }
+
+	const FTagPoolItem* FindItem(const TSoftObjectPtr<UDA_CoreItem>& Item) const;
+
+	/**Add @Item, or override the existing entry for the same item.*/
+	void AddOrUpdateItem(const FTagPoolItem& Item);
+
+	/**Returns false if the item was not in the pool.
+	 * The last item is moved into the removed items place.*/
+	bool RemoveItem(const TSoftObjectPtr<UDA_CoreItem>& Item);
 };
 
 /**A subsystem for handling storing a simple map of tags and items,
@@ -95,9 +125,25 @@ public:
 	UFUNCTION(Category = "Tag Loot Pool", BlueprintCallable, BlueprintPure)
 	TArray<FTagPoolItem> GetItemsFromTagPool(FGameplayTag Tag);
 
+	/**Pick one item out of the @TagPool using @Stream. The SpawnChance of
+	 * each item is its weight, relative to the other items in the pool.
+	 * This does not depend on how many items are in the pool.
+	 * Returns false if the pool doesn't exist or nothing in it can be picked.*/
+	UFUNCTION(Category = "Tag Loot Pool", BlueprintCallable)
+	bool RollItemFromTagPool(FGameplayTag TagPool, const FRandomStream& Stream, FTagPoolItem& Item);
+
 	UFUNCTION(Category = "Tag Loot Pool", BlueprintCallable, BlueprintPure)
 	float GetItemsSpawnChance(FGameplayTag TagPool, TSoftObjectPtr<UDA_CoreItem> Item);
 
+	/**Get the chance of @Item being picked by RollItemFromTagPool,
+	 * which is its spawn chance divided by the total of the pool.*/
+	UFUNCTION(Category = "Tag Loot Pool", BlueprintCallable, BlueprintPure)
+	float GetItemsRollChance(FGameplayTag TagPool, TSoftObjectPtr<UDA_CoreItem> Item);
+
+	/**Get the sum of the spawn chance of every item in the @TagPool.*/
+	UFUNCTION(Category = "Tag Loot Pool", BlueprintCallable, BlueprintPure)
+	float GetTagPoolTotalSpawnChance(FGameplayTag TagPool);
+
 	/**Add @Items to the specified loot pool assigned to the @TagPool
 	 * If the item already exists, then the spawn chance and other properties
 	 * passed in will simply get overriden with the new value.*/
@@ -106,13 +152,18 @@ public:
 
 	/**Helper function for adding an entire TMap to the tag loot pool*/
 	UFUNCTION(Category = "Tag Loot Pool", BlueprintCallable)
-	void AppendTagLootPoolMap(TMap<FGameplayTag, FTagLootPool> TagPool);
+	void AppendTagLootPoolMap(const TMap<FGameplayTag, FTagLootPool>& TagPool);
 
 	/**Remove @Items from the specified loot pool assigned to the @TagPool*/
 	UFUNCTION(Category = "Tag Loot Pool", BlueprintCallable)
-	void RemoveItemsFromTagLootPool(FGameplayTag TagPool, TArray<TSoftObjectPtr<UDA_CoreItem>> Items);
+	void RemoveItemsFromTagLootPool(FGameplayTag TagPool, const TArray<TSoftObjectPtr<UDA_CoreItem>>& Items);
 
 	/**Helper function for removing an entire TMap from the tag loot pool*/
 	UFUNCTION(Category = "Tag Loot Pool", BlueprintCallable)
-	void RemoveTagLootPoolMap(TMap<FGameplayTag, FTagLootPool> TagPool);
+	void RemoveTagLootPoolMap(const TMap<FGameplayTag, FTagLootPool>& TagPool);
+
+private:
+
+	/**Find the pool for @Tag, making sure its index is up to date.*/
+	FTagLootPool* FindTagLootPool(FGameplayTag Tag);
 };
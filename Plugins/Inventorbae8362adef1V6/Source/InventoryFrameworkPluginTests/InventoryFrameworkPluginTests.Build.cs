@@ -0,0 +1,23 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class InventoryFrameworkPluginTests : ModuleRules
+{
+	public InventoryFrameworkPluginTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		CppStandard = CppStandardVersion.Latest;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"GameplayTags",
+				"InventoryFrameworkPlugin",
+			}
+			);
+	}
+}
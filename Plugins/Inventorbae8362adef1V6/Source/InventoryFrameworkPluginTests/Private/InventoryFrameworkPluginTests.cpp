@@ -0,0 +1,6 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+//Only holds the automation specs under Private/Tests.
+IMPLEMENT_MODULE(FDefaultModuleImpl, InventoryFrameworkPluginTests)
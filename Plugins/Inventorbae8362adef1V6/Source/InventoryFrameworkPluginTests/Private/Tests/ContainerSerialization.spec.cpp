@@ -0,0 +1,244 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "IFPTestHelpers.h"
+#include "Core/Data/SG_InventorySerialization.h"
+#include "Core/Fragments/F_Tags.h"
+#include "Core/Fragments/FL_IFP_FragmentHelpers.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FContainerSerializationSpec, "IFP.Serialization.Containers", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	/**Compare everything the binary format stores about @Actual with @Expected.*/
+	void TestContainersEqual(const TArray<FS_ContainerSettings>& Actual, const TArray<FS_ContainerSettings>& Expected);
+
+END_DEFINE_SPEC(FContainerSerializationSpec)
+
+void FContainerSerializationSpec::TestContainersEqual(const TArray<FS_ContainerSettings>& Actual, const TArray<FS_ContainerSettings>& Expected)
+{
+	if(!TestEqual("Container count", Actual.Num(), Expected.Num()))
+	{
+		return;
+	}
+
+	for(int32 ContainerIndex = 0; ContainerIndex < Expected.Num(); ContainerIndex++)
+	{
+		const FS_ContainerSettings& ActualContainer = Actual[ContainerIndex];
+		const FS_ContainerSettings& ExpectedContainer = Expected[ContainerIndex];
+		TestEqual("Container ID", ActualContainer.UniqueID.IdentityNumber, ExpectedContainer.UniqueID.IdentityNumber);
+		TestEqual("Dimensions", ActualContainer.Dimensions, ExpectedContainer.Dimensions);
+		if(!TestEqual("Item count", ActualContainer.Items.Num(), ExpectedContainer.Items.Num()))
+		{
+			continue;
+		}
+
+		for(int32 ItemIndex = 0; ItemIndex < ExpectedContainer.Items.Num(); ItemIndex++)
+		{
+			const FS_InventoryItem& ActualItem = ActualContainer.Items[ItemIndex];
+			const FS_InventoryItem& ExpectedItem = ExpectedContainer.Items[ItemIndex];
+			TestEqual("Item ID", ActualItem.UniqueID.IdentityNumber, ExpectedItem.UniqueID.IdentityNumber);
+			TestEqual("TileIndex", ActualItem.TileIndex, ExpectedItem.TileIndex);
+			TestEqual("Count", ActualItem.Count, ExpectedItem.Count);
+			TestEqual("Rotation", ActualItem.Rotation.GetValue(), ExpectedItem.Rotation.GetValue());
+			TestEqual("Asset", ActualItem.ItemAssetSoftReference.ToSoftObjectPath(), ExpectedItem.ItemAssetSoftReference.ToSoftObjectPath());
+		}
+	}
+}
+
+void FContainerSerializationSpec::Define()
+{
+	Describe("WriteContainers", [this]()
+	{
+		It("should read back what it wrote", [this]()
+		{
+			const TArray<FS_ContainerSettings> Containers = IFPTests::MakeInventory();
+			TArray<uint8> Data;
+			TestTrue("Write", USG_InventorySerialization::WriteContainers(Containers, false, Data));
+
+			TArray<FS_ContainerSettings> LoadedContainers;
+			TArray<FLoadedItemInstance> ItemInstances;
+			TestTrue("Read", USG_InventorySerialization::ReadContainers(Data, LoadedContainers, ItemInstances));
+			TestContainersEqual(LoadedContainers, Containers);
+			TestEqual("Item instances", ItemInstances.Num(), 0);
+		});
+
+		It("should tag everything as validated when asked to", [this]()
+		{
+			const TArray<FS_ContainerSettings> Containers = IFPTests::MakeInventory();
+			TArray<uint8> Data;
+			USG_InventorySerialization::WriteContainers(Containers, true, Data);
+
+			TArray<FS_ContainerSettings> LoadedContainers;
+			TArray<FLoadedItemInstance> ItemInstances;
+			TestTrue("Read", USG_InventorySerialization::ReadContainers(Data, LoadedContainers, ItemInstances));
+
+			//The native tag isn't exported, look it up by name.
+			const FGameplayTag SkipValidation = FGameplayTag::RequestGameplayTag(TEXT("IFP.Initialization.SkipValidation"));
+			for(FS_ContainerSettings& CurrentContainer : LoadedContainers)
+			{
+				const FTagFragment* TagFragment = FindFragment<FTagFragment>(CurrentContainer.ContainerFragments);
+				TestTrue("Container skips validation", TagFragment && TagFragment->Tags.HasTagExact(SkipValidation));
+				for(FS_InventoryItem& CurrentItem : CurrentContainer.Items)
+				{
+					TagFragment = FindFragment<FTagFragment>(CurrentItem.ItemFragments);
+					TestTrue("Item skips validation", TagFragment && TagFragment->Tags.HasTagExact(SkipValidation));
+				}
+			}
+		});
+
+		It("should reject truncated or foreign data", [this]()
+		{
+			TArray<uint8> Data;
+			USG_InventorySerialization::WriteContainers(IFPTests::MakeInventory(), false, Data);
+
+			TArray<FS_ContainerSettings> LoadedContainers;
+			TArray<FLoadedItemInstance> ItemInstances;
+			TArray<uint8> Truncated(Data.GetData(), Data.Num() / 2);
+			TestFalse("Truncated", USG_InventorySerialization::ReadContainers(Truncated, LoadedContainers, ItemInstances));
+
+			TArray<uint8> Foreign = Data;
+			Foreign[0] ^= 0xFF;
+			TestFalse("Wrong magic", USG_InventorySerialization::ReadContainers(Foreign, LoadedContainers, ItemInstances));
+			TestFalse("Empty", USG_InventorySerialization::ReadContainers(TArray<uint8>(), LoadedContainers, ItemInstances));
+		});
+	});
+
+	Describe("WriteContainerSnapshot", [this]()
+	{
+		It("should write the same containers as WriteContainers", [this]()
+		{
+			const TArray<FS_ContainerSettings> Containers = IFPTests::MakeInventory();
+			TArray<FS_ContainerSettings> SnapshotContainers;
+			TArray<FLoadedItemInstance> SnapshotItemInstances;
+			USG_InventorySerialization::SnapshotContainers(Containers, SnapshotContainers, SnapshotItemInstances);
+
+			TArray<uint8> Data;
+			TestTrue("Write", USG_InventorySerialization::WriteContainerSnapshot(SnapshotContainers, SnapshotItemInstances, false, Data));
+
+			TArray<FS_ContainerSettings> LoadedContainers;
+			TArray<FLoadedItemInstance> ItemInstances;
+			TestTrue("Read", USG_InventorySerialization::ReadContainers(Data, LoadedContainers, ItemInstances));
+			TestContainersEqual(LoadedContainers, Containers);
+		});
+	});
+
+	Describe("WriteSingleItem", [this]()
+	{
+		It("should read back what it wrote", [this]()
+		{
+			const TArray<FS_ContainerSettings> Containers = IFPTests::MakeInventory();
+			const FS_InventoryItem& Item = Containers[1].Items[0];
+
+			TArray<uint8> Data;
+			FMemoryWriter Writer(Data, true);
+			USG_InventorySerialization::WriteSingleItem(Writer, Item, false);
+
+			FS_InventoryItem LoadedItem;
+			TOptional<FLoadedItemInstance> ItemInstance;
+			FMemoryReader Reader(Data, true);
+			TestTrue("Read", USG_InventorySerialization::ReadSingleItem(Reader, LoadedItem, ItemInstance));
+			TestEqual("Everything was read", Reader.Tell(), Reader.TotalSize());
+			TestEqual("Item ID", LoadedItem.UniqueID.IdentityNumber, Item.UniqueID.IdentityNumber);
+			TestEqual("Count", LoadedItem.Count, Item.Count);
+			TestEqual("Rotation", LoadedItem.Rotation.GetValue(), Item.Rotation.GetValue());
+			TestFalse("Item instance", ItemInstance.IsSet());
+		});
+	});
+
+	Describe("ApplyContainerPatch", [this]()
+	{
+		It("should only replace the dirty containers", [this]()
+		{
+			const TArray<FS_ContainerSettings> Original = IFPTests::MakeInventory();
+			TArray<uint8> BaseData;
+			USG_InventorySerialization::WriteContainers(Original, false, BaseData);
+
+			TArray<FS_ContainerSettings> Changed = Original;
+			Changed[0].Items[0].Count = 99;
+			//Not dirty, so the patch must not carry this over.
+			Changed[1].Items[0].Count = 1;
+
+			TArray<uint8> PatchData;
+			TestTrue("Write patch", USG_InventorySerialization::WriteContainerPatch(Changed, {1}, false, PatchData));
+
+			TArray<FS_ContainerSettings> LoadedContainers;
+			TArray<FLoadedItemInstance> ItemInstances;
+			USG_InventorySerialization::ReadContainers(BaseData, LoadedContainers, ItemInstances);
+			TestTrue("Apply patch", USG_InventorySerialization::ApplyContainerPatch(PatchData, LoadedContainers, ItemInstances));
+
+			TestEqual("Dirty container was patched", IFPTests::FindItem(LoadedContainers, 10)->Count, 99);
+			TestEqual("Clean container kept its save", IFPTests::FindItem(LoadedContainers, 12)->Count, 20);
+		});
+
+		It("should drop and reorder containers", [this]()
+		{
+			const TArray<FS_ContainerSettings> Original = IFPTests::MakeInventory();
+			TArray<uint8> BaseData;
+			USG_InventorySerialization::WriteContainers(Original, false, BaseData);
+
+			TArray<FS_ContainerSettings> Changed;
+			Changed.Add(Original[1]);
+			Changed.Add(IFPTests::MakeContainer(3));
+
+			TArray<uint8> PatchData;
+			USG_InventorySerialization::WriteContainerPatch(Changed, {3}, false, PatchData);
+
+			TArray<FS_ContainerSettings> LoadedContainers;
+			TArray<FLoadedItemInstance> ItemInstances;
+			USG_InventorySerialization::ReadContainers(BaseData, LoadedContainers, ItemInstances);
+			TestTrue("Apply patch", USG_InventorySerialization::ApplyContainerPatch(PatchData, LoadedContainers, ItemInstances));
+			TestContainersEqual(LoadedContainers, Changed);
+		});
+
+		It("should end up where a full save would, no matter how many patches were applied", [this]()
+		{
+			TArray<FS_ContainerSettings> Containers = IFPTests::MakeInventory();
+			TArray<uint8> BaseData;
+			USG_InventorySerialization::WriteContainers(Containers, false, BaseData);
+
+			TArray<TArray<uint8>> Patches;
+			for(int32 CurrentPatch = 0; CurrentPatch < 5; CurrentPatch++)
+			{
+				const int32 ContainerIndex = CurrentPatch % Containers.Num();
+				Containers[ContainerIndex].Items[0].Count += CurrentPatch + 1;
+				USG_InventorySerialization::WriteContainerPatch(Containers, {Containers[ContainerIndex].UniqueID.IdentityNumber}, false, Patches.AddDefaulted_GetRef());
+			}
+
+			TArray<FS_ContainerSettings> PatchedContainers;
+			TArray<FLoadedItemInstance> ItemInstances;
+			USG_InventorySerialization::ReadContainers(BaseData, PatchedContainers, ItemInstances);
+			for(const TArray<uint8>& CurrentPatch : Patches)
+			{
+				TestTrue("Apply patch", USG_InventorySerialization::ApplyContainerPatch(CurrentPatch, PatchedContainers, ItemInstances));
+			}
+
+			//Compacting writes the patched containers as the new full save.
+			TArray<uint8> CompactedData;
+			USG_InventorySerialization::WriteContainers(PatchedContainers, false, CompactedData);
+			TArray<FS_ContainerSettings> CompactedContainers;
+			USG_InventorySerialization::ReadContainers(CompactedData, CompactedContainers, ItemInstances);
+
+			TestContainersEqual(PatchedContainers, Containers);
+			TestContainersEqual(CompactedContainers, Containers);
+		});
+
+		It("should refuse patches for containers it doesn't have", [this]()
+		{
+			TArray<FS_ContainerSettings> Changed = IFPTests::MakeInventory();
+			Changed.Add(IFPTests::MakeContainer(4));
+
+			TArray<uint8> PatchData;
+			USG_InventorySerialization::WriteContainerPatch(Changed, {1}, false, PatchData);
+
+			TArray<FS_ContainerSettings> LoadedContainers = IFPTests::MakeInventory();
+			TArray<FLoadedItemInstance> ItemInstances;
+			AddExpectedMessage(TEXT("not in the save it is patching"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+			TestFalse("Apply patch", USG_InventorySerialization::ApplyContainerPatch(PatchData, LoadedContainers, ItemInstances));
+		});
+	});
+}
+
+#endif
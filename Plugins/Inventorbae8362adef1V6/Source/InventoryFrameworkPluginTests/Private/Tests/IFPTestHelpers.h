@@ -0,0 +1,74 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Data/IFP_CoreData.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+/**Builds the plain container structs the serialization specs work with.
+ * Items only point at an asset path, nothing is ever loaded.*/
+namespace IFPTests
+{
+	inline FS_ContainerSettings MakeContainer(int32 ContainerID, FIntPoint Dimensions = FIntPoint(4, 4))
+	{
+		FS_ContainerSettings Container;
+		Container.UniqueID.IdentityNumber = ContainerID;
+		Container.Dimensions = Dimensions;
+		return Container;
+	}
+
+	inline FS_InventoryItem& AddItem(FS_ContainerSettings& Container, int32 ItemID, int32 TileIndex, int32 Count = 1)
+	{
+		FS_InventoryItem& Item = Container.Items.AddDefaulted_GetRef();
+		Item.UniqueID.IdentityNumber = ItemID;
+		Item.ItemAssetSoftReference = TSoftObjectPtr<UDA_CoreItem>(FSoftObjectPath(TEXT("/Game/IFPTests/DA_TestItem.DA_TestItem")));
+		Item.TileIndex = TileIndex;
+		Item.Count = Count;
+		Item.ContainerIndex = Container.ContainerIndex;
+		Item.ItemIndex = Container.Items.Num() - 1;
+		return Item;
+	}
+
+	//Two containers, one of them holding a few items.
+	inline TArray<FS_ContainerSettings> MakeInventory()
+	{
+		TArray<FS_ContainerSettings> Containers;
+		Containers.Add(MakeContainer(1));
+		Containers.Add(MakeContainer(2, FIntPoint(2, 2)));
+		Containers[1].ContainerIndex = 1;
+		AddItem(Containers[0], 10, 0, 5);
+		AddItem(Containers[0], 11, 3);
+		AddItem(Containers[1], 12, 1, 20).Rotation = Ninety;
+		return Containers;
+	}
+
+	inline const FS_InventoryItem* FindItem(const TArray<FS_ContainerSettings>& Containers, int32 ItemID, int32* OutContainerID = nullptr)
+	{
+		for(const FS_ContainerSettings& CurrentContainer : Containers)
+		{
+			for(const FS_InventoryItem& CurrentItem : CurrentContainer.Items)
+			{
+				if(CurrentItem.UniqueID.IdentityNumber == ItemID)
+				{
+					if(OutContainerID)
+					{
+						*OutContainerID = CurrentContainer.UniqueID.IdentityNumber;
+					}
+					return &CurrentItem;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	//A file inside the automation transient directory, removed before it's handed out.
+	inline FString GetTestFilePath(const FString& FileName)
+	{
+		const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("IFP"), FileName);
+		IFileManager::Get().Delete(*FilePath, false, true, true);
+		return FilePath;
+	}
+}
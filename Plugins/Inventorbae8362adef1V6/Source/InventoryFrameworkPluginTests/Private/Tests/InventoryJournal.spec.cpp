@@ -0,0 +1,247 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "IFPTestHelpers.h"
+#include "Core/Data/InventoryJournal.h"
+#include "Core/Data/SG_InventorySerialization.h"
+#include "Misc/FileHelper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FInventoryJournalSpec, "IFP.Serialization.Journal", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	FString JournalPath;
+
+	//The journal written by WriteJournal, a record for each step.
+	TArray<uint8> JournalData;
+
+	//Where every record of JournalData starts, indexed by its sequence.
+	TMap<int64, int32> RecordStarts;
+
+	/**Write a journal of a snapshot at @SnapshotSequence followed by
+	 * the records after it, out of: 2 add item 20, 3 move item 10 into container 2,
+	 * 4 change the count of item 20, 5 remove item 11.*/
+	void WriteJournal(int64 SnapshotSequence = 1);
+
+	//The containers after applying the records up to and including @Sequence.
+	TArray<FS_ContainerSettings> GetExpectedContainers(int64 Sequence);
+
+	TArray<FS_ContainerSettings> Replay(int64 AfterSequence, const TArray<FS_ContainerSettings>& Base, int64& OutLastSequence);
+
+END_DEFINE_SPEC(FInventoryJournalSpec)
+
+TArray<FS_ContainerSettings> FInventoryJournalSpec::GetExpectedContainers(int64 Sequence)
+{
+	TArray<FS_ContainerSettings> Containers = IFPTests::MakeInventory();
+	if(Sequence >= 2)
+	{
+		IFPTests::AddItem(Containers[0], 20, 8, 3);
+	}
+	if(Sequence >= 3)
+	{
+		FS_InventoryItem MovedItem = Containers[0].Items[0];
+		Containers[0].Items.RemoveAt(0);
+		MovedItem.TileIndex = 2;
+		MovedItem.Rotation = OneEighty;
+		Containers[1].Items.Add(MovedItem);
+	}
+	if(Sequence >= 4)
+	{
+		Containers[0].Items.FindByPredicate([](const FS_InventoryItem& Item) { return Item.UniqueID.IdentityNumber == 20; })->Count = 7;
+	}
+	if(Sequence >= 5)
+	{
+		Containers[0].Items.RemoveAll([](const FS_InventoryItem& Item) { return Item.UniqueID.IdentityNumber == 11; });
+	}
+	return Containers;
+}
+
+void FInventoryJournalSpec::WriteJournal(int64 SnapshotSequence)
+{
+	JournalData.Reset();
+	RecordStarts.Reset();
+	FInventoryJournal::WriteHeader(JournalData);
+
+	TArray<uint8> SnapshotData;
+	USG_InventorySerialization::WriteContainers(GetExpectedContainers(SnapshotSequence), false, SnapshotData);
+	RecordStarts.Add(SnapshotSequence, JournalData.Num());
+	FInventoryJournal::WriteRecord(JournalData, SnapshotSequence, EInventoryJournalOperation::Snapshot, [&SnapshotData](FArchive& Archive)
+	{
+		Archive << SnapshotData;
+	});
+
+	const TArray<FS_ContainerSettings> AddedItem = GetExpectedContainers(2);
+	for(int64 CurrentSequence = SnapshotSequence + 1; CurrentSequence <= 5; CurrentSequence++)
+	{
+		RecordStarts.Add(CurrentSequence, JournalData.Num());
+		switch(CurrentSequence)
+		{
+		case 2:
+			FInventoryJournal::WriteRecord(JournalData, CurrentSequence, EInventoryJournalOperation::AddItem, [&AddedItem](FArchive& Archive)
+			{
+				int32 ContainerID = 1;
+				Archive << ContainerID;
+				USG_InventorySerialization::WriteSingleItem(Archive, *IFPTests::FindItem(AddedItem, 20), false);
+			});
+			break;
+		case 3:
+			FInventoryJournal::WriteRecord(JournalData, CurrentSequence, EInventoryJournalOperation::Move, [](FArchive& Archive)
+			{
+				int32 ItemID = 10;
+				int32 ContainerID = 2;
+				int32 TileIndex = 2;
+				uint8 Rotation = OneEighty;
+				Archive << ItemID << ContainerID << TileIndex << Rotation;
+			});
+			break;
+		case 4:
+			FInventoryJournal::WriteRecord(JournalData, CurrentSequence, EInventoryJournalOperation::CountChange, [](FArchive& Archive)
+			{
+				int32 ItemID = 20;
+				int32 Count = 7;
+				Archive << ItemID << Count;
+			});
+			break;
+		case 5:
+			FInventoryJournal::WriteRecord(JournalData, CurrentSequence, EInventoryJournalOperation::Remove, [](FArchive& Archive)
+			{
+				int32 ItemID = 11;
+				Archive << ItemID;
+			});
+			break;
+		default:
+			break;
+		}
+	}
+
+	FFileHelper::SaveArrayToFile(JournalData, *JournalPath);
+}
+
+TArray<FS_ContainerSettings> FInventoryJournalSpec::Replay(int64 AfterSequence, const TArray<FS_ContainerSettings>& Base, int64& OutLastSequence)
+{
+	TArray<FS_ContainerSettings> Containers = Base;
+	TArray<FLoadedItemInstance> ItemInstances;
+	TestTrue("Replay", FInventoryJournal::Replay(JournalPath, AfterSequence, Containers, ItemInstances, &OutLastSequence));
+	return Containers;
+}
+
+void FInventoryJournalSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		JournalPath = IFPTests::GetTestFilePath(TEXT("JournalSpec.ifpj"));
+	});
+
+	AfterEach([this]()
+	{
+		IFileManager::Get().Delete(*JournalPath, false, true, true);
+	});
+
+	Describe("Replay", [this]()
+	{
+		It("should apply every record after the snapshot", [this]()
+		{
+			WriteJournal();
+			int64 LastSequence = 0;
+			const TArray<FS_ContainerSettings> Containers = Replay(-1, {}, LastSequence);
+			TestEqual("LastSequence", LastSequence, 5ll);
+
+			int32 ContainerID = 0;
+			const FS_InventoryItem* MovedItem = IFPTests::FindItem(Containers, 10, &ContainerID);
+			TestTrue("Moved item", MovedItem && ContainerID == 2 && MovedItem->TileIndex == 2 && MovedItem->Rotation == OneEighty);
+			const FS_InventoryItem* AddedItem = IFPTests::FindItem(Containers, 20, &ContainerID);
+			TestTrue("Added item", AddedItem && ContainerID == 1 && AddedItem->Count == 7);
+			TestNull("Removed item", IFPTests::FindItem(Containers, 11));
+		});
+
+		It("should only apply records after the save it is given", [this]()
+		{
+			WriteJournal();
+			int64 LastSequence = 0;
+			const TArray<FS_ContainerSettings> Containers = Replay(3, GetExpectedContainers(3), LastSequence);
+			TestEqual("LastSequence", LastSequence, 5ll);
+			TestEqual("Count changed once", IFPTests::FindItem(Containers, 20)->Count, 7);
+			TestNull("Removed item", IFPTests::FindItem(Containers, 11));
+			TestEqual("Item count", Containers[0].Items.Num() + Containers[1].Items.Num(), 3);
+		});
+
+		It("should stop at a record that was only partially written", [this]()
+		{
+			WriteJournal();
+			JournalData.SetNum(JournalData.Num() - 2);
+			FFileHelper::SaveArrayToFile(JournalData, *JournalPath);
+
+			int64 LastSequence = 0;
+			AddExpectedMessage(TEXT("ends in an incomplete record"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+			const TArray<FS_ContainerSettings> Containers = Replay(-1, {}, LastSequence);
+			TestEqual("LastSequence", LastSequence, 4ll);
+			TestNotNull("Item 11 was not removed", IFPTests::FindItem(Containers, 11));
+		});
+
+		It("should stop at a record that fails its checksum", [this]()
+		{
+			WriteJournal();
+			//Past the size and checksum, inside the payload of record 4.
+			JournalData[RecordStarts[4] + 12] ^= 0xFF;
+			FFileHelper::SaveArrayToFile(JournalData, *JournalPath);
+
+			int64 LastSequence = 0;
+			AddExpectedMessage(TEXT("has a corrupt record"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+			const TArray<FS_ContainerSettings> Containers = Replay(-1, {}, LastSequence);
+			TestEqual("LastSequence", LastSequence, 3ll);
+			TestEqual("Count is from before record 4", IFPTests::FindItem(Containers, 20)->Count, 3);
+			TestNotNull("Record 5 after it is ignored as well", IFPTests::FindItem(Containers, 11));
+		});
+
+		It("should stop when records are missing", [this]()
+		{
+			WriteJournal();
+			//Cut record 3 out.
+			JournalData.RemoveAt(RecordStarts[3], RecordStarts[4] - RecordStarts[3]);
+			FFileHelper::SaveArrayToFile(JournalData, *JournalPath);
+
+			int64 LastSequence = 0;
+			AddExpectedMessage(TEXT("is missing records"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+			Replay(-1, {}, LastSequence);
+			TestEqual("LastSequence", LastSequence, 2ll);
+		});
+
+		It("should end up in the same place after being compacted", [this]()
+		{
+			WriteJournal();
+			int64 LastSequence = 0;
+			const TArray<FS_ContainerSettings> FullReplay = Replay(-1, {}, LastSequence);
+
+			//A compaction replaces everything up to the snapshot with the snapshot.
+			WriteJournal(4);
+			int64 CompactedLastSequence = 0;
+			const TArray<FS_ContainerSettings> CompactedReplay = Replay(-1, {}, CompactedLastSequence);
+			TestEqual("LastSequence", CompactedLastSequence, LastSequence);
+
+			for(const int32 ItemID : {10, 12, 20})
+			{
+				int32 FullContainerID = 0;
+				int32 CompactedContainerID = 0;
+				const FS_InventoryItem* FullItem = IFPTests::FindItem(FullReplay, ItemID, &FullContainerID);
+				const FS_InventoryItem* CompactedItem = IFPTests::FindItem(CompactedReplay, ItemID, &CompactedContainerID);
+				if(TestTrue(FString::Printf(TEXT("Item %d exists in both"), ItemID), FullItem && CompactedItem))
+				{
+					TestEqual("Container", CompactedContainerID, FullContainerID);
+					TestEqual("TileIndex", CompactedItem->TileIndex, FullItem->TileIndex);
+					TestEqual("Count", CompactedItem->Count, FullItem->Count);
+				}
+			}
+		});
+
+		It("should refuse files that are not a journal", [this]()
+		{
+			FFileHelper::SaveStringToFile(TEXT("Not a journal"), *JournalPath);
+			TArray<FS_ContainerSettings> Containers;
+			TArray<FLoadedItemInstance> ItemInstances;
+			AddExpectedMessage(TEXT("is not an inventory journal"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+			TestFalse("Replay", FInventoryJournal::Replay(JournalPath, -1, Containers, ItemInstances));
+		});
+	});
+}
+
+#endif
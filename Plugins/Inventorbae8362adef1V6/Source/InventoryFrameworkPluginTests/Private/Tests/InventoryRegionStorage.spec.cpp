@@ -0,0 +1,118 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "IFPTestHelpers.h"
+#include "Core/Subsystems/InventoryRegionStorageSubsystem.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FInventoryRegionStorageSpec, "IFP.Serialization.RegionCells", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	FString CellPath;
+
+	TMap<FString, TArray<uint8>> Entries;
+
+END_DEFINE_SPEC(FInventoryRegionStorageSpec)
+
+void FInventoryRegionStorageSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		CellPath = IFPTests::GetTestFilePath(TEXT("Cell_0_0.ifpr"));
+
+		Entries.Reset();
+		USG_InventorySerialization::WriteContainers(IFPTests::MakeInventory(), false, Entries.Add(TEXT("Crate_1")));
+		Entries.Add(TEXT("Crate_2"), {1, 2, 3, 4, 5});
+		Entries.Add(TEXT("Corpse_1"), {42});
+	});
+
+	AfterEach([this]()
+	{
+		IFileManager::Get().Delete(*CellPath, false, true, true);
+	});
+
+	Describe("WriteCellFile", [this]()
+	{
+		It("should write an index that finds every entry", [this]()
+		{
+			FInventoryRegionCellIndex WrittenIndex;
+			TestTrue("Write", UInventoryRegionStorageSubsystem::WriteCellFile(CellPath, Entries, WrittenIndex));
+
+			TArray<uint8> FileData;
+			TestTrue("File exists", FFileHelper::LoadFileToArray(FileData, *CellPath));
+			FMemoryReader Reader(FileData, true);
+			FInventoryRegionCellIndex ReadIndex;
+			TestTrue("Read index", UInventoryRegionStorageSubsystem::ReadCellIndex(Reader, ReadIndex));
+			TestEqual("DataStart", ReadIndex.DataStart, WrittenIndex.DataStart);
+			TestEqual("Entry count", ReadIndex.Entries.Num(), Entries.Num());
+
+			for(const TPair<FString, TArray<uint8>>& CurrentEntry : Entries)
+			{
+				const FInventoryRegionEntry* Entry = ReadIndex.FindEntry(CurrentEntry.Key);
+				if(!TestNotNull(*CurrentEntry.Key, Entry) || !TestEqual("Size", Entry->Size, CurrentEntry.Value.Num()))
+				{
+					continue;
+				}
+
+				//Only the entry itself is read, the same way LoadInventory does.
+				const TArray<uint8> EntryData(FileData.GetData() + ReadIndex.DataStart + Entry->Offset, Entry->Size);
+				TestTrue(FString::Printf(TEXT("%s data"), *CurrentEntry.Key), EntryData == CurrentEntry.Value);
+			}
+		});
+
+		It("should keep the containers of an entry intact", [this]()
+		{
+			FInventoryRegionCellIndex WrittenIndex;
+			UInventoryRegionStorageSubsystem::WriteCellFile(CellPath, Entries, WrittenIndex);
+
+			TArray<uint8> FileData;
+			FFileHelper::LoadFileToArray(FileData, *CellPath);
+			const FInventoryRegionEntry* Entry = WrittenIndex.FindEntry(TEXT("Crate_1"));
+			const TArray<uint8> EntryData(FileData.GetData() + WrittenIndex.DataStart + Entry->Offset, Entry->Size);
+
+			TArray<FS_ContainerSettings> Containers;
+			TArray<FLoadedItemInstance> ItemInstances;
+			TestTrue("Read containers", USG_InventorySerialization::ReadContainers(EntryData, Containers, ItemInstances));
+			TestEqual("Count", IFPTests::FindItem(Containers, 12)->Count, 20);
+		});
+
+		It("should delete the cell once it has no entries left", [this]()
+		{
+			FInventoryRegionCellIndex WrittenIndex;
+			UInventoryRegionStorageSubsystem::WriteCellFile(CellPath, Entries, WrittenIndex);
+			TestTrue("Written", IFileManager::Get().FileExists(*CellPath));
+
+			TestTrue("Write empty", UInventoryRegionStorageSubsystem::WriteCellFile(CellPath, {}, WrittenIndex));
+			TestFalse("Deleted", IFileManager::Get().FileExists(*CellPath));
+			TestFalse("No temporary file left", IFileManager::Get().FileExists(*(CellPath + TEXT(".tmp"))));
+		});
+	});
+
+	Describe("ReadCellIndex", [this]()
+	{
+		It("should refuse files that are not a cell", [this]()
+		{
+			const TArray<uint8> FileData = {'N', 'o', 't', ' ', 'a', ' ', 'c', 'e', 'l', 'l', 0, 0};
+			FMemoryReader Reader(FileData, true);
+			FInventoryRegionCellIndex Index;
+			TestFalse("Read index", UInventoryRegionStorageSubsystem::ReadCellIndex(Reader, Index));
+		});
+
+		It("should refuse an index that was cut short", [this]()
+		{
+			FInventoryRegionCellIndex WrittenIndex;
+			UInventoryRegionStorageSubsystem::WriteCellFile(CellPath, Entries, WrittenIndex);
+
+			TArray<uint8> FileData;
+			FFileHelper::LoadFileToArray(FileData, *CellPath);
+			FileData.SetNum(WrittenIndex.DataStart - 4);
+			FMemoryReader Reader(FileData, true);
+			FInventoryRegionCellIndex Index;
+			TestFalse("Read index", UInventoryRegionStorageSubsystem::ReadCellIndex(Reader, Index));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,91 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "LootTableSystem/Data/LootTableCoreData.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FLootAliasTableSpec, "IFP.LootTable.AliasTable", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FLootAliasTableSpec)
+
+void FLootAliasTableSpec::Define()
+{
+	Describe("Build", [this]()
+	{
+		It("should refuse weights that can never be picked", [this]()
+		{
+			FLootAliasTable AliasTable;
+			TestFalse("Empty weights", AliasTable.Build(TConstArrayView<float>()));
+			TestTrue("Built even when empty", AliasTable.IsBuilt());
+			TestFalse("Only zero and negative weights", AliasTable.Build({0.f, -2.f}));
+			TestEqual("Nothing is drawn", AliasTable.Draw(FRandomStream(1)), INDEX_NONE);
+		});
+
+		It("should be reset by Reset", [this]()
+		{
+			FLootAliasTable AliasTable;
+			AliasTable.Build({1.f, 2.f});
+			AliasTable.Reset();
+			TestFalse("IsBuilt", AliasTable.IsBuilt());
+			TestTrue("IsEmpty", AliasTable.IsEmpty());
+		});
+	});
+
+	Describe("Draw", [this]()
+	{
+		It("should never pick entries without weight", [this]()
+		{
+			FLootAliasTable AliasTable;
+			TestTrue("Build", AliasTable.Build({0.f, 3.f, -1.f, 1.f}));
+			TestEqual("TotalWeight", AliasTable.GetTotalWeight(), 4.0);
+
+			const FRandomStream Stream(1234);
+			for(int32 CurrentDraw = 0; CurrentDraw < 1000; CurrentDraw++)
+			{
+				const int32 Picked = AliasTable.Draw(Stream);
+				if(Picked != 1 && Picked != 3)
+				{
+					AddError(FString::Printf(TEXT("Picked entry %d, which has no weight"), Picked));
+					return;
+				}
+			}
+		});
+
+		It("should follow the weights", [this]()
+		{
+			FLootAliasTable AliasTable;
+			AliasTable.Build({1.f, 2.f, 7.f});
+
+			constexpr int32 Draws = 100000;
+			int32 Picks[3] = {0, 0, 0};
+			const FRandomStream Stream(42);
+			for(int32 CurrentDraw = 0; CurrentDraw < Draws; CurrentDraw++)
+			{
+				Picks[AliasTable.Draw(Stream)]++;
+			}
+
+			TestNearlyEqual("Entry 0", Picks[0] / static_cast<double>(Draws), 0.1, 0.01);
+			TestNearlyEqual("Entry 1", Picks[1] / static_cast<double>(Draws), 0.2, 0.01);
+			TestNearlyEqual("Entry 2", Picks[2] / static_cast<double>(Draws), 0.7, 0.01);
+		});
+
+		It("should give the same picks for the same seed", [this]()
+		{
+			FLootAliasTable AliasTable;
+			AliasTable.Build({5.f, 1.f, 1.f, 3.f});
+
+			const FRandomStream First(99);
+			const FRandomStream Second(99);
+			for(int32 CurrentDraw = 0; CurrentDraw < 100; CurrentDraw++)
+			{
+				if(AliasTable.Draw(First) != AliasTable.Draw(Second))
+				{
+					AddError(FString::Printf(TEXT("Draw %d differs between identical streams"), CurrentDraw));
+					return;
+				}
+			}
+		});
+	});
+}
+
+#endif
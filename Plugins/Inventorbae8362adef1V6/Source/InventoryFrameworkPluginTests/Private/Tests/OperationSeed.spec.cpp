@@ -0,0 +1,67 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Core/Components/AC_Inventory.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FOperationSeedSpec, "IFP.Networking.OperationSeed", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FOperationSeedSpec)
+
+void FOperationSeedSpec::Define()
+{
+	Describe("MakeOperationSeed", [this]()
+	{
+		It("should give the same seed for the same operation", [this]()
+		{
+			//Client and server have to end up with the same seed.
+			const FRandomStream First = UAC_Inventory::MakeOperationSeed(TEXT("MoveItem"), 7, {1, 2, 3});
+			const FRandomStream Second = UAC_Inventory::MakeOperationSeed(TEXT("MoveItem"), 7, {1, 2, 3});
+			TestEqual("Seed", First.GetInitialSeed(), Second.GetInitialSeed());
+		});
+
+		It("should give a different seed when anything changes", [this]()
+		{
+			const int32 Seed = UAC_Inventory::MakeOperationSeed(TEXT("MoveItem"), 7, {1, 2, 3}).GetInitialSeed();
+			TestNotEqual("Operation", UAC_Inventory::MakeOperationSeed(TEXT("SplitItem"), 7, {1, 2, 3}).GetInitialSeed(), Seed);
+			TestNotEqual("Sequence", UAC_Inventory::MakeOperationSeed(TEXT("MoveItem"), 8, {1, 2, 3}).GetInitialSeed(), Seed);
+			TestNotEqual("Values", UAC_Inventory::MakeOperationSeed(TEXT("MoveItem"), 7, {1, 2, 4}).GetInitialSeed(), Seed);
+			TestNotEqual("Value order", UAC_Inventory::MakeOperationSeed(TEXT("MoveItem"), 7, {3, 2, 1}).GetInitialSeed(), Seed);
+		});
+
+		It("should stay inside the range of the old random seeds", [this]()
+		{
+			for(int32 Sequence = 0; Sequence < 1000; Sequence++)
+			{
+				const int32 Seed = UAC_Inventory::MakeOperationSeed(TEXT("MoveItem"), Sequence, {Sequence}).GetInitialSeed();
+				if(Seed < 1 || Seed > 214748364)
+				{
+					AddError(FString::Printf(TEXT("Sequence %d gave seed %d"), Sequence, Seed));
+					return;
+				}
+			}
+		});
+	});
+
+	Describe("GetOperationSeed", [this]()
+	{
+		It("should only depend on the seed base and sequence", [this]()
+		{
+			TestEqual("Same input", UAC_Inventory::GetOperationSeed(1234, 5).GetInitialSeed(), UAC_Inventory::GetOperationSeed(1234, 5).GetInitialSeed());
+			TestNotEqual("Other sequence", UAC_Inventory::GetOperationSeed(1234, 5).GetInitialSeed(), UAC_Inventory::GetOperationSeed(1234, 6).GetInitialSeed());
+			TestNotEqual("Other seed base", UAC_Inventory::GetOperationSeed(1234, 5).GetInitialSeed(), UAC_Inventory::GetOperationSeed(4321, 5).GetInitialSeed());
+		});
+
+		It("should rarely give two sequences the same seed", [this]()
+		{
+			TSet<int32> Seeds;
+			for(int32 Sequence = 0; Sequence < 10000; Sequence++)
+			{
+				Seeds.Add(UAC_Inventory::GetOperationSeed(1234, Sequence).GetInitialSeed());
+			}
+			TestTrue("Unique seeds", Seeds.Num() > 9990);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,75 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Core/Subsystems/RPCBudgetSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRPCTokenBucketSpec, "IFP.Networking.TokenBucket", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FRPCTokenBucketSpec)
+
+void FRPCTokenBucketSpec::Define()
+{
+	Describe("Refill", [this]()
+	{
+		It("should start with a full burst", [this]()
+		{
+			FRPCTokenBucket Bucket;
+			Bucket.Refill(100, 5, 1);
+			TestEqual("Tokens", Bucket.Tokens, 5.f);
+			TestEqual("LastRefillTime", Bucket.LastRefillTime, 100.0);
+		});
+
+		It("should refill over time, but never above the burst size", [this]()
+		{
+			FRPCTokenBucket Bucket;
+			Bucket.Refill(100, 5, 2);
+			Bucket.Tokens = 0;
+
+			Bucket.Refill(101, 5, 2);
+			TestEqual("One second later", Bucket.Tokens, 2.f);
+
+			Bucket.Refill(200, 5, 2);
+			TestEqual("Long after", Bucket.Tokens, 5.f);
+		});
+	});
+
+	Describe("TrySpend", [this]()
+	{
+		It("should reject once the burst is used up", [this]()
+		{
+			FRPCTokenBucket Bucket;
+			Bucket.Refill(100, 3, 1);
+			for(int32 CurrentRequest = 0; CurrentRequest < 3; CurrentRequest++)
+			{
+				TestTrue(FString::Printf(TEXT("Request %d"), CurrentRequest), Bucket.TrySpend());
+			}
+			TestFalse("Request after the burst", Bucket.TrySpend());
+
+			//Half a token isn't enough to pay for a request.
+			Bucket.Refill(100.5, 3, 1);
+			TestFalse("Half a second later", Bucket.TrySpend());
+			Bucket.Refill(101, 3, 1);
+			TestTrue("A second later", Bucket.TrySpend());
+		});
+
+		It("should keep up with a client that stays within the rate", [this]()
+		{
+			FRPCTokenBucket Bucket;
+			double CurrentTime = 100;
+			Bucket.Refill(CurrentTime, 1, 8);
+			for(int32 CurrentRequest = 0; CurrentRequest < 100; CurrentRequest++)
+			{
+				if(!TestTrue(FString::Printf(TEXT("Request %d"), CurrentRequest), Bucket.TrySpend()))
+				{
+					return;
+				}
+				//Exactly one token per request, 0.125 has no rounding error.
+				CurrentTime += 0.125;
+				Bucket.Refill(CurrentTime, 1, 8);
+			}
+		});
+	});
+}
+
+#endif